@@ -0,0 +1,50 @@
+#include "alloc_tracker.h"
+
+#ifdef DHT_ALLOC_TRACKING
+#include <cstdlib>
+#include <new>
+
+namespace {
+// 常量初始化的 thread_local，operator new 在任何时刻（含静态初始化期间）调用都安全
+thread_local alloc::Counters tCounters;
+
+void* countedMalloc(std::size_t size) noexcept {
+    ++tCounters.allocs;
+    tCounters.bytes += size;
+    return std::malloc(size ? size : 1);
+}
+
+void countedFree(void* p) noexcept {
+    if (!p) return;
+    ++tCounters.frees;
+    std::free(p);
+}
+} // namespace
+
+// 带对齐参数的版本未替换（本项目不使用过对齐类型），不计入统计
+void* operator new(std::size_t size) {
+    if (void* p = countedMalloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = countedMalloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedMalloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedMalloc(size); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+
+bool alloc::enabled() { return true; }
+alloc::Counters alloc::threadCounters() { return tCounters; }
+
+#else
+
+bool alloc::enabled() { return false; }
+alloc::Counters alloc::threadCounters() { return {}; }
+
+#endif
@@ -0,0 +1,252 @@
+#include "code_coverage.h"
+#include "thread_pool.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DHT_HAS_AVX2_PATH 1
+#endif
+
+namespace {
+constexpr int kCodes = CodeCoverage::kCodes;
+constexpr int kCopies = CodeCoverage::kHistCopies;
+
+// 直方图布局 [副本][通道][码值]；按像素轮流写入各副本，打断同一码值连续出现时的存储-加载依赖
+inline uint32_t* channel(uint32_t* hist, int copy, int c) { return hist + (copy * 3 + c) * kCodes; }
+
+void histScalar(const uint32_t* px, size_t n, uint32_t* hist) {
+    size_t i = 0;
+    for (; i + kCopies <= n; i += kCopies) {
+        for (int k = 0; k < kCopies; ++k) {
+            const uint32_t v = px[i + k];
+            channel(hist, k, 0)[v & 0x3FF]++;
+            channel(hist, k, 1)[(v >> 10) & 0x3FF]++;
+            channel(hist, k, 2)[(v >> 20) & 0x3FF]++;
+        }
+    }
+    for (; i < n; ++i) {
+        const uint32_t v = px[i];
+        channel(hist, 0, 0)[v & 0x3FF]++;
+        channel(hist, 0, 1)[(v >> 10) & 0x3FF]++;
+        channel(hist, 0, 2)[(v >> 20) & 0x3FF]++;
+    }
+}
+
+// 逐位翻转计数：8 个字节纵向计数器（acc[s] 的第 j 字节统计第 s + 8j 位），255 次迭代内不会溢出
+void flushCounters(const uint32_t* acc, int lanes, uint64_t* bitCount) {
+    for (int s = 0; s < 8; ++s) {
+        for (int lane = 0; lane < lanes; ++lane) {
+            const uint32_t a = acc[s * lanes + lane];
+            for (int j = 0; j < 4; ++j) bitCount[s + 8 * j] += (a >> (8 * j)) & 0xFF;
+        }
+    }
+}
+
+void toggleScalar(const uint32_t* cur, const uint32_t* prev, size_t n, uint64_t* bitCount) {
+    size_t i = 0;
+    while (i < n) {
+        const size_t end = std::min(n, i + 255);
+        uint32_t acc[8] = {};
+        for (; i < end; ++i) {
+            const uint32_t x = cur[i] ^ prev[i];
+            for (int s = 0; s < 8; ++s) acc[s] += (x >> s) & 0x01010101u;
+        }
+        flushCounters(acc, 1, bitCount);
+    }
+}
+
+#ifdef DHT_HAS_AVX2_PATH
+// 8 像素一组向量化提取三通道码值，再分散写入 4 份直方图副本（AVX2 无冲突检测，散射自增保持标量）
+__attribute__((target("avx2"))) void histAvx2(const uint32_t* px, size_t n, uint32_t* hist) {
+    const __m256i mask = _mm256_set1_epi32(0x3FF);
+    alignas(32) uint32_t idx[3][8];
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(px + i));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(idx[0]), _mm256_and_si256(v, mask));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(idx[1]), _mm256_and_si256(_mm256_srli_epi32(v, 10), mask));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(idx[2]), _mm256_and_si256(_mm256_srli_epi32(v, 20), mask));
+        for (int c = 0; c < 3; ++c) {
+            for (int k = 0; k < 8; ++k) channel(hist, k & (kCopies - 1), c)[idx[c][k]]++;
+        }
+    }
+    histScalar(px + i, n - i, hist);
+}
+
+__attribute__((target("avx2"))) void toggleAvx2(const uint32_t* cur, const uint32_t* prev, size_t n, uint64_t* bitCount) {
+    const __m256i ones = _mm256_set1_epi32(0x01010101);
+    const size_t vecEnd = n & ~static_cast<size_t>(7);
+    size_t i = 0;
+    alignas(32) uint32_t acc[8 * 8];
+    while (i < vecEnd) {
+        const size_t end = std::min(vecEnd, i + 255 * 8);
+        __m256i a[8];
+        for (__m256i& v : a) v = _mm256_setzero_si256();
+        for (; i < end; i += 8) {
+            const __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur + i)),
+                                               _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + i)));
+            a[0] = _mm256_add_epi8(a[0], _mm256_and_si256(x, ones));
+            a[1] = _mm256_add_epi8(a[1], _mm256_and_si256(_mm256_srli_epi32(x, 1), ones));
+            a[2] = _mm256_add_epi8(a[2], _mm256_and_si256(_mm256_srli_epi32(x, 2), ones));
+            a[3] = _mm256_add_epi8(a[3], _mm256_and_si256(_mm256_srli_epi32(x, 3), ones));
+            a[4] = _mm256_add_epi8(a[4], _mm256_and_si256(_mm256_srli_epi32(x, 4), ones));
+            a[5] = _mm256_add_epi8(a[5], _mm256_and_si256(_mm256_srli_epi32(x, 5), ones));
+            a[6] = _mm256_add_epi8(a[6], _mm256_and_si256(_mm256_srli_epi32(x, 6), ones));
+            a[7] = _mm256_add_epi8(a[7], _mm256_and_si256(_mm256_srli_epi32(x, 7), ones));
+        }
+        for (int s = 0; s < 8; ++s) _mm256_store_si256(reinterpret_cast<__m256i*>(acc + s * 8), a[s]);
+        flushCounters(acc, 8, bitCount);
+    }
+    toggleScalar(cur + vecEnd, prev + vecEnd, n - vecEnd, bitCount);
+}
+
+bool hasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+#endif
+
+void histogram(const uint32_t* px, size_t n, uint32_t* hist) {
+#ifdef DHT_HAS_AVX2_PATH
+    if (hasAvx2()) return histAvx2(px, n, hist);
+#endif
+    histScalar(px, n, hist);
+}
+
+void toggles(const uint32_t* cur, const uint32_t* prev, size_t n, uint64_t* bitCount) {
+#ifdef DHT_HAS_AVX2_PATH
+    if (hasAvx2()) return toggleAvx2(cur, prev, n, bitCount);
+#endif
+    toggleScalar(cur, prev, n, bitCount);
+}
+} // namespace
+
+CodeCoverage::CodeCoverage()
+    : partialHist_(static_cast<size_t>(kSegments) * kHistCopies * 3 * kCodes), partialBits_(kSegments * 32),
+      total_(3 * kCodes, 0),
+      ring_(std::make_unique<ReadbackRing>(kSlots, "coverage", [this](const ReadbackRing::Frame& f) { onFrame(f); })) {}
+
+const char* CodeCoverage::simdPath() {
+#ifdef DHT_HAS_AVX2_PATH
+    if (hasAvx2()) return "avx2";
+#endif
+    return "scalar";
+}
+
+void CodeCoverage::reset() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    resetRequested_ = true;
+    // 已在途的旧图样帧不计入：后台按帧号丢弃
+    resetFrom_ = lastCapture_ + 1;
+}
+
+CodeCoverage::Stats CodeCoverage::stats() const {
+    Stats st;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        st = stats_;
+    }
+    st.skipped = ring_->skipped();
+    return st;
+}
+
+void CodeCoverage::capture(unsigned long long frame, GLuint fbo, GLenum readBuffer, int width, int height) {
+    DHT_TRACE_ZONE("coverage readback");
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        lastCapture_ = frame;
+    }
+    // 始终按 10-bit 读取：8-bit 帧缓冲的码值经转换后只落在 256 个位置上
+    ring_->capture(frame, "", fbo, readBuffer, width, height);
+}
+
+void CodeCoverage::onFrame(const ReadbackRing::Frame& frame) {
+    if (!frame.data) return;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (resetRequested_) {
+            resetRequested_ = false;
+            std::fill(total_.begin(), total_.end(), 0);
+            std::memset(toggleCount_, 0, sizeof(toggleCount_));
+            togglePixels_ = 0;
+            havePrev_ = false;
+            stats_ = Stats{};
+        }
+        if (frame.frame < resetFrom_) return;
+    }
+    analyze(frame);
+}
+
+void CodeCoverage::analyze(const ReadbackRing::Frame& slot) {
+    DHT_TRACE_ZONE("coverage analyze");
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    const size_t n = static_cast<size_t>(slot.width) * slot.height;
+    // 只有帧号相邻的两帧才统计翻转（中间有跳过时的差异不代表逐帧变化）
+    const bool pair = havePrev_ && slot.frame == prevFrame_ + 1 && prev_.size() == n;
+    const uint32_t* cur = slot.data;
+    const uint32_t* prev = prev_.data();
+    const size_t histSize = static_cast<size_t>(kHistCopies) * 3 * kCodes;
+    ThreadPool::shared().parallelFor(kSegments, 1, [&](size_t s0, size_t s1) {
+        for (size_t s = s0; s < s1; ++s) {
+            uint32_t* hist = partialHist_.data() + s * histSize;
+            uint64_t* bits = partialBits_.data() + s * 32;
+            std::fill(hist, hist + histSize, 0u);
+            std::fill(bits, bits + 32, 0ull);
+            const size_t b = n * s / kSegments, e = n * (s + 1) / kSegments;
+            histogram(cur + b, e - b, hist);
+            if (pair) toggles(cur + b, prev + b, e - b, bits);
+        }
+    });
+
+    Stats st;
+    uint64_t bitCount[32] = {};
+    for (int c = 0; c < 3; ++c) {
+        int frameUsed = 0;
+        for (int code = 0; code < kCodes; ++code) {
+            uint64_t count = 0;
+            for (int s = 0; s < kSegments; ++s) {
+                const uint32_t* hist = partialHist_.data() + s * histSize;
+                for (int k = 0; k < kHistCopies; ++k) count += hist[(k * 3 + c) * kCodes + code];
+            }
+            frameUsed += count != 0;
+            total_[c * kCodes + code] += count;
+        }
+        st.frameUsed[c] = frameUsed;
+    }
+    if (pair) {
+        for (size_t i = 0; i < partialBits_.size(); ++i) bitCount[i % 32] += partialBits_[i];
+        for (int c = 0; c < 3; ++c) {
+            for (int b = 0; b < kBits; ++b) toggleCount_[c][b] += bitCount[c * 10 + b];
+        }
+        togglePixels_ += n;
+    }
+    for (int c = 0; c < 3; ++c) {
+        const uint64_t* h = total_.data() + c * kCodes;
+        st.totalUsed[c] = static_cast<int>(std::count_if(h, h + kCodes, [](uint64_t v) { return v != 0; }));
+        const uint64_t* lo = std::find_if(h, h + kCodes, [](uint64_t v) { return v != 0; });
+        const uint64_t* hi = std::find_if(std::make_reverse_iterator(h + kCodes), std::make_reverse_iterator(h),
+                                          [](uint64_t v) { return v != 0; }).base();
+        st.minCode[c] = lo == h + kCodes ? 0 : static_cast<int>(lo - h);
+        st.maxCode[c] = hi == h ? 0 : static_cast<int>(hi - h - 1);
+        for (int b = 0; b < kBits; ++b) {
+            st.toggle[c][b] = togglePixels_ ? static_cast<double>(toggleCount_[c][b]) / togglePixels_ : 0.0;
+        }
+    }
+    prev_.assign(cur, cur + n);
+    prevFrame_ = slot.frame;
+    havePrev_ = true;
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    st.frames = stats_.frames + 1;
+    st.pairs = stats_.pairs + (pair ? 1 : 0);
+    st.lastFrame = slot.frame;
+    st.lastAnalyzeMs = ms;
+    st.width = slot.width;
+    st.height = slot.height;
+    stats_ = st;
+}
@@ -0,0 +1,453 @@
+#include "cpu_raster.h"
+#include "noise_hash.h"
+#include "patterns.h"
+#include "philox.h"
+#include "thread_pool.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DHT_HAS_AVX2_PATH 1
+#endif
+
+// 移植约定：逐像素的 float 运算顺序与 GLSL 源码一致（不使用 FMA），
+// uv 取像素中心 (x+0.5)/w，p = uv * 分辨率；GLSL 内建函数按规范定义展开（mix = a*(1-t)+b*t 等）
+namespace cpuraster {
+namespace {
+
+struct V3 { float r, g, b; };
+
+struct Ctx {
+    int width, height;
+    float resX, resY;
+    float t;        // uTime
+    float pf;       // float(uFrameIndex)
+    float tf;       // t + pf * 0.031
+    uint32_t fr;    // uint(uFrameIndex)
+};
+
+inline float fractf(float x) { return x - std::floor(x); }
+inline float modf1(float x, float y) { return x - y * std::floor(x / y); }
+inline float clampf(float x, float lo, float hi) { return std::min(std::max(x, lo), hi); }
+inline float clamp01(float x) { return clampf(x, 0.0f, 1.0f); }
+inline float mixf(float a, float b, float t) { return a * (1.0f - t) + b * t; }
+inline float stepf(float edge, float x) { return x < edge ? 0.0f : 1.0f; }
+inline float smoothstepf(float e0, float e1, float x) {
+    float t = clamp01((x - e0) / (e1 - e0));
+    return t * t * (3.0f - 2.0f * t);
+}
+inline float length2(float x, float y) { return std::sqrt(x * x + y * y); }
+
+V3 hsv2rgb(float h, float s, float v) {
+    const float k[3] = {0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+    float c[3];
+    for (int i = 0; i < 3; ++i) {
+        float p = std::fabs(fractf(h + k[i]) * 6.0f - 3.0f);
+        c[i] = v * mixf(1.0f, clamp01(p - 1.0f), s);
+    }
+    return {c[0], c[1], c[2]};
+}
+
+inline float hash1(int cx, int cy, uint32_t seed) {
+    return noise::hashToUnit(noise::xxhash32(static_cast<uint32_t>(cx), static_cast<uint32_t>(cy), seed));
+}
+
+// 帧缓冲 UNORM 转换（q10 量化过的值在此处精确还原为码值）
+inline uint32_t code(float c) { return static_cast<uint32_t>(std::floor(clamp01(c) * 1023.0f + 0.5f)); }
+inline uint32_t pack(V3 c) { return code(c.r) | (code(c.g) << 10) | (code(c.b) << 20) | (3u << 30); }
+inline V3 gray(float v) { return {v, v, v}; }
+
+// ---- 静态图样 ----
+V3 colorBars(float u) {
+    static constexpr V3 kBars[8] = {{1, 1, 1}, {1, 1, 0}, {0, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 0, 0}, {0, 0, 1}, {0, 0, 0}};
+    int idx = static_cast<int>(std::floor(u * 8.0f));
+    return kBars[std::clamp(idx, 0, 7)];
+}
+
+float gridMask(float px, float py, float spacing) {
+    const float lw = 1.0f;
+    float fx = fractf(px / spacing), fy = fractf(py / spacing);
+    return (fx < lw / spacing || fy < lw / spacing) ? 1.0f : 0.0f;
+}
+
+V3 staticPixel(const Ctx& c, int idx, float u, float v) {
+    const float px = u * c.resX, py = v * c.resY;
+    switch (idx) {
+        case 0: return colorBars(u);
+        case 1: return gray(clamp01(u));
+        case 2: return gray((std::floor(u * 16.0f) + 0.5f) / 16.0f);
+        case 3: return gray(modf1(std::floor(px) + std::floor(py), 2.0f));
+        case 4: return gray(modf1(std::floor(u * 16.0f) + std::floor(v * 16.0f), 2.0f));
+        case 5: return gray(mixf(0.10f, 1.0f, gridMask(px, py, 32.0f)));   // gridPattern(uv, 0.0)：背景不随时间变化
+        case 6: return gray(mixf(0.15f, 1.0f, gridMask(px, py, 8.0f)));
+        case 7: {
+            int m = static_cast<int>(std::floor(u * 90.0f)) % 3;
+            return m == 0 ? V3{1, 0, 0} : (m == 1 ? V3{0, 1, 0} : V3{0, 0, 1});
+        }
+        case 8: {
+            const float lw = 1.0f;
+            float line = stepf(std::fabs(u - 0.5f) * c.resX, lw) + stepf(std::fabs(v - 0.5f) * c.resY, lw);
+            line += stepf(std::fabs(u - 1.0f / 3.0f) * c.resX, lw) + stepf(std::fabs(u - 2.0f / 3.0f) * c.resX, lw) +
+                    stepf(std::fabs(v - 1.0f / 3.0f) * c.resY, lw) + stepf(std::fabs(v - 2.0f / 3.0f) * c.resY, lw);
+            return gray(clamp01(line));
+        }
+        case 9:  return gray(0.0f);
+        case 10: return gray(1.0f);
+        case 11: return {1, 0, 0};
+        case 12: return {0, 1, 0};
+        case 13: return {0, 0, 1};
+        case 14: return gray(0.5f);
+        case 15: return gray(std::cos(std::atan2(v - 0.5f, u - 0.5f) * 100.0f) > 0.0f ? 1.0f : 0.0f);
+        case 16: return gray(std::sin(400.0f * u * u) > 0.0f ? 1.0f : 0.0f);
+        case 17: return gray(std::sin(400.0f * v * v) > 0.0f ? 1.0f : 0.0f);
+        case 18: {
+            float cx = u - 0.5f, cy = v - 0.5f;
+            return gray(std::sin(120.0f * (cx * cx + cy * cy)) > 0.0f ? 1.0f : 0.0f);
+        }
+        case 19: {
+            float gx = fractf(px / 16.0f), gy = fractf(py / 16.0f);
+            float dx = std::min(gx, 1.0f - gx), dy = std::min(gy, 1.0f - gy);
+            float r = length2((dx - 0.5f / 16.0f) * 16.0f, (dy - 0.5f / 16.0f) * 16.0f);
+            return gray(smoothstepf(0.15f, 0.05f, r));
+        }
+        case 20: {
+            float g = (std::floor(u * 8.0f) + 0.5f) / 8.0f;
+            float cb = modf1(std::floor(u * 16.0f) + std::floor(v * 16.0f), 2.0f);
+            const float amp = 0.15f;
+            return gray(clamp01(g + (cb > 0.5f ? amp : -amp) * (1.0f - g) * g));
+        }
+    }
+    return gray(0.0f);
+}
+
+// ---- 动态图样（generateComplexColor；q10 量化由 code() 完成）----
+V3 bitPlaneFlicker(float u, float v, float t) {
+    int q = static_cast<int>(std::floor(clamp01(u) * 1023.0f + 0.5f));
+    int bitIdx = static_cast<int>(modf1(std::floor(t * 2.0f), 5.0f));
+    int phase = static_cast<int>(modf1(std::floor(t * 120.0f), 2.0f));
+    int qg = static_cast<int>(std::floor(v * 1023.0f + 0.5f));
+    int qb = static_cast<int>(std::floor(fractf(u + v) * 1023.0f + 0.5f));
+    if (phase == 1) {
+        q ^= 1 << bitIdx;
+        qg ^= 1 << ((bitIdx + 1) % 5);
+        qb ^= 1 << ((bitIdx + 2) % 5);
+    }
+    return {clamp01(q / 1023.0f), qg / 1023.0f, qb / 1023.0f};
+}
+
+V3 dynamicPixel(const Ctx& c, int idx, float u, float v) {
+    const float px = u * c.resX, py = v * c.resY;
+    const float t = c.t, pf = c.pf, tf = c.tf;
+    const int ix = static_cast<int>(std::floor(px)), iy = static_cast<int>(std::floor(py));
+    switch (idx) {
+        case 0: {
+            float dx = (u - 0.5f) * 2.0f, dy = (v - 0.5f) * 2.0f;
+            float h = fractf(std::atan2(dy, dx) / 6.2831853f + 1.0f + t * 0.06f);
+            return hsv2rgb(h, 0.9f, clamp01(1.0f - length2(dx, dy) * 0.2f));
+        }
+        case 1: {
+            noise::U3 hb = noise::pcg3d({static_cast<uint32_t>(ix), static_cast<uint32_t>(iy), c.fr});
+            float h1 = noise::hashToUnit(hb.x), h2 = noise::hashToUnit(hb.y), h3 = noise::hashToUnit(hb.z);
+            float m1 = hash1(static_cast<int>(std::floor(px * 0.5f)), static_cast<int>(std::floor(py * 0.5f)), c.fr * 2u + 1u);
+            float m2 = hash1(static_cast<int>(std::floor(px * 2.7f)), static_cast<int>(std::floor(py * 2.7f)), c.fr * 2u + 2u);
+            return {mixf(h1, m1, 0.5f), mixf(h2, m2, 0.5f), mixf(h3, h1, 0.5f)};
+        }
+        case 2: {
+            const float k = 6.28318f;
+            return {0.5f + 0.5f * std::sin(k * (u * 38.0f + v * 5.0f) + tf * 2.0f),
+                    0.5f + 0.5f * std::sin(k * (u * 7.0f + v * 33.0f) - tf * 1.7f),
+                    0.5f + 0.5f * std::sin(k * (u * 0.0f + v * 41.0f) + tf * 2.6f)};
+        }
+        case 3: {
+            float ppx = px * 0.5f + tf * 12.0f, ppy = py * 0.5f + tf * 9.4f;
+            int cx = static_cast<int>(std::floor(ppx)), cy = static_cast<int>(std::floor(ppy));
+            float n = clamp01(hash1(cx, cy, 0x3A1Fu) * 0.7f + hash1(cx, cy, 0x7C2Bu) * 0.3f);
+            return hsv2rgb(n, 0.9f, 0.95f);
+        }
+        case 4: {
+            float dx = (u - 0.5f) * 2.0f, dy = (v - 0.5f) * 2.0f;
+            float r = length2(dx, dy);
+            float a2 = std::atan2(dy, dx) + r * 3.0f + tf * 0.4f;
+            return {0.5f + 0.5f * std::sin(180.0f * a2),
+                    0.5f + 0.5f * std::sin(120.0f * (r + 0.3f * a2) + tf * 1.7f),
+                    0.5f + 0.5f * std::sin(90.0f * (r - 0.2f * a2) - tf * 1.1f)};
+        }
+        case 5: {
+            float dx = (u - 0.5f) * 2.0f, dy = (v - 0.5f) * 2.0f;
+            float r = length2(dx, dy);
+            float a = std::atan2(dy, dx);
+            float aN = a / 6.2831853f + 1.0f;
+            float w = mixf(80.0f, 240.0f, 0.5f + 0.5f * std::sin(tf * 0.27f + pf * 0.013f));
+            float ring = 0.5f + 0.5f * std::sin(w * r * r + tf * 1.3f + pf * 0.11f);
+            float hue = fractf(0.28f * aN + 0.35f * r + 0.15f * ring + tf * 0.07f + pf * 0.017f);
+            float sat = 0.75f + 0.25f * (0.5f + 0.5f * std::sin(6.0f * a + 3.0f * r + tf * 0.9f + pf * 0.05f));
+            return hsv2rgb(hue, sat, 0.55f + 0.45f * ring);
+        }
+        case 6: {
+            const float k = 6.28318f;
+            return {0.5f + 0.5f * std::sin(k * ((u * 1.0f + v * 0.15f) * 45.0f) + tf * 2.1f),
+                    0.5f + 0.5f * std::sin(k * ((u * -0.2f + v * 1.00f) * 37.0f) - tf * 1.8f),
+                    0.5f + 0.5f * std::sin(k * ((u * 0.9f + v * -0.30f) * 53.0f) + tf * 2.9f)};
+        }
+        case 7: return hsv2rgb(fractf(u + v + tf * 0.35f + pf * 0.123f), 0.9f, 0.9f);
+        case 8: {
+            float w = fractf(u * 0.37f + v * 0.41f + tf * 0.50f + pf * 0.217f);
+            return {mixf(1.0f, 0.0f, w), mixf(0.0f, 1.0f, w), mixf(0.5f, 1.0f, w)};
+        }
+        case 9:
+            return {std::sin(u * 157.0f + tf * 2.31f + pf * 1.1f) * std::sin(v * 133.0f - tf * 1.77f + pf * 0.7f) * 0.5f + 0.5f,
+                    std::sin(u * 141.0f - tf * 2.07f + pf * 0.9f) * std::sin(v * 149.0f + tf * 1.61f + pf * 1.3f) * 0.5f + 0.5f,
+                    std::sin(u * 163.0f + tf * 2.83f + pf * 0.5f) * std::sin(v * 127.0f - tf * 1.29f + pf * 1.7f) * 0.5f + 0.5f};
+        case 10: return bitPlaneFlicker(u, v, t);
+        case 11: return hsv2rgb(fractf(u + tf * 0.55f + pf * 0.21f), 0.85f, 0.95f);
+        case 12: {
+            float ph = tf * 0.85f + pf * 0.23f;
+            const float k = 6.28318f;
+            return {0.5f + 0.5f * std::sin(k * (u * 0.23f + v * 0.31f) + ph),
+                    0.5f + 0.5f * std::sin(k * (u * 0.29f + v * 0.17f) + ph + 2.094f),
+                    0.5f + 0.5f * std::sin(k * (u * 0.19f + v * 0.27f) + ph + 4.188f)};
+        }
+        case 13: {
+            const float Y = 0.7f;
+            float U = std::sin(u * 3.0f + tf * 1.2f + pf * 0.7f) * 0.5f;
+            float V = std::sin(v * 3.0f - tf * 1.5f + pf * 0.9f) * 0.5f;
+            return {clamp01(Y + 1.13983f * V), clamp01(Y - 0.39465f * U - 0.58060f * V), clamp01(Y + 2.03211f * U)};
+        }
+    }
+    return gray(0.0f); // 14 (Philox) 由整行内核处理
+}
+
+// ---- 辅助图样 ----
+V3 ufoPixel(float u, float v, float time) {
+    V3 col = gray(0.02f);
+    const int rowCount = 3;
+    for (int i = 0; i < rowCount; ++i) {
+        float y = mixf(0.2f, 0.8f, (i + 0.5f) / rowCount);
+        float speed = mixf(0.6f, 2.5f, i / std::max(1.0f, rowCount - 1.0f));
+        float cx = fractf(time * speed);
+        float body = smoothstepf(0.08f, 0.08f - 0.005f, length2((u - cx) * 2.0f, v - y));
+        float dome = smoothstepf(0.05f, 0.045f, length2(u - cx, v - (y + 0.035f)));
+        float trail = std::exp(-std::fabs(u - cx) * 30.0f) * smoothstepf(0.02f, 0.0f, std::fabs(v - y));
+        V3 ship = {mixf(0.1f, 1.0f, dome) * 0.9f, mixf(0.8f, 1.0f, dome) * 0.9f, mixf(1.0f, 1.0f, dome) * 0.9f};
+        float shipBody = mixf(0.1f, 0.9f, body);
+        col = {std::max({col.r, shipBody, ship.r, 1.0f * trail}), std::max({col.g, shipBody, ship.g, 0.8f * trail}),
+               std::max({col.b, shipBody, ship.b, 0.2f * trail})};
+    }
+    return col;
+}
+
+// ---- 行内核 ----
+using RowFn = void (*)(const Ctx&, int idx, int y, int x0, int x1, uint32_t* row);
+
+template <V3 (*Pixel)(const Ctx&, int, float, float)>
+void rowScalar(const Ctx& c, int idx, int y, int x0, int x1, uint32_t* row) {
+    const float v = (y + 0.5f) / c.resY;
+    for (int x = x0; x < x1; ++x) row[x] = pack(Pixel(c, idx, (x + 0.5f) / c.resX, v));
+}
+
+V3 auxPixel(const Ctx& c, int idx, float u, float v) {
+    return idx == 0 ? ufoPixel(u, v, c.t) : gray(0.04f + 0.04f * v);
+}
+
+void rowPhilox(const Ctx& c, int, int y, int x0, int x1, uint32_t* row) {
+    philox::rowCodes(c.fr, static_cast<uint32_t>(y), static_cast<uint32_t>(x0), static_cast<uint32_t>(x1 - x0), row + x0);
+    for (int x = x0; x < x1; ++x) row[x] |= 3u << 30;
+}
+
+void rowPhiloxScalar(const Ctx& c, int, int y, int x0, int x1, uint32_t* row) {
+    for (int x = x0; x < x1; ++x) row[x] = philox::packedCodes(static_cast<uint32_t>(x), static_cast<uint32_t>(y), c.fr) | (3u << 30);
+}
+
+#ifdef DHT_HAS_AVX2_PATH
+// 8 路整数哈希（与 noise:: 标量版本逐位一致）
+__attribute__((target("avx2"))) inline __m256i rotl17(__m256i h) {
+    return _mm256_or_si256(_mm256_slli_epi32(h, 17), _mm256_srli_epi32(h, 15));
+}
+
+__attribute__((target("avx2"))) inline __m256i xxhash8(__m256i x, __m256i y, uint32_t z) {
+    const __m256i P2 = _mm256_set1_epi32(static_cast<int>(2246822519u));
+    const __m256i P3 = _mm256_set1_epi32(static_cast<int>(3266489917u));
+    const __m256i P4 = _mm256_set1_epi32(static_cast<int>(668265263u));
+    __m256i h = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(z + 374761393u)), _mm256_mullo_epi32(x, P3));
+    h = _mm256_mullo_epi32(P4, rotl17(h));
+    h = _mm256_add_epi32(h, _mm256_mullo_epi32(y, P3));
+    h = _mm256_mullo_epi32(P4, rotl17(h));
+    h = _mm256_mullo_epi32(P2, _mm256_xor_si256(h, _mm256_srli_epi32(h, 15)));
+    h = _mm256_mullo_epi32(P3, _mm256_xor_si256(h, _mm256_srli_epi32(h, 13)));
+    return _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+}
+
+__attribute__((target("avx2"))) inline __m256 toUnit8(__m256i h) {
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(h, 8)), _mm256_set1_ps(1.0f / 16777216.0f));
+}
+
+__attribute__((target("avx2"))) inline __m256i floorToInt8(__m256 v) {
+    return _mm256_cvttps_epi32(_mm256_floor_ps(v));
+}
+
+__attribute__((target("avx2"))) inline __m256i code8(__m256 c) {
+    c = _mm256_min_ps(_mm256_max_ps(c, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+    return floorToInt8(_mm256_add_ps(_mm256_mul_ps(c, _mm256_set1_ps(1023.0f)), _mm256_set1_ps(0.5f)));
+}
+
+__attribute__((target("avx2"))) inline void store8(uint32_t* dst, __m256 r, __m256 g, __m256 b) {
+    __m256i p = _mm256_or_si256(code8(r), _mm256_slli_epi32(code8(g), 10));
+    p = _mm256_or_si256(p, _mm256_slli_epi32(code8(b), 20));
+    p = _mm256_or_si256(p, _mm256_set1_epi32(static_cast<int>(3u << 30)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), p);
+}
+
+// 像素中心坐标 p = ((x + 0.5) / w) * w，与标量路径同序计算
+__attribute__((target("avx2"))) inline __m256 pixelX8(const Ctx& c, int x, __m256& u) {
+    const __m256 lane = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+    u = _mm256_div_ps(_mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), lane), _mm256_set1_ps(c.resX));
+    return _mm256_mul_ps(u, _mm256_set1_ps(c.resX));
+}
+
+// D:1 多尺度哈希：PCG3D + 两级 xxhash32
+__attribute__((target("avx2"))) void rowMultiHashAvx2(const Ctx& c, int idx, int y, int x0, int x1, uint32_t* row) {
+    const float v = (y + 0.5f) / c.resY;
+    const float py = v * c.resY;
+    const __m256i iy = _mm256_set1_epi32(static_cast<int>(std::floor(py)));
+    const __m256i iy2 = _mm256_set1_epi32(static_cast<int>(std::floor(py * 0.5f)));
+    const __m256i iy3 = _mm256_set1_epi32(static_cast<int>(std::floor(py * 2.7f)));
+    const __m256i mul = _mm256_set1_epi32(1664525);
+    const __m256i inc = _mm256_set1_epi32(1013904223);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    int x = x0;
+    for (; x + 8 <= x1; x += 8) {
+        __m256 u;
+        const __m256 px = pixelX8(c, x, u);
+        // pcg3d(ix, iy, fr)
+        __m256i vx = _mm256_add_epi32(_mm256_mullo_epi32(floorToInt8(px), mul), inc);
+        __m256i vy = _mm256_add_epi32(_mm256_mullo_epi32(iy, mul), inc);
+        __m256i vz = _mm256_set1_epi32(static_cast<int>(c.fr * 1664525u + 1013904223u));
+        vx = _mm256_add_epi32(vx, _mm256_mullo_epi32(vy, vz));
+        vy = _mm256_add_epi32(vy, _mm256_mullo_epi32(vz, vx));
+        vz = _mm256_add_epi32(vz, _mm256_mullo_epi32(vx, vy));
+        vx = _mm256_xor_si256(vx, _mm256_srli_epi32(vx, 16));
+        vy = _mm256_xor_si256(vy, _mm256_srli_epi32(vy, 16));
+        vz = _mm256_xor_si256(vz, _mm256_srli_epi32(vz, 16));
+        vx = _mm256_add_epi32(vx, _mm256_mullo_epi32(vy, vz));
+        vy = _mm256_add_epi32(vy, _mm256_mullo_epi32(vz, vx));
+        vz = _mm256_add_epi32(vz, _mm256_mullo_epi32(vx, vy));
+        const __m256 h1 = toUnit8(vx), h2 = toUnit8(vy), h3 = toUnit8(vz);
+        const __m256 m1 = toUnit8(xxhash8(floorToInt8(_mm256_mul_ps(px, half)), iy2, c.fr * 2u + 1u));
+        const __m256 m2 = toUnit8(xxhash8(floorToInt8(_mm256_mul_ps(px, _mm256_set1_ps(2.7f))), iy3, c.fr * 2u + 2u));
+        // mix(a, b, 0.5) = a*0.5 + b*0.5
+        store8(row + x, _mm256_add_ps(_mm256_mul_ps(h1, half), _mm256_mul_ps(m1, half)),
+               _mm256_add_ps(_mm256_mul_ps(h2, half), _mm256_mul_ps(m2, half)),
+               _mm256_add_ps(_mm256_mul_ps(h3, half), _mm256_mul_ps(h1, half)));
+    }
+    rowScalar<dynamicPixel>(c, idx, y, x, x1, row);
+}
+
+// D:3 蓝噪声滚动：两路 xxhash32 + HSV 映射
+__attribute__((target("avx2"))) void rowBlueNoiseAvx2(const Ctx& c, int idx, int y, int x0, int x1, uint32_t* row) {
+    const float v = (y + 0.5f) / c.resY;
+    const __m256i cy = _mm256_set1_epi32(static_cast<int>(std::floor((v * c.resY) * 0.5f + c.tf * 9.4f)));
+    const __m256 scrollX = _mm256_set1_ps(c.tf * 12.0f);
+    const __m256 one = _mm256_set1_ps(1.0f), zero = _mm256_setzero_ps();
+    const __m256 s = _mm256_set1_ps(0.9f), oneMinusS = _mm256_set1_ps(1.0f - 0.9f), val = _mm256_set1_ps(0.95f);
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const float k[3] = {0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+    int x = x0;
+    for (; x + 8 <= x1; x += 8) {
+        __m256 u;
+        const __m256 px = pixelX8(c, x, u);
+        const __m256i cx = floorToInt8(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(0.5f)), scrollX));
+        const __m256 n1 = toUnit8(xxhash8(cx, cy, 0x3A1Fu));
+        const __m256 n2 = toUnit8(xxhash8(cx, cy, 0x7C2Bu));
+        __m256 h = _mm256_add_ps(_mm256_mul_ps(n1, _mm256_set1_ps(0.7f)), _mm256_mul_ps(n2, _mm256_set1_ps(0.3f)));
+        h = _mm256_min_ps(_mm256_max_ps(h, zero), one);
+        __m256 ch[3];
+        for (int i = 0; i < 3; ++i) {
+            __m256 t = _mm256_add_ps(h, _mm256_set1_ps(k[i]));
+            t = _mm256_sub_ps(t, _mm256_floor_ps(t));
+            t = _mm256_and_ps(_mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(3.0f)), absMask);
+            t = _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(t, one), zero), one);
+            ch[i] = _mm256_mul_ps(val, _mm256_add_ps(oneMinusS, _mm256_mul_ps(t, s)));
+        }
+        store8(row + x, ch[0], ch[1], ch[2]);
+    }
+    rowScalar<dynamicPixel>(c, idx, y, x, x1, row);
+}
+
+bool hasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+#endif
+
+std::atomic<bool> forceScalar{false};
+
+RowFn selectRow(int category, int index) {
+#ifdef DHT_HAS_AVX2_PATH
+    if (hasAvx2() && !forceScalar.load() && category == 1) {
+        if (index == 1) return rowMultiHashAvx2;
+        if (index == 3) return rowBlueNoiseAvx2;
+    }
+#endif
+    switch (category) {
+        case 0: return rowScalar<staticPixel>;
+        case 1:
+            if (index == 14) return forceScalar.load() ? rowPhiloxScalar : rowPhilox;
+            return rowScalar<dynamicPixel>;
+    }
+    return rowScalar<auxPixel>;
+}
+
+constexpr int kTileWidth = 256;
+constexpr int kTileHeight = 16;
+
+} // namespace
+
+void render(int category, int index, const Frame& frame, uint32_t* out) {
+    DHT_TRACE_ZONE("cpu raster");
+    const int w = frame.width, h = frame.height;
+    if (w <= 0 || h <= 0) return;
+    Ctx c;
+    c.width = w;
+    c.height = h;
+    c.resX = static_cast<float>(w);
+    c.resY = static_cast<float>(h);
+    c.t = frame.time;
+    c.fr = frame.frameIndex;
+    c.pf = static_cast<float>(frame.frameIndex);
+    c.tf = c.t + c.pf * 0.031f;
+    // 与着色器相同的索引钳制
+    if (category == 1) index = std::clamp(index, 0, kDynamicPatternCount - 1);
+    const RowFn row = selectRow(category, index);
+
+    // 块按行优先编号：工作窃取的初始均分使每个线程拿到连续的横带
+    const int tilesX = (w + kTileWidth - 1) / kTileWidth;
+    const int tilesY = (h + kTileHeight - 1) / kTileHeight;
+    ThreadPool::shared().parallelFor(static_cast<size_t>(tilesX) * tilesY, 1, [&](size_t t0, size_t t1) {
+        for (size_t t = t0; t < t1; ++t) {
+            const int tx = static_cast<int>(t % tilesX), ty = static_cast<int>(t / tilesX);
+            const int x0 = tx * kTileWidth, x1 = std::min(w, x0 + kTileWidth);
+            const int yEnd = std::min(h, (ty + 1) * kTileHeight);
+            for (int y = ty * kTileHeight; y < yEnd; ++y) row(c, index, y, x0, x1, out + static_cast<size_t>(y) * w);
+        }
+    });
+}
+
+bool bitExact(int category, int index) {
+    if (category == 0) return index == 3 || (index >= 9 && index <= 13);
+    if (category == 1) return index == 1 || index == 14;
+    return false;
+}
+
+const char* simdPath() {
+#ifdef DHT_HAS_AVX2_PATH
+    if (hasAvx2() && !forceScalar.load()) return "avx2";
+#endif
+    return "scalar";
+}
+
+void setForceScalar(bool scalar) { forceScalar.store(scalar); }
+
+} // namespace cpuraster
@@ -0,0 +1,182 @@
+#include "crc32c.h"
+
+#include <atomic>
+#include <cstring>
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define DHT_HAS_SSE42_PATH 1
+#endif
+
+namespace crc32c {
+namespace {
+
+constexpr uint32_t kPoly = 0x82F63B78u;   // 反射形式
+std::atomic<bool> forceTable{false};
+
+// slicing-by-8 查表
+struct Tables {
+    uint32_t t[8][256];
+    Tables() {
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? (c >> 1) ^ kPoly : c >> 1;
+            t[0][n] = c;
+        }
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = t[0][n];
+            for (int k = 1; k < 8; ++k) {
+                c = t[0][c & 0xFF] ^ (c >> 8);
+                t[k][n] = c;
+            }
+        }
+    }
+};
+const Tables& tables() {
+    static const Tables t;
+    return t;
+}
+
+uint32_t computeTable(const uint8_t* p, size_t n, uint32_t crc) {
+    const Tables& tb = tables();
+    while (n >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        v ^= crc;
+        crc = tb.t[7][v & 0xFF] ^ tb.t[6][(v >> 8) & 0xFF] ^ tb.t[5][(v >> 16) & 0xFF] ^ tb.t[4][(v >> 24) & 0xFF] ^
+              tb.t[3][(v >> 32) & 0xFF] ^ tb.t[2][(v >> 40) & 0xFF] ^ tb.t[1][(v >> 48) & 0xFF] ^ tb.t[0][v >> 56];
+        p += 8;
+        n -= 8;
+    }
+    while (n--) crc = tb.t[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+#ifdef DHT_HAS_SSE42_PATH
+// 三路交错：crc32 指令延迟 3 周期、吞吐 1 周期，三个独立流并行后用“追加 N 个零字节”算子合并
+constexpr size_t kLong = 8192;
+constexpr size_t kShort = 256;
+
+uint32_t gf2Times(const uint32_t* mat, uint32_t vec) {
+    uint32_t sum = 0;
+    while (vec) {
+        if (vec & 1) sum ^= *mat;
+        vec >>= 1;
+        ++mat;
+    }
+    return sum;
+}
+
+void gf2Square(uint32_t* square, const uint32_t* mat) {
+    for (int n = 0; n < 32; ++n) square[n] = gf2Times(mat, mat[n]);
+}
+
+// 对 CRC 追加 len 个零字节的线性算子，展开为 4 张字节表
+struct ShiftTable {
+    uint32_t z[4][256];
+    explicit ShiftTable(size_t len) {
+        uint32_t odd[32], even[32];
+        odd[0] = kPoly;
+        uint32_t row = 1;
+        for (int n = 1; n < 32; ++n) {
+            odd[n] = row;
+            row <<= 1;
+        }
+        gf2Square(even, odd);  // 2 个零位
+        gf2Square(odd, even);  // 4 个零位
+        const uint32_t* op = nullptr;
+        for (;;) {             // 每次平方使位数翻倍：8 位 = 1 字节起
+            gf2Square(even, odd);
+            len >>= 1;
+            if (len == 0) { op = even; break; }
+            gf2Square(odd, even);
+            len >>= 1;
+            if (len == 0) { op = odd; break; }
+        }
+        for (uint32_t n = 0; n < 256; ++n) {
+            z[0][n] = gf2Times(op, n);
+            z[1][n] = gf2Times(op, n << 8);
+            z[2][n] = gf2Times(op, n << 16);
+            z[3][n] = gf2Times(op, n << 24);
+        }
+    }
+    uint32_t shift(uint32_t crc) const {
+        return z[0][crc & 0xFF] ^ z[1][(crc >> 8) & 0xFF] ^ z[2][(crc >> 16) & 0xFF] ^ z[3][crc >> 24];
+    }
+};
+
+__attribute__((target("sse4.2"))) uint64_t threeWay(const uint8_t*& p, size_t& n, uint64_t c0,
+                                                    size_t block, const ShiftTable& st) {
+    while (n >= block * 3) {
+        uint64_t c1 = 0, c2 = 0;
+        const uint8_t* end = p + block;
+        do {
+            uint64_t a, b, c;
+            std::memcpy(&a, p, 8);
+            std::memcpy(&b, p + block, 8);
+            std::memcpy(&c, p + 2 * block, 8);
+            c0 = _mm_crc32_u64(c0, a);
+            c1 = _mm_crc32_u64(c1, b);
+            c2 = _mm_crc32_u64(c2, c);
+            p += 8;
+        } while (p < end);
+        c0 = st.shift(static_cast<uint32_t>(c0)) ^ c1;
+        c0 = st.shift(static_cast<uint32_t>(c0)) ^ c2;
+        p += 2 * block;
+        n -= 3 * block;
+    }
+    return c0;
+}
+
+__attribute__((target("sse4.2"))) uint32_t computeSse42(const uint8_t* p, size_t n, uint32_t crc) {
+    static const ShiftTable longShift(kLong);
+    static const ShiftTable shortShift(kShort);
+    uint64_t c0 = crc;
+    while (n && (reinterpret_cast<uintptr_t>(p) & 7)) {
+        c0 = _mm_crc32_u8(static_cast<uint32_t>(c0), *p++);
+        --n;
+    }
+    c0 = threeWay(p, n, c0, kLong, longShift);
+    c0 = threeWay(p, n, c0, kShort, shortShift);
+    while (n >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        c0 = _mm_crc32_u64(c0, v);
+        p += 8;
+        n -= 8;
+    }
+    while (n--) c0 = _mm_crc32_u8(static_cast<uint32_t>(c0), *p++);
+    return static_cast<uint32_t>(c0);
+}
+
+bool hasSse42() {
+    static const bool has = __builtin_cpu_supports("sse4.2");
+    return has;
+}
+#endif
+
+bool useSse42() {
+#ifdef DHT_HAS_SSE42_PATH
+    return hasSse42() && !forceTable.load(std::memory_order_relaxed);
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+uint32_t compute(const void* data, size_t bytes, uint32_t seed) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    const uint32_t crc = ~seed;
+#ifdef DHT_HAS_SSE42_PATH
+    if (useSse42()) return ~computeSse42(p, bytes, crc);
+#endif
+    return ~computeTable(p, bytes, crc);
+}
+
+const char* implementation() {
+    return useSse42() ? "sse4.2" : "table";
+}
+
+void setForceTable(bool table) { forceTable.store(table); }
+
+} // namespace crc32c
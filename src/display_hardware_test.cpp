@@ -1,6 +1,27 @@
 #include "display_hardware_test.h"
 #include "shader.h"
 #include "text_renderer.h"
+#include "noise_hash.h"
+#include "philox.h"
+#include "gl_state.h"
+#include "patterns.h"
+#include "render_target.h"
+#include "display_backend.h"
+#include "present_bench.h"
+#include "alloc_tracker.h"
+#include "trace.h"
+#include "probes.h"
+#include "gl_debug.h"
+#include "draw_stress.h"
+#include "upload_stream.h"
+#include "async_readback.h"
+#include "crc32c.h"
+#include "code_coverage.h"
+#include "frame_entropy.h"
+#include "dsc_model.h"
+#include "marker_renderer.h"
+#include "vram_test.h"
+#include <GLFW/glfw3.h>
 
 #include <iostream>
 #include <sstream>
@@ -10,8 +31,10 @@
 #include <vector>
 #include <filesystem>
 #include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 #include <cctype>
+#include <ctime>
 #include <iomanip>
 #if defined(_WIN32)
 #ifndef NOMINMAX
@@ -26,545 +49,8 @@
 #include <fontconfig/fontconfig.h>
 #endif
 
-// 着色器源码定义（主背景/内容）
-const std::string MonitorTest::vertexShaderSource = R"(
-#version 330 core
-layout (location = 0) in vec2 aPos;       // NDC 顶点坐标 [-1,1]
-layout (location = 1) in vec2 aTexCoord;  // 纹理坐标 [0,1]
-
-out vec2 TexCoord;
-
-void main()
-{
-    gl_Position = vec4(aPos, 0.0, 1.0);
-    TexCoord = aTexCoord;
-}
-)";
-
-const std::string MonitorTest::fragmentShaderSource = R"(
-#version 330 core
-out vec4 FragColor;
-
-in vec2 TexCoord;
-
-uniform float uTime;
-uniform vec2 uResolution;
-uniform int uColorVariation;
-uniform int uContentMode;
-uniform int uCategory; // 0: STATIC, 1: DYNAMIC
-uniform int uFrameIndex; // frame counter to force per-frame changes
-
-// 10-bit 量化（0..1023）
-float q10(float v) { return clamp(floor(clamp(v,0.0,1.0) * 1023.0 + 0.5) / 1023.0, 0.0, 1.0); }
-
-vec3 hsv2rgb(vec3 c){
-    vec3 p = abs(fract(vec3(c.x,c.x,c.x) + vec3(0.0,2.0/3.0,1.0/3.0)) * 6.0 - 3.0);
-    vec3 rgb = clamp(p - 1.0, 0.0, 1.0);
-    return c.z * mix(vec3(1.0), rgb, c.y);
-}
-
-// 前置声明：在 generateComplexColor 中调用到的函数（定义在后文）
-vec3 bitPlaneFlicker(vec2 uv, float time);
-
-// 分区渐变颜色（避免硬切换），用于增加不可压缩性
-vec3 tileGradColor(vec2 uv, float time, float pf){
-    vec2 p = uv * uResolution;
-    // 两套偏移网格，错位避免与编码 slice 对齐
-    vec2 spA = vec2(32.0, 28.0);
-    vec2 spB = vec2(36.0, 24.0);
-    vec2 idxA = floor(p / spA);
-    vec2 idxB = floor((p + vec2(16.0,12.0)) / spB);
-    float seed = fract(sin(dot(idxA, vec2(12.9898,78.233)) + dot(idxB, vec2(39.3468,11.135)) + pf*7.1 + time*0.7) * 43758.5453);
-    float hue = fract(seed + 0.123 * sin(dot(idxA, vec2(3.1,5.7))) + 0.071 * sin(dot(idxB, vec2(2.3,4.9))));
-    vec2 localA = fract(p / spA);
-    vec2 localB = fract((p + vec2(16.0,12.0)) / spB);
-    float g = clamp(localA.x * 0.6 + localB.y * 0.4, 0.0, 1.0);
-    float sat = 0.88;
-    float val = 0.70 + 0.30 * g; // 单帧渐变
-    return hsv2rgb(vec3(hue, sat, val));
-}
-
-// RGB->HSV（h:[0,1), s,v:[0,1]）
-
-// 高熵颜色场（避免大块重复色）
-vec3 generateComplexColor(vec2 uv, float time, int variation) {
-    if (variation == -1) return vec3(0.0);
-    vec2 p = uv * uResolution;
-    float t = time;
-    float pf = float(uFrameIndex);
-    float tf = t + pf * 0.031; // per-frame phase offset
-
-    // 基础哈希（避免使用纹理）
-    float h1 = fract(sin(dot(floor(p), vec2(12.9898, 78.233)) + tf * 19.19 + pf * 57.53) * 43758.5453);
-    float h2 = fract(sin(dot(floor(p)+13.0, vec2(39.3468, 11.135)) + tf * 23.17 + pf * 31.17) * 24634.6345);
-    float h3 = fract(sin(dot(floor(p)+71.0, vec2(9.154, 27.983)) + tf * 29.41 + pf * 41.99) * 17431.3711);
-
-    vec3 c;
-    if (variation == 0) {
-        // 色轮#1：经典 HSV 轮，缓慢旋转
-        vec2 d = (uv - 0.5) * 2.0; float r = length(d);
-        float rot = t * 0.06;
-        float h = fract((atan(d.y,d.x) / 6.2831853) + 1.0 + rot);
-        float v2 = clamp(1.0 - r * 0.2, 0.0, 1.0);
-        c = hsv2rgb(vec3(h, 0.9, v2));
-    } else if (variation == 1) {
-        // 多尺度哈希混合（噪声#1）
-        vec2 p2 = p * 0.5; vec2 p3 = p * 2.7;
-        float m1 = fract(sin(dot(floor(p2), vec2(15.7, 47.3)) + tf * 13.3 + pf * 23.0) * 31871.1);
-        float m2 = fract(sin(dot(floor(p3), vec2(61.3, 21.9)) + tf * 31.7 + pf * 17.0) * 55147.3);
-        c = vec3(mix(h1, m1, 0.5), mix(h2, m2, 0.5), mix(h3, h1, 0.5));
-    } else if (variation == 2) {
-        // 频谱混合（中频条纹，三通道不同朝向/频率）
-        float sr = 0.5 + 0.5 * sin(6.28318 * (uv.x * 38.0 + uv.y * 5.0) + tf * 2.0);
-        float sg = 0.5 + 0.5 * sin(6.28318 * (uv.x * 7.0  + uv.y * 33.0) - tf * 1.7);
-        float sb = 0.5 + 0.5 * sin(6.28318 * (uv.x * 0.0  + uv.y * 41.0) + tf * 2.6);
-        c = vec3(sr, sg, sb);
-    } else if (variation == 3) {
-        // 蓝噪声滚动（使用取模防止大坐标精度丢失导致纯色）；颜色采用单帧渐变映射
-        vec2 pp = p * 0.5 + vec2(tf * 12.0, tf * 9.4);
-        vec2 cell = floor(mod(pp, 1024.0));
-        float n1 = fract(sin(dot(cell, vec2(12.9898, 78.233))) * 43758.5453);
-        float n2 = fract(sin(dot(cell + 23.0, vec2(39.3468, 11.135))) * 24634.6345);
-        float v = clamp((n1 * 0.7 + n2 * 0.3), 0.0, 1.0);
-        // 使用 v->hue 的渐变映射，避免颜色切换，帧间运动靠 pp 滚动实现
-        float hue = v;
-        c = hsv2rgb(vec3(hue, 0.9, 0.95));
-    } else if (variation == 4) {
-        // 径向扰动 + 旋涡条纹（与区域板区分：更强调角向旋涡）
-        vec2 d = (uv - 0.5) * 2.0;
-        float r = length(d);
-        float a = atan(d.y, d.x);
-        float a2 = a + r * 3.0 + tf * 0.4;
-        float v1 = 0.5 + 0.5 * sin(180.0 * a2);
-        float v2 = 0.5 + 0.5 * sin(120.0 * (r + 0.3 * a2) + tf * 1.7);
-        float v3 = 0.5 + 0.5 * sin(90.0  * (r - 0.2 * a2) - tf * 1.1);
-        c = vec3(v1, v2, v3);
-    } else if (variation == 5) {
-        // 区域板动态（Zoneplate Dynamic）：更丰富的渐变色，强调径向频率+角向相位
-        vec2 d = (uv - 0.5) * 2.0;
-        float r = length(d);
-        float a = atan(d.y, d.x);
-        float aN = (a / 6.2831853) + 1.0;
-        // 动态环频，随时间与帧序轻微变化，保证逐帧不同
-        float w = mix(80.0, 240.0, 0.5 + 0.5 * sin(tf * 0.27 + pf * 0.013));
-        float ring = 0.5 + 0.5 * sin(w * r * r + tf * 1.3 + pf * 0.11);
-        // 色相由角度、半径与环形相位共同决定，保证单帧内色彩丰富但连续
-        float hue = fract(0.28 * aN + 0.35 * r + 0.15 * ring + tf * 0.07 + pf * 0.017);
-        float sat = 0.75 + 0.25 * (0.5 + 0.5 * sin(6.0 * a + 3.0 * r + tf * 0.9 + pf * 0.05));
-        float val = 0.55 + 0.45 * ring;
-        c = hsv2rgb(vec3(hue, sat, val));
-    } else if (variation == 6) {
-        // 混合场（通道朝向/频段显著不同，拉大差异）
-        float rr = 0.5 + 0.5 * sin(6.28318 * (dot(uv, vec2( 1.0,  0.15)) * 45.0) + tf * 2.1);
-        float gg = 0.5 + 0.5 * sin(6.28318 * (dot(uv, vec2(-0.2,  1.00)) * 37.0) - tf * 1.8);
-        float bb = 0.5 + 0.5 * sin(6.28318 * (dot(uv, vec2( 0.9, -0.30)) * 53.0) + tf * 2.9);
-        c = vec3(rr, gg, bb);
-    } else if (variation == 7) {
-        // HSV 全色域覆盖（平滑，无抖动）
-        float h = fract(uv.x + uv.y + tf*0.35 + pf*0.123);
-        float s = 0.9;
-        float v = 0.9;
-        c = hsv2rgb(vec3(h,s,v));
-    } else if (variation == 8) {
-        // 谱梯度混合（平滑，无抖动）
-        float w = fract(uv.x*0.37 + uv.y*0.41 + tf*0.50 + pf*0.217);
-        vec3 a = vec3(1.0, 0.0, 0.5);
-        vec3 b2 = vec3(0.0, 1.0, 1.0);
-        c = mix(a, b2, w);
-    } else if (variation == 9) {
-        // Lissajous 色域轨迹（叠加噪声防止重复块）
-        float r = sin(uv.x*157.0 + tf*2.31 + pf*1.1) * sin(uv.y*133.0 - tf*1.77 + pf*0.7) * 0.5 + 0.5;
-        float g = sin(uv.x*141.0 - tf*2.07 + pf*0.9) * sin(uv.y*149.0 + tf*1.61 + pf*1.3) * 0.5 + 0.5;
-        float b = sin(uv.x*163.0 + tf*2.83 + pf*0.5) * sin(uv.y*127.0 - tf*1.29 + pf*1.7) * 0.5 + 0.5;
-        c = vec3(r,g,b);
-    } else if (variation == 10) {
-        // 位平面闪烁（Bit-Plane Flicker）：三通道不同位平面逐帧翻转
-        c = bitPlaneFlicker(uv, t);
-    } else if (variation == 11) {
-        // 时域色相扫动（平滑）：hue 随时间线性变化
-        float h = fract(uv.x + tf*0.55 + pf*0.21);
-        c = hsv2rgb(vec3(h, 0.85, 0.95));
-    } else if (variation == 12) {
-        // 三正弦全色域（平滑）：相位错开 120 度
-        float ph = tf*0.85 + pf*0.23;
-        float r = 0.5 + 0.5*sin(6.28318*(uv.x*0.23 + uv.y*0.31) + ph);
-        float g = 0.5 + 0.5*sin(6.28318*(uv.x*0.29 + uv.y*0.17) + ph + 2.094);
-        float b = 0.5 + 0.5*sin(6.28318*(uv.x*0.19 + uv.y*0.27) + ph + 4.188);
-        c = vec3(r,g,b);
-    } else if (variation == 13) {
-        // 伪 YUV->RGB 扫动（平滑）：Y 固定、UV 扫动
-        float Y = 0.7;
-        float U = sin(uv.x*3.0 + tf*1.2 + pf*0.7)*0.5;
-        float V = sin(uv.y*3.0 - tf*1.5 + pf*0.9)*0.5;
-        float R = clamp(Y + 1.13983*V, 0.0, 1.0);
-        float G = clamp(Y - 0.39465*U - 0.58060*V, 0.0, 1.0);
-        float B = clamp(Y + 2.03211*U, 0.0, 1.0);
-        c = vec3(R,G,B);
-    } else {
-        // 混合场（通道交错不同相位/尺度）
-        float r = fract(sin(dot(p, vec2(0.251, 0.391)) + t * 2.3) * 51413.0);
-        float g = fract(sin(dot(p, vec2(0.173, 0.613)) - t * 1.7) * 37199.0);
-        float b = fract(sin(dot(p, vec2(0.421, 0.287)) + t * 3.1) * 29761.0);
-        c = vec3(r,g,b);
-    }
-
-    // 10-bit 量化，降低压缩可预测性同时确保位深覆盖
-    c = vec3(q10(c.r), q10(c.g), q10(c.b));
-    return c;
-}
-
-// 简化SMPTE彩条（横向8等分）
-vec3 colorBars(vec2 uv) {
-    float x = uv.x;
-    int idx = int(floor(x * 8.0));
-    if (idx == 0) return vec3(1.0, 1.0, 1.0);       // 白
-    if (idx == 1) return vec3(1.0, 1.0, 0.0);       // 黄
-    if (idx == 2) return vec3(0.0, 1.0, 1.0);       // 青
-    if (idx == 3) return vec3(0.0, 1.0, 0.0);       // 绿
-    if (idx == 4) return vec3(1.0, 0.0, 1.0);       // 品红
-    if (idx == 5) return vec3(1.0, 0.0, 0.0);       // 红
-    if (idx == 6) return vec3(0.0, 0.0, 1.0);       // 蓝
-    return vec3(0.0, 0.0, 0.0);                     // 黑
-}
-
-// 渐变与轻微噪声（观察色带/抖动）
-vec3 smoothGradient(vec2 uv, float time) {
-    float g = uv.x;
-    // 轻微蓝噪声，减少条带感
-    vec2 pixelPos = uv * uResolution;
-    float noise = fract(sin(dot(pixelPos + time, vec2(12.9898, 78.233))) * 43758.5453);
-    g = clamp(g + (noise - 0.5) * 0.01, 0.0, 1.0);
-    return vec3(g);
-}
-
-// 网格（32px间距，1px线宽）
-vec3 gridPattern(vec2 uv, float time) {
-    vec2 p = uv * uResolution;
-    float spacing = 32.0;
-    float lw = 1.0;
-    float fx = fract(p.x / spacing);
-    float fy = fract(p.y / spacing);
-    float mask = (fx < lw / spacing || fy < lw / spacing) ? 1.0 : 0.0;
-    // 背景微动态，避免静态压缩
-    float bg = 0.10 + 0.05 * sin(time * 0.6);
-    return mix(vec3(bg), vec3(1.0), mask);
-}
-
-// 移动竖向亮条（测试拖影/过冲）
-vec3 movingBar(vec2 uv, float time) {
-    float speed = 0.25; // 周期约4秒
-    float pos = fract(time * speed);
-    float dx = abs(uv.x - pos);
-    dx = min(dx, 1.0 - dx); // 环绕距离
-    float halfWidth = 0.05;
-    float bar = step(dx, halfWidth);
-    // 前缘加高亮边
-    float edge = smoothstep(halfWidth, halfWidth - 0.01, dx);
-    vec3 bg = vec3(0.0);
-    vec3 barColor = vec3(1.0);
-    vec3 edgeColor = vec3(1.0, 1.0, 0.3);
-    vec3 col = mix(bg, barColor, bar);
-    col = mix(col, edgeColor, edge * 0.6);
-    return col;
-}
-
-// UFO风格移动目标（多行不同速度，测试运动清晰度）
-vec3 ufoPattern(vec2 uv, float time) {
-    vec3 bg = vec3(0.02);
-    vec3 col = bg;
-    int rowCount = 3;
-    float sizeScale = 1.0;
-    for (int i = 0; i < rowCount; ++i) {
-        float y = mix(0.2, 0.8, (float(i) + 0.5) / float(rowCount));
-        float baseSpeed = mix(0.6, 2.5, float(i) / max(1.0, float(rowCount) - 1.0));
-        float pos = fract(time * baseSpeed);
-        vec2 c = vec2(pos, y);
-        // 椭圆飞船主体
-        vec2 d = (uv - c);
-        d.x *= 2.0; // 拉伸
-        float baseR = 0.08 * sizeScale;
-        float body = smoothstep(baseR, baseR - 0.005, length(d));
-        // 圆顶
-        vec2 domeD = uv - (c + vec2(0.0, 0.035 * sizeScale));
-        float dome = smoothstep(0.05 * sizeScale, 0.045 * sizeScale, length(domeD));
-        // 尾焰
-        float trail = exp(-abs(uv.x - c.x) * 30.0) * smoothstep(0.02 * sizeScale, 0.0, abs(uv.y - y));
-        vec3 ship = mix(vec3(0.1, 0.8, 1.0), vec3(1.0), dome) * 0.9;
-        vec3 shipBody = mix(vec3(0.1), vec3(0.9), body);
-        vec3 flame = vec3(1.0, 0.8, 0.2) * trail;
-        col = max(col, shipBody);
-        col = max(col, ship);
-        col = max(col, flame);
-    }
-    return col;
-}
-
-// 1px棋盘反相闪烁（时域极限，打满过渡）
-vec3 temporalFlip(vec2 uv, float time) {
-    vec2 p = uv * uResolution;
-    float cb = mod(floor(p.x) + floor(p.y), 2.0);
-    float flip = mod(floor(time * 120.0), 2.0); // 120Hz 反相
-    float v = abs(cb - flip);
-    return vec3(v);
-}
-
-// Zone plate（同心高频，覆盖各向频率）
-vec3 zonePlate(vec2 uv, float time) {
-    vec2 c = uv - vec2(0.5);
-    c *= 2.0;
-    float r2 = dot(c, c);
-    float w = 90.0; // 频率权重
-    float v = 0.5 + 0.5 * sin(w * r2 + time * 1.2);
-    // 三通道相移，避免等灰
-    float r = v;
-    float g = 0.5 + 0.5 * sin(w * r2 + time * 1.2 + 2.1);
-    float b = 0.5 + 0.5 * sin(w * r2 + time * 1.2 + 4.2);
-    return vec3(r, g, b);
-}
-
-// 位平面闪烁：在10bit量化上按位翻转（时域抖动）
-vec3 bitPlaneFlicker(vec2 uv, float time) {
-    float v = clamp(uv.x, 0.0, 1.0);
-    int q = int(floor(v * 1023.0 + 0.5));
-    int bitIdx = int(mod(floor(time * 2.0), 5.0)); // LSB..bit4 轮换
-    int phase = int(mod(floor(time * 120.0), 2.0));
-    if (phase == 1) {
-        q ^= (1 << bitIdx);
-    }
-    float outv = clamp(float(q) / 1023.0, 0.0, 1.0);
-    // 通道交错不同位平面
-    int bitIdxG = (bitIdx + 1) % 5;
-    int bitIdxB = (bitIdx + 2) % 5;
-    int qg = int(floor(uv.y * 1023.0 + 0.5));
-    int qb = int(floor(fract(uv.x + uv.y) * 1023.0 + 0.5));
-    if (phase == 1) { qg ^= (1 << bitIdxG); qb ^= (1 << bitIdxB); }
-    return vec3(outv, float(qg) / 1023.0, float(qb) / 1023.0);
-}
-
-// 彩色棋盘轮换：R/G/B 在棋盘上轮换，时域相位不同
-vec3 colorCheckerCycle(vec2 uv, float time) {
-    float s = 24.0;
-    vec2 cell = floor(uv * s);
-    float cb = mod(cell.x + cell.y, 2.0);
-    float phase = mod(floor(time * 2.0), 3.0);
-    vec3 c;
-    if (phase < 0.5) c = vec3(1.0, 0.0, 0.0);
-    else if (phase < 1.5) c = vec3(0.0, 1.0, 0.0);
-    else c = vec3(0.0, 0.0, 1.0);
-    return mix(vec3(0.0), c, cb);
-}
-
-// 蓝噪声滚动：高频伪蓝噪声，沿对角方向滚动
-vec3 blueNoiseScroll(vec2 uv, float time) {
-    vec2 p = uv * uResolution / 2.0 + vec2(time * 60.0, time * 47.0);
-    float n = fract(sin(dot(floor(p), vec2(12.9898, 78.233))) * 43758.5453);
-    float n2 = fract(sin(dot(floor(p + 23.0), vec2(39.3468, 11.135))) * 24634.6345);
-    float v = clamp((n * 0.7 + n2 * 0.3), 0.0, 1.0);
-    // 三通道相移 + 轻度时域抖动
-    float r = fract(v + 0.33);
-    float g = fract(v + 0.66);
-    float b = v;
-    return vec3(r, g, b);
-}
-
-// 径向相位扫频：动态改变径向频率，覆盖不同空间频率
-vec3 radialPhaseSweep(vec2 uv, float time) {
-    vec2 c = uv - vec2(0.5);
-    float r = length(c);
-    float k = mix(10.0, 250.0, 0.5 + 0.5 * sin(time * 0.7));
-    float v = 0.5 + 0.5 * sin(k * r + time * 2.0);
-    return vec3(v);
-}
-
-// 旋转楔形线：角向高频条纹，随时间旋转
-vec3 wedgeSpin(vec2 uv, float time) {
-    vec2 c = uv - vec2(0.5);
-    float a = atan(c.y, c.x) + time * 0.8;
-    float stripes = sin(a * 120.0);
-    float v = stripes > 0.0 ? 1.0 : 0.0;
-    return vec3(v);
-}
-// 棋盘格（高对比）
-vec3 checker(vec2 uv, float time) {
-    float s = 16.0; // 固定密度
-    vec2 gcell = floor(uv * s);
-    float cb = mod(gcell.x + gcell.y, 2.0);
-    return mix(vec3(0.0), vec3(1.0), cb);
-}
-
-// RGBW 全屏轮播
-vec3 rgbwCycle(float time) {
-    float t = floor(mod(time * 0.5, 4.0));
-    if (t < 0.5) return vec3(1.0, 0.0, 0.0);
-    else if (t < 1.5) return vec3(0.0, 1.0, 0.0);
-    else if (t < 2.5) return vec3(0.0, 0.0, 1.0);
-    else return vec3(1.0);
-}
-
-// Siemens Star（放射状楔形）
-vec3 siemensStar(vec2 uv) {
-    vec2 c = uv - vec2(0.5);
-    float a = atan(c.y, c.x);
-    float stripes = cos(a * 100.0);
-    float v = stripes > 0.0 ? 1.0 : 0.0;
-    return vec3(v);
-}
-
-// 水平分辨率楔形（沿X方向增加竖向条纹密度）
-vec3 horizWedge(vec2 uv) {
-    float k = 400.0;
-    float v = sin(k * uv.x * uv.x);
-    return vec3(v > 0.0 ? 1.0 : 0.0);
-}
-
-// 垂直分辨率楔形（沿Y方向增加横向条纹密度）
-vec3 vertWedge(vec2 uv) {
-    float k = 400.0;
-    float v = sin(k * uv.y * uv.y);
-    return vec3(v > 0.0 ? 1.0 : 0.0);
-}
-
-// 同心圆环（静态）
-vec3 concentricRings(vec2 uv) {
-    vec2 c = uv - vec2(0.5);
-    float r2 = dot(c, c);
-    float v = sin(120.0 * r2);
-    return vec3(v > 0.0 ? 1.0 : 0.0);
-}
-
-// 点栅格（网格点)
-vec3 dotGrid(vec2 uv) {
-    vec2 p = uv * uResolution;
-    vec2 g = fract(p / 16.0);
-    // 距离格点最近点
-    vec2 d = min(g, 1.0 - g);
-    float r = length((d - 0.5/16.0) * 16.0);
-    float dotv = smoothstep(0.15, 0.05, r);
-    return vec3(dotv);
-}
-
-// Gamma Checker（步进灰+嵌入棋盘）
-vec3 gammaChecker(vec2 uv) {
-    int steps = 8;
-    int idx = int(floor(uv.x * float(steps)));
-    float g = (float(idx) + 0.5) / float(steps);
-    // 内嵌棋盘
-    float n = 16.0;
-    vec2 p = uv * n;
-    float cb = mod(floor(p.x) + floor(p.y), 2.0);
-    float amp = 0.15; // 对比振幅
-    float v = clamp(g + (cb > 0.5 ? amp : -amp) * (1.0 - g) * g, 0.0, 1.0);
-    return vec3(v);
-}
-
-void main()
-{
-    vec2 uv = TexCoord;
-
-    // 半透明面板直接返回（避免受内容模式影响）
-    if (uColorVariation == -1) {
-        FragColor = vec4(0.0, 0.0, 0.0, 0.7);
-        return;
-    }
-
-    vec3 color;
-    if (uCategory == 0) {
-        // STATIC_GROUP: 常用静态测试图样
-        // 索引定义：
-        // 0: 彩条, 1: 灰阶渐变, 2: 16阶灰条, 3: 1px细棋盘, 4: 粗棋盘,
-        // 5: 32px网格, 6: 8px网格, 7: RGB竖条, 8: 十字/三分线,
-        // 9: 黑, 10: 白, 11: 红, 12: 绿, 13: 蓝, 14: 50%灰,
-        // 15: Siemens Star, 16: 水平楔形, 17: 垂直楔形, 18: 同心圆环, 19: 点栅格, 20: Gamma Checker
-        int idx = uContentMode;
-        if (idx == 0) {
-            color = colorBars(uv);
-        } else if (idx == 1) {
-            // 纯渐变（无抖动）
-            float g = clamp(uv.x, 0.0, 1.0);
-            color = vec3(g);
-        } else if (idx == 2) {
-            int steps = 16;
-            int bar = int(floor(uv.x * float(steps)));
-            float v = (float(bar) + 0.5) / float(steps);
-            color = vec3(v);
-        } else if (idx == 3) {
-            // 1px细棋盘
-            vec2 p = uv * uResolution;
-            float cb = mod(floor(p.x) + floor(p.y), 2.0);
-            color = vec3(cb);
-        } else if (idx == 4) {
-            color = checker(uv, uTime);
-        } else if (idx == 5) {
-            color = gridPattern(uv, 0.0);
-        } else if (idx == 6) {
-            // 8px网格
-            vec2 p = uv * uResolution; float spacing = 8.0; float lw = 1.0;
-            float fx = fract(p.x / spacing); float fy = fract(p.y / spacing);
-            float mask = (fx < lw / spacing || fy < lw / spacing) ? 1.0 : 0.0;
-            color = mix(vec3(0.15), vec3(1.0), mask);
-        } else if (idx == 7) {
-            // RGB 竖条（每3条循环）
-            int b = int(floor(uv.x * 90.0));
-            int m = b % 3;
-            if (m == 0) color = vec3(1.0, 0.0, 0.0);
-            else if (m == 1) color = vec3(0.0, 1.0, 0.0);
-            else color = vec3(0.0, 0.0, 1.0);
-        } else if (idx == 8) {
-            // 十字 + 三分线
-            vec2 p = uv * uResolution; float lw = 1.0;
-            float cx = abs(uv.x - 0.5) * uResolution.x; // 中心竖线
-            float cy = abs(uv.y - 0.5) * uResolution.y; // 中心横线
-            float t1x = abs(uv.x - 1.0/3.0) * uResolution.x;
-            float t2x = abs(uv.x - 2.0/3.0) * uResolution.x;
-            float t1y = abs(uv.y - 1.0/3.0) * uResolution.y;
-            float t2y = abs(uv.y - 2.0/3.0) * uResolution.y;
-            float line = 0.0;
-            line += step(cx, lw) + step(cy, lw);
-            line += step(t1x, lw) + step(t2x, lw) + step(t1y, lw) + step(t2y, lw);
-            color = mix(vec3(0.0), vec3(1.0), clamp(line, 0.0, 1.0));
-        } else if (idx == 9) {
-            color = vec3(0.0);
-        } else if (idx == 10) {
-            color = vec3(1.0);
-        } else if (idx == 11) {
-            color = vec3(1.0, 0.0, 0.0);
-        } else if (idx == 12) {
-            color = vec3(0.0, 1.0, 0.0);
-        } else if (idx == 13) {
-            color = vec3(0.0, 0.0, 1.0);
-        } else if (idx == 14) {
-            color = vec3(0.5);
-        } else if (idx == 15) {
-            color = siemensStar(uv);
-        } else if (idx == 16) {
-            color = horizWedge(uv);
-        } else if (idx == 17) {
-            color = vertWedge(uv);
-        } else if (idx == 18) {
-            color = concentricRings(uv);
-        } else if (idx == 19) {
-            color = dotGrid(uv);
-        } else if (idx == 20) {
-            color = gammaChecker(uv);
-        } else {
-            color = vec3(0.0);
-        }
-    } else if (uCategory == 1) {
-        // DYNAMIC_GROUP: 高熵带宽压力（避免重复色块，低可压缩性，10-bit 覆盖）
-        int idx = clamp(uContentMode, 0, 13);
-        color = generateComplexColor(uv, uTime, idx);
-    } else {
-        // AUX_GROUP: test‑ufo 对标
-        color = ufoPattern(uv, uTime);
-    }
-
-    FragColor = vec4(color, 1.0);
-}
-)";
-
 MonitorTest::MonitorTest() 
-    : window(nullptr)
-    , VAO(0)
+    : VAO(0)
     , VBO(0)
     , currentTime(0.0)
     , frameCount(0)
@@ -589,11 +75,12 @@ MonitorTest::~MonitorTest() {
     cleanup();
 }
 
-bool MonitorTest::initialize() {
-    glfwSetErrorCallback(errorCallback);
-    
-    if (!glfwInit()) {
-        std::cerr << tr("初始化GLFW失败", "Failed to initialize GLFW") << std::endl;
+bool MonitorTest::initialize(const LaunchOptions& options) {
+    launch = options;
+    backend = launch.headless ? createHeadlessBackend() : createGlfwBackend();
+    if (!backend) {
+        std::cerr << tr("此构建不支持无头模式（编译时未找到 EGL）", "Headless mode is not available in this build (EGL not found at build time)")
+                  << std::endl;
         return false;
     }
     
@@ -609,83 +96,87 @@ bool MonitorTest::initialize() {
     setupShaders();
     
     printSystemInfo();
-    printControls();
+    if (!launch.presentBench) printControls();
+    if (launch.checksumMode != 0 && !launch.presentBench) setChecksumMode(launch.checksumMode);
+    if (launch.coverage && !launch.presentBench) setCoverageEnabled(true);
+    if (launch.entropy && !launch.presentBench) setEntropyEnabled(true);
+    if (launch.dscBpp > 0.0 && !launch.presentBench) setDscEnabled(true);
+    if (launch.marker && !launch.presentBench) setMarkerEnabled(true);
+    if (launch.memtestMib > 0 && !launch.presentBench) setMemtestEnabled(true);
     
     return true;
 }
 
 bool MonitorTest::initializeWindow() {
-    // 设置GLFW窗口属性
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#ifdef __APPLE__
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
-    
-    // 获取主显示器
-    GLFWmonitor* monitor = glfwGetPrimaryMonitor();
-    const GLFWvidmode* current = glfwGetVideoMode(monitor);
-
-    // 选取当前分辨率下的最高刷新率，避免固定为 60Hz 的情况
-    int bestRefresh = current ? current->refreshRate : 60;
-    int bestW = current ? current->width : 1920;
-    int bestH = current ? current->height : 1080;
-    int count = 0;
-    const GLFWvidmode* modes = glfwGetVideoModes(monitor, &count);
-    if (modes && count > 0 && current) {
-        for (int i = 0; i < count; ++i) {
-            if (modes[i].width == current->width && modes[i].height == current->height) {
-                if (modes[i].refreshRate > bestRefresh) bestRefresh = modes[i].refreshRate;
-            }
-        }
+    DisplayBackend::Options bo;
+    bo.width = launch.width;
+    bo.height = launch.height;
+    bo.vsync = config.vsyncEnabled;
+    bo.debugContext = launch.glDebug;
+    bo.colorBits = launch.colorBits;
+    if (!backend->create(bo)) {
+        std::cerr << (launch.headless ? tr("创建无头 EGL 上下文失败", "Failed to create headless EGL context")
+                                      : tr("创建GLFW窗口失败", "Failed to create GLFW window")) << std::endl;
+        return false;
     }
 
-    windowWidth = bestW;
-    windowHeight = bestH;
-
-    preferredRefreshHz = bestRefresh;
-    std::cout << tr("检测到显示器分辨率: ", "Detected resolution: ")
-              << windowWidth << "x" << windowHeight << " @" << preferredRefreshHz << "Hz" << std::endl;
-
-    // 提示首选刷新率（独占全屏时有效）
-    glfwWindowHint(GLFW_REFRESH_RATE, bestRefresh);
+    windowWidth = backend->width();
+    windowHeight = backend->height();
+    preferredRefreshHz = backend->refreshRateHz();
+    backendName = backend->name();
+    std::cout << (launch.headless ? tr("离屏分辨率: ", "Offscreen resolution: ") : tr("检测到显示器分辨率: ", "Detected resolution: "))
+              << windowWidth << "x" << windowHeight << " @" << preferredRefreshHz << "Hz (" << backendName << ")" << std::endl;
 
-    // 创建全屏窗口
-    window = glfwCreateWindow(windowWidth, windowHeight, "Display Hardware Test", monitor, nullptr);
-    
-    if (!window) {
-        std::cerr << tr("创建GLFW窗口失败", "Failed to create GLFW window") << std::endl;
-        glfwTerminate();
-        return false;
-    }
-    
-    glfwMakeContextCurrent(window);
-    
     // 设置回调函数
-    glfwSetWindowUserPointer(window, this);
-    glfwSetKeyCallback(window, keyCallback);
-    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
-    
-    // 根据设置启用/禁用垂直同步
-    glfwSwapInterval(config.vsyncEnabled ? 1 : 0);
+    backend->setKeyHandler([this](int key, int action) { keyCallback(this, key, action); });
+    backend->setResizeHandler([this](int width, int height) { framebufferSizeCallback(this, width, height); });
     
     return true;
 }
 
 bool MonitorTest::initializeOpenGL() {
     // 初始化GLEW
-    if (glewInit() != GLEW_OK) {
+    if (!backend->loadGL()) {
         std::cerr << tr("初始化GLEW失败", "Failed to initialize GLEW") << std::endl;
         return false;
     }
     
+    // 驱动消息回调须在编译着色器之前安装
+    if (gldebug::install()) {
+        std::cout << tr("KHR_debug: 已安装消息回调", "KHR_debug: message callback installed")
+                  << (gldebug::debugContext() ? tr("（调试上下文）", " (debug context)")
+                                              : tr("（非调试上下文，可用 --gl-debug 获取完整性能警告）",
+                                                   " (non-debug context; use --gl-debug for full performance warnings)"))
+                  << std::endl;
+    }
+
+    // 新上下文：状态缓存置为未知
+    GLState& gs = GLState::get();
+    gs.invalidate();
+    gs.bindFramebuffer(GL_FRAMEBUFFER, backend->defaultFramebuffer());
+    // 离屏目标尺寸上限只在此查询一次，帧循环读取缓存值
+    RenderTarget::maxDimension();
+
     // 设置视口
-    glViewport(0, 0, windowWidth, windowHeight);
+    gs.viewport(0, 0, windowWidth, windowHeight);
     
     // OpenGL状态设置
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
+    gs.disable(GL_DEPTH_TEST);
+    gs.disable(GL_BLEND);
+    // 关闭抖动：保证输出码值与着色器结果逐位一致（回读校验依赖）
+    gs.disable(GL_DITHER);
+
+    // 默认帧缓冲每通道位数（回读格式选择）：实际协商结果低于请求时，输出链路承载的并非 10-bit 内容
+    framebufferRedBits = backend->colorBits();
+    framebufferFloat = backend->colorFloat();
+    std::cout << tr("默认帧缓冲: ", "Default framebuffer: ") << framebufferRedBits << " bpc" << (framebufferFloat ? " FP16" : "")
+              << tr("（请求 ", " (requested ") << launch.colorBits << ")" << std::endl;
+    if (framebufferRedBits < launch.colorBits) {
+        std::cerr << tr("警告: 平台未提供 ", "Warning: the platform did not provide a ") << launch.colorBits
+                  << tr("-bit 帧缓冲，输出被截断为 ", "-bit framebuffer; output is truncated to ") << framebufferRedBits
+                  << tr(" bit（q10/q12 图样的低位不会到达链路）", " bits (the low bits of q10/q12 patterns never reach the link)")
+                  << std::endl;
+    }
 
     // 背景清屏色
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
@@ -713,13 +204,14 @@ void MonitorTest::setupQuad() {
     static GLuint EBO = 0; // 保持EBO生命周期与进程一致，避免被释放
     if (EBO == 0) glGenBuffers(1, &EBO);
     
-    glBindVertexArray(VAO);
+    GLState& gs = GLState::get();
+    gs.bindVertexArray(VAO);
     
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    gs.bindBuffer(GL_ARRAY_BUFFER, VBO);
+    gs.bufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
     
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    gs.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    gs.bufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
     
     // 位置属性
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
@@ -729,12 +221,22 @@ void MonitorTest::setupQuad() {
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    gs.bindVertexArray(0);
 }
 
 void MonitorTest::setupShaders() {
-    // 主场景着色器
-    shader = std::make_unique<Shader>(vertexShaderSource, fragmentShaderSource);
+    // 主场景着色器（注入整数哈希库）
+    shader = std::make_unique<Shader>(kPatternVertexShader, patternFragmentSource());
+    philoxVerifier = std::make_unique<PhiloxVerifier>();
+    uColorVariation = shader->uniformInt("uColorVariation");
+    if (!shader->bindUniformBlock("FrameBlock", kFrameBlockBinding)) {
+        std::cerr << tr("着色器缺少 FrameBlock", "Shader is missing FrameBlock") << std::endl;
+    }
+    GLState& gs = GLState::get();
+    glGenBuffers(1, &frameUbo);
+    gs.bindBuffer(GL_UNIFORM_BUFFER, frameUbo);
+    gs.bufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_DYNAMIC_DRAW);
+    gs.bindBufferBase(GL_UNIFORM_BUFFER, kFrameBlockBinding, frameUbo);
 
     // 文本渲染器（FreeType）
     textRenderer = std::make_unique<TextRenderer>();
@@ -757,194 +259,316 @@ void MonitorTest::setupShaders() {
     }
 }
 
-static std::string toSafeString(const GLubyte* s) {
-    return s ? reinterpret_cast<const char*>(s) : std::string("Unknown");
+static const char* toSafeString(const GLubyte* s) {
+    return s ? reinterpret_cast<const char*>(s) : "Unknown";
 }
 
-void MonitorTest::renderStatusOverlay() {
-    // 半透明面板背景（使用主shader + 限制视口）
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    shader->use();
-    shader->setFloat("uTime", 0.0f); // 静态背景
-    shader->setVec2("uResolution", static_cast<float>(windowWidth), static_cast<float>(windowHeight));
-    shader->setInt("uCategory", 0);
-    shader->setInt("uContentMode", 0);
-    shader->setInt("uColorVariation", -1); // 特殊值用于背景
-    
-    glBindVertexArray(VAO);
-
-    // 动态计算面板大小（基于字体测量）
-    const float margin = 24.0f;      // 面板与屏幕边缘的距离
-    const float topMargin = 40.0f;   // 顶部留白
-    const float padding = 16.0f;     // 面板内边距（更紧凑）
-    const float scale = 1.0f;
-    const float lh = textRenderer ? textRenderer->GetLineHeightPx(scale) : 28.0f;
-    const float asc = textRenderer ? textRenderer->GetAscenderPx(scale) : lh * 0.8f;
-    const float desc = textRenderer ? textRenderer->GetDescenderPx(scale) : lh * 0.2f;
-
-    // 左侧文本内容（按渲染顺序）
-    struct Line { std::string txt; float r, g, b; bool extraGap; };
-    std::vector<Line> leftLines;
+// 左侧面板文本（按渲染顺序）；与绘制分离，便于单独计时。
+// 文本格式化到帧内 arena、行数组复用容量，稳态下不触发堆分配
+const std::vector<MonitorTest::OverlayLine>& MonitorTest::buildOverlayLines() {
+    DHT_TRACE_ZONE("overlay build");
+    std::vector<OverlayLine>& leftLines = overlayLines;
+    leftLines.clear();
+    FrameArena& a = frameArena;
     // 配色：标题高对比、正文近白
     const float cr = 0.92f, cg = 0.94f, cb = 0.96f; // 正文颜色
     if (minimalOverlay) {
-        std::ostringstream oss;
-        oss << "FPS: " << static_cast<int>(currentFps);
-        leftLines.push_back({oss.str(), 1.0f, 1.0f, 1.0f, false});
+        leftLines.push_back({a.format("FPS: %d", static_cast<int>(currentFps)), 1.0f, 1.0f, 1.0f, false});
     } else {
         leftLines.push_back({tr("GPU 信息", "GPU Info"), 0.30f, 0.95f, 0.50f, false});
-    std::string glVersion = std::string(tr("OpenGL 版本: ", "OpenGL: ")) + toSafeString(glGetString(GL_VERSION));
-    std::string glVendor  = std::string(tr("显卡厂商: ", "Vendor: ")) + toSafeString(glGetString(GL_VENDOR));
-    std::string glRend    = std::string(tr("显卡型号: ", "Renderer: ")) + toSafeString(glGetString(GL_RENDERER));
-    std::string res       = std::string(tr("分辨率: ", "Resolution: ")) + std::to_string(windowWidth) + "x" + std::to_string(windowHeight);
-    leftLines.push_back({glVersion, cr, cg, cb, false});
-    leftLines.push_back({glVendor,  cr, cg, cb, false});
-    leftLines.push_back({glRend,    cr, cg, cb, false});
-    leftLines.push_back({res,       cr, cg, cb, true}); // 额外间距
+    leftLines.push_back({a.format("%s%s", tr("OpenGL 版本: ", "OpenGL: "), toSafeString(glGetString(GL_VERSION))), cr, cg, cb, false});
+    leftLines.push_back({a.format("%s%s", tr("显卡厂商: ", "Vendor: "), toSafeString(glGetString(GL_VENDOR))), cr, cg, cb, false});
+    leftLines.push_back({a.format("%s%s", tr("显卡型号: ", "Renderer: "), toSafeString(glGetString(GL_RENDERER))), cr, cg, cb, false});
+    leftLines.push_back({a.format("%s%dx%d", tr("分辨率: ", "Resolution: "), windowWidth, windowHeight), cr, cg, cb, true}); // 额外间距
 
     leftLines.push_back({tr("显示器信息", "Monitor"), 0.40f, 0.80f, 1.00f, false});
-    GLFWmonitor* monitor = glfwGetPrimaryMonitor();
-    const GLFWvidmode* mode = glfwGetVideoMode(monitor);
-    std::string refresh = mode ? (std::string(tr("刷新率: ", "Refresh: ")) + std::to_string(mode->refreshRate) + " Hz")
-                               : std::string(tr("刷新率: 未知", "Refresh: Unknown"));
-    leftLines.push_back({refresh, cr, cg, cb, false});
+    const int refreshHz = backend->refreshRateHz();
+    leftLines.push_back({refreshHz > 0 ? a.format("%s%d Hz", tr("刷新率: ", "Refresh: "), refreshHz)
+                                       : std::string_view(tr("刷新率: 未知", "Refresh: Unknown")), cr, cg, cb, false});
     // 显示后端/平台信息与首选刷新率
-#ifdef _WIN32
-    std::string backend = "Backend: Win32";
-#else
-    const char* wld = std::getenv("WAYLAND_DISPLAY");
-    const char* x11d = std::getenv("DISPLAY");
-    std::string backend = wld ? "Backend: Wayland" : (x11d ? "Backend: X11" : "Backend: Unknown");
-#endif
     if (preferredRefreshHz > 0) {
-        backend += std::string(" | ") + tr("请求刷新率", "Requested Hz") + ": " + std::to_string(preferredRefreshHz);
+        leftLines.push_back({a.format("Backend: %s | %s: %d", backendName.c_str(), tr("请求刷新率", "Requested Hz"), preferredRefreshHz),
+                             cr, cg, cb, true});
+    } else {
+        leftLines.push_back({a.format("Backend: %s", backendName.c_str()), cr, cg, cb, true});
     }
-    leftLines.push_back({backend, cr, cg, cb, true});
 
     leftLines.push_back({tr("实时测试信息", "Runtime"), 1.00f, 0.75f, 0.30f, false});
-    std::string modeStr;
-    switch (config.mode) {
-        case TestMode::FIXED_FPS:       modeStr = tr("固定帧率", "Fixed FPS"); break;
-        case TestMode::JITTER_FPS:      modeStr = tr("抖动模式", "Jitter FPS"); break;
-        case TestMode::OSCILLATION_FPS: modeStr = tr("震荡模式", "Oscillation FPS"); break;
-        case TestMode::UNLIMITED_FPS:   modeStr = tr("无限制帧率", "Unlimited FPS"); break;
-    }
-    std::ostringstream oss;
-    oss << "FPS: " << static_cast<int>(currentFps);
     float ratio = static_cast<float>(std::min(currentFps / 120.0, 1.0));
-    leftLines.push_back({oss.str(), 1.0f - ratio, ratio, 0.2f, false});
-    std::ostringstream ft;
-    ft << std::fixed << std::setprecision(2)
-       << (language == Language::ZH ? "帧时间: " : "Frame time: ")
-       << frameTimeMs << " ms";
+    leftLines.push_back({a.format("FPS: %d", static_cast<int>(currentFps)), 1.0f - ratio, ratio, 0.2f, false});
     if (!((useDynamicFrameRange && !config.vsyncEnabled) || (config.mode == TestMode::UNLIMITED_FPS))) {
-        ft << (language == Language::ZH ? "  (目标: " : "  (Target: ")
-           << (targetFrameTime * 1000.0) << " ms)";
+        leftLines.push_back({a.format("%s%.2f ms%s%.2f ms)", tr("帧时间: ", "Frame time: "), frameTimeMs,
+                                      tr("  (目标: ", "  (Target: "), targetFrameTime * 1000.0), cr, cg, cb, false});
+    } else {
+        leftLines.push_back({a.format("%s%.2f ms", tr("帧时间: ", "Frame time: "), frameTimeMs), cr, cg, cb, false});
     }
-    leftLines.push_back({ft.str(), cr, cg, cb, false});
-    std::string pacing;
+    const char* pacing;
     if (config.vsyncEnabled) {
-        pacing = (language==Language::ZH?"帧率策略: 垂直同步":"Pacing: VSync");
+        pacing = tr("帧率策略: 垂直同步", "Pacing: VSync");
     } else {
         if (config.mode == TestMode::UNLIMITED_FPS) {
-            pacing = (language==Language::ZH?"帧率策略: 无限制":"Pacing: Unlimited");
+            pacing = tr("帧率策略: 无限制", "Pacing: Unlimited");
         } else {
-            pacing = useDynamicFrameRange ? (language==Language::ZH?"帧率策略: 动态范围":"Pacing: Range")
-                                          : (language==Language::ZH?"帧率策略: 固定":"Pacing: Fixed");
+            pacing = useDynamicFrameRange ? tr("帧率策略: 动态范围", "Pacing: Range")
+                                          : tr("帧率策略: 固定", "Pacing: Fixed");
         }
     }
     leftLines.push_back({pacing, cr, cg, cb, false});
     // 动态范围默认使用抖动策略
-    std::string groupStr;
+    const char* groupStr;
     if (config.category == Category::STATIC_GROUP) groupStr = tr("静态图样", "Static");
     else if (config.category == Category::DYNAMIC_GROUP) groupStr = tr("动态高熵", "High-Entropy");
     else groupStr = tr("辅助诊断", "Auxiliary");
-    auto staticName = [&](int idx)->std::string {
-        switch (idx) {
-            case 0: return language==Language::ZH? "彩条" : "Color Bars";
-            case 1: return language==Language::ZH? "灰阶渐变" : "Gray Gradient";
-            case 2: return language==Language::ZH? "16阶灰条" : "16-step Gray";
-            case 3: return language==Language::ZH? "细棋盘(1px)" : "Fine Checker (1px)";
-            case 4: return language==Language::ZH? "粗棋盘" : "Coarse Checker";
-            case 5: return language==Language::ZH? "网格32px" : "Grid 32px";
-            case 6: return language==Language::ZH? "网格8px" : "Grid 8px";
-            case 7: return language==Language::ZH? "RGB竖条" : "RGB Stripes";
-            case 8: return language==Language::ZH? "十字+三分线" : "Cross + Thirds";
-            case 9: return language==Language::ZH? "纯黑" : "Black";
-            case 10: return language==Language::ZH? "纯白" : "White";
-            case 11: return language==Language::ZH? "纯红" : "Red";
-            case 12: return language==Language::ZH? "纯绿" : "Green";
-            case 13: return language==Language::ZH? "纯蓝" : "Blue";
-            case 14: return language==Language::ZH? "50%灰" : "50% Gray";
-            case 15: return "Siemens Star";
-            case 16: return language==Language::ZH? "水平楔形" : "Horizontal Wedge";
-            case 17: return language==Language::ZH? "垂直楔形" : "Vertical Wedge";
-            case 18: return language==Language::ZH? "同心圆环" : "Concentric Rings";
-            case 19: return language==Language::ZH? "点栅格" : "Dot Grid";
-            case 20: return "Gamma Checker";
-        }
-        return language==Language::ZH? "静态图样" : "Static";
-    };
-    auto dynamicName = [&](int idx)->std::string {
-        switch (idx) {
-            case 0: return language==Language::ZH? "高熵: HSV 色轮" : "HE: HSV Wheel";
-            case 1: return language==Language::ZH? "高熵: 多尺度哈希" : "HE: Multi-Scale Hash";
-            case 2: return language==Language::ZH? "高熵: 频谱混合" : "HE: Spectral Mix";
-            case 3: return language==Language::ZH? "高熵: 蓝噪声滚动" : "HE: Blue-Noise Scroll";
-            case 4: return language==Language::ZH? "高熵: 径向扰动" : "HE: Radial Turbulence";
-            case 5: return language==Language::ZH? "高熵: 区域板动态" : "HE: Zoneplate Dynamic";
-            case 6: return language==Language::ZH? "高熵: 混合场" : "HE: Mixed Field";
-            case 7: return language==Language::ZH? "高熵: HSV 全色域" : "HE: HSV Full-Gamut";
-            case 8: return language==Language::ZH? "高熵: 谱梯度混合" : "HE: Spectral Gradient";
-            case 9: return language==Language::ZH? "高熵: Lissajous 色域" : "HE: Lissajous Field";
-            case 10: return language==Language::ZH? "高熵: 位平面闪烁" : "HE: Bit-Plane Flicker";
-            case 11: return language==Language::ZH? "高熵: 色相扫动" : "HE: Hue Sweep";
-            case 12: return language==Language::ZH? "高熵: 三正弦色域" : "HE: Tri-Sine Gamut";
-            case 13: return language==Language::ZH? "高熵: YUV 扫动" : "HE: YUV Sweep";
-        }
-        return language==Language::ZH? "高熵" : "High-Entropy";
-    };
-    auto auxName = [&](int idx)->std::string {
-        switch (idx) {
-            case 0: return language==Language::ZH? "辅助: 移动亮条" : "Aux: Moving Bar";
-            case 1: return language==Language::ZH? "辅助: UFO 运动" : "Aux: UFO Motion";
-            case 2: return language==Language::ZH? "辅助: 1px 反相" : "Aux: 1px Temporal Flip";
-            case 3: return language==Language::ZH? "辅助: Zone Plate" : "Aux: Zone Plate";
-            case 4: return language==Language::ZH? "辅助: 位平面闪烁" : "Aux: Bit-Plane Flicker";
-            case 5: return language==Language::ZH? "辅助: 彩色棋盘轮换" : "Aux: Color Checker Cycle";
-            case 6: return language==Language::ZH? "辅助: 蓝噪声滚动" : "Aux: Blue-Noise Scroll";
-            case 7: return language==Language::ZH? "辅助: 径向扫频" : "Aux: Radial Sweep";
-            case 8: return language==Language::ZH? "辅助: 旋转楔形" : "Aux: Wedge Spin";
-            case 9: return language==Language::ZH? "辅助: 粗棋盘" : "Aux: Checker Coarse";
-        }
-        return language==Language::ZH? "辅助" : "Aux";
-    };
-    std::string patStr;
+    int cat = 0;
     int patIdx = 0;
     char grp = 'S';
     if (config.category == Category::STATIC_GROUP) {
-        patIdx = config.staticMode; grp = 'S'; patStr = staticName(config.staticMode);
+        patIdx = config.staticMode; grp = 'S'; cat = 0;
     } else if (config.category == Category::DYNAMIC_GROUP) {
-        patIdx = config.dynamicMode; grp = 'D'; patStr = dynamicName(config.dynamicMode);
+        patIdx = config.dynamicMode; grp = 'D'; cat = 1;
     } else {
-        patIdx = config.auxMode; grp = 'A'; patStr = auxName(config.auxMode);
+        patIdx = config.auxMode; grp = 'A'; cat = 2;
+    }
+    leftLines.push_back({a.format("%s%s", tr("模式组: ", "Group: "), groupStr), cr, cg, cb, false});
+    leftLines.push_back({a.format("%s[%c:%d] %s", tr("图样: ", "Pattern: "), grp, patIdx,
+                                  patternName(cat, patIdx, language == Language::ZH)), cr, cg, cb, false});
+    if (drawStressActive()) {
+        // CPU 提交耗时（不含 GPU 执行；GPU 时间见时间线的 "GPU draw stress"）
+        const int n = drawStress->objectCount();
+        const double ms = drawStress->submitMs();
+        leftLines.push_back({a.format("%s%d | %s | %s%.2f ms (%.0f ns/%s)", tr("绘制压力: 对象 ", "Draw stress: objects "), n,
+                                      DrawStress::submitName(drawStress->submit(), language == Language::ZH),
+                                      tr("提交 ", "submit "), ms, ms * 1e6 / n, tr("对象", "object")),
+                             1.0f, 0.85f, 0.4f, false});
+    }
+    if (uploadStreamActive()) {
+        const UploadStream::Stats& us = uploadStream->stats();
+        leftLines.push_back({a.format("%s%s | %s", tr("上传: ", "Upload: "),
+                                      UploadStream::methodName(uploadStream->method(), language == Language::ZH),
+                                      UploadStream::formatName(uploadStream->format())), 1.0f, 0.85f, 0.4f, false});
+        if (us.valid) {
+            leftLines.push_back({a.format("%.2f GB/s%s%.2f GB/s) | %s%.2f ms%s%.2f ms (max %.2f)%s%.2f ms",
+                                          us.gbps, tr("（调用 ", " (call "), us.callGbps, tr("生成 ", "gen "), us.genMs,
+                                          tr(" | 上传 ", " | upload "), us.uploadMs, us.uploadMaxMs, " | GPU ", us.gpuMs),
+                                 1.0f, 0.85f, 0.4f, false});
+            if (us.mapFailures) {
+                leftLines.push_back({a.format("%s%u", tr("映射失败（已跳过上传）: ", "Map failures (upload skipped): "), us.mapFailures),
+                                     1.0f, 0.3f, 0.3f, false});
+            }
+            leftLines.push_back({a.format("%s%.2f ms, sd %.2f, max %.2f", tr("帧间隔: ", "Frame interval: "),
+                                          us.frameMs, us.frameSdMs, us.frameMaxMs), 1.0f, 0.85f, 0.4f, false});
+        }
     }
-    leftLines.push_back({std::string(tr("模式组: ", "Group: ")) + groupStr, cr, cg, cb, false});
     {
-        std::ostringstream lab; lab << tr("图样: ", "Pattern: ") << "[" << grp << ":" << patIdx << "] " << patStr;
-        leftLines.push_back({lab.str(), cr, cg, cb, false});
+        // 实际驱动的输出位深（默认帧缓冲附件查询值）；离屏渲染时另列渲染目标的实际位数
+        const bool truncated = framebufferRedBits < launch.colorBits;
+        const bool offscreen = renderTarget && renderTarget->valid() && internalResIndex != 0;
+        char renderBits[48] = "";
+        if (offscreen) {
+            std::snprintf(renderBits, sizeof(renderBits), "%s%d bpc", tr(" | 渲染 ", " | render "),
+                          renderTarget->attachmentBits());
+        }
+        leftLines.push_back({a.format("%s%d bpc%s%s%d)%s%s | q%d", tr("输出位深: ", "Output depth: "), framebufferRedBits,
+                                      framebufferFloat ? " FP16" : "", tr("（请求 ", " (requested "), launch.colorBits,
+                                      truncated ? tr(" 已截断", " TRUNCATED") : "", renderBits, patternQuantBits(offscreen)),
+                             truncated ? 1.0f : cr, truncated ? 0.3f : cg, truncated ? 0.3f : cb, false});
+    }
+    if (renderTarget && renderTarget->valid() && internalResIndex != 0) {
+        // 图样写入 + 缩放读取各一遍
+        double mb = renderTarget->bytes() / (1024.0 * 1024.0);
+        double gbps = renderTarget->bytes() * 2.0 * currentFps / 1e9;
+        leftLines.push_back({a.format("%s%s %dx%d %s%s%.1f MB | ~%.1f GB/s", tr("内部分辨率: ", "Internal res: "), internalResName(),
+                                      renderTarget->width(), renderTarget->height(), RenderTarget::formatName(renderTarget->format()),
+                                      tr(" | 显存 ", " | VRAM "), mb, gbps), cr, cg, cb, false});
+    } else {
+        leftLines.push_back({a.format("%s%s (%s)", tr("内部分辨率: ", "Internal res: "), internalResName(),
+                                      RenderTarget::formatName(static_cast<RenderTarget::Format>(internalFormatIndex))), cr, cg, cb, false});
+    }
+    if (!hashBenchSummary.empty()) leftLines.push_back({hashBenchSummary, cr, cg, cb, false});
+    if (philoxVerifyEnabled && philoxVerifier) {
+        auto st = philoxVerifier->stats();
+        bool ok = st.framesMismatched == 0;
+        leftLines.push_back({a.format("%s%llu%s%llu (%llu px) %.1f ms @%dbit", tr("Philox 校验: ", "Philox verify: "),
+                                      st.framesVerified, tr(" 帧, 不符 ", " frames, bad "), st.framesMismatched,
+                                      st.pixelsMismatched, st.lastVerifyMs, st.channelBits),
+                             ok ? 0.40f : 1.0f, ok ? 1.0f : 0.3f, ok ? 0.50f : 0.3f, false});
+    }
+    if (checksumReadback && checksumReadback->mode() != AsyncReadback::Mode::Off) {
+        const AsyncReadback::Stats cs = checksumReadback->stats();
+        leftLines.push_back({a.format("%s%s | %08x @%llu | %s%llu%s%llu%s%u%s",
+                                      tr("回读校验: ", "Readback CRC32C: "),
+                                      AsyncReadback::modeName(checksumReadback->mode(), language == Language::ZH),
+                                      cs.lastCrc, cs.lastFrame, tr("已记录 ", "logged "), cs.logged,
+                                      tr(" 跳过 ", " skipped "), cs.skipped, tr(" | 延迟 ", " | lag "), cs.lastLag,
+                                      tr(" 帧", " frames")), 0.70f, 0.85f, 1.00f, false});
+    }
+    if (codeCoverage) {
+        const CodeCoverage::Stats cs = codeCoverage->stats();
+        // 全部码值出现且 LSB 逐帧翻转为绿色，否则黄色（如 8-bit 帧缓冲只有 256 个码值）
+        const bool full = cs.totalUsed[0] == CodeCoverage::kCodes && cs.totalUsed[1] == CodeCoverage::kCodes &&
+                          cs.totalUsed[2] == CodeCoverage::kCodes;
+        const bool lsb = cs.toggle[0][0] > 0.0 && cs.toggle[1][0] > 0.0 && cs.toggle[2][0] > 0.0;
+        const float lr = full && lsb ? 0.40f : 1.0f, lg = full && lsb ? 1.0f : 0.85f, lb = full && lsb ? 0.50f : 0.3f;
+        leftLines.push_back({a.format("%s%d/%d/%d%s%d/%d/%d | %llu%s", tr("码值覆盖 R/G/B: 累计 ", "Codes R/G/B: total "),
+                                      cs.totalUsed[0], cs.totalUsed[1], cs.totalUsed[2], tr(" 单帧 ", " frame "),
+                                      cs.frameUsed[0], cs.frameUsed[1], cs.frameUsed[2], cs.frames, tr(" 帧", " frames")),
+                             lr, lg, lb, false});
+        // 各位翻转率取三通道平均（%），位 0 为 LSB
+        int pct[CodeCoverage::kBits];
+        for (int b = 0; b < CodeCoverage::kBits; ++b) {
+            pct[b] = static_cast<int>(std::lround((cs.toggle[0][b] + cs.toggle[1][b] + cs.toggle[2][b]) * 100.0 / 3.0));
+        }
+        leftLines.push_back({a.format("%s%d %d %d %d %d %d %d %d %d %d | %.1f ms", tr("翻转率 b0..b9 %: ", "Toggle b0..b9 %: "),
+                                      pct[0], pct[1], pct[2], pct[3], pct[4], pct[5], pct[6], pct[7], pct[8], pct[9],
+                                      cs.lastAnalyzeMs), lr, lg, lb, false});
+    }
+    if (frameEntropy) {
+        const FrameEntropy::Stats es = frameEntropy->stats();
+        const entropy::FrameStats& f = es.last;
+        auto avg = [](const double* v) { return (v[0] + v[1] + v[2]) / 3.0; };
+        const double rice = avg(f.riceBits);
+        leftLines.push_back({a.format("%s%.2f/%.2f/%.2f/%.2f | Rice %.2f bps (%.2f:1)", tr("熵 原值/左/上/MED: ", "Entropy raw/left/top/MED: "),
+                                      avg(f.bits[entropy::kRaw]), avg(f.bits[entropy::kLeft]), avg(f.bits[entropy::kTop]),
+                                      avg(f.bits[entropy::kMed]), rice, rice > 0.0 ? 10.0 / rice : 0.0),
+                             0.85f, 0.75f, 1.00f, false});
+        leftLines.push_back({a.format("%s%.1f%s%.1f%% | %s | %.1f ms%s%llu", tr("帧间 MSE: ", "Temporal MSE: "), avg(f.temporalMse),
+                                      tr(" 变化 ", " changed "), f.changed * 100.0, es.current.pattern, es.lastAnalyzeMs,
+                                      tr(" | 跳过 ", " | skipped "), es.skipped),
+                             0.85f, 0.75f, 1.00f, false});
+    }
+    if (dscMonitor) {
+        const DscMonitor::Stats ds = dscMonitor->stats();
+        const dsc::FrameScore& f = ds.last;
+        leftLines.push_back({a.format("DSC %.2f bpp: %s%.2f%s%.2f | QP %.1f/%d | ICH %.0f%% BP %.0f%%", dscMonitor->config().bitsPerPixel,
+                                      tr("需求 ", "demand "), f.demandBpp, tr(" 实际 ", " coded "), f.codedBpp, f.avgQp, f.maxQp,
+                                      f.ichPct, f.bpPct),
+                             1.00f, 0.80f, 0.55f, false});
+        leftLines.push_back({a.format("%s%.0f%%%s%lld%s%lld | %s | %.1f ms%s%llu", tr("缓冲峰值 ", "Buffer peak "),
+                                      ds.peakFullness * 100.0, tr(" 强制量化 ", " forced quant "), ds.forcedQuant,
+                                      tr(" 溢出 ", " overflow "), ds.overflow, ds.pattern, f.ms, tr(" | 跳过 ", " | skipped "),
+                                      ds.skipped),
+                             1.00f, 0.80f, 0.55f, ds.overflow > 0});
+    }
+    if (vramTest) {
+        const VramTest::Stats& vs = vramTest->stats();
+        leftLines.push_back({a.format("%s%d MiB | %s%.1f GiB%s%llu%s%llu", tr("显存校验 ", "VRAM test "), vramTest->allocatedMiB(),
+                                      tr("已校验 ", "verified "), vs.verifiedBytes / (1024.0 * 1024.0 * 1024.0),
+                                      tr(" 不匹配 ", " mismatches "), vs.mismatchWords, tr(" | 跳过 ", " | skipped "), vs.skipped),
+                             0.70f, 1.00f, 0.85f, vs.mismatchWords > 0});
+        if (vs.errorEvents > 0) {
+            leftLines.push_back({a.format("%s#%llu %s%d %s %s @%u %s0x%08X %s0x%08X", tr("最近错误 帧", "Last error frame"),
+                                          vs.lastErrorFrame, tr("块 ", "block "), vs.lastErrorBlock,
+                                          vs.lastErrorInBuffer ? tr("缓冲", "buffer") : tr("纹理", "texture"),
+                                          VramTest::patternName(vs.lastErrorPattern), vs.lastErrorWord, tr("期望 ", "expected "),
+                                          vs.lastErrorExpected, tr("差异位 ", "diff bits "), vs.lastErrorBits),
+                                 1.00f, 0.40f, 0.40f, false});
+        }
+    }
+    if (frameMarker) {
+        leftLines.push_back({a.format("%s#%u", tr("帧标记: ", "Frame marker: "), static_cast<uint32_t>(frameIndex)), cr, cg, cb, false});
     }
     // 垂直同步状态
-    leftLines.push_back({std::string(tr("垂直同步: ", "VSync: ")) + onOff(config.vsyncEnabled), cr, cg, cb, false});
-    leftLines.push_back({std::string(tr("目标帧率: ", "Target FPS: ")) + std::to_string(config.targetFps), cr, cg, cb, false});
-    leftLines.push_back({std::string(tr("范围: ", "Range: ")) + std::to_string(config.minFps) + "~" + std::to_string(config.maxFps), cr, cg, cb, config.isPaused});
+    leftLines.push_back({a.format("%s%s", tr("垂直同步: ", "VSync: "), onOff(config.vsyncEnabled)), cr, cg, cb, false});
+    leftLines.push_back({a.format("%s%d", tr("目标帧率: ", "Target FPS: "), config.targetFps), cr, cg, cb, false});
+    leftLines.push_back({a.format("%s%d~%d", tr("范围: ", "Range: "), config.minFps, config.maxFps), cr, cg, cb, config.isPaused});
     // 动态噪声默认全色域覆盖，无需显示切换状态
     if (config.isPaused) leftLines.push_back({tr("状态: 已暂停", "Status: Paused"), 1.0f, 0.2f, 0.2f, false});
     }
+    if (glStatsOverlay) {
+        // 上一帧的 GL 调用统计（本帧覆盖层自身的调用计入下一帧）
+        const GLState::Counters& gc = GLState::get().lastFrame();
+        leftLines.push_back({a.format("%s%u%s%u)%s%u | uniform %u%s%u (%.1f KB)",
+                                      tr("GL: 状态切换 ", "GL: state "), gc.stateChanges, tr(" (跳过 ", " (skipped "), gc.skipped,
+                                      tr(" | 绘制 ", " | draws "), gc.draws, gc.uniforms,
+                                      tr(" | 上传 ", " | uploads "), gc.uploads, gc.uploadBytes / 1024.0),
+                             0.70f, 0.85f, 1.00f, false});
+        if (gldebug::active()) {
+            const gldebug::Totals t = gldebug::totals();
+            const unsigned long long errors = t.byType[gldebug::typeIndex(GL_DEBUG_TYPE_ERROR)];
+            const unsigned long long perfMsgs = t.byType[gldebug::typeIndex(GL_DEBUG_TYPE_PERFORMANCE)];
+            unsigned long long total = 0;
+            for (uint64_t n : t.byType) total += n;
+            const bool perf = perfFlaggedFrames > 0;
+            leftLines.push_back({a.format("KHR_debug: %s%llu | %s%llu | %s%llu%s%llu (#%llu)",
+                                          tr("错误 ", "errors "), errors, tr("性能 ", "perf "), perfMsgs,
+                                          tr("其他 ", "other "), total - errors - perfMsgs,
+                                          tr(" | 性能警告帧 ", " | perf-flagged frames "), perfFlaggedFrames, lastPerfFlaggedFrame),
+                                 perf ? 1.0f : 0.70f, perf ? 0.6f : 0.85f, perf ? 0.2f : 1.00f, false});
+        }
+    }
+    if (alloc::enabled()) {
+        // 上一帧（整轮循环）的堆分配；稳态应为 0
+        const bool clean = lastFrameAllocs == 0;
+        leftLines.push_back({a.format("%s%llu (%llu B)%s%llu", tr("堆分配/帧: ", "Heap allocs/frame: "),
+                                      lastFrameAllocs, lastFrameAllocBytes, tr(" | 区间最大 ", " | interval max "), intervalMaxAllocs),
+                             clean ? 0.40f : 1.0f, clean ? 1.0f : 0.6f, clean ? 0.50f : 0.2f, false});
+    }
+
+    return leftLines;
+}
+
+// 右侧控制说明（两列：按键 / 说明）
+const std::vector<MonitorTest::ControlItem>& MonitorTest::buildControlItems() {
+    std::vector<ControlItem>& items = controlItems;
+    items.clear();
+    items.push_back({"", tr("控制说明", "Controls")});
+    items.push_back({"ESC", tr("退出程序", "Exit")});
+#ifndef _WIN32
+    items.push_back({"P", tr("暂停/继续", "Pause/Resume")});
+#endif
+    items.push_back({"SPACE", tr("切换模式组", "Toggle group")});
+    items.push_back({"←/→", tr("上一/下一图样", "Prev/Next pattern")});
+    items.push_back({"↑/↓", tr("固定帧率 -/+（长按快调）", "Fixed FPS -/+ (hold fast)")});
+    items.push_back({"V", tr("垂直同步 开/关", "VSync On/Off")});
+    items.push_back({"F1", tr("精简显示 开/关", "Minimal overlay On/Off")});
+    items.push_back({"F2", tr("帧率策略 固定/动态/无限制", "Pacing Fixed/Range/Unlimited")});
+    items.push_back({"F3", tr("GL 调用统计 开/关", "GL call stats On/Off")});
+    items.push_back({"F12", tr("一键极限模式", "Extreme mode toggle")});
+    items.push_back({"F5/F6", tr("动态最小帧 -/+（长按快调）", "Range min -/+ (hold fast)" )});
+    items.push_back({"F7/F8", tr("动态最大帧 -/+（长按快调）", "Range max -/+ (hold fast)" )});
+    items.push_back({"R", tr("内部分辨率 原生/2x/4K/8K/16K", "Internal res Native/2x/4K/8K/16K")});
+    items.push_back({"T", tr("离屏格式 RGBA8/RGB10_A2/RGBA16F", "Offscreen format RGBA8/RGB10_A2/RGBA16F")});
+    items.push_back({"H", tr("哈希自检(ALU/统计)", "Hash self-test (ALU/stats)")});
+    items.push_back({"K", tr("Philox 逐位校验 开/关", "Philox bit-exact verify On/Off")});
+    items.push_back({"[ / ]", tr("绘制压力对象数 1k..200k（A:1）", "Draw stress objects 1k..200k (A:1)")});
+    items.push_back({"I", tr("绘制压力提交方式 实例化/逐次/逐次+uniform", "Draw stress submit instanced/draws/draws+uniform")});
+    items.push_back({"U", tr("上传路径 TexSubImage/PBO 孤立/PBO 环/持久映射（A:2）", "Upload path TexSubImage/PBO orphan/PBO ring/persistent (A:2)")});
+    items.push_back({"Y", tr("上传格式 RGBA8/RGB10_A2", "Upload format RGBA8/RGB10_A2")});
+    items.push_back({"C", tr("回读校验 关/采样块/整帧", "Readback checksum off/tiles/full")});
+    items.push_back({"G", tr("码值覆盖分析 开/关", "Code coverage analyzer On/Off")});
+    items.push_back({"E", tr("熵/可压缩性估计 开/关", "Entropy estimator On/Off")});
+    items.push_back({"D", tr("DSC 编码器模型 开/关", "DSC encoder model On/Off")});
+    items.push_back({"B", tr("帧标记条（采集端校验）开/关", "Frame marker strip (capture verify) On/Off")});
+    items.push_back({"M", tr("显存完整性压力 开/关", "VRAM integrity stress On/Off")});
+    items.push_back({"F9", tr("导出时间线(Chrome trace)", "Dump timeline (Chrome trace)")});
+    items.push_back({"L", "Toggle language (ZH/EN)"});
+    return items;
+}
 
+void MonitorTest::renderStatusOverlay() {
+    DHT_TRACE_ZONE("overlay");
+    // 半透明面板背景（使用主shader + 限制视口）
+    GLState& gs = GLState::get();
+    gs.disable(GL_DEPTH_TEST);
+    gs.enable(GL_BLEND);
+    gs.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    shader->use();
+    shader->set(uColorVariation, -1); // 特殊值用于背景（着色器提前返回，不依赖 FrameBlock）
+    
+    gs.bindVertexArray(VAO);
+
+    // 动态计算面板大小（基于字体测量）
+    const float margin = 24.0f;      // 面板与屏幕边缘的距离
+    const float topMargin = 40.0f;   // 顶部留白
+    const float padding = 16.0f;     // 面板内边距（更紧凑）
+    const float scale = 1.0f;
+    const float lh = textRenderer ? textRenderer->GetLineHeightPx(scale) : 28.0f;
+    const float asc = textRenderer ? textRenderer->GetAscenderPx(scale) : lh * 0.8f;
+    const float desc = textRenderer ? textRenderer->GetDescenderPx(scale) : lh * 0.2f;
+
+    const std::vector<OverlayLine>& leftLines = buildOverlayLines();
+    const float cr = 0.92f, cg = 0.94f, cb = 0.96f; // 正文颜色
     float leftMaxW = 0.0f; float leftTotalH = 0.0f; float leftGaps = 0.0f;
     for (const auto& ln : leftLines) {
         float w = textRenderer ? textRenderer->MeasureTextWidth(ln.txt, scale) : static_cast<float>(ln.txt.size() * 10);
@@ -959,30 +583,14 @@ void MonitorTest::renderStatusOverlay() {
     GLint panelH = static_cast<GLint>(std::ceil(leftContentH + padding * 2));
 
     // 绘制左面板背景
-    glViewport(static_cast<GLint>(margin), windowHeight - (panelH + static_cast<GLint>(topMargin)), panelW, panelH);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    gs.viewport(static_cast<GLint>(margin), windowHeight - (panelH + static_cast<GLint>(topMargin)), panelW, panelH);
+    gs.drawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 
     // 可选绘制右面板
     GLint rightX = 0, rightY = 0, rightW = 0, rightH = 0;
     if (!minimalOverlay) {
         // 右侧控制说明（两列对齐渲染）
-        struct CtrlItem { std::string key; std::string desc; };
-        std::vector<CtrlItem> items;
-        items.push_back({"", tr("控制说明", "Controls")});
-        items.push_back({"ESC", tr("退出程序", "Exit")});
-#ifndef _WIN32
-        items.push_back({"P", tr("暂停/继续", "Pause/Resume")});
-#endif
-        items.push_back({"SPACE", tr("切换模式组", "Toggle group")});
-        items.push_back({"←/→", tr("上一/下一图样", "Prev/Next pattern")});
-        items.push_back({"↑/↓", tr("固定帧率 -/+（长按快调）", "Fixed FPS -/+ (hold fast)")});
-        items.push_back({"V", tr("垂直同步 开/关", "VSync On/Off")});
-    items.push_back({"F1", tr("精简显示 开/关", "Minimal overlay On/Off")});
-        items.push_back({"F2", tr("帧率策略 固定/动态/无限制", "Pacing Fixed/Range/Unlimited")});
-    items.push_back({"F12", tr("一键极限模式", "Extreme mode toggle")});
-    items.push_back({"F5/F6", tr("动态最小帧 -/+（长按快调）", "Range min -/+ (hold fast)" )});
-    items.push_back({"F7/F8", tr("动态最大帧 -/+（长按快调）", "Range max -/+ (hold fast)" )});
-        items.push_back({"L", "Toggle language (ZH/EN)"});
+        const std::vector<ControlItem>& items = buildControlItems();
 
         float col1W = 0.0f; float col2W = 0.0f; float rightTotalH = 0.0f;
         for (const auto& it : items) {
@@ -1000,12 +608,11 @@ void MonitorTest::renderStatusOverlay() {
         rightX = windowWidth - (rightW + static_cast<GLint>(margin));
         rightY = windowHeight - (rightH + static_cast<GLint>(topMargin));
 
-        glViewport(rightX, rightY, rightW, rightH);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        gs.viewport(rightX, rightY, rightW, rightH);
+        gs.drawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 
         // 恢复完整视口后绘制右侧文本（确保与左侧相同像素坐标映射与字号）
-        glViewport(0, 0, windowWidth, windowHeight);
-        glBindVertexArray(0);
+        gs.viewport(0, 0, windowWidth, windowHeight);
 
         // 文本内容（右侧两列）
         if (textRenderer) {
@@ -1029,8 +636,7 @@ void MonitorTest::renderStatusOverlay() {
     }
 
     // 恢复完整视口（左侧文本绘制所需；右侧已在绘制前重置）
-    glViewport(0, 0, windowWidth, windowHeight);
-    glBindVertexArray(0);
+    gs.viewport(0, 0, windowWidth, windowHeight);
 
     // 文本内容（左侧）
     if (textRenderer) {
@@ -1043,37 +649,72 @@ void MonitorTest::renderStatusOverlay() {
         }
     }
 
-    glDisable(GL_BLEND);
+    gs.disable(GL_BLEND);
 }
 
 void MonitorTest::run() {
-    while (!glfwWindowShouldClose(window)) {
-        handleInput();
+    if (launch.presentBench) {
+        runPresentBench();
+        return;
+    }
+    const auto runStart = std::chrono::high_resolution_clock::now();
+    unsigned long long framesRendered = 0;
+    // 主线程环形缓冲按 1000 Hz 下数秒的事件量分配
+    trace::setThreadName("main", 1u << 19);
+    // USDT 探针的 arg0：循环序号（暂停时 frameIndex 不变，序号仍递增）
+    unsigned long long loopSeq = 0;
+    while (!backend->shouldClose()) {
+        DHT_TRACE_ZONE("frame");
+        const unsigned long long seq = loopSeq++;
+        DHT_PROBE3(frame_start, seq, trace::nowNs(), frameIndex);
+        const alloc::Counters allocStart = alloc::threadCounters();
+        frameArena.reset();
+        {
+            DHT_TRACE_ZONE("input");
+            handleInput();
+        }
+        fireChangeProbes(seq);
         
         if (!config.isPaused) {
             frameIndex++;
-            update();
+            {
+                DHT_TRACE_ZONE("update");
+                update();
+            }
             render();
         } else {
             // 暂停时也渲染一次覆盖层，保持提示显示
             render();
         }
+        DHT_PROBE2(render_submit, seq, trace::nowNs());
         
         // 帧率控制：当关闭 VSync 时，按目标帧时间节流；无限制模式不节流
         {
+            DHT_TRACE_ZONE("sleep");
             auto now = std::chrono::high_resolution_clock::now();
             auto elapsed = std::chrono::duration<double>(now - lastFrameTime).count();
             if (!config.vsyncEnabled && config.mode != TestMode::UNLIMITED_FPS) {
                 if (elapsed < targetFrameTime) {
                     double sleepTime = targetFrameTime - elapsed;
+                    DHT_PROBE3(sleep_begin, seq, trace::nowNs(), static_cast<unsigned long long>(sleepTime * 1e9));
                     std::this_thread::sleep_for(std::chrono::duration<double>(sleepTime));
+                    DHT_PROBE2(sleep_end, seq, trace::nowNs());
                 }
             }
             lastFrameTime = std::chrono::high_resolution_clock::now();
         }
         
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        {
+            DHT_TRACE_ZONE("swap");
+            DHT_PROBE2(swap_begin, seq, trace::nowNs());
+            backend->swapBuffers();
+            DHT_PROBE2(swap_end, seq, trace::nowNs());
+        }
+        drainGlDebug();
+        {
+            DHT_TRACE_ZONE("poll");
+            backend->pollEvents();
+        }
         
         // 更新帧时间（毫秒，指数平滑）
         auto loopEnd = std::chrono::high_resolution_clock::now();
@@ -1082,7 +723,287 @@ void MonitorTest::run() {
         if (frameTimeMs <= 0.0) frameTimeMs = dt; else frameTimeMs = frameTimeMs * 0.9 + dt * 0.1;
 
         frameCount++;
-        reportFps();
+        if (alloc::enabled()) {
+            // 统计整轮循环（输入、更新、渲染、呈现）的堆分配；控制台汇报本身计入下一帧
+            const alloc::Counters allocEnd = alloc::threadCounters();
+            lastFrameAllocs = allocEnd.allocs - allocStart.allocs;
+            lastFrameAllocBytes = allocEnd.bytes - allocStart.bytes;
+            intervalMaxAllocs = std::max(intervalMaxAllocs, lastFrameAllocs);
+        }
+        {
+            DHT_TRACE_ZONE("report");
+            reportFps();
+        }
+        if (launch.maxFrames > 0 && ++framesRendered >= launch.maxFrames) backend->requestClose();
+    }
+
+    if (!launch.traceOut.empty()) dumpTrace(launch.traceOut);
+
+    // 运行汇总（无头/定帧数运行时用于逐提交对比）
+    if (launch.maxFrames > 0) {
+        double secs = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - runStart).count();
+        std::cout << std::fixed << std::setprecision(3)
+                  << tr("汇总: ", "Summary: ") << framesRendered << tr(" 帧, ", " frames, ") << secs << " s, "
+                  << tr("平均 ", "avg ") << (secs > 0 ? framesRendered / secs : 0.0) << " FPS, "
+                  << (framesRendered > 0 ? secs * 1000.0 / framesRendered : 0.0) << " ms/frame"
+                  << " @ " << windowWidth << "x" << windowHeight << " (" << backend->name() << ")" << std::endl;
+    }
+}
+
+void MonitorTest::setChecksumMode(int mode) {
+    if (!checksumReadback) {
+        std::string path = launch.checksumLog;
+        if (path.empty()) {
+            char name[64];
+            std::time_t t = std::time(nullptr);
+            std::strftime(name, sizeof(name), "dht_crc_%Y%m%d_%H%M%S.csv", std::localtime(&t));
+            path = name;
+        }
+        checksumReadback = std::make_unique<AsyncReadback>(path);
+        if (checksumReadback->logOpen()) {
+            std::cout << tr("校验和日志: ", "Checksum log: ") << path << " (CRC32C " << crc32c::implementation() << ")" << std::endl;
+        } else {
+            std::cerr << tr("无法写入校验和日志: ", "Cannot write checksum log: ") << path << std::endl;
+        }
+    }
+    const auto m = static_cast<AsyncReadback::Mode>(mode % AsyncReadback::kModeCount);
+    checksumReadback->setMode(m);
+    std::cout << tr("回读校验: ", "Readback checksum: ") << AsyncReadback::modeName(m, language == Language::ZH) << std::endl;
+}
+
+void MonitorTest::patternLabel(char (&out)[8]) const {
+    const char grp = "SDA"[static_cast<int>(config.category)];
+    const int sub = (config.category == Category::STATIC_GROUP) ? config.staticMode
+                  : ((config.category == Category::DYNAMIC_GROUP) ? config.dynamicMode : config.auxMode);
+    std::snprintf(out, sizeof(out), "%c:%d", grp, sub);
+}
+
+int MonitorTest::patternQuantBits(bool offscreen) const {
+    // 离屏渲染时只有 RGBA16F 目标能保留 12-bit 码值（RGB10_A2 / RGBA8 会再次量化）
+    const bool deepOutput = framebufferRedBits >= 12 || framebufferFloat;
+    const bool deepTarget = !offscreen || renderTarget->format() == RenderTarget::Format::RGBA16F;
+    return deepOutput && deepTarget ? 12 : 10;
+}
+
+void MonitorTest::sampleChecksum() {
+    char pattern[8];
+    patternLabel(pattern);
+    checksumReadback->capture(frameIndex, pattern, backend->defaultFramebuffer(), backend->readBuffer(),
+                              windowWidth, windowHeight, framebufferRedBits);
+}
+
+void MonitorTest::setCoverageEnabled(bool enabled) {
+    if (!enabled) {
+        if (codeCoverage) printCoverageReport();
+        codeCoverage.reset();
+        coveragePattern = -1;
+    } else if (!codeCoverage) {
+        codeCoverage = std::make_unique<CodeCoverage>();
+    }
+    std::cout << tr("码值覆盖分析: ", "Code coverage: ") << onOff(enabled);
+    if (enabled) std::cout << " (" << CodeCoverage::simdPath() << ")";
+    std::cout << std::endl;
+}
+
+void MonitorTest::sampleCoverage() {
+    const int cat = static_cast<int>(config.category);
+    const int sub = (cat == 0) ? config.staticMode : ((cat == 1) ? config.dynamicMode : config.auxMode);
+    const int pattern = cat * 256 + sub;
+    if (pattern != coveragePattern) {
+        // 累计覆盖按图样统计：切换前输出上一图样的结果
+        if (coveragePattern >= 0) printCoverageReport();
+        coveragePattern = pattern;
+        codeCoverage->reset();
+    }
+    codeCoverage->capture(frameIndex, backend->defaultFramebuffer(), backend->readBuffer(), windowWidth, windowHeight);
+}
+
+void MonitorTest::printCoverageReport() const {
+    const CodeCoverage::Stats cs = codeCoverage->stats();
+    if (cs.frames == 0) return;
+    const int cat = coveragePattern / 256, sub = coveragePattern % 256;
+    std::cout << tr("码值覆盖 [", "Code coverage [") << "SDA"[cat] << ":" << sub << "] " << patternName(cat, sub, language == Language::ZH)
+              << " | " << cs.frames << tr(" 帧", " frames") << std::endl;
+    static const char kChannels[3] = {'R', 'G', 'B'};
+    for (int c = 0; c < 3; ++c) {
+        std::cout << "  " << kChannels[c] << tr(": 累计 ", ": total ") << cs.totalUsed[c] << "/" << CodeCoverage::kCodes
+                  << tr(" 码值（未用 ", " codes (unused ") << CodeCoverage::kCodes - cs.totalUsed[c] << tr("，范围 ", ", range ")
+                  << cs.minCode[c] << ".." << cs.maxCode[c] << tr("）| 单帧 ", ") | frame ") << cs.frameUsed[c]
+                  << tr(" | 翻转率 b0..b9 %:", " | toggle b0..b9 %:");
+        for (int b = 0; b < CodeCoverage::kBits; ++b) std::cout << " " << std::lround(cs.toggle[c][b] * 100.0);
+        std::cout << std::endl;
+    }
+}
+
+void MonitorTest::setEntropyEnabled(bool enabled) {
+    if (!enabled) {
+        if (frameEntropy) {
+            printEntropyRanking();
+            std::cout << tr("熵估计结果: ", "Entropy results: ") << frameEntropy->logPath() << std::endl;
+        }
+        // 析构时写入当前图样的结果
+        frameEntropy.reset();
+    } else if (!frameEntropy) {
+        std::string path = launch.entropyLog;
+        if (path.empty()) {
+            char name[64];
+            std::time_t t = std::time(nullptr);
+            std::strftime(name, sizeof(name), "dht_entropy_%Y%m%d_%H%M%S.csv", std::localtime(&t));
+            path = name;
+        }
+        frameEntropy = std::make_unique<FrameEntropy>(path);
+        if (!frameEntropy->logOpen()) {
+            std::cerr << tr("无法写入熵估计日志: ", "Cannot write entropy log: ") << path << std::endl;
+        }
+    }
+    std::cout << tr("熵/可压缩性估计: ", "Entropy estimator: ") << onOff(enabled);
+    if (enabled) std::cout << " (" << entropy::simdPath() << ")";
+    std::cout << std::endl;
+}
+
+void MonitorTest::printEntropyRanking() const {
+    std::vector<FrameEntropy::PatternResult> results = frameEntropy->results();
+    if (results.empty()) return;
+    // 估计码长越高，链路压缩（DSC 等）越难、对链路的实际压力越大
+    std::stable_sort(results.begin(), results.end(), [](const FrameEntropy::PatternResult& a, const FrameEntropy::PatternResult& b) {
+        return a.riceBits > b.riceBits;
+    });
+    std::cout << tr("链路压力排名（MED 残差块自适应 Rice 码长，bit/样本，满值 10）:",
+                    "Link stress ranking (MED residual, block-adaptive Rice, bits/sample of 10):") << std::endl;
+    int rank = 0;
+    for (const FrameEntropy::PatternResult& r : results) {
+        std::cout << "  " << ++rank << ". " << r.pattern << " | Rice " << std::fixed << std::setprecision(2) << r.riceBits
+                  << " bps (" << r.ratio() << ":1) | H raw/left/top/MED " << r.bits[entropy::kRaw] << "/"
+                  << r.bits[entropy::kLeft] << "/" << r.bits[entropy::kTop] << "/" << r.bits[entropy::kMed]
+                  << tr(" | 帧间变化 ", " | changed ") << r.changed * 100.0 << "% | " << r.frames << tr(" 帧", " frames")
+                  << std::endl;
+    }
+}
+
+void MonitorTest::setDscEnabled(bool enabled) {
+    if (!enabled) {
+        if (dscMonitor) std::cout << tr("DSC 模型结果: ", "DSC model results: ") << dscMonitor->logPath() << std::endl;
+        dscMonitor.reset();
+    } else if (!dscMonitor) {
+        std::string path = launch.dscLog;
+        if (path.empty()) {
+            char name[64];
+            std::time_t t = std::time(nullptr);
+            std::strftime(name, sizeof(name), "dht_dsc_%Y%m%d_%H%M%S.csv", std::localtime(&t));
+            path = name;
+        }
+        dsc::Config dc;
+        dc.bitsPerPixel = launch.dscBpp > 0.0 ? launch.dscBpp : 8.0;
+        if (launch.dscSliceWidth > 0) {
+            dc.sliceWidth = launch.dscSliceWidth;
+            dc.sliceHeight = launch.dscSliceHeight;
+        }
+        dscMonitor = std::make_unique<DscMonitor>(dc, path);
+        if (!dscMonitor->logOpen()) {
+            std::cerr << tr("无法写入 DSC 模型日志: ", "Cannot write DSC model log: ") << path << std::endl;
+        }
+    }
+    std::cout << tr("DSC 编码器模型: ", "DSC encoder model: ") << onOff(enabled);
+    if (enabled) std::cout << " (" << dscMonitor->config().bitsPerPixel << " bpp)";
+    std::cout << std::endl;
+}
+
+void MonitorTest::setMarkerEnabled(bool enabled) {
+    if (!enabled) {
+        frameMarker.reset();
+    } else if (!frameMarker) {
+        frameMarker = std::make_unique<MarkerRenderer>();
+        if (!frameMarker->ok()) {
+            std::cerr << tr("帧标记条: 无法创建签名计算目标，已关闭", "Frame marker: cannot create signature targets, disabled")
+                      << std::endl;
+            frameMarker.reset();
+            return;
+        }
+    }
+    std::cout << tr("帧标记条: ", "Frame marker: ") << onOff(enabled) << std::endl;
+}
+
+void MonitorTest::setMemtestEnabled(bool enabled) {
+    if (!enabled) {
+        if (vramTest) {
+            const VramTest::Stats& vs = vramTest->stats();
+            std::cout << tr("显存校验: ", "VRAM test: ") << vs.verifications << tr(" 次校验, ", " verifications, ")
+                      << vs.mismatchWords << tr(" 个不匹配字, 结果: ", " mismatched words, results: ") << vramTest->logPath()
+                      << std::endl;
+        }
+        vramTest.reset();
+    } else if (!vramTest) {
+        std::string path = launch.memtestLog;
+        if (path.empty()) {
+            char name[64];
+            std::time_t t = std::time(nullptr);
+            std::strftime(name, sizeof(name), "dht_memtest_%Y%m%d_%H%M%S.csv", std::localtime(&t));
+            path = name;
+        }
+        vramTest = std::make_unique<VramTest>(launch.memtestMib > 0 ? launch.memtestMib : 256, path);
+        if (!vramTest->ok()) {
+            std::cerr << tr("显存完整性压力: 无法创建校验目标或分配显存块，已关闭",
+                            "VRAM integrity stress: cannot create verification targets or allocate blocks, disabled")
+                      << std::endl;
+            vramTest.reset();
+            return;
+        }
+        if (!vramTest->logOpen()) {
+            std::cerr << tr("无法写入显存校验日志: ", "Cannot write VRAM test log: ") << path << std::endl;
+        }
+    }
+    std::cout << tr("显存完整性压力: ", "VRAM integrity stress: ") << onOff(enabled);
+    if (enabled) {
+        std::cout << " (" << vramTest->allocatedMiB() << " MiB";
+        if (!vramTest->stats().bufferVerify) std::cout << tr("，仅校验纹理", ", textures only");
+        std::cout << ")";
+    }
+    std::cout << std::endl;
+}
+
+bool MonitorTest::uploadStreamActive() const {
+    return uploadStream && config.category == Category::AUX_GROUP && config.auxMode == kAuxUploadIndex;
+}
+
+bool MonitorTest::drawStressActive() const {
+    return drawStress && config.category == Category::AUX_GROUP && config.auxMode == kAuxDrawStressIndex;
+}
+
+void MonitorTest::drainGlDebug() {
+    const gldebug::FrameResult r = gldebug::drain();
+    if (r.performance == 0) return;
+    // 以消息产生时的帧号去重：同一帧的多条性能警告只标记一次
+    if (perfFlaggedFrames == 0 || r.performanceFrame != lastPerfFlaggedFrame) ++perfFlaggedFrames;
+    lastPerfFlaggedFrame = r.performanceFrame;
+    intervalPerfMessages += r.performance;
+}
+
+void MonitorTest::fireChangeProbes(unsigned long long seq) {
+    (void)seq; // 无 <sys/sdt.h> 时探针为空
+    // 未附加时不做比较；附加后的首帧按“变化”触发一次，报告当前状态
+    if (DHT_PROBE_ENABLED(pattern_change)) {
+        const int cat = static_cast<int>(config.category);
+        const int sub = (cat == 0) ? config.staticMode : ((cat == 1) ? config.dynamicMode : config.auxMode);
+        const int pattern = cat * 256 + sub;
+        if (pattern != probedPattern) {
+            probedPattern = pattern;
+            DHT_PROBE4(pattern_change, seq, trace::nowNs(), cat, sub);
+        }
+    } else {
+        probedPattern = -1;
+    }
+    if (DHT_PROBE_ENABLED(config_change)) {
+        // 标志位：bit0-3 模式，bit4 VSync，bit5 暂停，bit8-11 内部分辨率，bit12-15 离屏格式
+        const unsigned flags = static_cast<unsigned>(config.mode) | (config.vsyncEnabled ? 0x10u : 0u) |
+                               (config.isPaused ? 0x20u : 0u) | (static_cast<unsigned>(internalResIndex) << 8) |
+                               (static_cast<unsigned>(internalFormatIndex) << 12);
+        const ProbedConfig snapshot{config.targetFps, config.minFps, config.maxFps, flags};
+        if (snapshot != probedConfig) {
+            probedConfig = snapshot;
+            DHT_PROBE6(config_change, seq, trace::nowNs(), config.targetFps, config.minFps, config.maxFps, flags);
+        }
+    } else {
+        probedConfig = ProbedConfig{};
     }
 }
 
@@ -1094,41 +1015,132 @@ void MonitorTest::update() {
 }
 
 void MonitorTest::render() {
-    glClear(GL_COLOR_BUFFER_BIT);
+    DHT_TRACE_ZONE("render");
+    trace::collectGpu();
+    gldebug::setFrame(frameIndex);
+    GLState& gs = GLState::get();
+    gs.beginFrame();
+    // 内部分辨率渲染：图样先画到离屏目标，再缩放到默认帧缓冲
+    const bool offscreen = updateRenderTarget();
+    const int renderW = offscreen ? renderTarget->width() : windowWidth;
+    const int renderH = offscreen ? renderTarget->height() : windowHeight;
+    if (offscreen) {
+        renderTarget->bind();
+    } else {
+        gs.bindFramebuffer(GL_FRAMEBUFFER, backend->defaultFramebuffer());
+        gs.viewport(0, 0, windowWidth, windowHeight);
+    }
+    gs.clear(GL_COLOR_BUFFER_BIT);
     
     shader->use();
     
-    // 更新uniform变量
-    shader->setFloat("uTime", static_cast<float>(currentTime));
-    shader->setVec2("uResolution", static_cast<float>(windowWidth), static_cast<float>(windowHeight));
-    shader->setInt("uFrameIndex", static_cast<int>(frameIndex & 0x7fffffff));
     // 设置分类与子模式
     int cat = (config.category == Category::STATIC_GROUP) ? 0 : ((config.category == Category::DYNAMIC_GROUP) ? 1 : 2);
     int sub = (cat == 0) ? config.staticMode : ((cat==1)? config.dynamicMode : config.auxMode);
-    shader->setInt("uCategory", cat);
-    shader->setInt("uContentMode", sub);
+    // 每帧状态一次性上传到 FrameBlock
+    FrameUniforms fu{};
+    fu.time = static_cast<float>(currentTime);
+    fu.frameIndex = static_cast<GLint>(frameIndex & 0x7fffffff);
+    fu.category = cat;
+    fu.contentMode = sub;
+    fu.resolution[0] = static_cast<float>(renderW);
+    fu.resolution[1] = static_cast<float>(renderH);
+    fu.quantBits = patternQuantBits(offscreen);
+    gs.bindBuffer(GL_UNIFORM_BUFFER, frameUbo);
+    gs.bufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(fu), &fu);
     // 动态复杂内容的子变体（用于 generateComplexColor）
     int dynVar = (cat == 1) ? sub : 0;
-    shader->setInt("uColorVariation", dynVar);
+    shader->set(uColorVariation, dynVar);
     // 无参数传递（已去掉可调参数）
     
     // 绘制全屏四边形
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    {
+        DHT_TRACE_ZONE("pattern");
+        DHT_TRACE_GPU_ZONE("GPU pattern");
+        DHT_GL_DEBUG_GROUP("pattern");
+        gs.bindVertexArray(VAO);
+        gs.drawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    }
+
+    if (cat == 2 && sub == kAuxDrawStressIndex) {
+        DHT_TRACE_ZONE("draw stress");
+        DHT_TRACE_GPU_ZONE("GPU draw stress");
+        DHT_GL_DEBUG_GROUP("draw stress");
+        if (!drawStress) drawStress = std::make_unique<DrawStress>();
+        drawStress->render(static_cast<float>(currentTime), renderW, renderH);
+    }
+    if (cat == 2 && sub == kAuxUploadIndex) {
+        DHT_TRACE_ZONE("upload");
+        DHT_TRACE_GPU_ZONE("GPU upload");
+        DHT_GL_DEBUG_GROUP("upload");
+        if (!uploadStream) uploadStream = std::make_unique<UploadStream>();
+        uploadStream->render(frameIndex, renderW, renderH);
+    }
+
+    // Philox 图样：在缩放与覆盖层绘制前回读，交由后台逐位校验
+    if (philoxVerifyEnabled && cat == 1 && sub == 14) {
+        DHT_TRACE_ZONE("philox readback");
+        DHT_GL_DEBUG_GROUP("philox readback");
+        samplePhiloxFrame();
+    }
+    if (offscreen) {
+        DHT_TRACE_ZONE("resolve");
+        DHT_TRACE_GPU_ZONE("GPU resolve");
+        DHT_GL_DEBUG_GROUP("resolve");
+        renderTarget->resolveTo(backend->defaultFramebuffer(), windowWidth, windowHeight);
+    }
+    // 最终画面（缩放后、覆盖层前）异步回读并计算校验和
+    if (checksumReadback) {
+        DHT_GL_DEBUG_GROUP("checksum readback");
+        sampleChecksum();
+    }
+    if (codeCoverage) {
+        DHT_GL_DEBUG_GROUP("coverage readback");
+        sampleCoverage();
+    }
+    if (frameEntropy) {
+        DHT_GL_DEBUG_GROUP("entropy readback");
+        char pattern[8];
+        patternLabel(pattern);
+        frameEntropy->capture(frameIndex, pattern, backend->defaultFramebuffer(), backend->readBuffer(), windowWidth, windowHeight);
+    }
+    if (dscMonitor) {
+        DHT_GL_DEBUG_GROUP("dsc readback");
+        char pattern[8];
+        patternLabel(pattern);
+        dscMonitor->capture(frameIndex, pattern, backend->defaultFramebuffer(), backend->readBuffer(), windowWidth, windowHeight);
+    }
+    // 显存校验与本帧图样同一时间线提交（结果数帧后按本帧号记录）；之后恢复默认帧缓冲供覆盖层绘制
+    if (vramTest) {
+        DHT_TRACE_ZONE("memtest");
+        DHT_TRACE_GPU_ZONE("GPU memtest");
+        DHT_GL_DEBUG_GROUP("memtest");
+        vramTest->step(frameIndex, currentTime);
+        gs.bindFramebuffer(GL_FRAMEBUFFER, backend->defaultFramebuffer());
+        gs.viewport(0, 0, windowWidth, windowHeight);
+    }
     
     // 渲染状态覆盖层（精简显示时减少绘制）
+    DHT_TRACE_GPU_ZONE("GPU overlay");
+    DHT_GL_DEBUG_GROUP("overlay");
     renderStatusOverlay();
+
+    // 帧标记最后绘制，不受覆盖层遮挡，内容签名包含覆盖层；回读分析（上方）看到的是不含标记的图样
+    if (frameMarker) {
+        DHT_GL_DEBUG_GROUP("frame marker");
+        frameMarker->draw(static_cast<uint32_t>(frameIndex), backend->defaultFramebuffer(), backend->readBuffer(),
+                          windowWidth, windowHeight);
+    }
 }
 
 void MonitorTest::handleInput() {
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
-        glfwSetWindowShouldClose(window, true);
+    if (backend->isKeyDown(GLFW_KEY_ESCAPE)) {
+        backend->requestClose();
     }
 
     // Long-press fast adjustments for target/min/max FPS
     auto now = std::chrono::high_resolution_clock::now();
-    auto pressed = [&](int key){ return glfwGetKey(window, key) == GLFW_PRESS; };
+    auto pressed = [&](int key){ return backend->isKeyDown(key); };
     auto elapsedMs = [](auto a, auto b){ return std::chrono::duration<double, std::milli>(a - b).count(); };
     auto stepFor = [&](double holdMs)->int {
         if (holdMs > 1700) return 20;
@@ -1260,7 +1272,8 @@ void MonitorTest::reportFps() {
     if (elapsed >= 1.0) {  // 每秒报告一次
         currentFps = frameCount / elapsed;
         
-        std::string modeStr;
+        // 仅用字面量与 const char*，汇报帧同样不触发堆分配
+        const char* modeStr = "";
         switch (config.mode) {
             case TestMode::FIXED_FPS: modeStr = tr("固定帧率", "Fixed FPS"); break;
             case TestMode::JITTER_FPS: modeStr = tr("抖动模式", "Jitter FPS"); break;
@@ -1268,49 +1281,10 @@ void MonitorTest::reportFps() {
             case TestMode::UNLIMITED_FPS: modeStr = tr("无限制帧率", "Unlimited FPS"); break;
         }
         
-        auto staticName = [&](int idx)->std::string {
-            switch (idx) {
-                case 0: return language==Language::ZH? "彩条" : "Color Bars";
-                case 1: return language==Language::ZH? "灰阶渐变" : "Gray Gradient";
-                case 2: return language==Language::ZH? "16阶灰条" : "16-step Gray";
-                case 3: return language==Language::ZH? "细棋盘(1px)" : "Fine Checker (1px)";
-                case 4: return language==Language::ZH? "粗棋盘" : "Coarse Checker";
-                case 5: return language==Language::ZH? "网格32px" : "Grid 32px";
-                case 6: return language==Language::ZH? "网格8px" : "Grid 8px";
-                case 7: return language==Language::ZH? "RGB竖条" : "RGB Stripes";
-                case 8: return language==Language::ZH? "十字+三分线" : "Cross + Thirds";
-                case 9: return language==Language::ZH? "纯黑" : "Black";
-                case 10: return language==Language::ZH? "纯白" : "White";
-                case 11: return language==Language::ZH? "纯红" : "Red";
-                case 12: return language==Language::ZH? "纯绿" : "Green";
-                case 13: return language==Language::ZH? "纯蓝" : "Blue";
-                case 14: return language==Language::ZH? "50%灰" : "50% Gray";
-            }
-            return language==Language::ZH? "静态图样" : "Static";
-        };
-        auto dynamicName = [&](int idx)->std::string {
-            switch (idx) {
-                case 0: return language==Language::ZH? "高熵: HSV 色轮" : "HE: HSV Wheel";
-                case 1: return language==Language::ZH? "高熵: 多尺度哈希" : "HE: Multi-Scale Hash";
-                case 2: return language==Language::ZH? "高熵: 频谱混合" : "HE: Spectral Mix";
-                case 3: return language==Language::ZH? "高熵: 蓝噪声滚动" : "HE: Blue-Noise Scroll";
-                case 4: return language==Language::ZH? "高熵: 径向扰动" : "HE: Radial Turbulence";
-                case 5: return language==Language::ZH? "高熵: 区域板动态" : "HE: Zoneplate Dynamic";
-                case 6: return language==Language::ZH? "高熵: 混合场" : "HE: Mixed Field";
-                case 7: return language==Language::ZH? "高熵: HSV 全色域" : "HE: HSV Full-Gamut";
-                case 8: return language==Language::ZH? "高熵: 谱梯度混合" : "HE: Spectral Gradient";
-                case 9: return language==Language::ZH? "高熵: Lissajous 色域" : "HE: Lissajous Field";
-                case 10: return language==Language::ZH? "高熵: 位平面闪烁" : "HE: Bit-Plane Flicker";
-                case 11: return language==Language::ZH? "高熵: 色相扫动" : "HE: Hue Sweep";
-                case 12: return language==Language::ZH? "高熵: 三正弦色域" : "HE: Tri-Sine Gamut";
-                case 13: return language==Language::ZH? "高熵: YUV 扫动" : "HE: YUV Sweep";
-            }
-            return language==Language::ZH? "高熵" : "High-Entropy";
-        };
-        std::string groupStr = (config.category == Category::STATIC_GROUP) ? tr("静态图样", "Static") : tr("动态压力", "Dynamic");
-        std::string patStr = (config.category == Category::STATIC_GROUP)
-            ? staticName(config.staticMode)
-            : dynamicName(config.dynamicMode);
+        const char* groupStr = (config.category == Category::STATIC_GROUP) ? tr("静态图样", "Static") : tr("动态压力", "Dynamic");
+        const char* patStr = (config.category == Category::STATIC_GROUP)
+            ? patternName(0, config.staticMode, language == Language::ZH)
+            : patternName(1, config.dynamicMode, language == Language::ZH);
         if (language == Language::ZH) {
             std::cout << "当前帧率: " << static_cast<int>(currentFps) << " FPS | "
                       << "帧时间: " << std::fixed << std::setprecision(2) << frameTimeMs << " ms | "
@@ -1326,38 +1300,246 @@ void MonitorTest::reportFps() {
                       << "Pattern: " << patStr << " | "
                       << (config.isPaused ? "Paused" : "Running") << std::endl;
         }
+        if (alloc::enabled()) {
+            std::cout << tr("堆分配/帧: 最近 ", "Heap allocs/frame: last ") << lastFrameAllocs
+                      << " (" << lastFrameAllocBytes << " B)" << tr(", 区间最大 ", ", interval max ") << intervalMaxAllocs << std::endl;
+            intervalMaxAllocs = 0;
+        }
+        if (drawStressActive()) {
+            std::cout << tr("绘制压力: ", "Draw stress: ") << drawStress->objectCount() << tr(" 对象, ", " objects, ")
+                      << DrawStress::submitName(drawStress->submit(), language == Language::ZH)
+                      << tr(", 提交 ", ", submit ") << std::setprecision(3) << drawStress->submitMs() << " ms" << std::endl;
+        }
+        if (uploadStreamActive() && uploadStream->stats().valid) {
+            const UploadStream::Stats& us = uploadStream->stats();
+            std::cout << tr("上传: ", "Upload: ") << UploadStream::methodName(uploadStream->method(), language == Language::ZH)
+                      << " " << UploadStream::formatName(uploadStream->format()) << std::setprecision(2)
+                      << " | " << us.gbps << " GB/s" << tr("（调用 ", " (call ") << us.callGbps << " GB/s)"
+                      << tr(" | 生成 ", " | gen ") << us.genMs << tr(" ms | 上传 ", " ms | upload ") << us.uploadMs
+                      << " ms (max " << us.uploadMaxMs << ") | GPU " << us.gpuMs
+                      << tr(" ms | 帧间隔 ", " ms | frame ") << us.frameMs << " ms sd " << us.frameSdMs
+                      << " max " << us.frameMaxMs;
+            if (us.mapFailures) std::cout << tr(" | 映射失败 ", " | map failures ") << us.mapFailures;
+            std::cout << std::endl;
+        }
+        if (checksumReadback && checksumReadback->mode() != AsyncReadback::Mode::Off) {
+            const AsyncReadback::Stats cs = checksumReadback->stats();
+            std::cout << tr("回读校验: ", "Readback CRC32C: ") << AsyncReadback::modeName(checksumReadback->mode(), language == Language::ZH)
+                      << " | #" << cs.lastFrame << " " << std::hex << std::setw(8) << std::setfill('0') << cs.lastCrc
+                      << std::dec << std::setfill(' ') << tr(" | 已记录 ", " | logged ") << cs.logged << tr(" 跳过 ", " skipped ")
+                      << cs.skipped << tr(" | 延迟 ", " | lag ") << cs.lastLag << tr(" 帧 | 计算 ", " frames | hash ")
+                      << std::setprecision(3) << cs.lastHashMs << " ms" << std::endl;
+        }
+        if (codeCoverage) {
+            const CodeCoverage::Stats cs = codeCoverage->stats();
+            std::cout << tr("码值覆盖: R/G/B 累计 ", "Code coverage: R/G/B total ") << cs.totalUsed[0] << "/" << cs.totalUsed[1]
+                      << "/" << cs.totalUsed[2] << tr(" | LSB 翻转 ", " | LSB toggle ") << std::setprecision(3)
+                      << cs.toggle[0][0] * 100.0 << "/" << cs.toggle[1][0] * 100.0 << "/" << cs.toggle[2][0] * 100.0
+                      << tr("% | 帧 ", "% | frames ") << cs.frames << tr(" 跳过 ", " skipped ") << cs.skipped
+                      << tr(" | 分析 ", " | analyze ") << cs.lastAnalyzeMs << " ms" << std::endl;
+        }
+        if (frameEntropy) {
+            const FrameEntropy::Stats es = frameEntropy->stats();
+            const FrameEntropy::PatternResult& r = es.current;
+            std::cout << tr("熵估计 ", "Entropy ") << r.pattern << tr(": H 原值/左/上/MED ", ": H raw/left/top/MED ")
+                      << std::setprecision(3) << r.bits[entropy::kRaw] << "/" << r.bits[entropy::kLeft] << "/"
+                      << r.bits[entropy::kTop] << "/" << r.bits[entropy::kMed] << " | Rice " << r.riceBits << " bps | "
+                      << tr("帧间 MSE ", "temporal MSE ") << r.temporalMse << tr(" | 帧 ", " | frames ") << r.frames
+                      << tr(" 跳过 ", " skipped ") << es.skipped << tr(" | 分析 ", " | analyze ") << es.lastAnalyzeMs << " ms"
+                      << std::endl;
+        }
+        if (dscMonitor) {
+            const DscMonitor::Stats ds = dscMonitor->stats();
+            const dsc::FrameScore& f = ds.last;
+            std::cout << "DSC " << ds.pattern << tr(": 需求 ", ": demand ") << std::setprecision(3) << f.demandBpp
+                      << tr(" bpp 实际 ", " bpp coded ") << f.codedBpp << " bpp | QP " << f.avgQp << "/" << f.maxQp
+                      << tr(" | 缓冲峰值 ", " | buffer peak ") << ds.peakFullness * 100.0 << tr("% 强制量化 ", "% forced quant ")
+                      << ds.forcedQuant << tr(" 溢出 ", " overflow ") << ds.overflow;
+            if (f.worstSlice >= 0) {
+                const dsc::SliceStats& w = f.slices[f.worstSlice];
+                std::cout << tr(" | 最差 slice ", " | worst slice ") << f.worstSlice << " @" << w.x << "," << w.y;
+            }
+            std::cout << tr(" | 帧 ", " | frames ") << ds.frames << tr(" 跳过 ", " skipped ") << ds.skipped
+                      << tr(" | 编码 ", " | encode ") << f.ms << " ms" << std::endl;
+        }
+        if (vramTest) {
+            const VramTest::Stats& vs = vramTest->stats();
+            std::cout << tr("显存校验: ", "VRAM test: ") << vramTest->allocatedMiB() << " MiB | " << tr("轮次 ", "rotations ")
+                      << vs.rotations << tr(" | 已校验 ", " | verified ") << std::setprecision(3)
+                      << vs.verifiedBytes / (1024.0 * 1024.0 * 1024.0) << tr(" GiB | 不匹配 ", " GiB | mismatches ")
+                      << vs.mismatchWords << tr(" 字（", " words (") << vs.errorEvents << tr(" 次）", " events)");
+            if (vs.errorEvents > 0) {
+                std::cout << tr(" | 最近 #", " | last #") << vs.lastErrorFrame << tr(" 块 ", " block ") << vs.lastErrorBlock
+                          << (vs.lastErrorInBuffer ? tr(" 缓冲", " buffer") : tr(" 纹理", " texture"));
+            }
+            std::cout << tr(" | 跳过 ", " | skipped ") << vs.skipped << std::endl;
+        }
+        if (intervalPerfMessages > 0) {
+            std::cout << tr("驱动性能警告: 本秒 ", "Driver performance warnings: ") << intervalPerfMessages
+                      << tr(" 条，累计标记 ", " this second, flagged frames total ") << perfFlaggedFrames
+                      << tr(" 帧（最近 #", " (last #") << lastPerfFlaggedFrame << ")" << std::endl;
+            intervalPerfMessages = 0;
+        }
 
-        
         frameCount = 0;
         lastFpsReportTime = now;
     }
 }
 
+void MonitorTest::samplePhiloxFrame() {
+    if (!philoxVerifier) return;
+    // 离屏渲染时从渲染目标读取左下角窗口大小区域（码值只与像素坐标有关）
+    const bool offscreen = renderTarget && renderTarget->valid() && internalResIndex != 0;
+    const int bits = offscreen ? renderTarget->channelBits() : (framebufferRedBits >= 10 ? 10 : 8);
+    const int w = offscreen ? std::min(windowWidth, renderTarget->width()) : windowWidth;
+    const int h = offscreen ? std::min(windowHeight, renderTarget->height()) : windowHeight;
+    philoxVerifier->capture(frameIndex, offscreen ? renderTarget->framebuffer() : backend->defaultFramebuffer(),
+                            offscreen ? GL_COLOR_ATTACHMENT0 : backend->readBuffer(), w, h, bits);
+}
+
+namespace {
+// 内部分辨率预设：0 = 原生（不使用离屏目标），1 = 窗口 2 倍，其余按高度并保持窗口宽高比
+constexpr int kInternalResCount = 5;
+constexpr int kInternalResHeight[kInternalResCount] = {0, 0, 2160, 4320, 8640};
+constexpr const char* kInternalResName[kInternalResCount] = {"Native", "2x", "4K", "8K", "16K"};
+}
+
+const char* MonitorTest::internalResName() const {
+    if (internalResIndex == 0) return tr("原生", "Native");
+    return kInternalResName[internalResIndex];
+}
+
+bool MonitorTest::updateRenderTarget() {
+    if (internalResIndex == 0) {
+        if (renderTarget && renderTarget->valid()) renderTarget->release();
+        return false;
+    }
+    if (!renderTarget) renderTarget = std::make_unique<RenderTarget>();
+    double w = 2.0 * windowWidth, h = 2.0 * windowHeight;
+    if (internalResIndex > 1) {
+        h = kInternalResHeight[internalResIndex];
+        w = h * static_cast<double>(windowWidth) / std::max(1, windowHeight);
+    }
+    // 超出驱动上限时等比缩小
+    const double maxDim = RenderTarget::maxDimension();
+    const double s = std::min(1.0, maxDim / std::max(w, h));
+    const int tw = std::max(1, static_cast<int>(std::lround(w * s)));
+    const int th = std::max(1, static_cast<int>(std::lround(h * s)));
+    const auto fmt = static_cast<RenderTarget::Format>(internalFormatIndex);
+    if (renderTarget->ensure(tw, th, fmt)) return true;
+
+    std::cerr << tr("离屏目标分配失败（显存不足或格式不支持）: ", "Offscreen target allocation failed (out of VRAM or unsupported format): ")
+              << tw << "x" << th << " " << RenderTarget::formatName(fmt)
+              << tr("，回退到原生分辨率", "; falling back to native resolution") << std::endl;
+    internalResIndex = 0;
+    return false;
+}
+
+void MonitorTest::runNoiseHashBench() {
+    std::cout << tr("\n=== 哈希自检（离屏 ", "\n=== Hash self-test (offscreen ")
+              << windowWidth << "x" << windowHeight << ") ===" << std::endl;
+    auto results = NoiseHashBench::Run(windowWidth, windowHeight);
+    // 自检直接调用 GL，结束后状态缓存失效
+    GLState::get().invalidate();
+    GLState::get().bindFramebuffer(GL_FRAMEBUFFER, backend->defaultFramebuffer());
+    GLState::get().viewport(0, 0, windowWidth, windowHeight);
+    if (results.empty()) {
+        std::cout << tr("自检失败（FBO 不可用）", "Self-test failed (FBO unavailable)") << std::endl;
+        return;
+    }
+    for (const auto& r : results) {
+        std::cout << std::left << std::setw(11) << r.name << std::right
+                  << (r.largeCoords ? tr(" 大坐标", " large") : tr(" 原点  ", " origin"))
+                  << std::fixed << std::setprecision(4)
+                  << " | ns/px: " << r.nsPerHashPx
+                  << " | chi2/dof: " << r.chi2PerDof
+                  << " | bit bias: " << r.maxBitBias
+                  << " | adj corr: " << r.adjCorr << std::endl;
+    }
+    std::cout << "================\n" << std::endl;
+    // 覆盖层摘要：当前使用的 pcg3d 与旧 fract(sin) 的 ALU 开销对比
+    const auto* sinR = &results[0];
+    const auto* pcgR = &results[2];
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3) << tr("哈希: pcg3d ", "Hash: pcg3d ")
+        << pcgR->nsPerHashPx << " ns/px (sin " << sinR->nsPerHashPx << ")"
+        << std::setprecision(2) << " chi2 " << pcgR->chi2PerDof;
+    hashBenchSummary = oss.str();
+}
+
+void MonitorTest::dumpTrace(const std::string& path) {
+    const long events = trace::writeChromeJson(path, launch.traceSeconds);
+    if (events < 0) {
+        std::cerr << tr("写入时间线失败: ", "Failed to write trace: ") << path << std::endl;
+        return;
+    }
+    std::cout << tr("时间线已导出: ", "Trace written: ") << path << " (" << events
+              << tr(" 个事件，最近 ", " events, last ") << launch.traceSeconds
+              << tr(" 秒；可在 ui.perfetto.dev 或 chrome://tracing 打开)", " s; open in ui.perfetto.dev or chrome://tracing)") << std::endl;
+}
+
+void MonitorTest::runPresentBench() {
+    const int frames = launch.maxFrames > 0 ? static_cast<int>(std::min<unsigned long long>(launch.maxFrames, 100000)) : 300;
+    std::cout << tr("\n=== 呈现路径基准（空图样，每种配置 ", "\n=== Present-path benchmark (null pattern, ")
+              << frames << tr(" 帧） ===", " frames per config) ===") << std::endl;
+    if (!backend->supportsAdaptiveVsync()) {
+        std::cout << tr("不支持自适应垂直同步（swap_control_tear），跳过间隔 -1",
+                        "Adaptive vsync (swap_control_tear) not supported; skipping interval -1") << std::endl;
+    }
+    auto results = PresentBench::Run(*backend, frames, config.vsyncEnabled ? 1 : 0);
+    for (const auto& r : results) {
+        std::cout << std::left << std::setw(10)
+                  << (backend->headless() ? tr("离屏", "offscreen") : (r.fullscreen ? tr("全屏", "fullscreen") : tr("窗口", "windowed")))
+                  << std::right << " " << r.width << "x" << r.height
+                  << " | interval " << std::setw(2) << r.swapInterval
+                  << " | glFinish " << (r.finish ? "on " : "off")
+                  << std::fixed << std::setprecision(1) << " | " << std::setw(7) << r.loopFps << " FPS"
+                  << std::setprecision(3) << " | swap ms mean " << r.swapMeanMs << " sd " << r.swapStdMs
+                  << " p50 " << r.swapP50Ms << " p99 " << r.swapP99Ms << " max " << r.swapMaxMs << std::endl;
+    }
+    std::cout << "================\n" << std::endl;
+}
+
 void MonitorTest::cleanup() {
+    GLState& gs = GLState::get();
     if (VAO) {
+        gs.forgetVertexArray(VAO);
         glDeleteVertexArrays(1, &VAO);
         VAO = 0;
     }
     if (VBO) {
+        gs.forgetBuffer(VBO);
         glDeleteBuffers(1, &VBO);
         VBO = 0;
     }
+    if (frameUbo) {
+        gs.forgetBuffer(frameUbo);
+        glDeleteBuffers(1, &frameUbo);
+        frameUbo = 0;
+    }
     
+    // 以下对象析构时删除 GL 资源，须在后端销毁前释放
+    if (codeCoverage) setCoverageEnabled(false);
+    if (frameEntropy) setEntropyEnabled(false);
+    if (dscMonitor) setDscEnabled(false);
+    if (vramTest) setMemtestEnabled(false);
+    frameMarker.reset();
+    checksumReadback.reset();
+    uploadStream.reset();
+    drawStress.reset();
+    renderTarget.reset();
     shader.reset();
     textRenderer.reset();
+    philoxVerifier.reset();
     
-    if (window) {
-        glfwDestroyWindow(window);
-        window = nullptr;
-    }
-    
-    glfwTerminate();
+    trace::shutdownGpu();
+
+    // 最后销毁后端（窗口/上下文），此前的 GL 对象删除需要上下文仍然有效
+    backend.reset();
 }
 
 // 静态回调函数实现
-void MonitorTest::keyCallback(GLFWwindow* window, int key, int /*scancode*/, int action, int /*mods*/) {
-    MonitorTest* test = static_cast<MonitorTest*>(glfwGetWindowUserPointer(window));
-    
+void MonitorTest::keyCallback(MonitorTest* test, int key, int action) {
     if (!test) return;
 
     if (action == GLFW_PRESS) {
@@ -1386,13 +1568,13 @@ void MonitorTest::keyCallback(GLFWwindow* window, int key, int /*scancode*/, int
 
             case GLFW_KEY_RIGHT: {
                 if (test->config.category == Category::STATIC_GROUP) {
-                    test->config.staticMode = (test->config.staticMode + 1) % 21;
+                    test->config.staticMode = (test->config.staticMode + 1) % kStaticPatternCount;
                     std::cout << (test->language==Language::ZH?"静态图样索引: ":"Static index: ") << test->config.staticMode << std::endl;
                 } else if (test->config.category == Category::DYNAMIC_GROUP) {
-                    test->config.dynamicMode = (test->config.dynamicMode + 1) % 14;
+                    test->config.dynamicMode = (test->config.dynamicMode + 1) % kDynamicPatternCount;
                     std::cout << (test->language==Language::ZH?"动态图样索引: ":"Dynamic index: ") << test->config.dynamicMode << std::endl;
                 } else {
-                    test->config.auxMode = 0; // 仅 UFO
+                    test->config.auxMode = (test->config.auxMode + 1) % kAuxPatternCount;
                     std::cout << (test->language==Language::ZH?"辅助图样索引: ":"Aux index: ") << test->config.auxMode << std::endl;
                 }
                 break;
@@ -1400,13 +1582,13 @@ void MonitorTest::keyCallback(GLFWwindow* window, int key, int /*scancode*/, int
 
             case GLFW_KEY_LEFT: {
                 if (test->config.category == Category::STATIC_GROUP) {
-                    test->config.staticMode = (test->config.staticMode + 21 - 1) % 21;
+                    test->config.staticMode = (test->config.staticMode + kStaticPatternCount - 1) % kStaticPatternCount;
                     std::cout << (test->language==Language::ZH?"静态图样索引: ":"Static index: ") << test->config.staticMode << std::endl;
                 } else if (test->config.category == Category::DYNAMIC_GROUP) {
-                    test->config.dynamicMode = (test->config.dynamicMode + 14 - 1) % 14;
+                    test->config.dynamicMode = (test->config.dynamicMode + kDynamicPatternCount - 1) % kDynamicPatternCount;
                     std::cout << (test->language==Language::ZH?"动态图样索引: ":"Dynamic index: ") << test->config.dynamicMode << std::endl;
                 } else {
-                    test->config.auxMode = 0; // 仅 UFO
+                    test->config.auxMode = (test->config.auxMode + kAuxPatternCount - 1) % kAuxPatternCount;
                     std::cout << (test->language==Language::ZH?"辅助图样索引: ":"Aux index: ") << test->config.auxMode << std::endl;
                 }
                 break;
@@ -1415,14 +1597,104 @@ void MonitorTest::keyCallback(GLFWwindow* window, int key, int /*scancode*/, int
 
             case GLFW_KEY_V: {
                 test->config.vsyncEnabled = !test->config.vsyncEnabled;
-                glfwMakeContextCurrent(window);
-                glfwSwapInterval(test->config.vsyncEnabled ? 1 : 0);
+                test->backend->setSwapInterval(test->config.vsyncEnabled ? 1 : 0);
                 std::cout << (test->language==Language::ZH ? (test->config.vsyncEnabled ? "垂直同步: 开" : "垂直同步: 关")
                                                            : (test->config.vsyncEnabled ? "VSync: On" : "VSync: Off"))
                           << std::endl;
                 break;
             }
 
+            case GLFW_KEY_H: {
+                test->runNoiseHashBench();
+                break;
+            }
+
+            case GLFW_KEY_R: {
+                test->internalResIndex = (test->internalResIndex + 1) % kInternalResCount;
+                std::cout << (test->language==Language::ZH ? "内部分辨率: " : "Internal resolution: ")
+                          << test->internalResName() << std::endl;
+                break;
+            }
+
+            case GLFW_KEY_T: {
+                test->internalFormatIndex = (test->internalFormatIndex + 1) % RenderTarget::kFormatCount;
+                std::cout << (test->language==Language::ZH ? "离屏格式: " : "Offscreen format: ")
+                          << RenderTarget::formatName(static_cast<RenderTarget::Format>(test->internalFormatIndex)) << std::endl;
+                break;
+            }
+
+            case GLFW_KEY_LEFT_BRACKET:
+            case GLFW_KEY_RIGHT_BRACKET: {
+                if (!test->drawStressActive()) break;
+                test->drawStress->stepObjectCount(key == GLFW_KEY_RIGHT_BRACKET ? 1 : -1);
+                std::cout << (test->language==Language::ZH ? "绘制压力对象数: " : "Draw stress objects: ")
+                          << test->drawStress->objectCount() << std::endl;
+                break;
+            }
+
+            case GLFW_KEY_I: {
+                if (!test->drawStressActive()) break;
+                test->drawStress->cycleSubmit();
+                std::cout << (test->language==Language::ZH ? "绘制压力提交方式: " : "Draw stress submission: ")
+                          << DrawStress::submitName(test->drawStress->submit(), test->language == Language::ZH) << std::endl;
+                break;
+            }
+
+            case GLFW_KEY_U: {
+                if (!test->uploadStreamActive()) break;
+                test->uploadStream->cycleMethod();
+                std::cout << (test->language==Language::ZH ? "上传路径: " : "Upload path: ")
+                          << UploadStream::methodName(test->uploadStream->method(), test->language == Language::ZH) << std::endl;
+                break;
+            }
+
+            case GLFW_KEY_Y: {
+                if (!test->uploadStreamActive()) break;
+                test->uploadStream->cycleFormat();
+                std::cout << (test->language==Language::ZH ? "上传格式: " : "Upload format: ")
+                          << UploadStream::formatName(test->uploadStream->format()) << std::endl;
+                break;
+            }
+
+            case GLFW_KEY_C: {
+                const int current = test->checksumReadback ? static_cast<int>(test->checksumReadback->mode()) : 0;
+                test->setChecksumMode(current + 1);
+                break;
+            }
+
+            case GLFW_KEY_G: {
+                test->setCoverageEnabled(!test->codeCoverage);
+                break;
+            }
+
+            case GLFW_KEY_E: {
+                test->setEntropyEnabled(!test->frameEntropy);
+                break;
+            }
+
+            case GLFW_KEY_D: {
+                test->setDscEnabled(!test->dscMonitor);
+                break;
+            }
+
+            case GLFW_KEY_B: {
+                test->setMarkerEnabled(!test->frameMarker);
+                break;
+            }
+
+            case GLFW_KEY_M: {
+                test->setMemtestEnabled(!test->vramTest);
+                break;
+            }
+
+            case GLFW_KEY_K: {
+                test->philoxVerifyEnabled = !test->philoxVerifyEnabled;
+                if (test->philoxVerifier) test->philoxVerifier->reset();
+                std::cout << (test->language==Language::ZH ? "Philox 回读校验: " : "Philox readback verify: ")
+                          << test->onOff(test->philoxVerifyEnabled) << std::endl;
+                break;
+            }
+
             case GLFW_KEY_L: {
                 test->toggleLanguage();
                 std::cout << (test->language==Language::EN?"Language: English":"Language: Chinese") << std::endl;
@@ -1433,6 +1705,18 @@ void MonitorTest::keyCallback(GLFWwindow* window, int key, int /*scancode*/, int
                 test->minimalOverlay = !test->minimalOverlay;
                 break;
             }
+            case GLFW_KEY_F3: {
+                test->glStatsOverlay = !test->glStatsOverlay;
+                break;
+            }
+            case GLFW_KEY_F9: {
+                // 导出最近 N 秒时间线（文件名带时间戳，便于保留多次卡顿现场）
+                char name[64];
+                std::time_t t = std::time(nullptr);
+                std::strftime(name, sizeof(name), "dht_trace_%Y%m%d_%H%M%S.json", std::localtime(&t));
+                test->dumpTrace(name);
+                break;
+            }
             case GLFW_KEY_F2: {
                 // Cycle pacing: Fixed -> Range -> Unlimited -> Fixed ...
                 test->pacingSelection = (test->pacingSelection + 1) % 3;
@@ -1453,18 +1737,17 @@ void MonitorTest::keyCallback(GLFWwindow* window, int key, int /*scancode*/, int
                 } else {
                     // Unlimited
                     test->useDynamicFrameRange = false;
-                    test->config.vsyncEnabled = false; glfwSwapInterval(0);
+                    test->config.vsyncEnabled = false; test->backend->setSwapInterval(0);
                     test->config.mode = TestMode::UNLIMITED_FPS;
                     std::cout << (test->language==Language::ZH?"帧率策略: 无限制":"Pacing: Unlimited") << std::endl;
                 }
                 break;
             }
-            // F3 removed: range mode no longer switches jitter/oscillation
             // F4 merged into F2 cycling (Fixed/Range/Unlimited)
             case GLFW_KEY_F12: {
                 test->extremeMode = !test->extremeMode;
                 if (test->extremeMode) {
-                    test->config.vsyncEnabled = false; glfwSwapInterval(0);
+                    test->config.vsyncEnabled = false; test->backend->setSwapInterval(0);
                     test->minimalOverlay = true;
                     test->useDynamicFrameRange = false; // 极限模式使用“无限制帧率”
                     test->pacingSelection = 2; // Unlimited
@@ -1503,9 +1786,8 @@ void MonitorTest::keyCallback(GLFWwindow* window, int key, int /*scancode*/, int
     // 取消参数微调（已移除）
 }
 
-void MonitorTest::framebufferSizeCallback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
-    MonitorTest* test = static_cast<MonitorTest*>(glfwGetWindowUserPointer(window));
+void MonitorTest::framebufferSizeCallback(MonitorTest* test, int width, int height) {
+    GLState::get().viewport(0, 0, width, height);
     if (!test) return;
     test->windowWidth = width;
     test->windowHeight = height;
@@ -1519,10 +1801,6 @@ void MonitorTest::framebufferSizeCallback(GLFWwindow* window, int width, int hei
     }
 }
 
-void MonitorTest::errorCallback(int error, const char* description) {
-    std::cerr << "GLFW error " << error << ": " << description << std::endl;
-}
-
  
 
 void MonitorTest::printControls() const {
@@ -1537,9 +1815,25 @@ void MonitorTest::printControls() const {
     std::cout << (language==Language::ZH?"V      - 垂直同步 开/关":"V      - VSync On/Off") << std::endl;
     std::cout << "F1     - " << (language==Language::ZH?"精简显示 开/关":"Minimal overlay On/Off") << std::endl;
     std::cout << "F2     - " << (language==Language::ZH?"帧率策略 固定/动态/无限制":"Pacing Fixed/Range/Unlimited") << std::endl;
+    std::cout << "F3     - " << (language==Language::ZH?"GL 调用统计（状态切换/绘制/上传）开/关":"GL call stats (state changes/draws/uploads) On/Off") << std::endl;
     std::cout << "F5/F6  - " << (language==Language::ZH?"动态最小帧 -/+（长按快调）":"Range min -/+ (hold fast)") << std::endl;
     std::cout << "F7/F8  - " << (language==Language::ZH?"动态最大帧 -/+（长按快调）":"Range max -/+ (hold fast)") << std::endl;
     std::cout << "F12    - " << (language==Language::ZH?"一键极限模式":"Extreme mode toggle") << std::endl;
+    std::cout << "R      - " << (language==Language::ZH?"内部分辨率 原生/2x/4K/8K/16K（离屏渲染后缩放，显存带宽加压）":"Internal resolution Native/2x/4K/8K/16K (offscreen render + downsample, VRAM bandwidth stress)") << std::endl;
+    std::cout << "T      - " << (language==Language::ZH?"离屏格式 RGBA8/RGB10_A2/RGBA16F":"Offscreen format RGBA8/RGB10_A2/RGBA16F") << std::endl;
+    std::cout << "H      - " << (language==Language::ZH?"哈希自检（ALU 开销/统计质量）":"Hash self-test (ALU cost/statistics)") << std::endl;
+    std::cout << "K      - " << (language==Language::ZH?"Philox 图样回读逐位校验 开/关":"Philox pattern bit-exact readback verify On/Off") << std::endl;
+    std::cout << "[ / ]  - " << (language==Language::ZH?"绘制调用压力场景（辅助 A:1）对象数 1k..200k":"Draw-call stress scene (Aux A:1) object count 1k..200k") << std::endl;
+    std::cout << "I      - " << (language==Language::ZH?"绘制压力提交方式：实例化 / 逐次绘制 / 逐次绘制 + uniform":"Draw stress submission: instanced / one draw per object / draw + uniform per object") << std::endl;
+    std::cout << "U      - " << (language==Language::ZH?"上传带宽场景（辅助 A:2）路径：glTexSubImage2D / PBO 孤立化 / PBO 三缓冲环 / 持久映射":"Upload bandwidth scene (Aux A:2) path: glTexSubImage2D / orphaned PBO / PBO ring / persistent mapping") << std::endl;
+    std::cout << "Y      - " << (language==Language::ZH?"上传格式 RGBA8 / RGB10_A2":"Upload format RGBA8 / RGB10_A2") << std::endl;
+    std::cout << "C      - " << (language==Language::ZH?"最终画面异步回读校验 关/采样块/整帧（CRC32C 逐帧写入 CSV）":"Async readback checksum of the final image off/tiles/full (per-frame CRC32C to CSV)") << std::endl;
+    std::cout << "G      - " << (language==Language::ZH?"码值覆盖分析 开/关（最终画面 10-bit 异步回读：各通道码值直方图、未用码值、逐位翻转率）":"Code coverage analyzer On/Off (async 10-bit readback of the final image: per-channel code histograms, unused codes, per-bit toggle rates)") << std::endl;
+    std::cout << "E      - " << (language==Language::ZH?"熵/可压缩性估计 开/关（残差熵：原值/左/上/MED 预测，Rice 码长估计，帧间差分；按图样写 CSV，关闭时输出排名）":"Entropy estimator On/Off (residual entropy under raw/left/top/MED predictors, Rice size estimate, temporal difference; per-pattern CSV, ranking on close)") << std::endl;
+    std::cout << "D      - " << (language==Language::ZH?"DSC 1.2a 编码器模型 开/关（按 slice 并行：MMAP/BP/ICH、码率缓冲模型；报告码率需求、缓冲峰值、强制量化，逐 slice 写 CSV）":"DSC 1.2a encoder model On/Off (parallel per slice: MMAP/BP/ICH, rate-buffer model; reports bpp demand, buffer peak, forced quantization; per-slice CSV)") << std::endl;
+    std::cout << "B      - " << (language==Language::ZH?"帧标记条 开/关（画面底部色块编码帧号、内容签名与 CRC32C；dht_capture_verify 从 V4L2 采集卡解码，报告丢帧/重复/乱序/损坏/内容不符）":"Frame marker strip On/Off (blocks at the bottom encode frame index, content signature and CRC32C; dht_capture_verify decodes them from a V4L2 capture device and reports drops/duplicates/reordering/corruption/content mismatches)") << std::endl;
+    std::cout << "M      - " << (language==Language::ZH?"显存完整性压力 开/关（纹理+缓冲块写入行走 1/地址/随机图样，GPU 复制并校验，只回读不匹配计数；与图样同一时间线写 CSV）":"VRAM integrity stress On/Off (texture+buffer blocks filled with walking-ones/address/random patterns, copied and verified on the GPU, only mismatch counts read back; CSV on the same timeline as the pattern)") << std::endl;
+    std::cout << "F9     - " << (language==Language::ZH?"导出最近 N 秒时间线（Chrome trace JSON，Perfetto 可打开）":"Dump last N seconds of timeline (Chrome trace JSON, opens in Perfetto)") << std::endl;
     std::cout << "L      - Toggle language (ZH/EN)" << std::endl;
     std::cout << "===============\n" << std::endl;
 }
@@ -1550,6 +1844,8 @@ void MonitorTest::printSystemInfo() const {
     std::cout << (language==Language::ZH?"显卡厂商: ":"Vendor: ") << toSafeString(glGetString(GL_VENDOR)) << std::endl;
     std::cout << (language==Language::ZH?"显卡型号: ":"Renderer: ") << toSafeString(glGetString(GL_RENDERER)) << std::endl;
     std::cout << (language==Language::ZH?"分辨率: ":"Resolution: ") << windowWidth << "x" << windowHeight << std::endl;
+    std::cout << (language==Language::ZH?"输出位深: ":"Output depth: ") << framebufferRedBits << " bpc"
+              << (framebufferFloat ? " FP16" : "") << std::endl;
     std::cout << (language==Language::ZH?"目标: 10bit色深全带宽压力测试":"Goal: 10-bit deep color bandwidth stress") << std::endl;
     std::cout << "================\n" << std::endl;
 }
@@ -1558,7 +1854,7 @@ const char* MonitorTest::tr(const char* zh, const char* en) const {
     return language == Language::ZH ? zh : en;
 }
 
-std::string MonitorTest::onOff(bool v) const {
+const char* MonitorTest::onOff(bool v) const {
     return language == Language::ZH ? (v ? "开" : "关") : (v ? "On" : "Off");
 }
 
@@ -1584,6 +1880,7 @@ Language MonitorTest::detectLanguage() {
 }
 
 std::string MonitorTest::chooseFontPath() const {
+    DHT_TRACE_ZONE("chooseFontPath");
     // 改为始终优先使用“系统默认字体”，不再读取工程内置/下载字体
     namespace fs = std::filesystem;
 
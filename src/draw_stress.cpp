@@ -0,0 +1,119 @@
+#include "draw_stress.h"
+#include "gl_state.h"
+
+#include <chrono>
+#include <iterator>
+
+namespace {
+constexpr int kObjectCounts[] = {1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000};
+constexpr int kObjectCountSteps = static_cast<int>(std::size(kObjectCounts));
+
+const char* kStressVertexShader = R"(#version 330 core
+uniform int uMode;       // 0 实例化, 1 逐次绘制（first 偏移区分对象）, 2 逐次绘制 + uObject
+uniform int uObject;
+uniform int uCount;
+uniform float uTime;
+uniform float uAspect;   // 宽 / 高
+flat out vec3 vColor;
+
+const vec2 kCorners[6] = vec2[6](vec2(0, 0), vec2(1, 0), vec2(1, 1), vec2(1, 1), vec2(0, 1), vec2(0, 0));
+
+uint pcgHash(uint v) {
+    uint s = v * 747796405u + 2891336453u;
+    uint w = ((s >> ((s >> 28u) + 4u)) ^ s) * 277803737u;
+    return (w >> 22u) ^ w;
+}
+
+void main() {
+    int id = (uMode == 0) ? gl_InstanceID : ((uMode == 1) ? gl_VertexID / 6 : uObject);
+    // 按屏幕宽高比排成近似方形单元的网格
+    int cols = max(1, int(ceil(sqrt(float(uCount) * uAspect))));
+    int rows = (uCount + cols - 1) / cols;
+    vec2 cell = vec2(2.0 / float(cols), 2.0 / float(rows));
+    uint h = pcgHash(uint(id));
+    // 每个对象在单元内小幅运动（相位取自哈希），保证逐帧内容变化
+    float phase = float(h & 1023u) / 1023.0 * 6.2831853;
+    vec2 wobble = 0.15 * vec2(cos(uTime * 2.0 + phase), sin(uTime * 2.0 + phase));
+    vec2 origin = vec2(float(id % cols), float(id / cols)) * cell - 1.0;
+    vec2 p = origin + (kCorners[gl_VertexID % 6] * 0.7 + 0.15 + wobble) * cell;
+    gl_Position = vec4(p, 0.0, 1.0);
+    vColor = vec3(float(h & 1023u), float((h >> 10) & 1023u), float((h >> 20) & 1023u)) / 1023.0;
+}
+)";
+
+const char* kStressFragmentShader = R"(#version 330 core
+flat in vec3 vColor;
+out vec4 FragColor;
+void main() { FragColor = vec4(vColor, 1.0); }
+)";
+} // namespace
+
+DrawStress::DrawStress() {
+    shader_ = std::make_unique<Shader>(kStressVertexShader, kStressFragmentShader);
+    uMode_ = shader_->uniformInt("uMode");
+    uObject_ = shader_->uniformInt("uObject");
+    uCount_ = shader_->uniformInt("uCount");
+    uTime_ = shader_->uniformFloat("uTime");
+    uAspect_ = shader_->uniformFloat("uAspect");
+    glGenVertexArrays(1, &vao_);
+}
+
+DrawStress::~DrawStress() {
+    if (vao_) {
+        GLState::get().forgetVertexArray(vao_);
+        glDeleteVertexArrays(1, &vao_);
+    }
+}
+
+int DrawStress::objectCount() const { return kObjectCounts[countIndex_]; }
+
+void DrawStress::stepObjectCount(int delta) {
+    countIndex_ = (countIndex_ + delta + kObjectCountSteps) % kObjectCountSteps;
+    submitMs_ = 0.0;
+}
+
+void DrawStress::cycleSubmit() {
+    submit_ = static_cast<Submit>((static_cast<int>(submit_) + 1) % kSubmitCount);
+    submitMs_ = 0.0;
+}
+
+const char* DrawStress::submitName(Submit submit, bool zh) {
+    switch (submit) {
+        case Submit::Instanced:         return zh ? "实例化（1 次绘制）" : "instanced (1 draw)";
+        case Submit::Draws:             return zh ? "逐次绘制" : "one draw per object";
+        case Submit::DrawsWithUniforms: return zh ? "逐次绘制 + uniform" : "draw + uniform per object";
+    }
+    return "?";
+}
+
+double DrawStress::render(float time, int width, int height) {
+    GLState& gs = GLState::get();
+    const int count = objectCount();
+    gs.disable(GL_BLEND);
+    shader_->use();
+    shader_->set(uMode_, static_cast<int>(submit_));
+    shader_->set(uCount_, count);
+    shader_->set(uTime_, time);
+    shader_->set(uAspect_, height > 0 ? static_cast<float>(width) / height : 1.0f);
+    gs.bindVertexArray(vao_);
+
+    // 仅计提交循环：驱动校验、命令打包与 uniform 上传都在这里发生
+    const auto t0 = std::chrono::steady_clock::now();
+    switch (submit_) {
+        case Submit::Instanced:
+            gs.drawArraysInstanced(GL_TRIANGLES, 0, 6, count);
+            break;
+        case Submit::Draws:
+            for (int i = 0; i < count; ++i) gs.drawArrays(GL_TRIANGLES, i * 6, 6);
+            break;
+        case Submit::DrawsWithUniforms:
+            for (int i = 0; i < count; ++i) {
+                shader_->set(uObject_, i);
+                gs.drawArrays(GL_TRIANGLES, 0, 6);
+            }
+            break;
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    submitMs_ = submitMs_ <= 0.0 ? ms : submitMs_ * 0.9 + ms * 0.1;
+    return ms;
+}
@@ -0,0 +1,472 @@
+#include "dsc_model.h"
+#include "thread_pool.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+
+namespace dsc {
+namespace {
+constexpr int kRcModelSize = 8192;
+constexpr int kRanges = 15;
+// 8 bpc / 8 bpp 推荐码率控制参数（rc_buf_thresh、range_min/max_qp、range_bpg_offset）；
+// 其他位深的 QP 整体加 2*(bpc-8)，使量化步长相对位深不变
+constexpr int kBufThresh[kRanges - 1] = {896, 1792, 2688, 3584, 4480, 5376, 6272, 6720, 7168, 7616, 7744, 7872, 8000, 8064};
+constexpr int kMinQp8[kRanges] = {0, 0, 1, 1, 3, 3, 3, 3, 3, 3, 5, 5, 5, 7, 13};
+constexpr int kMaxQp8[kRanges] = {4, 4, 5, 6, 7, 7, 7, 8, 9, 10, 11, 12, 13, 13, 15};
+constexpr int kBpgOffset[kRanges] = {2, 0, 0, -2, -4, -6, -8, -8, -8, -10, -10, -12, -12, -12, -12};
+constexpr int kInitialOffset = 6144;
+constexpr int kFirstLineBpgOffset = 15;     // DSC 1.2 默认 first_line_bpg_offset
+constexpr int kTgtOffsetHi = 3, kTgtOffsetLo = 3;
+constexpr int kFlatnessMinQp8 = 3;
+constexpr int kFlatRangeLimit = 12;         // 缓冲接近满时不再为平坦区降低 QP
+constexpr int kIchSize = 32;
+constexpr int kIchIndexBits = 5;
+constexpr int kBpMinVector = 3, kBpMaxVector = 10;
+
+enum Component { kY = 0, kCo = 1, kCg = 2 };
+
+struct Pixel {
+    int c[3];
+};
+
+// YCoCg-R（整数可逆）：Co/Cg 比 RGB 多 1 位
+inline Pixel toYCoCg(uint32_t px) {
+    const int r = px & 0x3FF, g = (px >> 10) & 0x3FF, b = (px >> 20) & 0x3FF;
+    const int co = r - b;
+    const int t = b + (co >> 1);
+    const int cg = g - t;
+    return Pixel{{t + (cg >> 1), co, cg}};
+}
+
+inline void toRgb(const Pixel& p, int maxVal, int rgb[3]) {
+    const int t = p.c[kY] - (p.c[kCg] >> 1);
+    const int g = p.c[kCg] + t;
+    const int b = t - (p.c[kCo] >> 1);
+    const int r = b + p.c[kCo];
+    rgb[0] = std::clamp(r, 0, maxVal);
+    rgb[1] = std::clamp(g, 0, maxVal);
+    rgb[2] = std::clamp(b, 0, maxVal);
+}
+
+// 有符号值的补码位数（0 为 0 位，-1 为 1 位）
+inline int signedBits(int v) {
+    return v == 0 ? 0 : std::bit_width(static_cast<unsigned>(v >= 0 ? v : ~v)) + 1;
+}
+
+inline int quantize(int r, int ql) {
+    const int offset = ql ? (1 << (ql - 1)) - 1 : 0;
+    return r >= 0 ? (r + offset) >> ql : -((offset - r) >> ql);
+}
+
+// DSU-VLC：前缀为实际码长超过预测码长的一元码，之后 3 个残差各占 max(实际, 预测) 位
+inline int vlcBits(int required, int predicted) {
+    return required > predicted ? (required - predicted + 1) + 3 * required : 1 + 3 * predicted;
+}
+
+inline int med(int a, int b, int c) {
+    const int mn = std::min(a, b), mx = std::max(a, b);
+    return c >= mx ? mn : (c <= mn ? mx : a + b - c);
+}
+
+struct Params {
+    int bpc = 10;
+    int bpp16 = 128;            // 目标码率，1/16 bpp
+    int qpShift = 4;            // 2*(bpc-8)
+    int maxVal = 1023;
+    int lo[3], hi[3];           // 各分量重建值范围
+    int maxSize[3];
+    int initialDelayPx = 512;   // initial_xmit_delay：4096 / bpp 像素
+};
+
+class SliceEncoder {
+public:
+    SliceEncoder(const Params& p, const uint32_t* px, int picWidth, int picHeight, int x0, int y0, int w, int h)
+        : p_(p), px_(px), picWidth_(picWidth), picHeight_(picHeight), x0_(x0), y0_(y0), w_(w), h_(h) {
+        groups_ = (w + 2) / 3;
+        padded_ = groups_ * 3;
+        for (int c = 0; c < 3; ++c) {
+            src_[c].resize(padded_);
+            cur_[c].resize(padded_);
+            prev_[c].resize(padded_);
+        }
+    }
+
+    SliceStats run() {
+        SliceStats st;
+        st.x = x0_;
+        st.y = y0_;
+        st.width = w_;
+        st.height = h_;
+        const long long totalGroups = static_cast<long long>(groups_) * h_;
+        const double bpg = p_.bpp16 * 3 / 16.0;
+        const double delayBits = p_.initialDelayPx * p_.bpp16 / 16.0;
+        const double finalOffset = kRcModelSize - delayBits;
+        double fullness = 0.0;
+        double peak = 0.0;
+        long long coded = 0, demand = 0, qpSum = 0, ichGroups = 0, bpGroups = 0;
+        int qp = kMinQp8[0] + p_.qpShift;
+        int prevBits = static_cast<int>(bpg);
+        int predSize[3] = {}, prevQl[3] = {}, demandPred[3] = {};
+        long long g = 0;
+
+        for (int line = 0; line < h_; ++line) {
+            loadLine(line);
+            const bool firstLine = line == 0;
+            for (int gx = 0; gx < groups_; ++gx, ++g) {
+                const int x = gx * 3;
+                // 码率控制：rcModelFullness = 缓冲占用 + 变换偏移。偏移抵消初始发送延迟期间的填充，
+                // 并在 slice 内线性升至 final_offset，迫使 slice 末尾排空缓冲
+                const double xformOffset = kInitialOffset - std::min<double>(g * 3.0, p_.initialDelayPx) * p_.bpp16 / 16.0 +
+                                           (finalOffset + delayBits - kInitialOffset) * static_cast<double>(g) / totalGroups;
+                const double model = fullness + xformOffset;
+                int range = 0;
+                while (range < kRanges - 1 && model > kBufThresh[range]) ++range;
+                const double target = bpg + kBpgOffset[range] + (firstLine ? kFirstLineBpgOffset : 0);
+                if (prevBits > target + kTgtOffsetHi) {
+                    qp += prevBits > 2 * target ? 2 : 1;
+                } else if (prevBits < target - kTgtOffsetLo) {
+                    qp -= 1;
+                }
+                qp = std::clamp(qp, kMinQp8[range] + p_.qpShift, kMaxQp8[range] + p_.qpShift);
+                if (range == kRanges - 1) {
+                    // 缓冲即将溢出：QP 强制拉到上限
+                    qp = kMaxQp8[range] + p_.qpShift;
+                    st.forcedQuant++;
+                } else if (range <= kFlatRangeLimit && flat(x)) {
+                    qp = std::min(qp, kFlatnessMinQp8 + p_.qpShift);
+                }
+                const int ql[3] = {std::min(qp >> 1, p_.bpc - 1), std::min(qp ? (qp + 2) >> 1 : 0, p_.bpc),
+                                   std::min(qp ? (qp + 2) >> 1 : 0, p_.bpc)};
+
+                int vec = 0;
+                const bool bp = !firstLine && blockPrediction(x, vec);
+                int regular = 0, demandBits = 0;
+                int required[3], demandReq[3];
+                for (int c = 0; c < 3; ++c) {
+                    required[c] = 0;
+                    demandReq[c] = 0;
+                    for (int i = 0; i < 3; ++i) {
+                        const int xi = x + i;
+                        const int pred = bp ? cur_[c][xi - vec] : mmap(c, xi, firstLine, ql[c]);
+                        const int r = src_[c][xi] - pred;
+                        const int q = quantize(r, ql[c]);
+                        cur_[c][xi] = std::clamp(pred + q * (1 << ql[c]), p_.lo[c], p_.hi[c]);
+                        required[c] = std::max(required[c], signedBits(q));
+                        demandReq[c] = std::max(demandReq[c], signedBits(r));
+                    }
+                    required[c] = std::min(required[c], p_.maxSize[c]);
+                    demandReq[c] = std::min(demandReq[c], p_.maxSize[c]);
+                    // 预测码长随量化级别变化平移
+                    const int predicted = std::clamp(predSize[c] + prevQl[c] - ql[c], 0, p_.maxSize[c]);
+                    regular += vlcBits(required[c], predicted);
+                    demandBits += vlcBits(demandReq[c], demandPred[c]);
+                    demandPred[c] = demandReq[c];
+                }
+
+                // ICH：三个像素都能在历史表中找到误差允许范围内的颜色时，以索引代替残差
+                int bits = regular;
+                const int ichBits = 1 + 3 * kIchIndexBits;
+                int ichIndex[3];
+                if (regular > ichBits && ichLookup(x, ql, ichIndex)) {
+                    bits = ichBits;
+                    ichGroups++;
+                    for (int i = 0; i < 3; ++i) {
+                        const Pixel e = ich_[ichIndex[i]];
+                        for (int c = 0; c < 3; ++c) cur_[c][x + i] = e.c[c];
+                    }
+                    for (int i = 0; i < 3; ++i) ichTouch(Pixel{{cur_[kY][x + i], cur_[kCo][x + i], cur_[kCg][x + i]}});
+                } else {
+                    bpGroups += bp;
+                    for (int i = 0; i < 3; ++i) ichTouch(Pixel{{cur_[kY][x + i], cur_[kCo][x + i], cur_[kCg][x + i]}});
+                }
+                // 码长预测始终跟随常规模式的实际码长（ICH 组也照常计算），避免一次大残差后预测长期偏大
+                for (int c = 0; c < 3; ++c) {
+                    predSize[c] = required[c];
+                    prevQl[c] = ql[c];
+                }
+                // 平坦度标志：每超级组（4 组）1 位
+                if (gx % 4 == 0) bits += 1;
+
+                coded += bits;
+                demand += demandBits;
+                qpSum += qp;
+                st.maxQp = std::max(st.maxQp, qp);
+                prevBits = bits;
+                fullness += bits;
+                if (g * 3 >= p_.initialDelayPx) fullness -= bpg;
+                if (fullness < 0.0) {
+                    // 下溢：编码器插入填充比特
+                    st.padBits += static_cast<long long>(std::ceil(-fullness));
+                    coded += static_cast<long long>(std::ceil(-fullness));
+                    fullness = 0.0;
+                }
+                // 压力按物理缓冲占用计（rcModelFullness 含变换偏移，空闲时也在 75% 左右）
+                peak = std::max(peak, fullness);
+                if (fullness > kRcModelSize) st.overflow++;
+            }
+            storeLine(line, st.maxError);
+        }
+
+        const double pixels = static_cast<double>(w_) * h_;
+        st.demandBpp = demand / pixels;
+        st.codedBpp = coded / pixels;
+        st.avgQp = static_cast<double>(qpSum) / totalGroups;
+        st.peakFullness = peak / kRcModelSize;
+        st.ichPct = 100.0 * ichGroups / totalGroups;
+        st.bpPct = 100.0 * bpGroups / totalGroups;
+        return st;
+    }
+
+private:
+    // slice 的第 line 行（自上而下）转换到 YCoCg，超出 slice 宽度的部分复制最后一个像素
+    void loadLine(int line) {
+        const uint32_t* row = px_ + static_cast<size_t>(picHeight_ - 1 - (y0_ + line)) * picWidth_ + x0_;
+        for (int x = 0; x < padded_; ++x) {
+            const Pixel p = toYCoCg(row[std::min(x, w_ - 1)]);
+            for (int c = 0; c < 3; ++c) src_[c][x] = p.c[c];
+        }
+        if (line == 0) ichCount_ = 0;
+    }
+
+    void storeLine(int line, int& maxError) {
+        const uint32_t* row = px_ + static_cast<size_t>(picHeight_ - 1 - (y0_ + line)) * picWidth_ + x0_;
+        for (int x = 0; x < w_; ++x) {
+            int rgb[3];
+            toRgb(Pixel{{cur_[kY][x], cur_[kCo][x], cur_[kCg][x]}}, p_.maxVal, rgb);
+            for (int c = 0; c < 3; ++c) maxError = std::max(maxError, std::abs(rgb[c] - static_cast<int>((row[x] >> (10 * c)) & 0x3FF)));
+        }
+        for (int c = 0; c < 3; ++c) prev_[c].swap(cur_[c]);
+    }
+
+    // MMAP：上一行经低通滤波后按量化步长限幅混合，再做 MED 预测；slice 首行只有左邻
+    int mmap(int c, int x, bool firstLine, int ql) const {
+        const int mid = c == kY ? (1 << (p_.bpc - 1)) : 0;
+        if (firstLine) return x ? cur_[c][x - 1] : mid;
+        const std::vector<int>& up = prev_[c];
+        const int limit = (1 << ql) >> 1;
+        auto blended = [&](int xi) {
+            const int l = up[std::max(xi - 1, 0)], m = up[xi], r = up[std::min(xi + 1, padded_ - 1)];
+            const int filt = (l + 2 * m + r + 2) >> 2;
+            return m + std::clamp(filt - m, -limit, limit);
+        };
+        const int b = blended(x);
+        const int cc = x ? blended(x - 1) : b;
+        const int a = x ? cur_[c][x - 1] : b;
+        return med(a, b, cc);
+    }
+
+    // BP：在上一行比较各候选向量（向左 3..10 像素）与左邻预测的绝对误差和，向量更优时本组用块预测
+    bool blockPrediction(int x, int& vector) const {
+        int leftSad = 0;
+        for (int i = 0; i < 3; ++i) {
+            for (int c = 0; c < 3; ++c) leftSad += std::abs(prev_[c][x + i] - prev_[c][std::max(x + i - 1, 0)]);
+        }
+        int best = leftSad;
+        vector = 0;
+        for (int v = kBpMinVector; v <= kBpMaxVector && x - v >= 0; ++v) {
+            int sad = 0;
+            for (int i = 0; i < 3; ++i) {
+                for (int c = 0; c < 3; ++c) sad += std::abs(prev_[c][x + i] - prev_[c][x + i - v]);
+            }
+            if (sad < best) {
+                best = sad;
+                vector = v;
+            }
+        }
+        return vector != 0;
+    }
+
+    // 组内三个像素各分量的极差都很小时视为平坦
+    bool flat(int x) const {
+        const int thresh = 2 << (p_.bpc - 8);
+        for (int c = 0; c < 3; ++c) {
+            const int mn = std::min({src_[c][x], src_[c][x + 1], src_[c][x + 2]});
+            const int mx = std::max({src_[c][x], src_[c][x + 1], src_[c][x + 2]});
+            if (mx - mn > thresh) return false;
+        }
+        return true;
+    }
+
+    bool ichLookup(int x, const int ql[3], int index[3]) const {
+        if (ichCount_ == 0) return false;
+        const int limY = (1 << ql[kY]) >> 1, limC = (1 << ql[kCo]) >> 1;
+        for (int i = 0; i < 3; ++i) {
+            int bestErr = INT32_MAX;
+            index[i] = -1;
+            for (int e = 0; e < ichCount_; ++e) {
+                const Pixel& h = ich_[e];
+                const int ey = std::abs(h.c[kY] - src_[kY][x + i]);
+                const int eco = std::abs(h.c[kCo] - src_[kCo][x + i]);
+                const int ecg = std::abs(h.c[kCg] - src_[kCg][x + i]);
+                if (ey > limY || eco > limC || ecg > limC) continue;
+                const int err = 2 * ey + eco + ecg;
+                if (err < bestErr) {
+                    bestErr = err;
+                    index[i] = e;
+                }
+            }
+            if (index[i] < 0) return false;
+        }
+        return true;
+    }
+
+    // 最近使用优先：已在表中则移到表头，否则插入表头并淘汰最旧项
+    void ichTouch(const Pixel& p) {
+        int pos = 0;
+        while (pos < ichCount_ && std::memcmp(&ich_[pos], &p, sizeof(Pixel)) != 0) ++pos;
+        if (pos == ichCount_) {
+            if (ichCount_ < kIchSize) ++ichCount_;
+            pos = ichCount_ - 1;
+        }
+        std::memmove(&ich_[1], &ich_[0], sizeof(Pixel) * pos);
+        ich_[0] = p;
+    }
+
+    const Params& p_;
+    const uint32_t* px_;
+    int picWidth_, picHeight_, x0_, y0_, w_, h_;
+    int groups_ = 0, padded_ = 0;
+    std::vector<int> src_[3], cur_[3], prev_[3];
+    Pixel ich_[kIchSize] = {};
+    int ichCount_ = 0;
+};
+} // namespace
+
+void toYCoCgR(uint32_t px, int ycocg[3]) {
+    const Pixel p = toYCoCg(px);
+    for (int i = 0; i < 3; ++i) ycocg[i] = p.c[i];
+}
+
+uint32_t fromYCoCgR(const int ycocg[3]) {
+    int rgb[3];
+    toRgb(Pixel{{ycocg[kY], ycocg[kCo], ycocg[kCg]}}, 0x3FF, rgb);
+    return static_cast<uint32_t>(rgb[0]) | static_cast<uint32_t>(rgb[1]) << 10 | static_cast<uint32_t>(rgb[2]) << 20;
+}
+
+FrameScore encode(const uint32_t* px, int width, int height, const Config& config) {
+    DHT_TRACE_ZONE("dsc encode");
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    FrameScore score;
+    if (width <= 0 || height <= 0) return score;
+
+    Params p;
+    p.bpc = std::clamp(config.bitsPerComponent, 8, 10);
+    p.qpShift = 2 * (p.bpc - 8);
+    p.maxVal = (1 << p.bpc) - 1;
+    p.bpp16 = std::clamp(static_cast<int>(std::lround(config.bitsPerPixel * 16.0)), 6 * 16, 3 * p.bpc * 16);
+    p.initialDelayPx = 4096 * 16 / p.bpp16;
+    p.lo[kY] = 0;
+    p.hi[kY] = p.maxVal;
+    p.maxSize[kY] = p.bpc;
+    for (int c : {kCo, kCg}) {
+        p.lo[c] = -(1 << p.bpc);
+        p.hi[c] = (1 << p.bpc) - 1;
+        p.maxSize[c] = p.bpc + 1;
+    }
+
+    const int sliceW = config.sliceWidth > 0 ? std::min(config.sliceWidth, width) : (width + 3) / 4;
+    const int sliceH = config.sliceHeight > 0 ? std::min(config.sliceHeight, height) : height;
+    const int cols = (width + sliceW - 1) / sliceW, rows = (height + sliceH - 1) / sliceH;
+    score.slices.resize(static_cast<size_t>(cols) * rows);
+    ThreadPool::shared().parallelFor(score.slices.size(), 1, [&](size_t b, size_t e) {
+        for (size_t s = b; s < e; ++s) {
+            const int sx = static_cast<int>(s % cols) * sliceW, sy = static_cast<int>(s / cols) * sliceH;
+            SliceEncoder enc(p, px, width, height, sx, sy, std::min(sliceW, width - sx), std::min(sliceH, height - sy));
+            score.slices[s] = enc.run();
+        }
+    });
+
+    double pixels = 0.0, groups = 0.0;
+    for (size_t s = 0; s < score.slices.size(); ++s) {
+        const SliceStats& st = score.slices[s];
+        const double n = static_cast<double>(st.width) * st.height;
+        const double ng = static_cast<double>((st.width + 2) / 3) * st.height;
+        pixels += n;
+        groups += ng;
+        score.demandBpp += st.demandBpp * n;
+        score.codedBpp += st.codedBpp * n;
+        score.avgQp += st.avgQp * ng;
+        score.ichPct += st.ichPct * ng;
+        score.bpPct += st.bpPct * ng;
+        score.maxQp = std::max(score.maxQp, st.maxQp);
+        score.forcedQuant += st.forcedQuant;
+        score.overflow += st.overflow;
+        score.maxError = std::max(score.maxError, st.maxError);
+        if (score.worstSlice < 0 || st.peakFullness > score.peakFullness) {
+            score.peakFullness = st.peakFullness;
+            score.worstSlice = static_cast<int>(s);
+        }
+    }
+    score.demandBpp /= pixels;
+    score.codedBpp /= pixels;
+    score.avgQp /= groups;
+    score.ichPct /= groups;
+    score.bpPct /= groups;
+    score.ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+    return score;
+}
+
+} // namespace dsc
+
+DscMonitor::DscMonitor(const dsc::Config& config, std::string logPath) : config_(config), logPath_(std::move(logPath)) {
+    log_.open(logPath_, std::ios::out | std::ios::app);
+    if (log_.is_open() && log_.tellp() == 0) {
+        log_ << "frame,pattern,bpp,slice,x,y,width,height,demand_bpp,coded_bpp,avg_qp,max_qp,peak_fullness_pct,"
+                "forced_quant,overflow,pad_bits,ich_pct,bp_pct,max_error\n";
+    }
+    ring_ = std::make_unique<ReadbackRing>(kSlots, "dsc", [this](const ReadbackRing::Frame& f) { encode(f); });
+}
+
+DscMonitor::~DscMonitor() {
+    ring_.reset();
+}
+
+DscMonitor::Stats DscMonitor::stats() const {
+    Stats st;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        st = stats_;
+    }
+    st.skipped = ring_->skipped();
+    return st;
+}
+
+void DscMonitor::capture(unsigned long long frame, const char* pattern, GLuint fbo, GLenum readBuffer, int width, int height) {
+    DHT_TRACE_ZONE("dsc readback");
+    ring_->capture(frame, pattern, fbo, readBuffer, width, height);
+}
+
+void DscMonitor::encode(const ReadbackRing::Frame& frame) {
+    if (!frame.data) return;
+    dsc::FrameScore score = dsc::encode(frame.data, frame.width, frame.height, config_);
+    if (log_.is_open()) {
+        log_ << std::fixed << std::setprecision(3);
+        for (size_t s = 0; s < score.slices.size(); ++s) {
+            const dsc::SliceStats& st = score.slices[s];
+            log_ << frame.frame << ',' << frame.pattern << ',' << config_.bitsPerPixel << ',' << s << ',' << st.x << ','
+                 << st.y << ',' << st.width << ',' << st.height << ',' << st.demandBpp << ',' << st.codedBpp << ','
+                 << st.avgQp << ',' << st.maxQp << ',' << st.peakFullness * 100.0 << ',' << st.forcedQuant << ','
+                 << st.overflow << ',' << st.padBits << ',' << st.ichPct << ',' << st.bpPct << ',' << st.maxError << '\n';
+        }
+        log_.flush();
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (std::strcmp(stats_.pattern, frame.pattern) != 0) {
+        stats_ = Stats{};
+        std::snprintf(stats_.pattern, sizeof(stats_.pattern), "%s", frame.pattern);
+    }
+    stats_.frames++;
+    stats_.peakFullness = std::max(stats_.peakFullness, score.peakFullness);
+    stats_.forcedQuant += score.forcedQuant;
+    stats_.overflow += score.overflow;
+    stats_.maxDemandBpp = std::max(stats_.maxDemandBpp, score.demandBpp);
+    stats_.last = std::move(score);
+}
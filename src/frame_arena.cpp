@@ -0,0 +1,53 @@
+#include "frame_arena.h"
+
+#include <cstdarg>
+#include <cstdio>
+
+FrameArena::FrameArena(size_t capacity) : buffer_(capacity) {}
+
+void FrameArena::reset() {
+    if (overflowBytes_ > 0) {
+        // 按本帧峰值扩容并留余量，避免逐帧小步增长
+        buffer_.resize((used_ + overflowBytes_) * 2);
+        overflow_.clear();
+        overflowBytes_ = 0;
+    }
+    used_ = 0;
+}
+
+char* FrameArena::allocate(size_t bytes) {
+    if (used_ + bytes <= buffer_.size()) {
+        char* p = buffer_.data() + used_;
+        used_ += bytes;
+        return p;
+    }
+    overflow_.push_back(std::make_unique<char[]>(bytes));
+    overflowBytes_ += bytes;
+    return overflow_.back().get();
+}
+
+std::string_view FrameArena::format(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list probe;
+    va_copy(probe, args);
+    // 先尝试直接写入剩余空间，放不下再按实际长度分配
+    const size_t remaining = buffer_.size() - used_;
+    const int n = std::vsnprintf(buffer_.data() + used_, remaining, fmt, probe);
+    va_end(probe);
+    if (n < 0) {
+        va_end(args);
+        return {};
+    }
+    const size_t len = static_cast<size_t>(n);
+    if (len + 1 <= remaining) {
+        char* p = buffer_.data() + used_;
+        used_ += len + 1;
+        va_end(args);
+        return {p, len};
+    }
+    char* p = allocate(len + 1);
+    std::vsnprintf(p, len + 1, fmt, args);
+    va_end(args);
+    return {p, len};
+}
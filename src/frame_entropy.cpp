@@ -0,0 +1,382 @@
+#include "frame_entropy.h"
+#include "thread_pool.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DHT_HAS_AVX2_PATH 1
+#endif
+
+namespace entropy {
+namespace {
+constexpr int kCodes = 1024;
+constexpr int kSumCount = 8;                // 每段：Rice 码长 x3、平方差 x3、变化像素
+constexpr int kMaxRiceK = 9;                // 折叠残差 < 1024，k 再大只会更长
+
+// 直方图布局 [预测器][通道][码值]；每像素依次写 12 张表，同一地址的相邻自增间隔足够远，无需多副本
+inline uint32_t* table(uint32_t* hist, int predictor, int c) { return hist + (predictor * 3 + c) * kCodes; }
+
+inline uint32_t code(uint32_t px, int c) { return (px >> (10 * c)) & 0x3FF; }
+
+// 10-bit 残差按有符号解释后折叠为非负（0, -1, 1, -2, ... → 0, 1, 2, 3, ...）
+inline uint16_t fold(uint32_t r) {
+    const int32_t s = static_cast<int32_t>(r ^ 512u) - 512;
+    return static_cast<uint16_t>((static_cast<uint32_t>(s) << 1) ^ static_cast<uint32_t>(s >> 31));
+}
+
+// 一行 [x0, x1) 的残差直方图与 MED 折叠残差。边界：首行上邻取左邻，首列左邻/左上取上邻，(0,0) 预测为 0
+void residualScalar(const uint32_t* row, const uint32_t* up, int x0, int x1, uint32_t* hist, uint16_t* const m[3]) {
+    for (int x = x0; x < x1; ++x) {
+        uint32_t pa, pb, pc;
+        if (!up) {
+            pa = x ? row[x - 1] : 0;
+            pb = pc = pa;
+        } else if (x == 0) {
+            pa = pb = pc = up[0];
+        } else {
+            pa = row[x - 1];
+            pb = up[x];
+            pc = up[x - 1];
+        }
+        for (int c = 0; c < 3; ++c) {
+            const uint32_t v = code(row[x], c), a = code(pa, c), b = code(pb, c), tl = code(pc, c);
+            const uint32_t mn = std::min(a, b), mx = std::max(a, b);
+            const uint32_t med = tl >= mx ? mn : (tl <= mn ? mx : a + b - tl);
+            table(hist, kRaw, c)[v]++;
+            table(hist, kLeft, c)[(v - a) & 0x3FF]++;
+            table(hist, kTop, c)[(v - b) & 0x3FF]++;
+            const uint32_t r = (v - med) & 0x3FF;
+            table(hist, kMed, c)[r]++;
+            m[c][x] = fold(r);
+        }
+    }
+}
+
+// 每 kRiceBlock 个样本选最优 k：码长 = Σ(m >> k) + n(k + 1) + 参数位
+uint64_t riceScalar(const uint16_t* m, int n) {
+    uint64_t bits = 0;
+    for (int b = 0; b < n; b += Analyzer::kRiceBlock) {
+        const int len = std::min(Analyzer::kRiceBlock, n - b);
+        uint32_t best = UINT32_MAX;
+        for (int k = 0; k <= kMaxRiceK; ++k) {
+            uint32_t cost = static_cast<uint32_t>(len * (k + 1));
+            for (int i = 0; i < len; ++i) cost += m[b + i] >> k;
+            best = std::min(best, cost);
+        }
+        bits += best + Analyzer::kRiceParamBits;
+    }
+    return bits;
+}
+
+void temporalScalar(const uint32_t* cur, const uint32_t* prev, int n, uint64_t* sq, uint64_t& changed) {
+    for (int i = 0; i < n; ++i) {
+        changed += ((cur[i] ^ prev[i]) & 0x3FFFFFFFu) != 0;
+        for (int c = 0; c < 3; ++c) {
+            const int64_t d = static_cast<int64_t>(code(cur[i], c)) - code(prev[i], c);
+            sq[c] += static_cast<uint64_t>(d * d);
+        }
+    }
+}
+
+#ifdef DHT_HAS_AVX2_PATH
+// 8 像素一组：向量化计算四种预测与折叠残差，直方图自增保持标量（AVX2 无冲突检测）
+__attribute__((target("avx2"))) void residualAvx2(const uint32_t* row, const uint32_t* up, int w, uint32_t* hist,
+                                                   uint16_t* const m[3]) {
+    if (!up || w < 9) return residualScalar(row, up, 0, w, hist, m);
+    residualScalar(row, up, 0, 1, hist, m);
+    const __m256i mask = _mm256_set1_epi32(0x3FF);
+    const __m256i half = _mm256_set1_epi32(512);
+    alignas(32) uint32_t idx[kPredictorCount][8];
+    int x = 1;
+    for (; x + 8 <= w; x += 8) {
+        const __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x));
+        const __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x - 1));
+        const __m256i top = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(up + x));
+        const __m256i topLeft = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(up + x - 1));
+        for (int c = 0; c < 3; ++c) {
+            const __m128i shift = _mm_cvtsi32_si128(10 * c);
+            const __m256i v = _mm256_and_si256(_mm256_srl_epi32(cur, shift), mask);
+            const __m256i a = _mm256_and_si256(_mm256_srl_epi32(left, shift), mask);
+            const __m256i b = _mm256_and_si256(_mm256_srl_epi32(top, shift), mask);
+            const __m256i tl = _mm256_and_si256(_mm256_srl_epi32(topLeft, shift), mask);
+            const __m256i mn = _mm256_min_epi32(a, b), mx = _mm256_max_epi32(a, b);
+            const __m256i grad = _mm256_sub_epi32(_mm256_add_epi32(a, b), tl);
+            // tl > mn ? grad : mx，再 mx > tl ? 上式 : mn（与标量分支顺序一致）
+            const __m256i inner = _mm256_blendv_epi8(mx, grad, _mm256_cmpgt_epi32(tl, mn));
+            const __m256i med = _mm256_blendv_epi8(mn, inner, _mm256_cmpgt_epi32(mx, tl));
+            const __m256i r = _mm256_and_si256(_mm256_sub_epi32(v, med), mask);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(idx[kRaw]), v);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(idx[kLeft]), _mm256_and_si256(_mm256_sub_epi32(v, a), mask));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(idx[kTop]), _mm256_and_si256(_mm256_sub_epi32(v, b), mask));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(idx[kMed]), r);
+            const __m256i s = _mm256_sub_epi32(_mm256_xor_si256(r, half), half);
+            const __m256i z = _mm256_xor_si256(_mm256_slli_epi32(s, 1), _mm256_srai_epi32(s, 31));
+            // 32→16 位打包在 128 位通道内进行，取第 0、2 个 64 位块恢复顺序
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(z, z), 0x08);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(m[c] + x), _mm256_castsi256_si128(packed));
+            for (int p = 0; p < kPredictorCount; ++p) {
+                uint32_t* t = table(hist, p, c);
+                for (int k = 0; k < 8; ++k) t[idx[p][k]]++;
+            }
+        }
+    }
+    residualScalar(row, up, x, w, hist, m);
+}
+
+__attribute__((target("avx2"))) inline uint32_t hsum(__m256i v) {
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(s));
+}
+
+__attribute__((target("avx2"))) uint64_t riceAvx2(const uint16_t* m, int n) {
+    static_assert(Analyzer::kRiceBlock == 32, "riceAvx2 assumes two 16-lane vectors per block");
+    const __m256i ones = _mm256_set1_epi16(1);
+    const int full = n - n % Analyzer::kRiceBlock;
+    uint64_t bits = 0;
+    for (int b = 0; b < full; b += Analyzer::kRiceBlock) {
+        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m + b));
+        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m + b + 16));
+        uint32_t best = UINT32_MAX;
+        for (int k = 0; k <= kMaxRiceK; ++k) {
+            const __m128i shift = _mm_cvtsi32_si128(k);
+            const __m256i s = _mm256_add_epi16(_mm256_srl_epi16(v0, shift), _mm256_srl_epi16(v1, shift));
+            const uint32_t cost = hsum(_mm256_madd_epi16(s, ones)) + static_cast<uint32_t>(Analyzer::kRiceBlock * (k + 1));
+            best = std::min(best, cost);
+        }
+        bits += best + Analyzer::kRiceParamBits;
+    }
+    return bits + riceScalar(m + full, n - full);
+}
+
+__attribute__((target("avx2"))) void temporalAvx2(const uint32_t* cur, const uint32_t* prev, int n, uint64_t* sq,
+                                                   uint64_t& changed) {
+    const __m256i mask = _mm256_set1_epi32(0x3FF);
+    const __m256i rgb = _mm256_set1_epi32(0x3FFFFFFF);
+    const int vecEnd = n & ~7;
+    int i = 0;
+    while (i < vecEnd) {
+        // 单通道平方差 < 2^20，每 2048 组（每通道 16384 项）刷新一次 32 位累加器
+        const int end = std::min(vecEnd, i + 2048 * 8);
+        __m256i acc[3] = {_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+        for (; i < end; i += 8) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + i));
+            const __m256i same = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_xor_si256(a, b), rgb), _mm256_setzero_si256());
+            changed += 8 - __builtin_popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(same))));
+            for (int c = 0; c < 3; ++c) {
+                const __m128i shift = _mm_cvtsi32_si128(10 * c);
+                const __m256i d = _mm256_sub_epi32(_mm256_and_si256(_mm256_srl_epi32(a, shift), mask),
+                                                   _mm256_and_si256(_mm256_srl_epi32(b, shift), mask));
+                acc[c] = _mm256_add_epi32(acc[c], _mm256_mullo_epi32(d, d));
+            }
+        }
+        alignas(32) uint32_t lanes[8];
+        for (int c = 0; c < 3; ++c) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc[c]);
+            for (uint32_t v : lanes) sq[c] += v;
+        }
+    }
+    temporalScalar(cur + vecEnd, prev + vecEnd, n - vecEnd, sq, changed);
+}
+
+bool hasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+#endif
+
+std::atomic<bool> forceScalar{false};
+
+bool useAvx2() {
+#ifdef DHT_HAS_AVX2_PATH
+    return hasAvx2() && !forceScalar.load();
+#else
+    return false;
+#endif
+}
+
+void residualRow(const uint32_t* row, const uint32_t* up, int w, uint32_t* hist, uint16_t* const m[3]) {
+#ifdef DHT_HAS_AVX2_PATH
+    if (useAvx2()) return residualAvx2(row, up, w, hist, m);
+#endif
+    residualScalar(row, up, 0, w, hist, m);
+}
+
+uint64_t riceBits(const uint16_t* m, int n) {
+#ifdef DHT_HAS_AVX2_PATH
+    if (useAvx2()) return riceAvx2(m, n);
+#endif
+    return riceScalar(m, n);
+}
+
+void temporalRow(const uint32_t* cur, const uint32_t* prev, int n, uint64_t* sq, uint64_t& changed) {
+#ifdef DHT_HAS_AVX2_PATH
+    if (useAvx2()) return temporalAvx2(cur, prev, n, sq, changed);
+#endif
+    temporalScalar(cur, prev, n, sq, changed);
+}
+
+// 零阶熵：log2(N) - Σ n·log2(n) / N
+double shannon(const uint32_t* hist, int segments, size_t stride, double total) {
+    double acc = 0.0;
+    for (int v = 0; v < kCodes; ++v) {
+        uint64_t n = 0;
+        for (int s = 0; s < segments; ++s) n += hist[s * stride + v];
+        if (n) acc += static_cast<double>(n) * std::log2(static_cast<double>(n));
+    }
+    return std::log2(total) - acc / total;
+}
+} // namespace
+
+const char* predictorName(int predictor) {
+    static const char* const kNames[kPredictorCount] = {"raw", "left", "top", "MED"};
+    return predictor >= 0 && predictor < kPredictorCount ? kNames[predictor] : "?";
+}
+
+const char* simdPath() {
+    return useAvx2() ? "avx2" : "scalar";
+}
+
+void setForceScalar(bool scalar) { forceScalar.store(scalar); }
+
+FrameStats Analyzer::analyze(const uint32_t* px, int width, int height, const uint32_t* prev) {
+    DHT_TRACE_ZONE("entropy analyze");
+    FrameStats st;
+    if (width <= 0 || height <= 0) return st;
+    const size_t histStride = static_cast<size_t>(kPredictorCount) * 3 * kCodes;
+    hist_.resize(kSegments * histStride);
+    sums_.resize(kSegments * kSumCount);
+    rows_.resize(static_cast<size_t>(kSegments) * 3 * width);
+
+    ThreadPool::shared().parallelFor(kSegments, 1, [&](size_t s0, size_t s1) {
+        for (size_t s = s0; s < s1; ++s) {
+            uint32_t* hist = hist_.data() + s * histStride;
+            uint64_t* sums = sums_.data() + s * kSumCount;
+            std::fill(hist, hist + histStride, 0u);
+            std::fill(sums, sums + kSumCount, 0ull);
+            uint16_t* const m[3] = {rows_.data() + (s * 3 + 0) * width, rows_.data() + (s * 3 + 1) * width,
+                                    rows_.data() + (s * 3 + 2) * width};
+            const int y0 = static_cast<int>(height * s / kSegments), y1 = static_cast<int>(height * (s + 1) / kSegments);
+            for (int y = y0; y < y1; ++y) {
+                const uint32_t* row = px + static_cast<size_t>(y) * width;
+                residualRow(row, y ? row - width : nullptr, width, hist, m);
+                for (int c = 0; c < 3; ++c) sums[c] += riceBits(m[c], width);
+                if (prev) temporalRow(row, prev + static_cast<size_t>(y) * width, width, sums + 3, sums[6]);
+            }
+        }
+    });
+
+    const double total = static_cast<double>(width) * height;
+    uint64_t sums[kSumCount] = {};
+    for (size_t i = 0; i < sums_.size(); ++i) sums[i % kSumCount] += sums_[i];
+    for (int p = 0; p < kPredictorCount; ++p) {
+        for (int c = 0; c < 3; ++c) st.bits[p][c] = shannon(table(hist_.data(), p, c), kSegments, histStride, total);
+    }
+    for (int c = 0; c < 3; ++c) st.riceBits[c] = sums[c] / total;
+    if (prev) {
+        st.temporal = true;
+        for (int c = 0; c < 3; ++c) st.temporalMse[c] = sums[3 + c] / total;
+        st.changed = sums[6] / total;
+    }
+    return st;
+}
+
+} // namespace entropy
+
+FrameEntropy::FrameEntropy(std::string logPath) : logPath_(std::move(logPath)) {
+    log_.open(logPath_, std::ios::out | std::ios::app);
+    if (log_.is_open() && log_.tellp() == 0)
+        log_ << "pattern,frames,width,height,h_raw,h_left,h_top,h_med,rice_bps,ratio,temporal_frames,temporal_mse,changed_pct\n";
+    ring_ = std::make_unique<ReadbackRing>(kSlots, "entropy", [this](const ReadbackRing::Frame& f) { analyze(f); });
+}
+
+FrameEntropy::~FrameEntropy() {
+    ring_.reset();
+    std::lock_guard<std::mutex> lk(mutex_);
+    finishPattern();
+}
+
+FrameEntropy::Stats FrameEntropy::stats() const {
+    Stats st;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        st = stats_;
+    }
+    st.skipped = ring_->skipped();
+    return st;
+}
+
+std::vector<FrameEntropy::PatternResult> FrameEntropy::results() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    std::vector<PatternResult> out = finished_;
+    if (stats_.current.frames) out.push_back(stats_.current);
+    return out;
+}
+
+void FrameEntropy::capture(unsigned long long frame, const char* pattern, GLuint fbo, GLenum readBuffer, int width, int height) {
+    DHT_TRACE_ZONE("entropy readback");
+    ring_->capture(frame, pattern, fbo, readBuffer, width, height);
+}
+
+void FrameEntropy::analyze(const ReadbackRing::Frame& slot) {
+    if (!slot.data) return;
+    {
+        // 图样切换：结束上一图样（写 CSV），时间差分不跨图样
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (stats_.current.frames && std::strcmp(stats_.current.pattern, slot.pattern) != 0) {
+            finishPattern();
+            havePrev_ = false;
+        }
+    }
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    const size_t n = static_cast<size_t>(slot.width) * slot.height;
+    // 只有帧号相邻的两帧才计算差分（中间有跳过时的差异不代表逐帧变化）
+    const bool temporal = havePrev_ && slot.frame == prevFrame_ + 1 && prev_.size() == n;
+    const entropy::FrameStats fs = analyzer_.analyze(slot.data, slot.width, slot.height, temporal ? prev_.data() : nullptr);
+    prev_.assign(slot.data, slot.data + n);
+    prevFrame_ = slot.frame;
+    havePrev_ = true;
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    PatternResult& cur = stats_.current;
+    if (cur.frames == 0) std::snprintf(cur.pattern, sizeof(cur.pattern), "%s", slot.pattern);
+    cur.width = slot.width;
+    cur.height = slot.height;
+    // 逐帧平均（增量形式），三通道取平均
+    const double inv = 1.0 / static_cast<double>(++cur.frames);
+    for (int p = 0; p < entropy::kPredictorCount; ++p) {
+        cur.bits[p] += ((fs.bits[p][0] + fs.bits[p][1] + fs.bits[p][2]) / 3.0 - cur.bits[p]) * inv;
+    }
+    cur.riceBits += ((fs.riceBits[0] + fs.riceBits[1] + fs.riceBits[2]) / 3.0 - cur.riceBits) * inv;
+    if (fs.temporal) {
+        const double tinv = 1.0 / static_cast<double>(++cur.temporalFrames);
+        cur.temporalMse += ((fs.temporalMse[0] + fs.temporalMse[1] + fs.temporalMse[2]) / 3.0 - cur.temporalMse) * tinv;
+        cur.changed += (fs.changed - cur.changed) * tinv;
+    }
+    stats_.last = fs;
+    stats_.lastAnalyzeMs = ms;
+}
+
+void FrameEntropy::finishPattern() {
+    PatternResult& cur = stats_.current;
+    if (cur.frames == 0) return;
+    if (log_.is_open()) {
+        log_ << cur.pattern << ',' << cur.frames << ',' << cur.width << ',' << cur.height << std::fixed << std::setprecision(4);
+        for (double b : cur.bits) log_ << ',' << b;
+        log_ << ',' << cur.riceBits << ',' << cur.ratio() << ',' << cur.temporalFrames << ',' << cur.temporalMse << ','
+             << cur.changed * 100.0 << '\n';
+        log_.flush();
+    }
+    finished_.push_back(cur);
+    cur = PatternResult{};
+}
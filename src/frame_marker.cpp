@@ -0,0 +1,233 @@
+#include "frame_marker.h"
+#include "crc32c.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DHT_HAS_AVX2_PATH 1
+#endif
+
+namespace marker {
+namespace {
+constexpr float kMinContrast = 32.0f;           // 同步块白黑之差下限（8-bit 取样）
+
+// 掩码按起点所在的 4 字节相位旋转，使第 i 个字节对应 mask 的 ((起点 + i) & 3) 字节
+uint32_t alignMask(uint32_t mask, size_t offset) {
+    const int shift = static_cast<int>(offset & 3) * 8;
+    return shift ? (mask >> shift) | (mask << (32 - shift)) : mask;
+}
+
+uint64_t sumScalar(const uint8_t* p, size_t n, uint32_t mask) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i) sum += p[i] & (mask >> ((i & 3) * 8));
+    return sum;
+}
+
+#ifdef DHT_HAS_AVX2_PATH
+// 每 32 字节与掩码后以 SAD 对零求和（4 个 64 位部分和）
+__attribute__((target("avx2"))) uint64_t sumAvx2(const uint8_t* p, size_t n, uint32_t mask) {
+    const __m256i m = _mm256_set1_epi32(static_cast<int>(mask));
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), m);
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, zero));
+    }
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    // 32 字节为 4 的倍数，尾部相位不变
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumScalar(p + i, n - i, mask);
+}
+
+bool hasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+#endif
+
+std::atomic<bool> forceScalar{false};
+
+bool useAvx2() {
+#ifdef DHT_HAS_AVX2_PATH
+    return hasAvx2() && !forceScalar.load();
+#else
+    return false;
+#endif
+}
+
+uint64_t sumMasked(const uint8_t* p, size_t n, uint32_t mask) {
+#ifdef DHT_HAS_AVX2_PATH
+    if (useAvx2()) return sumAvx2(p, n, mask);
+#endif
+    return sumScalar(p, n, mask);
+}
+
+size_t countMasked(size_t n, uint32_t mask) {
+    size_t count = 0;
+    for (int k = 0; k < 4; ++k) {
+        if (!((mask >> (k * 8)) & 0xFFu)) continue;
+        count += n / 4 + (static_cast<size_t>(k) < n % 4);
+    }
+    return count;
+}
+} // namespace
+
+Payload make(uint32_t frame, uint32_t content) {
+    Payload p;
+    p.frame = frame;
+    p.content = content;
+    const uint8_t bytes[8] = {
+        static_cast<uint8_t>(frame), static_cast<uint8_t>(frame >> 8), static_cast<uint8_t>(frame >> 16),
+        static_cast<uint8_t>(frame >> 24), static_cast<uint8_t>(content), static_cast<uint8_t>(content >> 8),
+        static_cast<uint8_t>(content >> 16), static_cast<uint8_t>(content >> 24)};
+    p.crc = crc32c::compute(bytes, sizeof(bytes));
+    return p;
+}
+
+bool valid(const Payload& p) {
+    return make(p.frame, p.content).crc == p.crc;
+}
+
+bool white(const Payload& p, int row, int col) {
+    if (col == 0 || col == kCells - 1) return true;
+    if (col == 1 || col == kCells - 2) return false;
+    const uint32_t word = row == 0 ? p.frame : (row == 1 ? p.content : p.crc);
+    return (word >> (kBits - 1 - (col - 2))) & 1u;
+}
+
+Rect cell(int row, int col, int width, int height) {
+    const long long h = height, w = width;
+    Rect r;
+    r.x0 = static_cast<int>(col * w / kCells);
+    r.x1 = static_cast<int>((col + 1) * w / kCells);
+    r.y0 = static_cast<int>(h - (kRows - row) * h / kHeightDivisor);
+    r.y1 = static_cast<int>(h - (kRows - row - 1) * h / kHeightDivisor);
+    return r;
+}
+
+Rect strip(int width, int height) {
+    const Rect first = cell(0, 0, width, height), last = cell(kRows - 1, kCells - 1, width, height);
+    return Rect{first.x0, first.y0, last.x1, last.y1};
+}
+
+Rect block(int index, int width, int height) {
+    const long long w = width, h = strip(width, height).y0;
+    const int col = index % kBlockCols, row = index / kBlockCols;
+    Rect r;
+    r.x0 = static_cast<int>(col * w / kBlockCols);
+    r.x1 = static_cast<int>((col + 1) * w / kBlockCols);
+    r.y0 = static_cast<int>(row * h / kBlockRows);
+    r.y1 = static_cast<int>((row + 1) * h / kBlockRows);
+    return r;
+}
+
+uint32_t signature(const float mean[kBlocks]) {
+    uint32_t word = 0;
+    for (int i = 0; i < kBlocks; ++i) {
+        const float q = std::floor(std::clamp(mean[i], 0.0f, 1.0f) * kBlockLevels + 0.5f);
+        word = (word << 4) | static_cast<uint32_t>(q);
+    }
+    return word;
+}
+
+int blockLevel(uint32_t content, int index) {
+    return static_cast<int>((content >> ((kBlocks - 1 - index) * 4)) & 0xFu);
+}
+
+void measure(const uint8_t* image, int width, int height, size_t stride, const Layout& layout,
+             float level[kRows][kCells]) {
+    const size_t bpp = static_cast<size_t>(layout.bytesPerPixel);
+    for (int row = 0; row < kRows; ++row) {
+        for (int col = 0; col < kCells; ++col) {
+            // 只取中心一半，避开缩放/色度插值造成的边缘过渡
+            const Rect r = cell(row, col, width, height);
+            const int qx = (r.x1 - r.x0) / 4, qy = (r.y1 - r.y0) / 4;
+            const size_t offset = (r.x0 + qx) * bpp;
+            const size_t bytes = static_cast<size_t>(r.x1 - r.x0 - 2 * qx) * bpp;
+            const uint32_t mask = alignMask(layout.mask, offset);
+            uint64_t sum = 0;
+            for (int y = r.y0 + qy; y < r.y1 - qy; ++y) sum += sumMasked(image + y * stride + offset, bytes, mask);
+            const size_t count = countMasked(bytes, mask) * static_cast<size_t>(r.y1 - r.y0 - 2 * qy);
+            level[row][col] = count ? static_cast<float>(static_cast<double>(sum) / count) : 0.0f;
+        }
+    }
+}
+
+bool decode(const float level[kRows][kCells], Payload& out) {
+    uint32_t words[kRows];
+    for (int row = 0; row < kRows; ++row) {
+        const float* l = level[row];
+        if (l[0] - l[1] < kMinContrast) return false;
+        const float threshold = (l[0] + l[1]) * 0.5f;
+        if (l[kCells - 1] < threshold || l[kCells - 2] >= threshold) return false;
+        uint32_t word = 0;
+        for (int b = 0; b < kBits; ++b) word = (word << 1) | (l[2 + b] >= threshold ? 1u : 0u);
+        words[row] = word;
+    }
+    out.frame = words[0];
+    out.content = words[1];
+    out.crc = words[2];
+    return true;
+}
+
+void measureBlocks(const uint8_t* image, int width, int height, size_t stride, const Layout& layout,
+                   float mean[kBlocks]) {
+    const size_t bpp = static_cast<size_t>(layout.bytesPerPixel);
+    const bool rgb = layout.rgb[0] >= 0;
+    for (int i = 0; i < kBlocks; ++i) {
+        const Rect r = block(i, width, height);
+        const size_t offset = r.x0 * bpp;
+        const size_t bytes = static_cast<size_t>(r.x1 - r.x0) * bpp;
+        double sum = 0.0;
+        if (rgb) {
+            // RGB 采集：逐像素按 BT.709 加权（与生成端签名同一亮度定义）
+            for (int y = r.y0; y < r.y1; ++y) {
+                const uint8_t* p = image + y * stride + offset;
+                uint64_t sr = 0, sg = 0, sb = 0;
+                for (int x = r.x0; x < r.x1; ++x, p += bpp) {
+                    sr += p[layout.rgb[0]];
+                    sg += p[layout.rgb[1]];
+                    sb += p[layout.rgb[2]];
+                }
+                sum += 0.2126 * sr + 0.7152 * sg + 0.0722 * sb;
+            }
+            const size_t count = static_cast<size_t>(r.x1 - r.x0) * static_cast<size_t>(r.y1 - r.y0);
+            mean[i] = count ? static_cast<float>(sum / count) : 0.0f;
+        } else {
+            const uint32_t mask = alignMask(layout.mask, offset);
+            uint64_t total = 0;
+            for (int y = r.y0; y < r.y1; ++y) total += sumMasked(image + y * stride + offset, bytes, mask);
+            const size_t count = countMasked(bytes, mask) * static_cast<size_t>(r.y1 - r.y0);
+            mean[i] = count ? static_cast<float>(static_cast<double>(total) / count) : 0.0f;
+        }
+    }
+}
+
+int contentMismatches(uint32_t content, const float level[kRows][kCells], const float mean[kBlocks], float tolerance) {
+    // 黑/白电平取各行首尾同步块的平均（采集端限幅 16..235 时据此还原 0..1）
+    float black = 0.0f, white = 0.0f;
+    for (int row = 0; row < kRows; ++row) {
+        white += level[row][0] + level[row][kCells - 1];
+        black += level[row][1] + level[row][kCells - 2];
+    }
+    white /= 2 * kRows;
+    black /= 2 * kRows;
+    if (white - black < kMinContrast) return kBlocks;
+    int mismatches = 0;
+    for (int i = 0; i < kBlocks; ++i) {
+        const float measured = (mean[i] - black) / (white - black) * kBlockLevels;
+        if (std::fabs(measured - blockLevel(content, i)) > tolerance + 0.5f) mismatches++;
+    }
+    return mismatches;
+}
+
+const char* simdPath() {
+    return useAvx2() ? "avx2" : "scalar";
+}
+
+void setForceScalar(bool scalar) { forceScalar.store(scalar); }
+
+} // namespace marker
@@ -0,0 +1,248 @@
+#include "gl_debug.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+
+namespace gldebug {
+namespace {
+
+struct Message {
+    GLenum source;
+    GLenum type;
+    GLenum severity;
+    GLuint id;
+    unsigned long long frame;
+    char text[256];
+};
+
+// 有界 MPMC 队列（每槽序号，Vyukov）：回调可能在驱动线程并发调用，写入端不加锁、不分配
+constexpr size_t kQueueSize = 256;  // 2 的幂
+struct Slot {
+    std::atomic<size_t> seq;
+    Message msg;
+};
+Slot gQueue[kQueueSize];
+std::atomic<size_t> gHead{0};       // 下一个写入位置
+std::atomic<size_t> gTail{0};       // 下一个读取位置
+
+std::atomic<uint64_t> gByType[kTypeCount];
+std::atomic<uint64_t> gBySeverity[kSeverityCount];
+std::atomic<uint64_t> gDropped{0};
+std::atomic<unsigned long long> gFrame{0};
+bool gActive = false;
+bool gDebugContext = false;
+GLint gMaxLength = 0;               // GL_MAX_DEBUG_MESSAGE_LENGTH（含结尾 0）
+
+constexpr unsigned kPrintLimit = 3; // 同一 (来源, id) 只打印前几次，避免逐帧刷屏
+// 已打印次数：定长开放寻址表（线性探测），帧循环中不分配；表满后新出现的 id 不再打印（计数不受影响）
+constexpr size_t kPrintedSize = 512;    // 2 的幂
+struct PrintedEntry {
+    uint64_t key = 0;                   // 0 = 空（来源枚举非 0，有效键不为 0）
+    unsigned count = 0;
+};
+PrintedEntry gPrinted[kPrintedSize];
+size_t gPrintedUsed = 0;
+
+// 返回键对应的计数；表满且键不存在时返回 nullptr
+unsigned* printedCount(uint64_t key) {
+    size_t i = static_cast<size_t>((key ^ (key >> 29)) * 0x9E3779B97F4A7C15ull >> 32) & (kPrintedSize - 1);
+    for (size_t probe = 0; probe < kPrintedSize; ++probe, i = (i + 1) & (kPrintedSize - 1)) {
+        PrintedEntry& e = gPrinted[i];
+        if (e.key == key) return &e.count;
+        if (e.key == 0) {
+            // 保留一个空位使探测总能终止
+            if (gPrintedUsed + 1 >= kPrintedSize) return nullptr;
+            e.key = key;
+            ++gPrintedUsed;
+            return &e.count;
+        }
+    }
+    return nullptr;
+}
+
+void initQueue() {
+    for (size_t i = 0; i < kQueueSize; ++i) gQueue[i].seq.store(i, std::memory_order_relaxed);
+}
+
+bool push(const Message& m) {
+    size_t pos = gHead.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = gQueue[pos & (kQueueSize - 1)];
+        const size_t seq = slot.seq.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (gHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.msg = m;
+                slot.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;           // 队列已满
+        } else {
+            pos = gHead.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool pop(Message& out) {
+    size_t pos = gTail.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = gQueue[pos & (kQueueSize - 1)];
+        const size_t seq = slot.seq.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (gTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                out = slot.msg;
+                slot.seq.store(pos + kQueueSize, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;           // 队列为空
+        } else {
+            pos = gTail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+int severityIndex(GLenum severity) {
+    switch (severity) {
+        case GL_DEBUG_SEVERITY_HIGH:   return 0;
+        case GL_DEBUG_SEVERITY_MEDIUM: return 1;
+        case GL_DEBUG_SEVERITY_LOW:    return 2;
+        default:                       return 3;
+    }
+}
+
+const char* severityName(GLenum severity) {
+    static const char* const kNames[kSeverityCount] = {"high", "medium", "low", "notification"};
+    return kNames[severityIndex(severity)];
+}
+
+const char* sourceName(GLenum source) {
+    switch (source) {
+        case GL_DEBUG_SOURCE_API:             return "api";
+        case GL_DEBUG_SOURCE_WINDOW_SYSTEM:   return "window-system";
+        case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader-compiler";
+        case GL_DEBUG_SOURCE_THIRD_PARTY:     return "third-party";
+        case GL_DEBUG_SOURCE_APPLICATION:     return "application";
+        default:                              return "other";
+    }
+}
+
+void GLAPIENTRY onMessage(GLenum source, GLenum type, GLuint id, GLenum severity,
+                          GLsizei length, const GLchar* message, const void*) {
+    gByType[typeIndex(type)].fetch_add(1, std::memory_order_relaxed);
+    gBySeverity[severityIndex(severity)].fetch_add(1, std::memory_order_relaxed);
+    Message m;
+    m.source = source;
+    m.type = type;
+    m.severity = severity;
+    m.id = id;
+    m.frame = gFrame.load(std::memory_order_relaxed);
+    const size_t n = length < 0 ? std::strlen(message) : static_cast<size_t>(length);
+    const size_t copy = n < sizeof(m.text) - 1 ? n : sizeof(m.text) - 1;
+    std::memcpy(m.text, message, copy);
+    m.text[copy] = '\0';
+    if (!push(m)) gDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+bool install() {
+    gActive = false;
+    if (!(GLEW_VERSION_4_3 || GLEW_KHR_debug)) return false;
+    GLint flags = 0;
+    glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+    gDebugContext = (flags & GL_CONTEXT_FLAG_DEBUG_BIT) != 0;
+    glGetIntegerv(GL_MAX_DEBUG_MESSAGE_LENGTH, &gMaxLength);
+    initQueue();
+    glDebugMessageCallback(onMessage, nullptr);
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+    // 自身的调试组与标记不回传
+    glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_PUSH_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+    glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_POP_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+    glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_MARKER, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+    // 异步回调：不强制 GL_DEBUG_OUTPUT_SYNCHRONOUS，避免驱动串行化拖慢高帧率循环
+    glEnable(GL_DEBUG_OUTPUT);
+    gActive = true;
+    return true;
+}
+
+bool active() { return gActive; }
+
+bool debugContext() { return gDebugContext; }
+
+void setFrame(unsigned long long frame) { gFrame.store(frame, std::memory_order_relaxed); }
+
+FrameResult drain() {
+    FrameResult r;
+    if (!gActive) return r;
+    Message m;
+    while (pop(m)) {
+        ++r.messages;
+        if (m.type == GL_DEBUG_TYPE_PERFORMANCE) {
+            ++r.performance;
+            r.performanceFrame = m.frame;
+        }
+        if (m.type == GL_DEBUG_TYPE_ERROR) ++r.errors;
+        // 应用插入的消息已由调用方打印；通知级只计数（部分驱动逐帧报告缓冲信息）
+        if (m.source == GL_DEBUG_SOURCE_APPLICATION) continue;
+        if (m.severity == GL_DEBUG_SEVERITY_NOTIFICATION && m.type != GL_DEBUG_TYPE_PERFORMANCE) continue;
+        const uint64_t key = (static_cast<uint64_t>(m.source) << 32) | m.id;
+        unsigned* slot = printedCount(key);
+        if (!slot || *slot >= kPrintLimit) continue;
+        const unsigned printed = ++*slot;
+        std::cerr << "[GL " << typeName(typeIndex(m.type)) << "/" << severityName(m.severity) << " "
+                  << sourceName(m.source) << " #" << m.id << " @frame " << m.frame << "] " << m.text
+                  << (printed == kPrintLimit ? " (further repeats suppressed)" : "") << std::endl;
+    }
+    return r;
+}
+
+Totals totals() {
+    Totals t;
+    for (int i = 0; i < kTypeCount; ++i) t.byType[i] = gByType[i].load(std::memory_order_relaxed);
+    for (int i = 0; i < kSeverityCount; ++i) t.bySeverity[i] = gBySeverity[i].load(std::memory_order_relaxed);
+    t.dropped = gDropped.load(std::memory_order_relaxed);
+    return t;
+}
+
+int typeIndex(GLenum type) {
+    switch (type) {
+        case GL_DEBUG_TYPE_ERROR:               return 0;
+        case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return 1;
+        case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:  return 2;
+        case GL_DEBUG_TYPE_PORTABILITY:         return 3;
+        case GL_DEBUG_TYPE_PERFORMANCE:         return 4;
+        case GL_DEBUG_TYPE_MARKER:              return 5;
+        case GL_DEBUG_TYPE_PUSH_GROUP:          return 6;
+        case GL_DEBUG_TYPE_POP_GROUP:           return 7;
+        default:                                return 8;
+    }
+}
+
+const char* typeName(int index) {
+    static const char* const kNames[kTypeCount] = {"error", "deprecated", "undefined", "portability",
+                                                   "performance", "marker", "push-group", "pop-group", "other"};
+    return (index >= 0 && index < kTypeCount) ? kNames[index] : "?";
+}
+
+void insert(GLenum type, GLenum severity, const char* text) {
+    if (!gActive) return;
+    // 超过 GL_MAX_DEBUG_MESSAGE_LENGTH 会被拒绝（GL_INVALID_VALUE），截断插入
+    const size_t limit = gMaxLength > 1 ? static_cast<size_t>(gMaxLength - 1) : 0;
+    const size_t n = std::min(std::strlen(text), limit);
+    if (n > 0) glDebugMessageInsert(GL_DEBUG_SOURCE_APPLICATION, type, 0, severity, static_cast<GLsizei>(n), text);
+}
+
+Group::Group(const char* name) : pushed_(gActive) {
+    if (pushed_) glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+}
+
+Group::~Group() {
+    if (pushed_) glPopDebugGroup();
+}
+
+} // namespace gldebug
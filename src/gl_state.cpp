@@ -0,0 +1,180 @@
+#include "gl_state.h"
+
+GLState& GLState::get() {
+    static GLState state;
+    return state;
+}
+
+void GLState::invalidate() {
+    program_ = kUnknown;
+    vao_ = kUnknown;
+    for (auto& b : buffers_) b = kUnknown;
+    drawFbo_ = readFbo_ = kUnknown;
+    activeUnit_ = kUnknown;
+    for (auto& t : textures2D_) t = kUnknown;
+    for (auto& c : caps_) c = -1;
+    blendSrc_ = blendDst_ = kUnknown;
+    vpKnown_ = false;
+}
+
+void GLState::beginFrame() {
+    last_ = cur_;
+    cur_ = Counters();
+}
+
+int GLState::capSlot(GLenum cap) {
+    switch (cap) {
+        case GL_BLEND: return 0;
+        case GL_DEPTH_TEST: return 1;
+        case GL_DITHER: return 2;
+        case GL_SCISSOR_TEST: return 3;
+        case GL_CULL_FACE: return 4;
+        case GL_FRAMEBUFFER_SRGB: return 5;
+    }
+    return -1;
+}
+
+int GLState::bufferSlot(GLenum target) {
+    // GL_ELEMENT_ARRAY_BUFFER 属于 VAO 状态，不缓存
+    switch (target) {
+        case GL_ARRAY_BUFFER: return 0;
+        case GL_UNIFORM_BUFFER: return 1;
+        case GL_PIXEL_PACK_BUFFER: return 2;
+        case GL_PIXEL_UNPACK_BUFFER: return 3;
+        case GL_COPY_READ_BUFFER: return 4;
+        case GL_COPY_WRITE_BUFFER: return 5;
+    }
+    return -1;
+}
+
+void GLState::setCap(GLenum cap, bool on) {
+    int slot = capSlot(cap);
+    if (slot >= 0 && caps_[slot] == (on ? 1 : 0)) { cur_.skipped++; return; }
+    if (on) glEnable(cap); else glDisable(cap);
+    if (slot >= 0) caps_[slot] = on ? 1 : 0;
+    cur_.stateChanges++;
+}
+
+void GLState::useProgram(GLuint program) {
+    if (program_ == program) { cur_.skipped++; return; }
+    glUseProgram(program);
+    program_ = program;
+    cur_.stateChanges++;
+}
+
+void GLState::bindVertexArray(GLuint vao) {
+    if (vao_ == vao) { cur_.skipped++; return; }
+    glBindVertexArray(vao);
+    vao_ = vao;
+    cur_.stateChanges++;
+}
+
+void GLState::bindBuffer(GLenum target, GLuint buffer) {
+    int slot = bufferSlot(target);
+    if (slot >= 0 && buffers_[slot] == buffer) { cur_.skipped++; return; }
+    glBindBuffer(target, buffer);
+    if (slot >= 0) buffers_[slot] = buffer;
+    cur_.stateChanges++;
+}
+
+void GLState::bindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    // 同时改变通用绑定点
+    glBindBufferBase(target, index, buffer);
+    int slot = bufferSlot(target);
+    if (slot >= 0) buffers_[slot] = buffer;
+    cur_.stateChanges++;
+}
+
+void GLState::bindFramebuffer(GLenum target, GLuint fbo) {
+    bool draw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+    bool read = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+    if ((!draw || drawFbo_ == fbo) && (!read || readFbo_ == fbo)) { cur_.skipped++; return; }
+    glBindFramebuffer(target, fbo);
+    if (draw) drawFbo_ = fbo;
+    if (read) readFbo_ = fbo;
+    cur_.stateChanges++;
+}
+
+void GLState::activeTexture(GLenum unit) {
+    if (activeUnit_ == unit) { cur_.skipped++; return; }
+    glActiveTexture(unit);
+    activeUnit_ = unit;
+    cur_.stateChanges++;
+}
+
+void GLState::bindTexture(GLenum target, GLuint texture) {
+    int unit = activeUnit_ == kUnknown ? -1 : static_cast<int>(activeUnit_ - GL_TEXTURE0);
+    bool cached = target == GL_TEXTURE_2D && unit >= 0 && unit < kTextureUnits;
+    if (cached && textures2D_[unit] == texture) { cur_.skipped++; return; }
+    glBindTexture(target, texture);
+    if (cached) textures2D_[unit] = texture;
+    cur_.stateChanges++;
+}
+
+void GLState::blendFunc(GLenum src, GLenum dst) {
+    if (blendSrc_ == src && blendDst_ == dst) { cur_.skipped++; return; }
+    glBlendFunc(src, dst);
+    blendSrc_ = src;
+    blendDst_ = dst;
+    cur_.stateChanges++;
+}
+
+void GLState::viewport(GLint x, GLint y, GLsizei w, GLsizei h) {
+    if (vpKnown_ && vp_[0] == x && vp_[1] == y && vp_[2] == w && vp_[3] == h) { cur_.skipped++; return; }
+    glViewport(x, y, w, h);
+    vp_[0] = x; vp_[1] = y; vp_[2] = w; vp_[3] = h;
+    vpKnown_ = true;
+    cur_.stateChanges++;
+}
+
+void GLState::forgetBuffer(GLuint buffer) {
+    for (auto& b : buffers_) if (b == buffer) b = 0;
+}
+
+void GLState::forgetTexture(GLuint texture) {
+    for (auto& t : textures2D_) if (t == texture) t = 0;
+}
+
+void GLState::forgetVertexArray(GLuint vao) {
+    if (vao_ == vao) vao_ = 0;
+}
+
+void GLState::forgetProgram(GLuint program) {
+    // 删除当前程序时 GL 保持其生效直至切换，置为未知以确保下次 use 真正下发
+    if (program_ == program) program_ = kUnknown;
+}
+
+void GLState::forgetFramebuffer(GLuint fbo) {
+    if (drawFbo_ == fbo) drawFbo_ = 0;
+    if (readFbo_ == fbo) readFbo_ = 0;
+}
+
+void GLState::clear(GLbitfield mask) {
+    glClear(mask);
+    cur_.draws++;
+}
+
+void GLState::drawArrays(GLenum mode, GLint first, GLsizei count) {
+    glDrawArrays(mode, first, count);
+    cur_.draws++;
+}
+
+void GLState::drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances) {
+    glDrawArraysInstanced(mode, first, count, instances);
+    cur_.draws++;
+}
+
+void GLState::drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    glDrawElements(mode, count, type, indices);
+    cur_.draws++;
+}
+
+void GLState::bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    glBufferData(target, size, data, usage);
+    countUpload(static_cast<size_t>(size));
+}
+
+void GLState::bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    glBufferSubData(target, offset, size, data);
+    countUpload(static_cast<size_t>(size));
+}
@@ -0,0 +1,184 @@
+#include "display_backend.h"
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+class GlfwBackend : public DisplayBackend {
+public:
+    ~GlfwBackend() override {
+        if (window_) glfwDestroyWindow(window_);
+        if (initialized_) glfwTerminate();
+    }
+
+    bool create(const Options& options) override {
+        glfwSetErrorCallback(errorCallback);
+        if (!glfwInit()) return false;
+        initialized_ = true;
+
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, options.debugContext ? GLFW_TRUE : GLFW_FALSE);
+#ifdef __APPLE__
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+
+        // 获取主显示器
+        GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+        const GLFWvidmode* current = glfwGetVideoMode(monitor);
+
+        // 选取当前分辨率下的最高刷新率，避免固定为 60Hz 的情况
+        int bestRefresh = current ? current->refreshRate : 60;
+        int bestW = current ? current->width : 1920;
+        int bestH = current ? current->height : 1080;
+        int count = 0;
+        const GLFWvidmode* modes = glfwGetVideoModes(monitor, &count);
+        if (modes && count > 0 && current) {
+            for (int i = 0; i < count; ++i) {
+                if (modes[i].width == current->width && modes[i].height == current->height) {
+                    if (modes[i].refreshRate > bestRefresh) bestRefresh = modes[i].refreshRate;
+                }
+            }
+        }
+        refreshHz_ = bestRefresh;
+        monitor_ = monitor;
+        fullscreenW_ = bestW;
+        fullscreenH_ = bestH;
+
+        // 提示首选刷新率（独占全屏时有效）
+        glfwWindowHint(GLFW_REFRESH_RATE, bestRefresh);
+
+        // 指定尺寸时使用窗口模式，否则在主显示器上全屏
+        const bool windowed = options.width > 0 && options.height > 0;
+        width_ = windowed ? options.width : bestW;
+        height_ = windowed ? options.height : bestH;
+        if (windowed) {
+            windowedW_ = options.width;
+            windowedH_ = options.height;
+        }
+        fullscreen_ = !windowed;
+        // 显式请求每通道位数：不设置时多数平台默认 8-bit，10-bit 内容在输出前被静默截断。
+        // 位数提示是软约束，GLFW 总会选最接近的格式而不会因此创建失败，实际位深以 loadGL 查询为准
+        setColorHints(options.colorBits);
+        window_ = glfwCreateWindow(width_, height_, "Display Hardware Test", windowed ? nullptr : monitor, nullptr);
+        if (!window_) return false;
+
+        glfwMakeContextCurrent(window_);
+        glfwGetFramebufferSize(window_, &width_, &height_);
+
+        glfwSetWindowUserPointer(window_, this);
+        glfwSetKeyCallback(window_, keyCallback);
+        glfwSetFramebufferSizeCallback(window_, framebufferSizeCallback);
+
+        // 根据设置启用/禁用垂直同步
+        glfwSwapInterval(options.vsync ? 1 : 0);
+        return true;
+    }
+
+    bool loadGL() override {
+        if (glewInit() != GLEW_OK) return false;
+        // 像素格式提示只是请求，实际位数以附件查询为准（合成器/驱动可能给出更低位深）
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLint bits[3] = {0, 0, 0};
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE, &bits[0]);
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_GREEN_SIZE, &bits[1]);
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_BLUE_SIZE, &bits[2]);
+        const int minBits = std::min({bits[0], bits[1], bits[2]});
+        colorBits_ = minBits > 0 ? minBits : 8;
+        GLint type = GL_NONE;
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE, &type);
+        colorFloat_ = type == GL_FLOAT;
+        return true;
+    }
+
+    bool shouldClose() const override { return glfwWindowShouldClose(window_); }
+    void requestClose() override { glfwSetWindowShouldClose(window_, true); }
+    void swapBuffers() override { glfwSwapBuffers(window_); }
+    void pollEvents() override { glfwPollEvents(); }
+    void setSwapInterval(int interval) override {
+        glfwMakeContextCurrent(window_);
+        glfwSwapInterval(interval);
+    }
+    bool supportsAdaptiveVsync() const override {
+        return glfwExtensionSupported("GLX_EXT_swap_control_tear") || glfwExtensionSupported("WGL_EXT_swap_control_tear");
+    }
+    bool setFullscreen(bool fullscreen) override {
+        if (!monitor_) return false;
+        if (fullscreen == fullscreen_) return true;
+        if (fullscreen) {
+            glfwSetWindowMonitor(window_, monitor_, 0, 0, fullscreenW_, fullscreenH_, refreshHz_);
+        } else {
+            glfwSetWindowMonitor(window_, nullptr, 100, 100, windowedW_, windowedH_, GLFW_DONT_CARE);
+        }
+        fullscreen_ = fullscreen;
+        // 尺寸回调在下一次事件处理时才到达，这里同步一次
+        glfwGetFramebufferSize(window_, &width_, &height_);
+        if (resizeHandler_) resizeHandler_(width_, height_);
+        return true;
+    }
+    bool fullscreen() const override { return fullscreen_; }
+    bool isKeyDown(int key) const override { return glfwGetKey(window_, key) == GLFW_PRESS; }
+
+    int width() const override { return width_; }
+    int height() const override { return height_; }
+    GLuint defaultFramebuffer() const override { return 0; }
+    GLenum readBuffer() const override { return GL_BACK; }
+    int colorBits() const override { return colorBits_; }
+    bool colorFloat() const override { return colorFloat_; }
+    int refreshRateHz() const override { return refreshHz_; }
+    std::string name() const override {
+#ifdef _WIN32
+        return "Win32";
+#else
+        if (std::getenv("WAYLAND_DISPLAY")) return "Wayland";
+        return std::getenv("DISPLAY") ? "X11" : "Unknown";
+#endif
+    }
+    bool headless() const override { return false; }
+
+private:
+    // GLFW 没有浮点像素格式提示：16 位请求只能匹配平台按 16 bpc 提供的格式，实际类型以 loadGL 查询为准。
+    // ≥12 位时不约束 alpha，避免 alpha 位数差距把格式匹配拉向颜色位更低的配置
+    static void setColorHints(int bits) {
+        glfwWindowHint(GLFW_RED_BITS, bits);
+        glfwWindowHint(GLFW_GREEN_BITS, bits);
+        glfwWindowHint(GLFW_BLUE_BITS, bits);
+        glfwWindowHint(GLFW_ALPHA_BITS, bits >= 12 ? GLFW_DONT_CARE : (bits >= 10 ? 2 : 8));
+    }
+    static void keyCallback(GLFWwindow* window, int key, int /*scancode*/, int action, int /*mods*/) {
+        auto* self = static_cast<GlfwBackend*>(glfwGetWindowUserPointer(window));
+        if (self && self->keyHandler_) self->keyHandler_(key, action);
+    }
+    static void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
+        auto* self = static_cast<GlfwBackend*>(glfwGetWindowUserPointer(window));
+        if (!self) return;
+        self->width_ = width;
+        self->height_ = height;
+        if (self->resizeHandler_) self->resizeHandler_(width, height);
+    }
+    static void errorCallback(int error, const char* description) {
+        std::cerr << "GLFW error " << error << ": " << description << std::endl;
+    }
+
+    GLFWwindow* window_ = nullptr;
+    GLFWmonitor* monitor_ = nullptr;
+    bool initialized_ = false;
+    int width_ = 0;
+    int height_ = 0;
+    int refreshHz_ = 0;
+    int colorBits_ = 8;
+    bool colorFloat_ = false;
+    int fullscreenW_ = 0;
+    int fullscreenH_ = 0;
+    int windowedW_ = 1280;        // 以全屏启动时切回窗口所用尺寸
+    int windowedH_ = 720;
+    bool fullscreen_ = false;
+};
+} // namespace
+
+std::unique_ptr<DisplayBackend> createGlfwBackend() {
+    return std::make_unique<GlfwBackend>();
+}
@@ -0,0 +1,233 @@
+#include "display_backend.h"
+
+#ifdef HAS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+namespace {
+bool hasExtension(const char* list, const char* name) {
+    if (!list) return false;
+    const size_t n = std::strlen(name);
+    for (const char* p = list; (p = std::strstr(p, name)) != nullptr; p += n) {
+        if ((p == list || p[-1] == ' ') && (p[n] == ' ' || p[n] == '\0')) return true;
+    }
+    return false;
+}
+
+// 无头后端：EGL surfaceless 上下文 + 离屏 FBO 作为“默认帧缓冲”
+class EglHeadlessBackend : public DisplayBackend {
+public:
+    ~EglHeadlessBackend() override {
+        if (context_ != EGL_NO_CONTEXT) {
+            for (GLsync& f : fences_) if (f) glDeleteSync(f);
+            if (fbo_) glDeleteFramebuffers(1, &fbo_);
+            if (color_) glDeleteRenderbuffers(1, &color_);
+            eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            eglDestroyContext(display_, context_);
+        }
+        if (display_ != EGL_NO_DISPLAY) eglTerminate(display_);
+    }
+
+    bool create(const Options& options) override {
+        width_ = options.width > 0 ? options.width : 1920;
+        height_ = options.height > 0 ? options.height : 1080;
+        swapInterval_ = options.vsync ? 1 : 0;
+        requestedBits_ = options.colorBits;
+
+        if (!openDisplay()) {
+            std::cerr << "EGL: no usable display (surfaceless/device/default)" << std::endl;
+            return false;
+        }
+        if (!hasExtension(eglQueryString(display_, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context")) {
+            std::cerr << "EGL: EGL_KHR_surfaceless_context not supported" << std::endl;
+            return false;
+        }
+        if (!eglBindAPI(EGL_OPENGL_API)) return false;
+
+        const EGLint configAttrs[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+        EGLConfig config = nullptr;
+        EGLint numConfigs = 0;
+        if (!eglChooseConfig(display_, configAttrs, &config, 1, &numConfigs) || numConfigs == 0) {
+            config = nullptr; // EGL_KHR_no_config_context
+        }
+        // EGL_CONTEXT_OPENGL_DEBUG 为 EGL 1.5 属性，仅在请求调试上下文时传入
+        EGLint contextAttrs[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE, EGL_NONE,
+            EGL_NONE
+        };
+        if (options.debugContext) {
+            contextAttrs[6] = EGL_CONTEXT_OPENGL_DEBUG;
+            contextAttrs[7] = EGL_TRUE;
+        }
+        context_ = eglCreateContext(display_, config, EGL_NO_CONTEXT, contextAttrs);
+        if (context_ == EGL_NO_CONTEXT) {
+            std::cerr << "EGL: failed to create a GL 3.3 core context" << std::endl;
+            return false;
+        }
+        return eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, context_) == EGL_TRUE;
+    }
+
+    bool loadGL() override {
+        // glewInit 依赖 GLX/WGL 当前上下文，surfaceless 下只加载 GL 入口
+        glewExperimental = GL_TRUE;
+        if (glewContextInit() != GLEW_OK) return false;
+
+        glGenRenderbuffers(1, &color_);
+        glGenFramebuffers(1, &fbo_);
+        glBindRenderbuffer(GL_RENDERBUFFER, color_);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+        // 与窗口后端一致：按请求位数分配，不完整时逐级回退（RGBA16F → RGBA12 → RGB10_A2 → RGBA8）
+        struct Candidate { int bits; GLenum format; const char* name; };
+        static const Candidate kCandidates[] = {
+            {16, GL_RGBA16F, "RGBA16F"}, {12, GL_RGBA12, "RGBA12"}, {10, GL_RGB10_A2, "RGB10_A2"}};
+        bool complete = false;
+        for (const Candidate& c : kCandidates) {
+            if (c.bits > requestedBits_) continue;
+            complete = attachColor(c.format);
+            if (complete) break;
+            std::cerr << "EGL: " << c.name << " framebuffer incomplete, falling back" << std::endl;
+        }
+        if (!complete && !attachColor(GL_RGBA8)) {
+            std::cerr << "EGL: offscreen framebuffer incomplete" << std::endl;
+            return false;
+        }
+        GLint bits[3] = {0, 0, 0};
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE, &bits[0]);
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_GREEN_SIZE, &bits[1]);
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_BLUE_SIZE, &bits[2]);
+        const int minBits = std::min({bits[0], bits[1], bits[2]});
+        colorBits_ = minBits > 0 ? minBits : 8;
+        GLint type = GL_NONE;
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE, &type);
+        colorFloat_ = type == GL_FLOAT;
+        nextVblank_ = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    bool shouldClose() const override { return closeRequested_; }
+    void requestClose() override { closeRequested_ = true; }
+
+    void swapBuffers() override {
+        // 模拟双缓冲交换链：最多 kFramesInFlight 帧在途，避免 CPU 无限超前于 GPU
+        GLsync& slot = fences_[fenceIndex_];
+        if (slot) {
+            glClientWaitSync(slot, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+            glDeleteSync(slot);
+        }
+        slot = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        fenceIndex_ = (fenceIndex_ + 1) % kFramesInFlight;
+        glFlush();
+
+        // 垂直同步开启时按模拟刷新率节拍呈现，保持帧率控制路径与窗口模式一致
+        if (swapInterval_ > 0) {
+            const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(static_cast<double>(swapInterval_) / kRefreshHz));
+            auto now = std::chrono::steady_clock::now();
+            nextVblank_ += period;
+            if (nextVblank_ < now) nextVblank_ = now; // 落后时重新对齐，不补帧
+            std::this_thread::sleep_until(nextVblank_);
+        }
+    }
+
+    void pollEvents() override {}
+    void setSwapInterval(int interval) override { swapInterval_ = interval; }
+    bool supportsAdaptiveVsync() const override { return false; }
+    bool setFullscreen(bool) override { return false; }
+    bool fullscreen() const override { return false; }
+    bool isKeyDown(int) const override { return false; }
+
+    int width() const override { return width_; }
+    int height() const override { return height_; }
+    GLuint defaultFramebuffer() const override { return fbo_; }
+    GLenum readBuffer() const override { return GL_COLOR_ATTACHMENT0; }
+    int colorBits() const override { return colorBits_; }
+    bool colorFloat() const override { return colorFloat_; }
+    int refreshRateHz() const override { return kRefreshHz; }
+    std::string name() const override { return std::string("Headless (") + displayKind_ + ")"; }
+    bool headless() const override { return true; }
+
+private:
+    bool attachColor(GLenum internalFormat) {
+        glRenderbufferStorage(GL_RENDERBUFFER, internalFormat, width_, height_);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color_);
+        return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    bool openDisplay() {
+        const char* clientExt = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        // 1) Mesa surfaceless 平台（llvmpipe / 无显示器的 DRM 节点）
+        if (getPlatformDisplay && hasExtension(clientExt, "EGL_MESA_platform_surfaceless")) {
+            display_ = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display_ != EGL_NO_DISPLAY && eglInitialize(display_, nullptr, nullptr)) {
+                displayKind_ = "EGL surfaceless";
+                return true;
+            }
+        }
+        // 2) EGL 设备平台（NVIDIA 等专有驱动的无头节点）
+        auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+        if (getPlatformDisplay && queryDevices && hasExtension(clientExt, "EGL_EXT_platform_device")) {
+            EGLDeviceEXT devices[8];
+            EGLint count = 0;
+            if (queryDevices(8, devices, &count)) {
+                for (EGLint i = 0; i < count; ++i) {
+                    display_ = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, devices[i], nullptr);
+                    if (display_ != EGL_NO_DISPLAY && eglInitialize(display_, nullptr, nullptr)) {
+                        displayKind_ = "EGL device";
+                        return true;
+                    }
+                }
+            }
+        }
+        // 3) 默认显示
+        display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (display_ != EGL_NO_DISPLAY && eglInitialize(display_, nullptr, nullptr)) {
+            displayKind_ = "EGL default";
+            return true;
+        }
+        display_ = EGL_NO_DISPLAY;
+        return false;
+    }
+
+    static constexpr int kFramesInFlight = 2;
+    static constexpr int kRefreshHz = 60;
+
+    EGLDisplay display_ = EGL_NO_DISPLAY;
+    EGLContext context_ = EGL_NO_CONTEXT;
+    const char* displayKind_ = "EGL";
+    GLuint fbo_ = 0;
+    GLuint color_ = 0;
+    GLsync fences_[kFramesInFlight] = {};
+    int fenceIndex_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    int swapInterval_ = 0;
+    int requestedBits_ = 10;
+    int colorBits_ = 8;
+    bool colorFloat_ = false;
+    bool closeRequested_ = false;
+    std::chrono::steady_clock::time_point nextVblank_;
+};
+} // namespace
+
+std::unique_ptr<DisplayBackend> createHeadlessBackend() {
+    return std::make_unique<EglHeadlessBackend>();
+}
+
+#else
+
+std::unique_ptr<DisplayBackend> createHeadlessBackend() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+// 堆分配计数（可选）：以 -DDHT_ALLOC_TRACKING=ON 构建时替换全局 operator new/delete，
+// 按线程累计分配次数与字节数；未启用时 enabled() 为 false，计数恒为 0
+namespace alloc {
+
+struct Counters {
+    uint64_t allocs = 0;
+    uint64_t frees = 0;
+    uint64_t bytes = 0;     // 累计申请字节数
+};
+
+bool enabled();
+// 当前线程的累计计数（帧首尾相减得到每帧分配）
+Counters threadCounters();
+
+} // namespace alloc
@@ -0,0 +1,61 @@
+#pragma once
+#include "readback_ring.h"
+#include <GL/glew.h>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// 异步回读校验（C 切换）：把最终画面（整帧或固定采样块）经 ReadbackRing 读入 PBO 环，
+// 围栏就绪后（通常数帧之后）才映射，不阻塞渲染线程；后台线程对映射内存计算 CRC32C 并逐帧写日志。
+// 同一确定性画面在 GPU 正常时校验和恒定，可与采集端比对，区分“GPU 输出错误”与“链路错误”。
+class AsyncReadback {
+public:
+    enum class Mode { Off = 0, Tiles = 1, Full = 2 };
+    static constexpr int kModeCount = 3;
+    static constexpr int kSlots = 4;        // 在途回读上限；环满时本帧跳过（计入 skipped）
+    static constexpr int kTileGrid = 4;     // 采样块：4x4 均匀分布
+    static constexpr int kTileSize = 64;
+
+    struct Stats {
+        unsigned long long logged = 0;      // 已写入日志的帧
+        unsigned long long skipped = 0;     // 环满未能回读的帧
+        unsigned long long lastFrame = 0;   // 最近一次校验对应的帧号
+        uint32_t lastCrc = 0;
+        unsigned lastLag = 0;               // 回读发起到映射之间的帧数
+        double lastHashMs = 0.0;            // 后台计算校验和耗时
+        size_t lastBytes = 0;
+    };
+
+    // logPath 在首次启用时打开（追加写 CSV 表头）
+    explicit AsyncReadback(std::string logPath);
+    ~AsyncReadback();
+
+    // 在最终画面（缩放后、覆盖层前）调用：回收已完成的槽、映射已就绪的槽，再对 fbo 发起本帧回读。
+    // pattern 为日志中的图样标签（如 "D:14"）；channelBits >= 10 时按 2_10_10_10_REV 读取
+    void capture(unsigned long long frame, const char* pattern, GLuint fbo, GLenum readBuffer,
+                 int width, int height, int channelBits);
+
+    Mode mode() const { return mode_; }
+    void setMode(Mode mode) { mode_ = mode; }
+    void cycleMode() { mode_ = static_cast<Mode>((static_cast<int>(mode_) + 1) % kModeCount); }
+    static const char* modeName(Mode mode, bool zh);
+    const std::string& logPath() const { return logPath_; }
+    bool logOpen() const { return log_.is_open(); }
+    Stats stats() const;
+
+private:
+    void hash(const ReadbackRing::Frame& frame);
+
+    Mode mode_ = Mode::Off;
+    mutable std::mutex mutex_;
+    std::string logPath_;
+    std::ofstream log_;                     // 仅后台线程写入
+    Stats stats_;
+    // 最后声明：析构时先停止后台线程
+    std::unique_ptr<ReadbackRing> ring_;
+
+    AsyncReadback(const AsyncReadback&) = delete;
+    AsyncReadback& operator=(const AsyncReadback&) = delete;
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include "readback_ring.h"
+#include <GL/glew.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// 码值覆盖分析（G 切换）：最终画面以 2_10_10_10_REV 异步回读（PBO 环 + 围栏，渲染线程不等待），
+// 后台线程统计每通道 1024 码值直方图、未用码值数，以及相邻两帧间每个位的翻转比例。
+// 用于证明图样确实覆盖全部 10-bit 码值且低位逐帧变化；帧缓冲只有 8 bit 时只会出现 256 个码值。
+class CodeCoverage {
+public:
+    static constexpr int kSlots = 3;        // 在途回读上限；环满时本帧跳过（翻转统计只取相邻帧对）
+    static constexpr int kCodes = 1024;
+    static constexpr int kBits = 10;
+    static constexpr int kSegments = 16;    // 每帧切成的并行段数（交给共享线程池）
+    static constexpr int kHistCopies = 4;   // 每段直方图副本数
+
+    struct Stats {
+        unsigned long long frames = 0;      // 自重置以来分析的帧
+        unsigned long long pairs = 0;       // 其中帧号相邻的帧对（参与翻转统计）
+        unsigned long long skipped = 0;     // 环满未能回读的帧
+        unsigned long long lastFrame = 0;
+        int frameUsed[3] = {};              // 最近一帧各通道出现的码值数
+        int totalUsed[3] = {};              // 自重置以来累计出现的码值数
+        int minCode[3] = {};                // 累计最小/最大码值
+        int maxCode[3] = {};
+        double toggle[3][kBits] = {};       // 各通道各位的平均翻转比例（0..1，位 0 为 LSB）
+        double lastAnalyzeMs = 0.0;
+        int width = 0, height = 0;
+    };
+
+    CodeCoverage();
+
+    // 在最终画面（缩放后、覆盖层前）调用：回收/映射已完成的槽，再对 fbo 发起本帧整帧回读
+    void capture(unsigned long long frame, GLuint fbo, GLenum readBuffer, int width, int height);
+    // 清空累计直方图与翻转计数（切换图样时调用）
+    void reset();
+    Stats stats() const;
+    // 直方图/翻转计数内核（"avx2" / "scalar"）
+    static const char* simdPath();
+
+private:
+    void onFrame(const ReadbackRing::Frame& frame);
+    void analyze(const ReadbackRing::Frame& frame);
+
+    mutable std::mutex mutex_;
+    bool resetRequested_ = false;
+    unsigned long long resetFrom_ = 0;      // 重置后只分析此帧号及以后的帧
+    unsigned long long lastCapture_ = 0;
+
+    // 以下仅后台线程访问
+    std::vector<uint32_t> partialHist_;     // 各段局部直方图 kSegments x kHistCopies x 3 x kCodes
+    std::vector<uint64_t> partialBits_;     // 各段相邻帧异或结果中各位为 1 的像素数 kSegments x 32
+    std::vector<uint32_t> prev_;            // 上一分析帧（计算翻转）
+    unsigned long long prevFrame_ = 0;
+    bool havePrev_ = false;
+    std::vector<uint64_t> total_;           // 累计直方图 3 x kCodes
+    uint64_t toggleCount_[3][kBits] = {};
+    uint64_t togglePixels_ = 0;
+
+    Stats stats_;
+    // 最后声明：析构时先停止后台线程
+    std::unique_ptr<ReadbackRing> ring_;
+
+    CodeCoverage(const CodeCoverage&) = delete;
+    CodeCoverage& operator=(const CodeCoverage&) = delete;
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+
+// CPU 参考光栅器：patterns.cpp 中全部静态/动态图样（及辅助背景）的 C++ 移植。
+// 用途：与 GPU 回读做黄金图比对、无 GL 环境下生成参考帧、CPU 吞吐基准（tools/dht_cpuref）。
+// 整数哈希类图样有 AVX2 内核（运行时检测，否则标量），画面按块分配到共享线程池（工作窃取）并行渲染。
+namespace cpuraster {
+
+// 与 FrameBlock 对应的每帧参数
+struct Frame {
+    int width = 0;
+    int height = 0;
+    float time = 0.0f;          // uTime
+    uint32_t frameIndex = 0;    // uFrameIndex（主程序取低 31 位）
+};
+
+// 渲染一帧到 out（width * height 个像素，第 0 行为画面底部，与 glReadPixels 行序一致）。
+// 每像素为打包 10-bit 码值 R | G<<10 | B<<20 | 3<<30，与 GL_UNSIGNED_INT_2_10_10_10_REV 回读布局一致
+void render(int category, int index, const Frame& frame, uint32_t* out);
+
+// 整数运算图样：与 RGB10_A2 目标上的 GPU 输出应逐位一致；其余图样含三角函数/插值，按容差比较
+bool bitExact(int category, int index);
+// 当前内核路径（"avx2" / "scalar"）
+const char* simdPath();
+// 强制使用标量内核（基准对比 AVX2 加速比）
+void setForceScalar(bool scalar);
+
+} // namespace cpuraster
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// CRC32C（Castagnoli）：x86 上 SSE4.2 可用时用 crc32 指令（三路交错），否则查表（slicing-by-8）。
+// 回读校验和与采集端校验共用，两端结果逐位一致。
+namespace crc32c {
+
+// seed 为上一段的返回值时可分段累加
+uint32_t compute(const void* data, size_t bytes, uint32_t seed = 0);
+// 当前使用的实现（"sse4.2" / "table"）
+const char* implementation();
+// 强制使用查表实现（测试两种实现一致、基准对比）
+void setForceTable(bool table);
+
+} // namespace crc32c
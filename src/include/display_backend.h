@@ -0,0 +1,65 @@
+#pragma once
+#include <GL/glew.h>
+#include <functional>
+#include <memory>
+#include <string>
+
+// 显示后端：负责创建 GL 3.3 core 上下文、默认帧缓冲、呈现与输入事件。
+// 图样、帧率控制与统计代码只依赖此接口，在窗口与无头环境下走同一路径。
+class DisplayBackend {
+public:
+    struct Options {
+        int width = 0;            // 0 = 取显示器当前分辨率（无头后端默认 1920x1080）
+        int height = 0;
+        bool vsync = false;
+        bool debugContext = false; // 请求 GL 调试上下文（KHR_debug 完整报告，驱动可能略慢）
+        int colorBits = 10;        // 请求的每通道位数：16 = FP16（RGBA16F），12、10 = RGB10_A2，8 = RGBA8；不可用时逐级回退
+    };
+    // 键码沿用 GLFW_KEY_* / GLFW_PRESS 取值
+    using KeyHandler = std::function<void(int key, int action)>;
+    using ResizeHandler = std::function<void(int width, int height)>;
+
+    virtual ~DisplayBackend() = default;
+
+    virtual bool create(const Options& options) = 0;
+    // 上下文当前后加载 GL 函数指针
+    virtual bool loadGL() = 0;
+
+    virtual bool shouldClose() const = 0;
+    virtual void requestClose() = 0;
+    virtual void swapBuffers() = 0;
+    virtual void pollEvents() = 0;
+    virtual void setSwapInterval(int interval) = 0;
+    // 是否支持自适应垂直同步（交换间隔 -1，EXT_swap_control_tear）
+    virtual bool supportsAdaptiveVsync() const = 0;
+    // 窗口/全屏切换（无头后端不支持，返回 false）
+    virtual bool setFullscreen(bool fullscreen) = 0;
+    virtual bool fullscreen() const = 0;
+    virtual bool isKeyDown(int key) const = 0;
+
+    virtual int width() const = 0;
+    virtual int height() const = 0;
+    // 最终呈现的帧缓冲（窗口为 0，无头为离屏 FBO）及其读取缓冲
+    virtual GLuint defaultFramebuffer() const = 0;
+    virtual GLenum readBuffer() const = 0;
+    // 默认帧缓冲每通道位数：loadGL 后以 glGetFramebufferAttachmentParameteriv 查询的实际值（RGB 取最小）
+    virtual int colorBits() const = 0;
+    // 默认帧缓冲是否为浮点（FP16，scRGB 式输出）
+    virtual bool colorFloat() const = 0;
+    // 显示器刷新率（未知为 0）
+    virtual int refreshRateHz() const = 0;
+    virtual std::string name() const = 0;
+    virtual bool headless() const = 0;
+
+    void setKeyHandler(KeyHandler handler) { keyHandler_ = std::move(handler); }
+    void setResizeHandler(ResizeHandler handler) { resizeHandler_ = std::move(handler); }
+
+protected:
+    KeyHandler keyHandler_;
+    ResizeHandler resizeHandler_;
+};
+
+// GLFW 全屏窗口后端（主显示器，取当前分辨率下最高刷新率）
+std::unique_ptr<DisplayBackend> createGlfwBackend();
+// EGL surfaceless 无头后端，渲染到离屏 FBO；未编译 EGL 支持时返回 nullptr
+std::unique_ptr<DisplayBackend> createHeadlessBackend();
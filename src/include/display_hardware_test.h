@@ -1,18 +1,57 @@
 #pragma once
 #include <GL/glew.h>
-#include <GLFW/glfw3.h>
 #include <memory>
 #include <chrono>
 #include <string>
+#include <string_view>
 #include <fstream>
+#include <vector>
+#include "shader.h"
+#include "patterns.h"
+#include "frame_arena.h"
 
-class Shader;
 class TextRenderer;
+class DisplayBackend;
+class PhiloxVerifier;
+class RenderTarget;
+class DrawStress;
+class UploadStream;
+class AsyncReadback;
+class CodeCoverage;
+class FrameEntropy;
+class DscMonitor;
+class VramTest;
+class MarkerRenderer;
 
 enum class TestMode { FIXED_FPS, JITTER_FPS, OSCILLATION_FPS, UNLIMITED_FPS };
 enum class Category { STATIC_GROUP = 0, DYNAMIC_GROUP = 1, AUX_GROUP = 2 };
 enum class Language { ZH = 0, EN = 1 };
 
+// 启动参数（命令行）
+struct LaunchOptions {
+    bool headless = false;               // 无头模式：EGL surfaceless + 离屏帧缓冲
+    int width = 0;                       // 0 = 显示器分辨率（无头默认 1920x1080）
+    int height = 0;
+    unsigned long long maxFrames = 0;    // 渲染指定帧数后退出，0 = 不限
+    bool presentBench = false;           // 呈现路径基准（空图样），maxFrames 为每种配置的帧数
+    std::string traceOut;                // 退出时导出时间线（Chrome trace JSON），空 = 不导出
+    double traceSeconds = 10.0;          // 导出最近 N 秒（F9 与 traceOut 共用）
+    bool glDebug = false;                // 请求 GL 调试上下文（KHR_debug 完整报告性能警告）
+    int checksumMode = 0;                // 启动即开启回读校验：0 关, 1 采样块, 2 整帧（AsyncReadback::Mode）
+    std::string checksumLog;             // 校验和日志路径，空 = dht_crc_<时间戳>.csv
+    int colorBits = 10;                  // 请求的默认帧缓冲每通道位数（8 / 10 / 12 / 16 = FP16，不可用时逐级回退）
+    bool coverage = false;               // 启动即开启码值覆盖分析（G 切换）
+    bool entropy = false;                // 启动即开启熵/可压缩性估计（E 切换）
+    std::string entropyLog;              // 每图样熵估计结果，空 = dht_entropy_<时间戳>.csv
+    double dscBpp = 0.0;                 // 启动即开启 DSC 模型（D 切换）的目标码率，0 = 不开启（D 开启时用 8）
+    int dscSliceWidth = 0;               // DSC slice 尺寸，0 = 宽度四等分 / 高度 108
+    int dscSliceHeight = 0;
+    std::string dscLog;                  // 逐 slice DSC 模型结果，空 = dht_dsc_<时间戳>.csv
+    bool marker = false;                 // 启动即绘制帧标记条（B 切换）
+    int memtestMib = 0;                  // 启动即开启显存完整性压力（M 切换）的容量，0 = 不开启（M 开启时用 256）
+    std::string memtestLog;              // 逐次显存校验结果，空 = dht_memtest_<时间戳>.csv
+};
+
 struct TestConfig {
     int minFps = 30;
     int maxFps = 144;
@@ -28,10 +67,16 @@ struct TestConfig {
 };
 
 class MonitorTest {
+    // tools/dht_microbench.cpp：对覆盖层构建、帧率计算、输入处理等 CPU 热路径单独计时
+    friend struct MicrobenchAccess;
+
 private:
-    GLFWwindow* window;
+    std::unique_ptr<DisplayBackend> backend;
+    LaunchOptions launch;
     std::unique_ptr<Shader> shader;
+    UniformInt uColorVariation;
     GLuint VAO, VBO;
+    GLuint frameUbo = 0;             // FrameBlock 的 uniform buffer
     TestConfig config;
     std::chrono::high_resolution_clock::time_point startTime;
     std::chrono::high_resolution_clock::time_point lastFrameTime;
@@ -44,13 +89,30 @@ private:
     unsigned long long frameIndex;
     int windowWidth;
     int windowHeight;
-    static const std::string vertexShaderSource;
-    static const std::string fragmentShaderSource;
     std::unique_ptr<TextRenderer> textRenderer;
     void renderStatusOverlay();
+    // 文本视图指向字面量或 frameArena，仅在本帧有效
+    struct OverlayLine { std::string_view txt; float r, g, b; bool extraGap; };
+    struct ControlItem { std::string_view key; std::string_view desc; };
+    const std::vector<OverlayLine>& buildOverlayLines();
+    const std::vector<ControlItem>& buildControlItems();
+    FrameArena frameArena;           // 帧内临时字符串，每帧开始时 reset
+    std::vector<OverlayLine> overlayLines;
+    std::vector<ControlItem> controlItems;
+    std::string backendName;         // 初始化时缓存，避免每帧构造
+    // 堆分配统计（DHT_ALLOC_TRACKING 构建时有效）
+    unsigned long long lastFrameAllocs = 0;
+    unsigned long long lastFrameAllocBytes = 0;
+    unsigned long long intervalMaxAllocs = 0;
+    // KHR_debug：出现驱动性能警告（重编译/停顿/缓冲迁移等）的帧
+    unsigned long long perfFlaggedFrames = 0;
+    unsigned long long lastPerfFlaggedFrame = 0;
+    unsigned long long intervalPerfMessages = 0;
+    void drainGlDebug();
     std::string chooseFontPath() const;
     Language language = Language::ZH;
     bool minimalOverlay = false;
+    bool glStatsOverlay = false;     // F3：显示每帧 GL 调用统计
     bool useDynamicFrameRange = false;
     bool extremeMode = false;
     bool dynamicOscillation = false; // true=OSC, false=JITTER
@@ -60,7 +122,7 @@ private:
 public:
     MonitorTest();
     ~MonitorTest();
-    bool initialize();
+    bool initialize(const LaunchOptions& options = LaunchOptions());
     void run();
     void cleanup();
     static Language detectLanguage();
@@ -76,13 +138,69 @@ private:
     void updateFrameRate();
     double calculateTargetFps();
     void reportFps();
-    static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
-    static void framebufferSizeCallback(GLFWwindow* window, int width, int height);
-    static void errorCallback(int error, const char* description);
+    static void keyCallback(MonitorTest* test, int key, int action);
+    static void framebufferSizeCallback(MonitorTest* test, int width, int height);
     void printControls() const;
     void printSystemInfo() const;
+    void runNoiseHashBench();
+    void runPresentBench();
+    void dumpTrace(const std::string& path);
+    // 比较图样与配置快照，变化时触发 USDT 探针 pattern_change / config_change（见 probes.h）
+    void fireChangeProbes(unsigned long long seq);
+    struct ProbedConfig {
+        int targetFps = -1, minFps = -1, maxFps = -1;
+        unsigned flags = 0;
+        bool operator==(const ProbedConfig&) const = default;
+    };
+    int probedPattern = -1;
+    ProbedConfig probedConfig;
+    std::string hashBenchSummary;    // 最近一次哈希自检摘要（覆盖层显示）
+    void samplePhiloxFrame();
+    std::unique_ptr<PhiloxVerifier> philoxVerifier;
+    bool philoxVerifyEnabled = false;
+    int framebufferRedBits = 8;      // 默认帧缓冲每通道位数（附件查询的实际值，可能低于 launch.colorBits）
+    bool framebufferFloat = false;   // 默认帧缓冲为 FP16
+    // 高熵生成器的量化位数：输出与当前渲染目标都能承载 12 bpc 时为 12，否则 10
+    int patternQuantBits(bool offscreen) const;
+    // 内部分辨率离屏渲染（R/T 切换）；返回本帧是否渲染到离屏目标
+    bool updateRenderTarget();
+    const char* internalResName() const;
+    std::unique_ptr<RenderTarget> renderTarget;
+    int internalResIndex = 0;        // 0=原生, 1=2x, 2=4K, 3=8K, 4=16K
+    int internalFormatIndex = 1;     // RenderTarget::Format，默认 RGB10_A2
+    // 绘制调用压力场景（A:1）；[ / ] 调整对象数，I 切换提交方式。首次进入该图样时创建
+    std::unique_ptr<DrawStress> drawStress;
+    bool drawStressActive() const;
+    // 上传带宽场景（A:2）；U 切换上传路径，Y 切换 RGBA8/RGB10_A2。首次进入该图样时创建
+    std::unique_ptr<UploadStream> uploadStream;
+    bool uploadStreamActive() const;
+    // 异步回读校验（C 切换 关/采样块/整帧）：最终画面的 CRC32C 逐帧写入 CSV。首次开启时创建
+    std::unique_ptr<AsyncReadback> checksumReadback;
+    void setChecksumMode(int mode);
+    void sampleChecksum();
+    // 码值覆盖分析（G 切换）：最终画面各通道码值直方图与逐位翻转率。开启时创建，关闭时释放
+    std::unique_ptr<CodeCoverage> codeCoverage;
+    int coveragePattern = -1;        // 当前统计的图样（cat*256+sub），切换图样时清空累计
+    void setCoverageEnabled(bool enabled);
+    void sampleCoverage();
+    void printCoverageReport() const;
+    // 熵/可压缩性估计（E 切换）：最终画面的残差熵、Rice 码长与帧间差分，按图样写 CSV。开启时创建，关闭时释放
+    std::unique_ptr<FrameEntropy> frameEntropy;
+    void setEntropyEnabled(bool enabled);
+    void printEntropyRanking() const;
+    // DSC 1.2a 编码器模型（D 切换）：最终画面按 slice 并行编码，报告码率需求、缓冲压力与强制量化。开启时创建，关闭时释放
+    std::unique_ptr<DscMonitor> dscMonitor;
+    void setDscEnabled(bool enabled);
+    // 帧标记条（B 切换）：覆盖层之后在画面底部绘制帧号/内容签名/CRC 色块，供 dht_capture_verify 采集端校验。开启时创建，关闭时释放
+    std::unique_ptr<MarkerRenderer> frameMarker;
+    void setMarkerEnabled(bool enabled);
+    // 显存完整性压力（M 切换）：每帧校验/重写一个显存块，不匹配计数按帧号写 CSV。开启时分配，关闭时释放
+    std::unique_ptr<VramTest> vramTest;
+    void setMemtestEnabled(bool enabled);
+    // 图样标签（S/D/A:序号），与覆盖层一致，供回读日志按图样筛选
+    void patternLabel(char (&out)[8]) const;
     const char* tr(const char* zh, const char* en) const;
-    std::string onOff(bool v) const;
+    const char* onOff(bool v) const;
     void toggleLanguage();
     std::chrono::high_resolution_clock::time_point lastLoopTime;
     // Key repeat states for fast adjustments
@@ -0,0 +1,43 @@
+#pragma once
+#include <GL/glew.h>
+#include <memory>
+#include "shader.h"
+
+// 绘制调用压力场景（辅助图样 A:1）：N 个小方块，逐个提交以放大 CPU 提交与驱动开销。
+// 其余图样都只有一次全屏绘制，测不到 CPU 端的帧时间尖峰（VRR 下常见的卡顿来源）。
+class DrawStress {
+public:
+    // 提交方式：单次实例化绘制 / N 次绘制 / N 次绘制且每次修改 uniform
+    enum class Submit { Instanced = 0, Draws = 1, DrawsWithUniforms = 2 };
+    static constexpr int kSubmitCount = 3;
+
+    DrawStress();
+    ~DrawStress();
+
+    // 绘制到当前绑定的帧缓冲与视口；返回本次 CPU 提交耗时（毫秒，不含 GPU 执行）
+    double render(float time, int width, int height);
+
+    int objectCount() const;
+    // 在预设档位（1k..200k）间前后切换
+    void stepObjectCount(int delta);
+    Submit submit() const { return submit_; }
+    void cycleSubmit();
+    // 提交耗时（指数平滑，毫秒）
+    double submitMs() const { return submitMs_; }
+    static const char* submitName(Submit submit, bool zh);
+
+private:
+    std::unique_ptr<Shader> shader_;
+    GLuint vao_ = 0;                 // 无顶点属性：位置由 gl_VertexID/gl_InstanceID 生成
+    UniformInt uMode_;
+    UniformInt uObject_;
+    UniformInt uCount_;
+    UniformFloat uTime_;
+    UniformFloat uAspect_;
+    int countIndex_ = 3;             // 默认 10k
+    Submit submit_ = Submit::Draws;
+    double submitMs_ = 0.0;
+
+    DrawStress(const DrawStress&) = delete;
+    DrawStress& operator=(const DrawStress&) = delete;
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include "readback_ring.h"
+#include <GL/glew.h>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// VESA DSC 1.2a 编码器模型：按 DSC 的结构对 10-bit 帧做 YCoCg-R 变换、按 slice 切分，
+// 每组 3 像素选择 MMAP / BP / ICH 预测，按 QP 量化，以 DSU-VLC 码长和码率缓冲模型驱动码率控制。
+// 目的是给图样打分（哪些内容逼高 QP、挤满码率缓冲），并非逐位一致的合规编码器（不输出码流）。
+namespace dsc {
+
+struct Config {
+    int bitsPerComponent = 10;
+    double bitsPerPixel = 8.0;      // 目标码率（按 1/16 bpp 取整）
+    int sliceWidth = 0;             // 0 = 画面宽度四等分
+    int sliceHeight = 108;          // 0 = 整个画面高度
+};
+
+struct SliceStats {
+    int x = 0, y = 0, width = 0, height = 0;
+    double demandBpp = 0.0;         // 以最低 QP 编码所需的比特/像素（内容本身的码率需求）
+    double codedBpp = 0.0;          // 码率控制后实际产生的比特/像素（含下溢填充）
+    double avgQp = 0.0;
+    int maxQp = 0;
+    double peakFullness = 0.0;      // 码率缓冲峰值占用（相对 rc_model_size，>1 即溢出）
+    int forcedQuant = 0;            // 缓冲进入最高区间、QP 被强制拉到上限的组数
+    int overflow = 0;               // 缓冲超出 rc_model_size 的组数（实际编码器将违反码率）
+    long long padBits = 0;          // 下溢填充比特
+    double ichPct = 0.0, bpPct = 0.0;   // ICH / BP 模式组占比（%）
+    int maxError = 0;               // 重建误差（RGB 最大码值差）
+};
+
+struct FrameScore {
+    std::vector<SliceStats> slices;
+    // 全帧汇总（比特按像素加权，峰值取最差 slice）
+    double demandBpp = 0.0;
+    double codedBpp = 0.0;
+    double avgQp = 0.0;
+    int maxQp = 0;
+    double peakFullness = 0.0;
+    long long forcedQuant = 0;
+    long long overflow = 0;
+    double ichPct = 0.0, bpPct = 0.0;
+    int maxError = 0;
+    int worstSlice = -1;            // 峰值占用最高的 slice
+    double ms = 0.0;
+};
+
+// 像素为 2_10_10_10_REV 打包（第 0 行为画面底部，与 glReadPixels 行序一致）。各 slice 互相独立，
+// 分配到共享线程池并行编码
+FrameScore encode(const uint32_t* px, int width, int height, const Config& config);
+
+// 编码器内部使用的 YCoCg-R 正/逆变换（整数可逆）：ycocg 依次为 Y、Co、Cg，Co/Cg 比 RGB 多 1 位。
+// 输入/输出为 2_10_10_10_REV 打包像素（逆变换的 alpha 位为 0）
+void toYCoCgR(uint32_t px, int ycocg[3]);
+uint32_t fromYCoCgR(const int ycocg[3]);
+
+} // namespace dsc
+
+// DSC 模型回读（D 切换）：最终画面经 ReadbackRing 异步回读，后台线程逐帧运行 dsc::encode，
+// 每个 slice 一行追加到 CSV；覆盖层/控制台显示最近一帧的汇总与本图样的累计压力。
+class DscMonitor {
+public:
+    static constexpr int kSlots = 3;        // 在途回读上限；环满时本帧跳过
+
+    struct Stats {
+        unsigned long long frames = 0;      // 本图样已编码的帧
+        unsigned long long skipped = 0;
+        char pattern[8] = {};
+        dsc::FrameScore last;               // 最近一帧（含逐 slice 结果）
+        double peakFullness = 0.0;          // 本图样所有帧中最高的缓冲峰值
+        long long forcedQuant = 0;          // 本图样累计强制量化组数
+        long long overflow = 0;             // 本图样累计溢出组数
+        double maxDemandBpp = 0.0;          // 本图样单帧最高码率需求
+    };
+
+    // logPath 在构造时以追加方式打开（空文件时写 CSV 表头）
+    DscMonitor(const dsc::Config& config, std::string logPath);
+    ~DscMonitor();
+
+    // 在最终画面（缩放后、覆盖层前）调用；pattern 为图样标签，变化时清空累计
+    void capture(unsigned long long frame, const char* pattern, GLuint fbo, GLenum readBuffer, int width, int height);
+    Stats stats() const;
+    const dsc::Config& config() const { return config_; }
+    const std::string& logPath() const { return logPath_; }
+    bool logOpen() const { return log_.is_open(); }
+
+private:
+    void encode(const ReadbackRing::Frame& frame);
+
+    const dsc::Config config_;
+    mutable std::mutex mutex_;
+    std::string logPath_;
+    std::ofstream log_;                     // 仅后台线程写
+    Stats stats_;
+    // 最后声明：析构时先停止后台线程
+    std::unique_ptr<ReadbackRing> ring_;
+
+    DscMonitor(const DscMonitor&) = delete;
+    DscMonitor& operator=(const DscMonitor&) = delete;
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#if defined(__GNUC__)
+#define DHT_PRINTF_FORMAT(fmtIndex, argIndex) __attribute__((format(printf, fmtIndex, argIndex)))
+#else
+#define DHT_PRINTF_FORMAT(fmtIndex, argIndex)
+#endif
+
+// 帧内临时字符串的线性分配器：每帧 reset 后从头复用同一块缓冲，返回的视图仅在本帧有效。
+// 本帧容量不足时临时从堆上分配溢出块，reset 时按峰值一次性扩容，之后稳态下不再触发堆分配
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity = 16 * 1024);
+
+    void reset();
+    // printf 风格格式化到 arena
+    std::string_view format(const char* fmt, ...) DHT_PRINTF_FORMAT(2, 3);
+
+    size_t used() const { return used_; }
+    size_t capacity() const { return buffer_.size(); }
+
+private:
+    char* allocate(size_t bytes);
+
+    std::vector<char> buffer_;
+    size_t used_ = 0;
+    size_t overflowBytes_ = 0;                          // 本帧溢出总量
+    std::vector<std::unique_ptr<char[]>> overflow_;     // 本帧溢出块（reset 时释放）
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+};
@@ -0,0 +1,113 @@
+#pragma once
+#include "readback_ring.h"
+#include <GL/glew.h>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 帧熵/可压缩性估计：对 10-bit 帧计算多种预测器下残差的零阶熵、块自适应 Rice 编码码长，
+// 以及与上一帧的差分能量。动态图样的目的就是不可压缩，以此衡量各图样对链路（DSC 等压缩）的实际压力。
+namespace entropy {
+
+// 预测器：不预测（码值本身）、左邻、上邻、MED（LOCO-I / JPEG-LS 中值边缘检测）
+enum Predictor { kRaw = 0, kLeft = 1, kTop = 2, kMed = 3, kPredictorCount = 4 };
+const char* predictorName(int predictor);
+
+struct FrameStats {
+    double bits[kPredictorCount][3] = {};   // 各预测器残差（模 1024）的零阶熵，bit/样本
+    double riceBits[3] = {};                // MED 残差以块自适应 Rice 编码的估计码长，bit/样本（含每块 4 bit 参数）
+    double temporalMse[3] = {};             // 与上一帧的均方差（码值²）
+    double changed = 0.0;                   // 与上一帧任一通道不同的像素比例
+    bool temporal = false;                  // 是否提供了上一帧
+};
+
+// 像素为 2_10_10_10_REV 打包（R | G<<10 | B<<20），与回读及 cpuraster::render 输出一致。
+// 画面按行切段交给共享线程池；残差/差分内核有 AVX2 路径（运行时检测，与标量逐位一致）
+class Analyzer {
+public:
+    static constexpr int kSegments = 16;
+    static constexpr int kRiceBlock = 32;   // Rice 参数 k 按每 32 个样本（同一行）选取
+    static constexpr int kRiceParamBits = 4;
+
+    // prev 为上一帧（同尺寸），nullptr 时不计算时间差分
+    FrameStats analyze(const uint32_t* px, int width, int height, const uint32_t* prev);
+
+private:
+    std::vector<uint32_t> hist_;            // 各段直方图 kSegments x kPredictorCount x 3 x 1024
+    std::vector<uint64_t> sums_;            // 各段累加量（Rice 码长、平方差、变化像素）
+    std::vector<uint16_t> rows_;            // 各段一行的 MED 折叠残差 kSegments x 3 x width
+};
+
+// 当前内核路径（"avx2" / "scalar"）
+const char* simdPath();
+// 强制使用标量内核（基准对比 AVX2 加速比）
+void setForceScalar(bool scalar);
+
+} // namespace entropy
+
+// 熵估计回读（E 切换）：最终画面以 2_10_10_10_REV 异步回读（PBO 环 + 围栏，渲染线程不等待），
+// 后台线程逐帧分析，按图样累计平均值；图样切换及析构时向 CSV 追加一行，并保留结果供排名。
+class FrameEntropy {
+public:
+    static constexpr int kSlots = 3;        // 在途回读上限；环满时本帧跳过
+
+    // 单个图样的逐帧平均（三通道平均）
+    struct PatternResult {
+        char pattern[8] = {};
+        unsigned long long frames = 0;
+        unsigned long long temporalFrames = 0;  // 其中与上一帧相邻（参与差分统计）的帧
+        int width = 0, height = 0;
+        double bits[entropy::kPredictorCount] = {};
+        double riceBits = 0.0;
+        double temporalMse = 0.0;
+        double changed = 0.0;
+        // 相对 10 bit 原始数据的估计压缩比
+        double ratio() const { return riceBits > 0.0 ? 10.0 / riceBits : 0.0; }
+    };
+
+    struct Stats {
+        unsigned long long skipped = 0;     // 环满未能回读的帧
+        entropy::FrameStats last;           // 最近一帧
+        double lastAnalyzeMs = 0.0;
+        PatternResult current;              // 当前图样的累计平均
+    };
+
+    // logPath 在构造时以追加方式打开（空文件时写 CSV 表头）
+    explicit FrameEntropy(std::string logPath);
+    ~FrameEntropy();
+
+    // 在最终画面（缩放后、覆盖层前）调用：回收/映射已完成的槽，再对 fbo 发起本帧整帧回读。
+    // pattern 为图样标签（如 "D:14"），标签变化时结束上一图样的统计
+    void capture(unsigned long long frame, const char* pattern, GLuint fbo, GLenum readBuffer, int width, int height);
+
+    Stats stats() const;
+    // 已结束的图样与当前图样的结果（按出现顺序）
+    std::vector<PatternResult> results() const;
+    const std::string& logPath() const { return logPath_; }
+    bool logOpen() const { return log_.is_open(); }
+
+private:
+    void analyze(const ReadbackRing::Frame& frame);
+    void finishPattern();                   // 需持有 mutex_
+
+    mutable std::mutex mutex_;
+    std::string logPath_;
+    std::ofstream log_;
+
+    // 以下仅后台线程访问
+    entropy::Analyzer analyzer_;
+    std::vector<uint32_t> prev_;            // 上一分析帧（时间差分）
+    unsigned long long prevFrame_ = 0;
+    bool havePrev_ = false;
+
+    Stats stats_;
+    std::vector<PatternResult> finished_;
+    // 最后声明：析构时先停止后台线程
+    std::unique_ptr<ReadbackRing> ring_;
+
+    FrameEntropy(const FrameEntropy&) = delete;
+    FrameEntropy& operator=(const FrameEntropy&) = delete;
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// 帧标记条（B 切换）：画面底部 3 行大色块，黑/白二值编码帧号、内容签名与 CRC32C，供采集卡端
+// （dht_capture_verify）逐帧解码，客观判定丢帧、重复、乱序与损坏。色块按画面宽高的比例划分，
+// 采集端经缩放、8-bit YUV 限幅后仍可解码；每行首尾的同步块兼作阈值参考。
+// 本文件只含编解码（不依赖 GL），绘制见 marker_renderer.h
+namespace marker {
+
+constexpr int kRows = 3;            // 帧号 / 内容签名 / CRC
+constexpr int kBits = 32;
+constexpr int kCells = kBits + 4;   // 每行：白、黑同步块 + 32 位（高位在前）+ 黑、白结束块
+constexpr int kHeightDivisor = 40;  // 每行高度 = 画面高度 / 40（1080p 为 27 像素）
+
+// 内容签名：标记条以上区域划分为 4x2 块，每块 BT.709 亮度均值量化为 4 bit（0..15），块 0（左上）在最高位。
+// 粒度足够粗，经缩放、色度子采样与 8-bit 限幅后采集端仍可按容差复核
+constexpr int kBlockCols = 4;
+constexpr int kBlockRows = 2;
+constexpr int kBlocks = kBlockCols * kBlockRows;
+constexpr int kBlockLevels = 15;
+
+struct Payload {
+    uint32_t frame = 0;
+    uint32_t content = 0;           // 本帧画面（不含标记条）的块均值签名，由 GPU 在绘制标记前计算
+    uint32_t crc = 0;               // CRC32C(frame, content)：检出误码及来自不同帧的撕裂行
+};
+
+Payload make(uint32_t frame, uint32_t content);
+// 仅校验 CRC；签名与画面是否相符由 contentMismatches 判定
+bool valid(const Payload& p);
+
+// 单元格范围（自上而下坐标，左闭右开）
+struct Rect {
+    int x0, y0, x1, y1;
+};
+Rect cell(int row, int col, int width, int height);
+// 单元格是否为白色：首尾同步块固定，中间 32 位高位在前（GPU 绘制着色器按同一规则）
+bool white(const Payload& p, int row, int col);
+// 整个标记条（自上而下坐标）
+Rect strip(int width, int height);
+// 内容签名的第 index 块（自上而下坐标，位于标记条以上）
+Rect block(int index, int width, int height);
+
+// 块均值（0..1）→ 签名；量化规则与 GPU 端相同（求和顺序不同，恰在半级边界时可能相差一级）
+uint32_t signature(const float mean[kBlocks]);
+int blockLevel(uint32_t content, int index);
+
+// 采集帧的字节布局：每像素 bytesPerPixel 字节（1..4），mask 为按 4 字节循环的取样掩码
+// （如 YUYV 只取亮度字节 0x00FF00FF，BGRX 去掉填充字节 0x00FFFFFF）；
+// rgb 为 R/G/B 在像素内的字节偏移（-1 = 亮度平面，按 mask 直接取样）
+struct Layout {
+    int bytesPerPixel = 4;
+    uint32_t mask = 0xFFFFFFFFu;
+    int rgb[3] = {-1, -1, -1};
+};
+
+// 每个单元格取中心一半区域的取样平均值（0..255）。单元格求和有 AVX2 内核（运行时检测，与标量一致）
+void measure(const uint8_t* image, int width, int height, size_t stride, const Layout& layout,
+             float level[kRows][kCells]);
+// 以每行的同步块取阈值解码；同步块对比度不足或结束块不符时返回 false（无标记或错位）
+bool decode(const float level[kRows][kCells], Payload& out);
+
+// 内容签名各块的亮度平均值（0..255；RGB 布局按 BT.709 加权）
+void measureBlocks(const uint8_t* image, int width, int height, size_t stride, const Layout& layout,
+                   float mean[kBlocks]);
+// 块均值按标记同步块的黑/白电平归一化后与签名比较；偏差超过 tolerance 级（加半级量化误差）的块数
+int contentMismatches(uint32_t content, const float level[kRows][kCells], const float mean[kBlocks], float tolerance);
+
+// 当前内核路径（"avx2" / "scalar"）
+const char* simdPath();
+// 强制使用标量内核（基准对比 AVX2 加速比）
+void setForceScalar(bool scalar);
+
+} // namespace marker
@@ -0,0 +1,56 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+
+// KHR_debug 消息收集：驱动回调（可能来自驱动线程）写入无锁有界队列，按类型/严重度计数；
+// GL 线程每帧 drain 一次，打印新消息并报告本帧是否出现性能类警告（重编译、停顿、缓冲迁移等）。
+// 调试组（glPushDebugGroup）标注 GPU 区段，便于在 RenderDoc/Nsight 与驱动消息中定位。
+namespace gldebug {
+
+constexpr int kTypeCount = 9;       // ERROR..OTHER，见 typeName()
+constexpr int kSeverityCount = 4;   // HIGH/MEDIUM/LOW/NOTIFICATION
+
+struct Totals {
+    uint64_t byType[kTypeCount] = {};
+    uint64_t bySeverity[kSeverityCount] = {};
+    uint64_t dropped = 0;           // 队列满时丢弃的消息（计数仍有效）
+};
+
+struct FrameResult {
+    unsigned messages = 0;          // 本次取出的消息数
+    unsigned performance = 0;       // 其中 GL_DEBUG_TYPE_PERFORMANCE 的条数
+    unsigned long long performanceFrame = 0; // 最后一条性能消息产生时的帧号（异步回调可能晚于该帧到达）
+    unsigned errors = 0;            // 其中 GL_DEBUG_TYPE_ERROR 的条数
+};
+
+// 上下文当前后调用：需 KHR_debug 或 GL 4.3；返回回调是否已安装
+bool install();
+bool active();
+// 当前上下文是否为调试上下文（驱动在此时才报告完整的性能警告）
+bool debugContext();
+// 标记后续消息所属帧号（回调线程读取）
+void setFrame(unsigned long long frame);
+// 取出队列中的消息并打印（同一消息 id 只打印前几次）；仅 GL 线程
+FrameResult drain();
+Totals totals();
+int typeIndex(GLenum type);
+const char* typeName(int index);
+// 应用自身的消息（如着色器编译日志）插入同一消息流，便于统一计数；未安装时为空操作
+void insert(GLenum type, GLenum severity, const char* text);
+
+class Group {
+public:
+    explicit Group(const char* name);
+    ~Group();
+private:
+    bool pushed_;
+    Group(const Group&) = delete;
+    Group& operator=(const Group&) = delete;
+};
+
+} // namespace gldebug
+
+#define DHT_GL_DEBUG_CAT2(a, b) a##b
+#define DHT_GL_DEBUG_CAT(a, b) DHT_GL_DEBUG_CAT2(a, b)
+#define DHT_GL_DEBUG_GROUP(name) ::gldebug::Group DHT_GL_DEBUG_CAT(dhtGlGroup_, __LINE__)(name)
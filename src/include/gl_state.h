@@ -0,0 +1,81 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+
+// 轻量 GL 状态缓存：跳过冗余的绑定/开关/视口调用，并统计每帧状态切换、绘制与上传次数。
+// 仅对单一上下文有效；绕过本类直接调用 GL 的代码结束后需调用 invalidate()。
+class GLState {
+public:
+    struct Counters {
+        unsigned stateChanges = 0;  // 实际下发的状态切换
+        unsigned skipped = 0;       // 被缓存过滤的冗余调用
+        unsigned uniforms = 0;      // uniform 设置
+        unsigned draws = 0;         // 绘制/清屏
+        unsigned uploads = 0;       // 缓冲/纹理上传
+        size_t uploadBytes = 0;
+    };
+
+    static GLState& get();
+
+    // 缓存置为未知（上下文创建后或外部直接改动 GL 状态后调用）
+    void invalidate();
+    // 帧边界：保存上一帧计数并清零
+    void beginFrame();
+    const Counters& lastFrame() const { return last_; }
+    const Counters& currentFrame() const { return cur_; }
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vao);
+    void bindBuffer(GLenum target, GLuint buffer);
+    void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+    void bindFramebuffer(GLenum target, GLuint fbo);
+    void activeTexture(GLenum unit);
+    void bindTexture(GLenum target, GLuint texture);
+    void enable(GLenum cap) { setCap(cap, true); }
+    void disable(GLenum cap) { setCap(cap, false); }
+    void blendFunc(GLenum src, GLenum dst);
+    void viewport(GLint x, GLint y, GLsizei w, GLsizei h);
+
+    // 删除对象时同步清理缓存中的绑定
+    void forgetBuffer(GLuint buffer);
+    void forgetTexture(GLuint texture);
+    void forgetVertexArray(GLuint vao);
+    void forgetProgram(GLuint program);
+    void forgetFramebuffer(GLuint fbo);
+
+    // 计数型调用（不缓存，仅统计）
+    void countUniform() { cur_.uniforms++; }
+    void clear(GLbitfield mask);
+    void drawArrays(GLenum mode, GLint first, GLsizei count);
+    void drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances);
+    void drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
+    void bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+    void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+    void countUpload(size_t bytes) { cur_.uploads++; cur_.uploadBytes += bytes; }
+
+private:
+    GLState() { invalidate(); }
+    void setCap(GLenum cap, bool on);
+    static int capSlot(GLenum cap);
+    static int bufferSlot(GLenum target);
+
+    static constexpr GLuint kUnknown = ~0u;
+    static constexpr int kTextureUnits = 16;
+    static constexpr int kBufferSlots = 6;
+    static constexpr int kCapSlots = 6;
+
+    GLuint program_ = kUnknown;
+    GLuint vao_ = kUnknown;
+    GLuint buffers_[kBufferSlots];
+    GLuint drawFbo_ = kUnknown;
+    GLuint readFbo_ = kUnknown;
+    GLenum activeUnit_ = kUnknown;
+    GLuint textures2D_[kTextureUnits];
+    signed char caps_[kCapSlots];      // -1 未知, 0 关, 1 开
+    GLenum blendSrc_ = kUnknown, blendDst_ = kUnknown;
+    GLint vp_[4];
+    bool vpKnown_ = false;
+
+    Counters cur_;
+    Counters last_;
+};
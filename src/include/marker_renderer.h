@@ -0,0 +1,42 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+#include <memory>
+#include "shader.h"
+
+// 帧标记条的 GPU 绘制（编码规则见 frame_marker.h）：先把标记条以上区域复制到纹理，两遍归约求 4x2 块的
+// 亮度均值并量化为内容签名，同一着色器算出 CRC32C(帧号, 签名)，再由绘制着色器按单元格输出黑/白。
+// 签名与 CRC 全程留在 GPU 上，无需回读；不改变清屏色
+class MarkerRenderer {
+public:
+    static constexpr int kSubCells = 16;    // 每块先归约为 16x16 个子区域的亮度和
+
+    MarkerRenderer();
+    ~MarkerRenderer();
+
+    // 中间目标全部创建成功
+    bool ok() const { return ok_; }
+
+    // 从 fbo 的 readBuffer 读取当前画面计算签名，并把第 frame 帧的标记条画到同一帧缓冲底部。
+    // 应在画面（含覆盖层）绘制完成后调用；会改变帧缓冲、视口、程序与纹理绑定，并关闭混合
+    void draw(uint32_t frame, GLuint fbo, GLenum readBuffer, int width, int height);
+
+private:
+    void release();
+
+    std::unique_ptr<Shader> cellShader_;
+    std::unique_ptr<Shader> signShader_;
+    std::unique_ptr<Shader> stripShader_;
+    UniformInt uCellSrc_, uCellWidth_, uCellHeight_;
+    UniformInt uSignCells_, uSignWidth_, uSignHeight_, uSignFrame_;
+    UniformInt uStripSig_, uStripWidth_, uStripHeight_, uStripFrame_;
+    GLuint vao_ = 0;
+    GLuint copyTexture_ = 0, copyFbo_ = 0;  // 标记条以上区域的副本（按画面尺寸重新分配）
+    int copyWidth_ = 0, copyHeight_ = 0;
+    GLuint cellTexture_ = 0, cellFbo_ = 0;  // 64x32 子区域亮度和
+    GLuint signTexture_ = 0, signFbo_ = 0;  // 1x1 (签名, CRC)
+    bool ok_ = false;
+
+    MarkerRenderer(const MarkerRenderer&) = delete;
+    MarkerRenderer& operator=(const MarkerRenderer&) = delete;
+};
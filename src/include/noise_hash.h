@@ -0,0 +1,55 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// GLSL 整数哈希库（PCG3D / xxhash32，uint 运算），由 Shader::insertAfterVersion 注入主着色器
+extern const std::string kNoiseHashGlsl;
+
+// CPU 侧实现，与 GLSL 版本逐位一致（用于参考渲染/回读校验）
+namespace noise {
+
+struct U3 { uint32_t x, y, z; };
+
+inline U3 pcg3d(U3 v) {
+    v.x = v.x * 1664525u + 1013904223u;
+    v.y = v.y * 1664525u + 1013904223u;
+    v.z = v.z * 1664525u + 1013904223u;
+    v.x += v.y * v.z; v.y += v.z * v.x; v.z += v.x * v.y;
+    v.x ^= v.x >> 16; v.y ^= v.y >> 16; v.z ^= v.z >> 16;
+    v.x += v.y * v.z; v.y += v.z * v.x; v.z += v.x * v.y;
+    return v;
+}
+
+inline uint32_t rotl32(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+
+inline uint32_t xxhash32(uint32_t x, uint32_t y, uint32_t z) {
+    constexpr uint32_t P2 = 2246822519u, P3 = 3266489917u, P4 = 668265263u, P5 = 374761393u;
+    uint32_t h = z + P5 + x * P3;
+    h = P4 * rotl32(h, 17);
+    h += y * P3;
+    h = P4 * rotl32(h, 17);
+    h = P2 * (h ^ (h >> 15));
+    h = P3 * (h ^ (h >> 13));
+    return h ^ (h >> 16);
+}
+
+// 取高 24 位映射到 [0,1)，与 GLSL hashToUnit 一致
+inline float hashToUnit(uint32_t h) { return static_cast<float>(h >> 8) * (1.0f / 16777216.0f); }
+
+} // namespace noise
+
+// 哈希 ALU 开销与统计质量自检（离屏渲染 + 回读），需在有效 GL 上下文中调用
+class NoiseHashBench {
+public:
+    struct Result {
+        std::string name;
+        bool largeCoords = false; // 是否在大坐标偏移下测量
+        double nsPerHashPx = 0.0; // 每像素每次哈希的 GPU 耗时（ns）
+        double chi2PerDof = 0.0;  // 10-bit 码值直方图卡方/自由度（理想≈1）
+        double maxBitBias = 0.0;  // 10 个码值位中 |P(1)-0.5| 的最大值
+        double adjCorr = 0.0;     // 水平相邻像素码值相关系数（理想≈0）
+    };
+    static std::vector<Result> Run(int width, int height);
+};
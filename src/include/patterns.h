@@ -0,0 +1,38 @@
+#pragma once
+#include <GL/glew.h>
+#include <string>
+
+// 图样着色器与元数据（主程序与 dht_bench 共用）
+
+// 各模式组的图样数量
+constexpr int kStaticPatternCount = 21;
+constexpr int kDynamicPatternCount = 15;
+constexpr int kAuxPatternCount = 3;      // 0 = UFO 运动, 1 = 绘制调用压力, 2 = 上传带宽
+// 辅助组中由 C++ 端绘制内容的场景：图样着色器只画背景，不是填充率图样
+constexpr int kAuxDrawStressIndex = 1;
+constexpr int kAuxUploadIndex = 2;
+constexpr bool isFillRatePattern(int category, int index) { return category != 2 || index == 0; }
+
+// 全屏四边形顶点着色器（location 0 = NDC 位置，1 = UV）
+extern const std::string kPatternVertexShader;
+// 图样片元着色器（未注入哈希/Philox 库）
+extern const std::string kPatternFragmentShader;
+// 注入 GLSL 库后的完整片元着色器源码
+std::string patternFragmentSource();
+
+// FrameBlock 的 C++ 镜像（std140：vec2 按 8 字节对齐，块大小向上取整到 16 字节）
+struct FrameUniforms {
+    float time;
+    GLint frameIndex;
+    GLint category;
+    GLint contentMode;
+    float resolution[2];
+    GLint quantBits;       // 高熵生成器的量化位数：12 = q12（12 bpc / FP16 输出），其余 = q10
+    float pad;
+};
+static_assert(sizeof(FrameUniforms) == 32, "FrameBlock std140 layout mismatch");
+constexpr GLuint kFrameBlockBinding = 0;
+
+// category: 0 = 静态, 1 = 动态, 2 = 辅助（与着色器 uCategory 一致）
+int patternCount(int category);
+const char* patternName(int category, int index, bool zh);
@@ -0,0 +1,81 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+class ReadbackRing;
+
+// GLSL Philox4x32-10 库（动态图样 D:14 使用），与下方 CPU 实现逐位一致
+extern const std::string kPhiloxGlsl;
+
+namespace philox {
+
+// 计数器 = (x, y, frameIndex, 0)，密钥固定；每像素输出 4x32bit，取 3 路高 10 位作为 RGB 码值
+inline constexpr uint32_t kKey0 = 0x44485431u; // "DHT1"
+inline constexpr uint32_t kKey1 = 0x9E3779B9u;
+
+struct Block { uint32_t v[4]; };
+
+inline Block philox4x32_10(uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3) {
+    constexpr uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+    constexpr uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+    uint32_t k0 = kKey0, k1 = kKey1;
+    for (int r = 0; r < 10; ++r) {
+        uint64_t p0 = static_cast<uint64_t>(M0) * c0;
+        uint64_t p1 = static_cast<uint64_t>(M1) * c2;
+        uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n1 = static_cast<uint32_t>(p1);
+        uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        uint32_t n3 = static_cast<uint32_t>(p0);
+        c0 = n0; c1 = n1; c2 = n2; c3 = n3;
+        k0 += W0; k1 += W1;
+    }
+    return {{c0, c1, c2, c3}};
+}
+
+// 打包 10-bit 码值：R | G<<10 | B<<20（与 GL_UNSIGNED_INT_2_10_10_10_REV 读回布局一致，不含 alpha）
+inline uint32_t packedCodes(uint32_t x, uint32_t y, uint32_t frame) {
+    Block b = philox4x32_10(x, y, frame, 0u);
+    return (b.v[0] >> 22) | ((b.v[1] >> 22) << 10) | ((b.v[2] >> 22) << 20);
+}
+
+// 计算一行 [x0, x0+n) 的期望码值（AVX2 可用时 8 路并行）
+void rowCodes(uint32_t frame, uint32_t y, uint32_t x0, uint32_t n, uint32_t* out);
+
+} // namespace philox
+
+// 回读帧与 CPU 期望帧逐位比对：经 ReadbackRing 异步回读（PBO 环 + 围栏，渲染线程不等待），
+// 后台线程直接在映射内存上校验（线程池按行并行）
+class PhiloxVerifier {
+public:
+    static constexpr int kSlots = 3;    // 在途回读上限；环满时本帧跳过（采样率随校验速度自适应）
+
+    struct Stats {
+        unsigned long long framesVerified = 0;
+        unsigned long long framesMismatched = 0;
+        unsigned long long pixelsMismatched = 0;
+        unsigned long long lastMismatchFrame = 0;
+        unsigned long long skipped = 0;
+        double lastVerifyMs = 0.0;
+        int channelBits = 0; // 比对精度：10 = 逐码值，8 = 期望值按 8-bit 转换后比对
+    };
+    // 需在 GL 上下文中构造与析构（PBO 环）
+    PhiloxVerifier();
+    ~PhiloxVerifier();
+    // 对 fbo 左下角 width x height 发起异步回读；channelBits >= 10 时按 2_10_10_10_REV 读取，否则 RGBA8
+    void capture(unsigned long long frame, GLuint fbo, GLenum readBuffer, int width, int height, int channelBits);
+    Stats stats() const;
+    void reset();
+private:
+    // pixels: 10-bit 时为 2_10_10_10_REV 打包值；8-bit 时为 RGBA8（按字节）
+    void verify(uint32_t frame, int width, int height, int channelBits, const uint32_t* pixels);
+    mutable std::mutex mutex_;
+    Stats stats_;
+    // 最后声明：析构时先停止后台线程
+    std::unique_ptr<ReadbackRing> ring_;
+
+    PhiloxVerifier(const PhiloxVerifier&) = delete;
+    PhiloxVerifier& operator=(const PhiloxVerifier&) = delete;
+};
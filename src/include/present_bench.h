@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+#include <vector>
+
+class DisplayBackend;
+
+// 呈现路径开销基准（"空图样"）：只清屏为单色、不绘制覆盖层，测量交换调用耗时与循环吞吐，
+// 得到本机/合成器下的理论 FPS 上限，作为判定显示器问题前的基线。需在有效 GL 上下文中调用
+class PresentBench {
+public:
+    struct Result {
+        bool fullscreen = false;
+        int swapInterval = 0;     // 0 / 1 / -1（自适应）
+        bool finish = false;      // 交换前是否 glFinish
+        int width = 0;
+        int height = 0;
+        int frames = 0;
+        double loopFps = 0.0;     // 整个循环吞吐（帧/秒）
+        double swapMeanMs = 0.0;  // swapBuffers 调用耗时
+        double swapStdMs = 0.0;
+        double swapP50Ms = 0.0;
+        double swapP99Ms = 0.0;
+        double swapMaxMs = 0.0;
+    };
+    // 依次测量 {窗口, 全屏} x {交换间隔 0, 1, -1} x {无/有 glFinish}；
+    // 后端不支持的组合（无头全屏、无 swap_control_tear 时的 -1）跳过。结束后恢复原模式与交换间隔
+    static std::vector<Result> Run(DisplayBackend& backend, int framesPerConfig, int restoreSwapInterval);
+};
@@ -0,0 +1,37 @@
+#pragma once
+// USDT 静态探针（provider "dht"）：帧起始、渲染提交、睡眠、交换、图样/配置变化。
+// 供 bpftrace/perf 将本程序的帧与内核/DRM 事件（如 atomic commit）对齐。
+// 每个探针带 USDT 信号量（定义见 probes.cpp）：附加时由 bpftrace/perf 递增，未附加时只读一次内存并跳过，
+// 参数（含 trace::nowNs() 的时钟读取）不求值。
+// 时间戳参数为 CLOCK_MONOTONIC 纳秒（trace::nowNs），与 bpftrace 的 nsecs 同一时钟。
+// 构建时找不到 <sys/sdt.h>（或 -DDHT_USDT=OFF、Windows）则整体编译为空，参数不求值。
+//
+// 例：bpftrace -e 'usdt:./display_hardware_test:dht:swap_end { printf("%llu %llu\n", arg0, arg1); }'
+#if defined(HAS_SDT)
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+// 信号量符号名须为 <provider>_<probe>_semaphore，位于 .probes 段
+#define DHT_PROBE_SEMAPHORE(name) dht_##name##_semaphore
+extern volatile unsigned short dht_frame_start_semaphore;
+extern volatile unsigned short dht_render_submit_semaphore;
+extern volatile unsigned short dht_sleep_begin_semaphore;
+extern volatile unsigned short dht_sleep_end_semaphore;
+extern volatile unsigned short dht_swap_begin_semaphore;
+extern volatile unsigned short dht_swap_end_semaphore;
+extern volatile unsigned short dht_pattern_change_semaphore;
+extern volatile unsigned short dht_config_change_semaphore;
+
+#define DHT_PROBE_ENABLED(name) __builtin_expect(DHT_PROBE_SEMAPHORE(name) != 0, 0)
+#define DHT_PROBE2(name, a, b) do { if (DHT_PROBE_ENABLED(name)) DTRACE_PROBE2(dht, name, a, b); } while (0)
+#define DHT_PROBE3(name, a, b, c) do { if (DHT_PROBE_ENABLED(name)) DTRACE_PROBE3(dht, name, a, b, c); } while (0)
+#define DHT_PROBE4(name, a, b, c, d) do { if (DHT_PROBE_ENABLED(name)) DTRACE_PROBE4(dht, name, a, b, c, d); } while (0)
+#define DHT_PROBE6(name, a, b, c, d, e, f) \
+    do { if (DHT_PROBE_ENABLED(name)) DTRACE_PROBE6(dht, name, a, b, c, d, e, f); } while (0)
+#else
+#define DHT_PROBE_ENABLED(name) false
+#define DHT_PROBE2(name, a, b) do {} while (0)
+#define DHT_PROBE3(name, a, b, c) do {} while (0)
+#define DHT_PROBE4(name, a, b, c, d) do {} while (0)
+#define DHT_PROBE6(name, a, b, c, d, e, f) do {} while (0)
+#endif
@@ -0,0 +1,81 @@
+#pragma once
+#include <GL/glew.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 异步回读环（回读校验和、Philox 校验、码值覆盖、熵估计、DSC 模型共用）：画面（整帧或均匀分布的采样块）
+// 读入 PBO 环（默认 2_10_10_10_REV），围栏完成后（通常数帧之后）才映射，交给后台线程的处理函数；
+// 渲染线程不等待，环满时本帧跳过。
+class ReadbackRing {
+public:
+    // 处理函数收到的帧：data 为映射内存，仅在回调期间有效；映射失败时为 nullptr（帧信息仍有效）
+    struct Frame {
+        const uint32_t* data = nullptr;
+        size_t bytes = 0;
+        unsigned long long frame = 0;
+        unsigned lag = 0;                               // 发起回读到映射之间的帧数
+        int width = 0, height = 0;                      // 采样块时为拼接后的尺寸（tile*grid 见方）
+        int tileGrid = 0;                               // 0 = 整帧；否则为 grid x grid 个采样块
+        GLenum type = GL_UNSIGNED_INT_2_10_10_10_REV;   // 或 GL_UNSIGNED_BYTE（RGBA8）
+        char pattern[8] = {};
+    };
+    using Handler = std::function<void(const Frame&)>;
+
+    // 采样块：grid x grid 个 size x size 的块均匀覆盖画面四角与中部，按块顺序连续存放
+    struct Tiles {
+        int grid;                           // 0 = 整帧
+        int size;
+    };
+
+    // handler 在名为 threadName 的后台线程上按发起顺序调用
+    ReadbackRing(int slots, const char* threadName, Handler handler);
+    // 停止后台线程（未处理的帧丢弃）并释放 PBO；须在 GL 上下文销毁前调用
+    ~ReadbackRing();
+
+    // 在最终画面（缩放后、覆盖层前）调用：回收/映射已完成的槽，再对 fbo 发起本帧回读。
+    // 环满时返回 false（计入 skipped）。type 为 GL_RGBA 的像素类型，每像素 4 字节
+    bool capture(unsigned long long frame, const char* pattern, GLuint fbo, GLenum readBuffer, int width, int height,
+                 GLenum type = GL_UNSIGNED_INT_2_10_10_10_REV, Tiles tiles = {0, 0});
+    // 只回收/映射已完成的槽，不发起新回读（暂停采样时调用，使已发起的帧仍得到处理）
+    void poll(unsigned long long frame);
+    // 等待 GPU 完成在途回读，并等待后台处理完所有已映射的帧（退出前调用，结果不缺帧）
+    void flush();
+    unsigned long long skipped() const;
+
+private:
+    enum class SlotState { Free, Pending, Mapped };
+    struct Slot {
+        GLuint pbo = 0;
+        size_t capacity = 0;
+        GLsync fence = nullptr;
+        SlotState state = SlotState::Free;
+        bool done = false;                  // 后台处理完成后置位（受 mutex_ 保护），渲染线程据此解除映射
+        Frame frame;
+    };
+
+    void retire();
+    void mapReady(unsigned long long frame);
+    void workerLoop(const char* threadName);
+
+    std::vector<Slot> slots_;
+    std::deque<int> pendingOrder_;          // 渲染线程：待映射槽（按发起顺序）
+    unsigned long long lastFrame_ = 0;
+    Handler handler_;
+
+    std::thread worker_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable doneCv_;        // 后台每处理完一帧通知（flush 等待）
+    std::deque<int> queue_;                 // 已映射待处理的槽
+    bool stop_ = false;
+    unsigned long long skipped_ = 0;
+
+    ReadbackRing(const ReadbackRing&) = delete;
+    ReadbackRing& operator=(const ReadbackRing&) = delete;
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <memory>
+#include "shader.h"
+
+// 离屏渲染目标：图样以内部分辨率（可至 16K）渲染到 FBO，再盒式滤波缩放到默认帧缓冲。
+// 用于给发送端显存带宽/容量加压，区分 GPU 显存子系统与链路引起的异常。
+class RenderTarget {
+public:
+    enum class Format { RGBA8 = 0, RGB10_A2 = 1, RGBA16F = 2 };
+    static constexpr int kFormatCount = 3;
+
+    RenderTarget() = default;
+    ~RenderTarget();
+
+    // 按需（重新）分配；尺寸与格式未变时为空操作。显存不足或 FBO 不完整时返回 false 并释放
+    bool ensure(int width, int height, Format format);
+    void release();
+    bool valid() const { return fbo_ != 0; }
+
+    // 绑定为绘制目标并设置整幅视口
+    void bind() const;
+    // 盒式滤波缩放到目标帧缓冲 (0,0,dstWidth,dstHeight)
+    void resolveTo(GLuint dstFramebuffer, int dstWidth, int dstHeight);
+
+    GLuint framebuffer() const { return fbo_; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+    Format format() const { return format_; }
+    // 颜色附件显存占用（字节）
+    size_t bytes() const;
+    // 每通道位数（回读比对精度）：按实际附件位数，RGBA16F 计为 10（可精确表示全部 10-bit 码值）
+    int channelBits() const;
+    // 分配后以 glGetFramebufferAttachmentParameteriv 查询的实际每通道位数（RGB 取最小）
+    int attachmentBits() const { return attachmentBits_; }
+
+    static const char* formatName(Format format);
+    static size_t bytesPerPixel(Format format);
+    // 驱动允许的最大边长（纹理尺寸与视口上限取小）。首次调用时查询并缓存，须在 loadGL() 之后调用；
+    // 与 GLState 一样只适用于单一上下文
+    static int maxDimension();
+
+private:
+    GLuint fbo_ = 0;
+    GLuint color_ = 0;
+    GLuint vao_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    Format format_ = Format::RGBA8;
+    int attachmentBits_ = 0;
+    std::unique_ptr<Shader> resolveShader_;
+    UniformInt uSrc_;
+    UniformVec2 uScale_;
+
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+};
@@ -1,11 +1,29 @@
 #pragma once
 #include <GL/glew.h>
+#include "gl_state.h"
 #include <string>
 #include <iostream>
+#include <unordered_map>
+
+// 链接时解析的 uniform 句柄（按类型区分，热路径无需字符串查找）
+template <typename Tag>
+struct UniformHandle {
+    GLint location = -1;
+    explicit operator bool() const { return location != -1; }
+};
+struct UniformFloatTag {};
+struct UniformVec2Tag {};
+struct UniformVec3Tag {};
+struct UniformIntTag {};
+using UniformFloat = UniformHandle<UniformFloatTag>;
+using UniformVec2 = UniformHandle<UniformVec2Tag>;
+using UniformVec3 = UniformHandle<UniformVec3Tag>;
+using UniformInt = UniformHandle<UniformIntTag>;
 
 class Shader {
 private:
     GLuint programID;
+    std::unordered_map<std::string, GLint> uniformLocations; // 链接后一次性收集
 public:
     Shader(const std::string& vertexSource, const std::string& fragmentSource);
     ~Shader();
@@ -14,8 +32,23 @@ public:
     void setVec2(const std::string& name, float x, float y) const;
     void setVec3(const std::string& name, float x, float y, float z) const;
     void setInt(const std::string& name, int value) const;
+    // 类型化句柄：初始化时获取一次，每帧直接使用（调用前需 use()）
+    UniformFloat uniformFloat(const std::string& name) const { return {location(name)}; }
+    UniformVec2 uniformVec2(const std::string& name) const { return {location(name)}; }
+    UniformVec3 uniformVec3(const std::string& name) const { return {location(name)}; }
+    UniformInt uniformInt(const std::string& name) const { return {location(name)}; }
+    void set(UniformFloat u, float value) const { if (u) { glUniform1f(u.location, value); GLState::get().countUniform(); } }
+    void set(UniformVec2 u, float x, float y) const { if (u) { glUniform2f(u.location, x, y); GLState::get().countUniform(); } }
+    void set(UniformVec3 u, float x, float y, float z) const { if (u) { glUniform3f(u.location, x, y, z); GLState::get().countUniform(); } }
+    void set(UniformInt u, int value) const { if (u) { glUniform1i(u.location, value); GLState::get().countUniform(); } }
+    // 将 uniform block 绑定到指定绑定点；块不存在时返回 false
+    bool bindUniformBlock(const std::string& blockName, GLuint bindingPoint) const;
     GLuint getProgram() const { return programID; }
+    // 将 GLSL 库源码插入到 #version 行之后（GLSL 无 #include）
+    static std::string insertAfterVersion(const std::string& source, const std::string& lib);
 private:
+    GLint location(const std::string& name) const;
+    void collectUniforms();
     GLuint compileShader(const std::string& source, GLenum shaderType);
     void checkCompileErrors(GLuint shader, const std::string& type);
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <memory>
 #include <vector>
@@ -21,13 +22,14 @@ public:
     ~TextRenderer();
     bool Init(int screenWidth, int screenHeight);
     bool LoadFont(const std::string& fontPath, int pixelHeight);
-    void RenderText(const std::string& utf8Text, float x, float y, float scale,
+    void RenderText(std::string_view utf8Text, float x, float y, float scale,
                     float r, float g, float b);
     void SetScreenSize(int screenWidth, int screenHeight);
-    float MeasureTextWidth(const std::string& utf8Text, float scale = 1.0f);
+    float MeasureTextWidth(std::string_view utf8Text, float scale = 1.0f);
     float GetLineHeightPx(float scale = 1.0f) const;
     float GetAscenderPx(float scale = 1.0f) const;
     float GetDescenderPx(float scale = 1.0f) const;
+    static std::u32string Utf8ToUtf32(std::string_view utf8);
 private:
     struct Character {
         GLuint textureId = 0;
@@ -37,8 +39,8 @@ private:
         int bearingY = 0;
         long advance = 0;
     };
-    static std::u32string Utf8ToUtf32(const std::string& utf8);
-    bool EnsureGlyphCached(char32_t codepoint);
+    // 返回缓存中的字形（未命中时加载；失败为 nullptr）
+    const Character* EnsureGlyphCached(char32_t codepoint);
     FT_Library ft_ = nullptr;
     FT_Face face_ = nullptr;
     bool ftReady_ = false;
@@ -47,6 +49,9 @@ private:
     GLuint vao_ = 0;
     GLuint vbo_ = 0;
     std::unique_ptr<Shader> shader_;
+    UniformVec2 uScreenSize_;
+    UniformVec3 uTextColor_;
+    bool screenSizeDirty_ = true;
     int screenW_ = 0;
     int screenH_ = 0;
     TextRenderer(const TextRenderer&) = delete;
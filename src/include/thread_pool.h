@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 简单线程池：parallelFor 将区间切块并行执行，调用线程同时参与计算。
+// 块区间先按参与者均分（相邻块落在同一线程，分块渲染时缓存友好），
+// 做完自己的部分后从剩余最多的参与者尾部窃取一半，负载不均时自动平衡。
+// 空闲工作线程可加入队列中任一尚有剩余块的任务（最新提交者优先，
+// 正在帮旧任务的线程做完当前块即转去帮新任务，渲染线程的小任务不会排在分析任务之后）
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = 0); // 0 = hardware_concurrency
+    ~ThreadPool();
+    unsigned size() const { return static_cast<unsigned>(workers_.size()) + 1; }
+    // 对 [0, count) 按 grain 切块调用 fn(begin, end)，阻塞直至全部完成
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+    // 进程级共享池（分析器/校验器共用，避免线程数膨胀）
+    static ThreadPool& shared();
+private:
+    struct Job {
+        size_t count = 0;
+        size_t grain = 1;
+        const std::function<void(size_t, size_t)>* fn = nullptr;
+        // 每个参与者的块区间 [begin, end)，打包为 (end << 32) | begin，由 CAS 取头/窃尾
+        std::unique_ptr<std::atomic<uint64_t>[]> ranges;
+        unsigned slots = 0;
+        std::atomic<unsigned> nextSlot{0};
+        std::atomic<size_t> done{0};
+    };
+    static constexpr uint64_t kNoChunk = ~uint64_t(0);
+    static uint64_t popFront(std::atomic<uint64_t>& range);
+    static uint64_t steal(Job& job, unsigned self);
+    static bool hasWork(const Job& job);
+    std::shared_ptr<Job> nextJob(); // 需持有 mutex_
+    static constexpr unsigned kCaller = ~0u;
+    // generation：工作线程取任务时的提交计数，之后再有提交即让出；提交者传 kCaller，始终做完
+    void runJob(Job& job, unsigned generation);
+    void runChunk(Job& job, uint64_t chunk);
+    void workerLoop();
+    std::vector<std::thread> workers_;
+    std::deque<std::shared_ptr<Job>> jobs_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable doneCv_;
+    std::atomic<unsigned> submitted_{0};
+    bool stop_ = false;
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+};
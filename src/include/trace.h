@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 轻量时间线追踪：作用域区间写入各线程独立的环形缓冲（仅属主线程写入，无锁），
+// GPU 区间用 GL_TIMESTAMP 查询测得后换算到 CPU 时间轴；按需导出最近 N 秒为 Chrome trace JSON（可直接在 Perfetto 打开）
+namespace trace {
+
+void setEnabled(bool enabled);
+bool enabled();
+// 当前线程在时间线上的名称与环形缓冲容量（事件数，2 的幂）；需在该线程首次记录前调用才影响容量
+void setThreadName(const char* name, size_t capacity = 1u << 14);
+uint64_t nowNs();
+// name 须为静态字符串（只保存指针）
+void record(const char* name, uint64_t beginNs, uint64_t endNs);
+
+// 非线程轨道（如 GPU 时间线）：与线程缓冲一起导出；同一轨道同一时刻只能有一个写入者
+struct Track;
+Track* createTrack(const char* name, size_t capacity);
+void recordTo(Track* track, const char* name, uint64_t beginNs, uint64_t endNs);
+
+class Scope {
+public:
+    explicit Scope(const char* name) : name_(name), begin_(enabled() ? nowNs() : 0) {}
+    ~Scope() { if (begin_) record(name_, begin_, nowNs()); }
+private:
+    const char* name_;
+    uint64_t begin_;
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+// GPU 区间：起止各插入一次时间戳查询，结果在后续帧的 collectGpu() 中非阻塞取回（仅 GL 线程）。
+// 实现在 trace_gpu.cpp（dht_core），其余部分不依赖 GL，离线工具经 dht_offline 使用
+class GpuScope {
+public:
+    explicit GpuScope(const char* name);
+    ~GpuScope();
+private:
+    int slot_ = -1;
+    GpuScope(const GpuScope&) = delete;
+    GpuScope& operator=(const GpuScope&) = delete;
+};
+void collectGpu();
+// 删除查询对象（上下文销毁前调用）
+void shutdownGpu();
+
+// 导出最近 seconds 秒（<=0 为缓冲内全部）；返回写入的事件数，失败返回 -1
+long writeChromeJson(const std::string& path, double seconds);
+
+} // namespace trace
+
+#define DHT_TRACE_CONCAT2(a, b) a##b
+#define DHT_TRACE_CONCAT(a, b) DHT_TRACE_CONCAT2(a, b)
+#define DHT_TRACE_ZONE(name) ::trace::Scope DHT_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define DHT_TRACE_GPU_ZONE(name) ::trace::GpuScope DHT_TRACE_CONCAT(traceGpuScope_, __LINE__)(name)
@@ -0,0 +1,108 @@
+#pragma once
+#include <GL/glew.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "shader.h"
+
+// 主机 -> GPU 上传带宽场景（辅助图样 A:2）：每帧在 CPU 上生成整幅画面并上传到纹理后显示。
+// 比较四种上传路径（glTexSubImage2D、孤立化 PBO、三缓冲 PBO 环、ARB_buffer_storage 持久映射）
+// 在 RGBA8 / RGB10_A2 下的有效带宽与对帧节奏的影响。
+class UploadStream {
+public:
+    enum class Method { TexSubImage = 0, PboOrphan = 1, PboRing = 2, Persistent = 3 };
+    static constexpr int kMethodCount = 4;
+    enum class Format { RGBA8 = 0, RGB10_A2 = 1 };
+    static constexpr int kRingSize = 3;
+
+    // 最近一个统计窗口（约 1 秒）的结果
+    struct Stats {
+        double gbps = 0.0;           // 实际送达带宽（上传字节 / 窗口时长）
+        double callGbps = 0.0;       // 上传调用本身的吞吐（字节 / CPU 上传耗时，不含生成）
+        double genMs = 0.0;          // CPU 生成画面耗时（平均）
+        double uploadMs = 0.0;       // 上传调用耗时（映射/拷贝/TexSubImage，平均）
+        double uploadMaxMs = 0.0;
+        double gpuMs = 0.0;          // GPU 端拷贝耗时（计时查询，平均；不可用时为 0）
+        double frameMs = 0.0;        // 帧间隔平均 / 标准差 / 最大（帧节奏）
+        double frameSdMs = 0.0;
+        double frameMaxMs = 0.0;
+        unsigned mapFailures = 0;    // 映射失败而跳过上传的帧（不计入带宽）
+        bool valid = false;
+    };
+
+    UploadStream();
+    ~UploadStream();
+
+    // 生成并上传一帧，再全屏绘制到当前绑定的帧缓冲
+    void render(unsigned long long frame, int width, int height);
+
+    Method method() const { return method_; }
+    Format format() const { return format_; }
+    void cycleMethod();
+    void cycleFormat();
+    // 持久映射需 ARB_buffer_storage 或 GL 4.4
+    static bool methodSupported(Method method);
+    static const char* methodName(Method method, bool zh);
+    static const char* formatName(Format format);
+    const Stats& stats() const { return stats_; }
+
+private:
+    void ensure(int width, int height);
+    void release();
+    void generate(uint32_t* dst, unsigned long long frame);
+    void upload(unsigned long long frame);
+    void resetWindow();
+    void collectGpu();
+
+    std::unique_ptr<Shader> shader_;
+    UniformInt uSrc_;
+    GLuint vao_ = 0;
+    GLuint texture_ = 0;
+    GLenum textureInternal_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    size_t frameBytes_ = 0;
+    Method method_ = Method::PboRing;
+    Format format_ = Format::RGB10_A2;
+    bool storageDirty_ = true;       // 方法/格式/尺寸改变后重建纹理与缓冲
+
+    std::vector<uint32_t> staging_;  // TexSubImage 路径的客户端内存
+    GLuint orphanPbo_ = 0;
+    GLuint ringPbo_[kRingSize] = {};
+    GLuint persistentPbo_ = 0;
+    uint8_t* persistentPtr_ = nullptr;
+    GLsync fences_[kRingSize] = {};
+    int ringIndex_ = 0;
+
+    GLuint queries_[kRingSize] = {};
+    bool queryPending_[kRingSize] = {};
+
+    // 生成回调只构造一次（每帧复用，不在帧循环中分配）
+    std::function<void(size_t, size_t)> genRows_;
+    uint32_t* genDst_ = nullptr;
+    unsigned long long genFrame_ = 0;
+
+    // 统计窗口
+    std::chrono::steady_clock::time_point windowStart_;
+    std::chrono::steady_clock::time_point lastFrame_;
+    bool haveLastFrame_ = false;
+    unsigned windowFrames_ = 0;
+    size_t windowBytes_ = 0;
+    unsigned windowMapFailures_ = 0;
+    double windowGenMs_ = 0.0;
+    double windowUploadMs_ = 0.0;
+    double windowUploadMaxMs_ = 0.0;
+    double windowGpuMs_ = 0.0;
+    unsigned windowGpuSamples_ = 0;
+    double windowFrameSum_ = 0.0;
+    double windowFrameSqSum_ = 0.0;
+    double windowFrameMax_ = 0.0;
+    unsigned windowIntervals_ = 0;
+    Stats stats_;
+
+    UploadStream(const UploadStream&) = delete;
+    UploadStream& operator=(const UploadStream&) = delete;
+};
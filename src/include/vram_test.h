@@ -0,0 +1,100 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "shader.h"
+
+// 显存完整性压力（M 切换，memtest 式）：分配大块 RGBA32UI 纹理与等量缓冲，依次写入行走 1、地址即数据、
+// 计数器随机三种确定性图样，在 GPU 上复制（纹理 → 缓冲）并以片元着色器校验、归约为不匹配计数，
+// 只回读每次校验 32 字节的计数。每帧轮转一个块，与显示图样处于同一时间线（按帧号记录）。
+class VramTest {
+public:
+    static constexpr int kBlockWidth = 2048;    // 每块纹理 2048x1024 RGBA32UI = 32 MiB，缓冲同样大小
+    static constexpr int kBlockHeight = 1024;
+    static constexpr int kBlockMiB = 64;        // 纹理 + 缓冲
+    static constexpr int kSlots = 4;            // 在途计数回读上限；环满时本帧跳过
+
+    enum Pattern { kWalkingOnes = 0, kAddress = 1, kRandom = 2, kPatternCount = 3 };
+    static const char* patternName(int pattern);
+    // 第 word 个 32 位字（全局地址）在 (pattern, pass) 下的期望值，与着色器逐位一致
+    static uint32_t expected(int pattern, uint32_t pass, uint32_t word);
+
+    struct Stats {
+        int blocks = 0;                     // 实际分配成功的块
+        bool bufferVerify = false;          // 缓冲以纹理缓冲对象直接校验（驱动上限不足时只校验纹理）
+        unsigned long long verifications = 0;
+        unsigned long long verifiedBytes = 0;
+        unsigned long long mismatchWords = 0;
+        unsigned long long errorEvents = 0; // 出现不匹配的校验次数
+        unsigned long long skipped = 0;
+        unsigned long long rotations = 0;   // 全部块完成一轮写入的次数
+        // 最近一次不匹配
+        unsigned long long lastErrorFrame = 0;
+        int lastErrorBlock = -1;
+        bool lastErrorInBuffer = false;
+        int lastErrorPattern = 0;
+        uint32_t lastErrorWord = 0;         // 块内首个出错字
+        uint32_t lastErrorExpected = 0;     // 该字的期望值
+        uint32_t lastErrorBits = 0;         // 出错位（异或差的并集）
+    };
+
+    // 按 MiB 分配（向下取整为块，至少一块）；logPath 以追加方式打开（空文件时写 CSV 表头）
+    VramTest(int mib, std::string logPath);
+    ~VramTest();
+
+    // 每帧调用一次：回收已完成的计数，校验一个块上一轮的内容，再写入下一图样并复制到缓冲。
+    // 会改变帧缓冲、视口、程序与纹理绑定，调用方随后需重新绑定
+    void step(unsigned long long frame, double time);
+
+    // 校验目标创建成功且至少分配到一块
+    bool ok() const { return !blocks_.empty(); }
+    const Stats& stats() const { return stats_; }
+    int allocatedMiB() const { return stats_.blocks * kBlockMiB; }
+    const std::string& logPath() const { return logPath_; }
+    bool logOpen() const { return log_.is_open(); }
+
+private:
+    struct Block {
+        GLuint texture = 0;
+        GLuint fbo = 0;
+        GLuint buffer = 0;
+        GLuint bufferTexture = 0;           // 0 = 不支持的纹理缓冲大小
+        uint32_t fills = 0;                 // 已写入次数；图样 = (fills-1) % 3，轮次 = (fills-1) / 3
+    };
+    struct Slot {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        unsigned long long frame = 0;
+        double time = 0.0;
+        int block = 0;
+        int pattern = 0;
+        uint32_t pass = 0;
+    };
+
+    void poll();
+    void record(const Slot& slot, const uint32_t* counts);
+    void release();
+
+    std::vector<Block> blocks_;
+    std::vector<Slot> slots_;
+    std::vector<int> pending_;              // 在途槽（按发起顺序）
+    int next_ = 0;
+    std::unique_ptr<Shader> fillShader_;
+    std::unique_ptr<Shader> verifyShader_;
+    std::unique_ptr<Shader> reduceShader_;
+    UniformInt uFillPattern_, uFillPass_, uFillBase_;
+    UniformInt uVerifyPattern_, uVerifyPass_, uVerifyBase_, uVerifyTex_, uVerifyBuf_;
+    UniformInt uReduceSrc_;
+    GLuint vao_ = 0;
+    GLuint cellTexture_ = 0, cellFbo_ = 0;  // 64x128 逐单元计数（上半纹理、下半缓冲）
+    GLuint sumTexture_ = 0, sumFbo_ = 0;    // 2x1 归约结果
+    Stats stats_;
+    std::string logPath_;
+    std::ofstream log_;
+
+    VramTest(const VramTest&) = delete;
+    VramTest& operator=(const VramTest&) = delete;
+};
@@ -1,4 +1,7 @@
 #include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include "display_hardware_test.h"
 #ifdef _WIN32
 #include <windows.h>
@@ -6,8 +9,140 @@ extern "C" __declspec(dllexport) DWORD NvOptimusEnablement = 0x00000001;
 extern "C" __declspec(dllexport) int AmdPowerXpressRequestHighPerformance = 1;
 #endif
 
-int main() {
+static void printUsage(const char* argv0, Language lang) {
+    if (lang == Language::ZH) {
+        std::cout << "用法: " << argv0 << " [--headless] [--frames N] [--size WxH] [--present-bench] [--trace-out PATH] [--trace-seconds N] [--gl-debug] [--checksum tiles|full] [--checksum-log PATH] [--bits 8|10|12|16] [--coverage] [--entropy] [--entropy-log PATH] [--dsc BPP] [--dsc-slice WxH] [--dsc-log PATH] [--marker] [--memtest MIB] [--memtest-log PATH]\n"
+                  << "  --headless   无显示器运行（EGL surfaceless，渲染到离屏帧缓冲）\n"
+                  << "  --frames N   渲染 N 帧后退出并输出汇总\n"
+                  << "  --size WxH   渲染尺寸（窗口模式为窗口大小；无头默认 1920x1080）\n"
+                  << "  --present-bench  呈现路径基准：单色清屏、无覆盖层，测量交换耗时与循环吞吐\n"
+                  << "                   （交换间隔 0/1/-1 x 有无 glFinish x 窗口/全屏；--frames 为每种配置帧数，默认 300）\n"
+                  << "  --trace-out PATH     退出时将时间线（CPU/GPU 区段）导出为 Chrome trace JSON（Perfetto 可打开）\n"
+                  << "  --trace-seconds N    导出最近 N 秒（默认 10；运行中按 F9 亦可导出）\n"
+                  << "  --gl-debug           请求 GL 调试上下文：驱动完整报告 KHR_debug 消息（含性能警告），F3 显示计数\n"
+                  << "  --checksum tiles|full  启动即开启最终画面异步回读校验（4x4 采样块 / 整帧，运行中按 C 切换）\n"
+                  << "  --checksum-log PATH    逐帧 CRC32C 日志（CSV，追加写入；默认 dht_crc_<时间戳>.csv）\n"
+                  << "  --bits 8|10|12|16      请求的帧缓冲每通道位数（默认 10；16 = FP16；不可用时逐级回退；覆盖层显示实际位深）\n"
+                  << "  --coverage             启动即开启码值覆盖分析（运行中按 G 切换；切换图样及退出时输出报告）\n"
+                  << "  --entropy              启动即开启熵/可压缩性估计（运行中按 E 切换；退出时按估计码长输出图样排名）\n"
+                  << "  --entropy-log PATH     每图样熵估计结果（CSV，追加写入；默认 dht_entropy_<时间戳>.csv；隐含 --entropy）\n"
+                  << "  --dsc BPP              启动即开启 DSC 1.2a 编码器模型，目标码率 BPP（6..30；运行中按 D 切换，默认 8）\n"
+                  << "  --dsc-slice WxH        DSC slice 尺寸（默认宽度四等分 x 108 行）\n"
+                  << "  --dsc-log PATH         逐 slice DSC 模型结果（CSV，追加写入；默认 dht_dsc_<时间戳>.csv）\n"
+                  << "  --marker               启动即绘制帧标记条（运行中按 B 切换；配合 dht_capture_verify 采集端校验）\n"
+                  << "  --memtest MIB          启动即开启显存完整性压力，分配 MIB 显存（64 MiB 一块；运行中按 M 切换，默认 256）\n"
+                  << "  --memtest-log PATH     逐次显存校验结果（CSV，追加写入；默认 dht_memtest_<时间戳>.csv）\n";
+    } else {
+        std::cout << "Usage: " << argv0 << " [--headless] [--frames N] [--size WxH] [--present-bench] [--trace-out PATH] [--trace-seconds N] [--gl-debug] [--checksum tiles|full] [--checksum-log PATH] [--bits 8|10|12|16] [--coverage] [--entropy] [--entropy-log PATH] [--dsc BPP] [--dsc-slice WxH] [--dsc-log PATH] [--marker] [--memtest MIB] [--memtest-log PATH]\n"
+                  << "  --headless   run without a display (EGL surfaceless, render to an offscreen framebuffer)\n"
+                  << "  --frames N   exit after N frames and print a summary\n"
+                  << "  --size WxH   render size (window size when windowed; headless default 1920x1080)\n"
+                  << "  --present-bench  present-path benchmark: one-colour clear, no overlay; measures swap time and loop throughput\n"
+                  << "                   (swap interval 0/1/-1 x glFinish off/on x windowed/fullscreen; --frames = frames per config, default 300)\n"
+                  << "  --trace-out PATH     on exit, write the CPU/GPU zone timeline as Chrome trace JSON (opens in Perfetto)\n"
+                  << "  --trace-seconds N    export the last N seconds (default 10; press F9 at runtime to export too)\n"
+                  << "  --gl-debug           request a GL debug context so the driver reports all KHR_debug messages (incl. performance warnings); counts shown with F3\n"
+                  << "  --checksum tiles|full  start with async readback checksums of the final image (4x4 sample tiles / full frame; press C to cycle)\n"
+                  << "  --checksum-log PATH    per-frame CRC32C log (CSV, appended; default dht_crc_<timestamp>.csv)\n"
+                  << "  --bits 8|10|12|16      requested framebuffer bits per channel (default 10; 16 = FP16; falls back step by step; the overlay shows the real depth)\n"
+                  << "  --coverage             start with the code coverage analyzer on (press G to toggle; reports on pattern change and exit)\n"
+                  << "  --entropy              start with the entropy/compressibility estimator on (press E to toggle; ranks patterns on exit)\n"
+                  << "  --entropy-log PATH     per-pattern entropy results (CSV, appended; default dht_entropy_<timestamp>.csv; implies --entropy)\n"
+                  << "  --dsc BPP              start with the DSC 1.2a encoder model on at BPP bits/pixel (6..30; press D to toggle, default 8)\n"
+                  << "  --dsc-slice WxH        DSC slice size (default a quarter of the width x 108 lines)\n"
+                  << "  --dsc-log PATH         per-slice DSC model results (CSV, appended; default dht_dsc_<timestamp>.csv)\n"
+                  << "  --marker               start with the frame marker strip on (press B to toggle; verify with dht_capture_verify)\n"
+                  << "  --memtest MIB          start with the VRAM integrity stress on, using MIB of video memory (64 MiB blocks; press M to toggle, default 256)\n"
+                  << "  --memtest-log PATH     per-verification VRAM test results (CSV, appended; default dht_memtest_<timestamp>.csv)\n";
+    }
+}
+
+int main(int argc, char** argv) {
     auto lang = MonitorTest::detectLanguage();
+
+    LaunchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--headless") == 0) {
+            options.headless = true;
+        } else if (std::strcmp(arg, "--present-bench") == 0) {
+            options.presentBench = true;
+        } else if (std::strcmp(arg, "--frames") == 0 && i + 1 < argc) {
+            options.maxFrames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--size") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2 ||
+                options.width <= 0 || options.height <= 0) {
+                std::cerr << (lang==Language::ZH?"无效尺寸: ":"Invalid size: ") << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (std::strcmp(arg, "--gl-debug") == 0) {
+            options.glDebug = true;
+        } else if (std::strcmp(arg, "--trace-out") == 0 && i + 1 < argc) {
+            options.traceOut = argv[++i];
+        } else if (std::strcmp(arg, "--trace-seconds") == 0 && i + 1 < argc) {
+            options.traceSeconds = std::atof(argv[++i]);
+            if (options.traceSeconds <= 0.0) {
+                std::cerr << (lang==Language::ZH?"无效秒数: ":"Invalid seconds: ") << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (std::strcmp(arg, "--checksum") == 0 && i + 1 < argc) {
+            const char* m = argv[++i];
+            if (std::strcmp(m, "tiles") == 0) {
+                options.checksumMode = 1;
+            } else if (std::strcmp(m, "full") == 0) {
+                options.checksumMode = 2;
+            } else {
+                std::cerr << (lang==Language::ZH?"无效校验模式: ":"Invalid checksum mode: ") << m << std::endl;
+                return -1;
+            }
+        } else if (std::strcmp(arg, "--checksum-log") == 0 && i + 1 < argc) {
+            options.checksumLog = argv[++i];
+        } else if (std::strcmp(arg, "--bits") == 0 && i + 1 < argc) {
+            options.colorBits = std::atoi(argv[++i]);
+            if (options.colorBits != 8 && options.colorBits != 10 && options.colorBits != 12 && options.colorBits != 16) {
+                std::cerr << (lang==Language::ZH?"无效位深: ":"Invalid bit depth: ") << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (std::strcmp(arg, "--coverage") == 0) {
+            options.coverage = true;
+        } else if (std::strcmp(arg, "--entropy") == 0) {
+            options.entropy = true;
+        } else if (std::strcmp(arg, "--entropy-log") == 0 && i + 1 < argc) {
+            options.entropyLog = argv[++i];
+            options.entropy = true;
+        } else if (std::strcmp(arg, "--dsc") == 0 && i + 1 < argc) {
+            options.dscBpp = std::atof(argv[++i]);
+            if (options.dscBpp < 6.0 || options.dscBpp > 30.0) {
+                std::cerr << (lang==Language::ZH?"无效 DSC 码率: ":"Invalid DSC bpp: ") << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (std::strcmp(arg, "--dsc-slice") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.dscSliceWidth, &options.dscSliceHeight) != 2 ||
+                options.dscSliceWidth <= 0 || options.dscSliceHeight <= 0) {
+                std::cerr << (lang==Language::ZH?"无效 slice 尺寸: ":"Invalid slice size: ") << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (std::strcmp(arg, "--dsc-log") == 0 && i + 1 < argc) {
+            options.dscLog = argv[++i];
+        } else if (std::strcmp(arg, "--marker") == 0) {
+            options.marker = true;
+        } else if (std::strcmp(arg, "--memtest") == 0 && i + 1 < argc) {
+            options.memtestMib = std::atoi(argv[++i]);
+            if (options.memtestMib < 64) {
+                std::cerr << (lang==Language::ZH?"无效显存容量（至少 64 MiB）: ":"Invalid VRAM size (at least 64 MiB): ") << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (std::strcmp(arg, "--memtest-log") == 0 && i + 1 < argc) {
+            options.memtestLog = argv[++i];
+        } else if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage(argv[0], lang);
+            return 0;
+        } else {
+            std::cerr << (lang==Language::ZH?"未知参数: ":"Unknown argument: ") << arg << std::endl;
+            printUsage(argv[0], lang);
+            return -1;
+        }
+    }
     if (lang == Language::ZH) {
         std::cout << "=== 显示器硬件测试 (display_hardware_test) ===\n";
         std::cout << "- 目标：10bit色深与高刷新率压力、链路稳定性诊断\n\n";
@@ -19,7 +154,7 @@ int main() {
     try {
         MonitorTest test;
 
-        if (!test.initialize()) {
+        if (!test.initialize(options)) {
             std::cerr << (lang==Language::ZH?"初始化失败":"Initialization failed") << std::endl;
             return -1;
         }
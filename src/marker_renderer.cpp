@@ -0,0 +1,238 @@
+#include "marker_renderer.h"
+#include "frame_marker.h"
+#include "gl_state.h"
+
+#include <algorithm>
+
+namespace {
+static_assert(marker::kBlockCols == 4 && marker::kBlockRows == 2 && marker::kBlockLevels == 15,
+              "着色器中的块划分与量化级数需同步修改");
+static_assert(marker::kRows == 3 && marker::kCells == 36 && marker::kHeightDivisor == 40,
+              "kStripFragmentShader 中的单元格划分需同步修改");
+static_assert(MarkerRenderer::kSubCells == 16, "着色器中的 kSub 需同步修改");
+
+const char* kVertexShader = R"(#version 330 core
+void main() {
+    // 全屏三角形（无需顶点缓冲）
+    vec2 p = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+// 区间划分与 frame_marker.cpp 相同：第 i 段起点 = i * extent / parts（整数除法）
+const std::string kSplitGlsl = R"(
+const int kSub = 16;
+int split(int extent, int parts, int i) { return i * extent / parts; }
+)";
+
+// 第一遍：每个片元求一个子区域的 BT.709 亮度和。片元坐标自下而上，块与子区域按自上而下编号；
+// 副本纹理的第 0 行是区域最底行
+const char* kCellFragmentShader = R"(#version 330 core
+uniform sampler2D uSrc;
+uniform int uWidth;
+uniform int uHeight;
+out float FragColor;
+void main() {
+    ivec2 c = ivec2(gl_FragCoord.xy);
+    int row = 2 * kSub - 1 - c.y;
+    int bx = c.x / kSub, by = row / kSub;
+    int bx0 = split(uWidth, 4, bx), bx1 = split(uWidth, 4, bx + 1);
+    int by0 = split(uHeight, 2, by), by1 = split(uHeight, 2, by + 1);
+    int x0 = bx0 + split(bx1 - bx0, kSub, c.x % kSub), x1 = bx0 + split(bx1 - bx0, kSub, c.x % kSub + 1);
+    int y0 = by0 + split(by1 - by0, kSub, row % kSub), y1 = by0 + split(by1 - by0, kSub, row % kSub + 1);
+    float sum = 0.0;
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            sum += dot(texelFetch(uSrc, ivec2(x, uHeight - 1 - y), 0).rgb, vec3(0.2126, 0.7152, 0.0722));
+        }
+    }
+    FragColor = sum;
+}
+)";
+
+// 第二遍（单个片元）：各块均值量化为 4 bit 拼成签名（块 0 在最高位），再算 CRC32C(帧号, 签名)，
+// 字节顺序与 marker::make 相同（小端）
+const char* kSignFragmentShader = R"(#version 330 core
+uniform sampler2D uCells;
+uniform int uWidth;
+uniform int uHeight;
+uniform int uFrame;
+out uvec2 FragColor;
+uint crcWord(uint crc, uint word) {
+    for (int i = 0; i < 4; ++i) {
+        crc ^= (word >> uint(i * 8)) & 0xFFu;
+        for (int k = 0; k < 8; ++k) crc = (crc >> 1u) ^ (0x82F63B78u & (0u - (crc & 1u)));
+    }
+    return crc;
+}
+void main() {
+    uint content = 0u;
+    for (int i = 0; i < 8; ++i) {
+        int bx = i % 4, by = i / 4;
+        float sum = 0.0;
+        for (int y = 0; y < kSub; ++y) {
+            for (int x = 0; x < kSub; ++x) sum += texelFetch(uCells, ivec2(bx * kSub + x, 2 * kSub - 1 - (by * kSub + y)), 0).r;
+        }
+        int area = (split(uWidth, 4, bx + 1) - split(uWidth, 4, bx)) * (split(uHeight, 2, by + 1) - split(uHeight, 2, by));
+        float mean = area > 0 ? sum / float(area) : 0.0;
+        content = (content << 4u) | uint(floor(clamp(mean, 0.0, 1.0) * 15.0 + 0.5));
+    }
+    uint frame = uint(uFrame);
+    FragColor = uvec2(content, crcWord(crcWord(0xFFFFFFFFu, frame), content) ^ 0xFFFFFFFFu);
+}
+)";
+
+// 标记条：按 marker::cell / marker::white 的规则逐片元求所在单元格与位值（剪裁限定在标记条内）
+const char* kStripFragmentShader = R"(#version 330 core
+uniform usampler2D uSig;
+uniform int uWidth;
+uniform int uHeight;
+uniform int uFrame;
+const int kRows = 3;
+const int kCells = 36;
+const int kDivisor = 40;
+out vec4 FragColor;
+void main() {
+    int x = int(gl_FragCoord.x), y = uHeight - 1 - int(gl_FragCoord.y);
+    int col = 0;
+    for (int c = 1; c < kCells; ++c) {
+        if (x >= c * uWidth / kCells) col = c;
+    }
+    int row = 0;
+    for (int r = 1; r < kRows; ++r) {
+        if (y >= uHeight - (kRows - r) * uHeight / kDivisor) row = r;
+    }
+    uvec2 sig = texelFetch(uSig, ivec2(0, 0), 0).xy;
+    uint word = row == 0 ? uint(uFrame) : (row == 1 ? sig.x : sig.y);
+    bool white = col == 0 || col == kCells - 1 ||
+                 (col != 1 && col != kCells - 2 && ((word >> uint(kCells - 3 - col)) & 1u) != 0u);
+    FragColor = vec4(vec3(white ? 1.0 : 0.0), 1.0);
+}
+)";
+
+// 纹理 + 帧缓冲；不完整时返回 false（已创建的对象由调用方删除）
+bool createTarget(GLenum internal, GLenum format, GLenum type, int width, int height, GLuint& texture, GLuint& fbo) {
+    GLState& gs = GLState::get();
+    glGenTextures(1, &texture);
+    gs.activeTexture(GL_TEXTURE0);
+    gs.bindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, internal, width, height, 0, format, type, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glGenFramebuffers(1, &fbo);
+    gs.bindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    gs.bindFramebuffer(GL_FRAMEBUFFER, 0);
+    return complete;
+}
+
+void deleteTarget(GLuint& texture, GLuint& fbo) {
+    GLState& gs = GLState::get();
+    if (fbo) {
+        gs.forgetFramebuffer(fbo);
+        glDeleteFramebuffers(1, &fbo);
+        fbo = 0;
+    }
+    if (texture) {
+        gs.forgetTexture(texture);
+        glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+}
+} // namespace
+
+MarkerRenderer::MarkerRenderer() {
+    cellShader_ = std::make_unique<Shader>(kVertexShader, Shader::insertAfterVersion(kCellFragmentShader, kSplitGlsl));
+    uCellSrc_ = cellShader_->uniformInt("uSrc");
+    uCellWidth_ = cellShader_->uniformInt("uWidth");
+    uCellHeight_ = cellShader_->uniformInt("uHeight");
+    signShader_ = std::make_unique<Shader>(kVertexShader, Shader::insertAfterVersion(kSignFragmentShader, kSplitGlsl));
+    uSignCells_ = signShader_->uniformInt("uCells");
+    uSignWidth_ = signShader_->uniformInt("uWidth");
+    uSignHeight_ = signShader_->uniformInt("uHeight");
+    uSignFrame_ = signShader_->uniformInt("uFrame");
+    stripShader_ = std::make_unique<Shader>(kVertexShader, kStripFragmentShader);
+    uStripSig_ = stripShader_->uniformInt("uSig");
+    uStripWidth_ = stripShader_->uniformInt("uWidth");
+    uStripHeight_ = stripShader_->uniformInt("uHeight");
+    uStripFrame_ = stripShader_->uniformInt("uFrame");
+    glGenVertexArrays(1, &vao_);
+    ok_ = createTarget(GL_R32F, GL_RED, GL_FLOAT, 4 * kSubCells, 2 * kSubCells, cellTexture_, cellFbo_) &&
+          createTarget(GL_RG32UI, GL_RG_INTEGER, GL_UNSIGNED_INT, 1, 1, signTexture_, signFbo_) &&
+          createTarget(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 1, 1, copyTexture_, copyFbo_);
+    if (!ok_) release();
+}
+
+MarkerRenderer::~MarkerRenderer() { release(); }
+
+void MarkerRenderer::release() {
+    deleteTarget(copyTexture_, copyFbo_);
+    deleteTarget(cellTexture_, cellFbo_);
+    deleteTarget(signTexture_, signFbo_);
+    copyWidth_ = copyHeight_ = 0;
+    if (vao_) {
+        GLState::get().forgetVertexArray(vao_);
+        glDeleteVertexArrays(1, &vao_);
+        vao_ = 0;
+    }
+}
+
+void MarkerRenderer::draw(uint32_t frame, GLuint fbo, GLenum readBuffer, int width, int height) {
+    if (!ok_ || width <= 0 || height <= 0) return;
+    GLState& gs = GLState::get();
+    const marker::Rect s = marker::strip(width, height);
+    const int contentHeight = s.y0;
+    gs.disable(GL_SCISSOR_TEST);
+    gs.disable(GL_BLEND);
+    gs.bindVertexArray(vao_);
+    gs.activeTexture(GL_TEXTURE0);
+
+    // 标记条以上区域复制到纹理（画面尺寸变化时重新分配）
+    if (copyWidth_ != width || copyHeight_ != contentHeight) {
+        gs.bindTexture(GL_TEXTURE_2D, copyTexture_);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, std::max(1, contentHeight), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        copyWidth_ = width;
+        copyHeight_ = contentHeight;
+    }
+    if (contentHeight > 0) {
+        gs.bindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+        glReadBuffer(readBuffer);
+        gs.bindFramebuffer(GL_DRAW_FRAMEBUFFER, copyFbo_);
+        glBlitFramebuffer(0, height - contentHeight, width, height, 0, 0, width, contentHeight, GL_COLOR_BUFFER_BIT,
+                          GL_NEAREST);
+    }
+
+    gs.bindFramebuffer(GL_FRAMEBUFFER, cellFbo_);
+    gs.viewport(0, 0, 4 * kSubCells, 2 * kSubCells);
+    cellShader_->use();
+    cellShader_->set(uCellSrc_, 0);
+    cellShader_->set(uCellWidth_, width);
+    cellShader_->set(uCellHeight_, contentHeight);
+    gs.bindTexture(GL_TEXTURE_2D, copyTexture_);
+    gs.drawArrays(GL_TRIANGLES, 0, 3);
+
+    gs.bindFramebuffer(GL_FRAMEBUFFER, signFbo_);
+    gs.viewport(0, 0, 1, 1);
+    signShader_->use();
+    signShader_->set(uSignCells_, 0);
+    signShader_->set(uSignWidth_, width);
+    signShader_->set(uSignHeight_, contentHeight);
+    signShader_->set(uSignFrame_, static_cast<int>(frame));
+    gs.bindTexture(GL_TEXTURE_2D, cellTexture_);
+    gs.drawArrays(GL_TRIANGLES, 0, 3);
+
+    gs.bindFramebuffer(GL_FRAMEBUFFER, fbo);
+    gs.viewport(0, 0, width, height);
+    gs.enable(GL_SCISSOR_TEST);
+    glScissor(s.x0, height - s.y1, s.x1 - s.x0, s.y1 - s.y0);
+    stripShader_->use();
+    stripShader_->set(uStripSig_, 0);
+    stripShader_->set(uStripWidth_, width);
+    stripShader_->set(uStripHeight_, height);
+    stripShader_->set(uStripFrame_, static_cast<int>(frame));
+    gs.bindTexture(GL_TEXTURE_2D, signTexture_);
+    gs.drawArrays(GL_TRIANGLES, 0, 3);
+    gs.disable(GL_SCISSOR_TEST);
+}
@@ -0,0 +1,186 @@
+#include "noise_hash.h"
+#include "shader.h"
+
+#include <algorithm>
+#include <cmath>
+
+const std::string kNoiseHashGlsl = R"(
+// ---- 整数哈希库（PCG3D / xxhash32）：各厂商结果一致，大坐标下不退化 ----
+uvec3 pcg3d(uvec3 v) {
+    v = v * 1664525u + 1013904223u;
+    v.x += v.y * v.z; v.y += v.z * v.x; v.z += v.x * v.y;
+    v ^= v >> 16u;
+    v.x += v.y * v.z; v.y += v.z * v.x; v.z += v.x * v.y;
+    return v;
+}
+
+uint xxhash32(uvec3 p) {
+    const uint P2 = 2246822519u, P3 = 3266489917u, P4 = 668265263u, P5 = 374761393u;
+    uint h = p.z + P5 + p.x * P3;
+    h = P4 * ((h << 17u) | (h >> 15u));
+    h += p.y * P3;
+    h = P4 * ((h << 17u) | (h >> 15u));
+    h = P2 * (h ^ (h >> 15u));
+    h = P3 * (h ^ (h >> 13u));
+    return h ^ (h >> 16u);
+}
+
+// 取高 24 位映射到 [0,1)（float 可精确表示）
+float hashToUnit(uint h) { return float(h >> 8u) * (1.0 / 16777216.0); }
+vec3 hashToUnit(uvec3 h) { return vec3(h >> 8u) * (1.0 / 16777216.0); }
+
+// 像素格 + 种子 -> 单通道 / 三通道均匀随机
+float hash1(ivec2 cell, uint seed) { return hashToUnit(xxhash32(uvec3(uvec2(cell), seed))); }
+vec3 hash3(ivec2 cell, uint seed) { return hashToUnit(pcg3d(uvec3(uvec2(cell), seed))); }
+)";
+
+namespace {
+const char* kBenchVertexShader = R"(#version 330 core
+void main() {
+    // 全屏三角形（无需顶点缓冲）
+    vec2 p = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+const char* kBenchFragmentShader = R"(#version 330 core
+uniform int uHashKind;   // 0: fract(sin), 1: pcg3d, 2: xxhash32
+uniform int uIterations;
+uniform vec2 uOffset;    // 坐标偏移（测试大坐标退化）
+out uvec4 FragOut;
+
+uint evalHash(vec2 p, uint i) {
+    if (uHashKind == 0) {
+        float f = fract(sin(dot(p, vec2(12.9898, 78.233)) + float(i) * 0.618) * 43758.5453);
+        return uint(f * 16777216.0) << 8u;
+    } else if (uHashKind == 1) {
+        return pcg3d(uvec3(uvec2(ivec2(p)), i)).x;
+    }
+    return xxhash32(uvec3(uvec2(ivec2(p)), i));
+}
+
+void main() {
+    vec2 p = floor(gl_FragCoord.xy) + uOffset;
+    uint acc = 0u;
+    for (int i = 0; i < uIterations; ++i) acc ^= evalHash(p, uint(i));
+    FragOut = uvec4(acc, 0u, 0u, 1u);
+}
+)";
+
+struct Stats { double chi2PerDof; double maxBitBias; double adjCorr; };
+
+Stats analyzeCodes(const std::vector<uint32_t>& px, int w, int h) {
+    // 取高 10 位作为码值（与 q10 量化对应）
+    std::vector<uint32_t> hist(1024, 0);
+    uint64_t ones[10] = {};
+    double sx = 0, sy = 0, sxx = 0, syy = 0, sxy = 0; long long pairs = 0;
+    for (int y = 0; y < h; ++y) {
+        const uint32_t* row = px.data() + static_cast<size_t>(y) * w;
+        for (int x = 0; x < w; ++x) {
+            uint32_t c = row[x] >> 22;
+            ++hist[c];
+            for (int b = 0; b < 10; ++b) ones[b] += (c >> b) & 1u;
+            if (x + 1 < w) {
+                double a = c, n = row[x + 1] >> 22;
+                sx += a; sy += n; sxx += a * a; syy += n * n; sxy += a * n; ++pairs;
+            }
+        }
+    }
+    const double total = static_cast<double>(w) * h;
+    const double expected = total / 1024.0;
+    double chi2 = 0.0;
+    for (uint32_t v : hist) { double d = v - expected; chi2 += d * d / expected; }
+    double bias = 0.0;
+    for (int b = 0; b < 10; ++b) bias = std::max(bias, std::abs(ones[b] / total - 0.5));
+    double corr = 0.0;
+    if (pairs > 1) {
+        double n = static_cast<double>(pairs);
+        double cov = sxy / n - (sx / n) * (sy / n);
+        double vx = sxx / n - (sx / n) * (sx / n);
+        double vy = syy / n - (sy / n) * (sy / n);
+        if (vx > 0 && vy > 0) corr = cov / std::sqrt(vx * vy);
+    }
+    return {chi2 / 1023.0, bias, corr};
+}
+} // namespace
+
+std::vector<NoiseHashBench::Result> NoiseHashBench::Run(int width, int height) {
+    std::vector<Result> results;
+    if (width <= 0 || height <= 0) return results;
+
+    Shader prog(kBenchVertexShader, Shader::insertAfterVersion(kBenchFragmentShader, kNoiseHashGlsl));
+    const UniformInt uKind = prog.uniformInt("uHashKind");
+    const UniformInt uIter = prog.uniformInt("uIterations");
+    const UniformVec2 uOff = prog.uniformVec2("uOffset");
+
+    GLuint tex = 0, fbo = 0, vao = 0, query = 0;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, width, height, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+    glGenVertexArrays(1, &vao);
+    glGenQueries(1, &query);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE) {
+        glViewport(0, 0, width, height);
+        glDisable(GL_BLEND);
+        prog.use();
+        glBindVertexArray(vao);
+
+        // 单次绘制的 GPU 耗时（ns），取多次最小值降低噪声
+        auto timeDraw = [&](int iterations) {
+            prog.set(uIter, iterations);
+            GLuint64 best = ~GLuint64(0);
+            for (int rep = 0; rep < 4; ++rep) {
+                glBeginQuery(GL_TIME_ELAPSED, query);
+                glDrawArrays(GL_TRIANGLES, 0, 3);
+                glEndQuery(GL_TIME_ELAPSED);
+                GLuint64 ns = 0;
+                glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+                best = std::min(best, ns);
+            }
+            return static_cast<double>(best);
+        };
+
+        const char* names[] = {"fract(sin)", "pcg3d", "xxhash32"};
+        const int kLoop = 64;
+        const double pixels = static_cast<double>(width) * height;
+        std::vector<uint32_t> px(static_cast<size_t>(width) * height);
+        for (int kind = 0; kind < 3; ++kind) {
+            prog.set(uKind, kind);
+            prog.set(uOff, 0.0f, 0.0f);
+            double t1 = timeDraw(1);
+            double tN = timeDraw(kLoop);
+            double perHash = std::max(0.0, (tN - t1) / (kLoop - 1)) / pixels;
+            for (int large = 0; large < 2; ++large) {
+                // 大坐标：约 4M 像素偏移，仍在 float 可精确表示的整数范围内
+                prog.set(uOff, large ? 4000000.0f : 0.0f, large ? 3000000.0f : 0.0f);
+                prog.set(uIter, 1);
+                glDrawArrays(GL_TRIANGLES, 0, 3);
+                glReadPixels(0, 0, width, height, GL_RED_INTEGER, GL_UNSIGNED_INT, px.data());
+                Stats st = analyzeCodes(px, width, height);
+                Result r;
+                r.name = names[kind];
+                r.largeCoords = large != 0;
+                r.nsPerHashPx = perHash;
+                r.chi2PerDof = st.chi2PerDof;
+                r.maxBitBias = st.maxBitBias;
+                r.adjCorr = st.adjCorr;
+                results.push_back(r);
+            }
+        }
+    }
+
+    glBindVertexArray(0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteQueries(1, &query);
+    glDeleteVertexArrays(1, &vao);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &tex);
+    return results;
+}
@@ -0,0 +1,634 @@
+#include "patterns.h"
+#include "shader.h"
+#include "noise_hash.h"
+#include "philox.h"
+
+// 着色器源码定义（主背景/内容）
+const std::string kPatternVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec2 aPos;       // NDC 顶点坐标 [-1,1]
+layout (location = 1) in vec2 aTexCoord;  // 纹理坐标 [0,1]
+
+out vec2 TexCoord;
+
+void main()
+{
+    gl_Position = vec4(aPos, 0.0, 1.0);
+    TexCoord = aTexCoord;
+}
+)";
+
+const std::string kPatternFragmentShader = R"(
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoord;
+
+// 每帧状态（std140，单次上传；布局与 C++ 侧 FrameUniforms 一致）
+layout(std140) uniform FrameBlock {
+    float uTime;
+    int uFrameIndex;   // frame counter to force per-frame changes
+    int uCategory;     // 0: STATIC, 1: DYNAMIC, 2: AUX
+    int uContentMode;
+    vec2 uResolution;
+    int uQuantBits;    // 12: 深色输出（12 bpc / FP16）改用 q12
+};
+uniform int uColorVariation; // -1: 覆盖层半透明面板
+
+// 10-bit 量化（0..1023）
+float q10(float v) { return clamp(floor(clamp(v,0.0,1.0) * 1023.0 + 0.5) / 1023.0, 0.0, 1.0); }
+// 12-bit 量化（0..4095）：12 bpc 与 FP16 帧缓冲下让低 2 位同样到达链路
+float q12(float v) { return clamp(floor(clamp(v,0.0,1.0) * 4095.0 + 0.5) / 4095.0, 0.0, 1.0); }
+vec3 quantize(vec3 c) {
+    return uQuantBits >= 12 ? vec3(q12(c.r), q12(c.g), q12(c.b)) : vec3(q10(c.r), q10(c.g), q10(c.b));
+}
+
+vec3 hsv2rgb(vec3 c){
+    vec3 p = abs(fract(vec3(c.x,c.x,c.x) + vec3(0.0,2.0/3.0,1.0/3.0)) * 6.0 - 3.0);
+    vec3 rgb = clamp(p - 1.0, 0.0, 1.0);
+    return c.z * mix(vec3(1.0), rgb, c.y);
+}
+
+// 前置声明：在 generateComplexColor 中调用到的函数（定义在后文）
+vec3 bitPlaneFlicker(vec2 uv, float time);
+
+// 分区渐变颜色（避免硬切换），用于增加不可压缩性。fr 为整数帧序（uFrameIndex）：
+// 浮点帧计数超过 2^24 后相邻帧取整相同，哈希不再逐帧变化
+vec3 tileGradColor(vec2 uv, float time, uint fr){
+    vec2 p = uv * uResolution;
+    // 两套偏移网格，错位避免与编码 slice 对齐
+    vec2 spA = vec2(32.0, 28.0);
+    vec2 spB = vec2(36.0, 24.0);
+    vec2 idxA = floor(p / spA);
+    vec2 idxB = floor((p + vec2(16.0,12.0)) / spB);
+    // 两套网格索引 + 帧序级联哈希
+    uint hB = xxhash32(uvec3(uvec2(ivec2(idxB)), fr));
+    float seed = hashToUnit(xxhash32(uvec3(uvec2(ivec2(idxA)), hB)));
+    float hue = fract(seed + 0.123 * sin(dot(idxA, vec2(3.1,5.7))) + 0.071 * sin(dot(idxB, vec2(2.3,4.9))));
+    vec2 localA = fract(p / spA);
+    vec2 localB = fract((p + vec2(16.0,12.0)) / spB);
+    float g = clamp(localA.x * 0.6 + localB.y * 0.4, 0.0, 1.0);
+    float sat = 0.88;
+    float val = 0.70 + 0.30 * g; // 单帧渐变
+    return hsv2rgb(vec3(hue, sat, val));
+}
+
+// RGB->HSV（h:[0,1), s,v:[0,1]）
+
+// 高熵颜色场（避免大块重复色）
+vec3 generateComplexColor(vec2 uv, float time, int variation) {
+    if (variation == -1) return vec3(0.0);
+    vec2 p = uv * uResolution;
+    float t = time;
+    float pf = float(uFrameIndex);
+    float tf = t + pf * 0.031; // per-frame phase offset
+
+    // 基础哈希（整数哈希，像素格 + 帧序为种子，逐帧去相关）
+    uint fr = uint(uFrameIndex);
+    ivec2 ip = ivec2(floor(p));
+    vec3 hb = hash3(ip, fr);
+    float h1 = hb.x, h2 = hb.y, h3 = hb.z;
+
+    vec3 c;
+    if (variation == 0) {
+        // 色轮#1：经典 HSV 轮，缓慢旋转
+        vec2 d = (uv - 0.5) * 2.0; float r = length(d);
+        float rot = t * 0.06;
+        float h = fract((atan(d.y,d.x) / 6.2831853) + 1.0 + rot);
+        float v2 = clamp(1.0 - r * 0.2, 0.0, 1.0);
+        c = hsv2rgb(vec3(h, 0.9, v2));
+    } else if (variation == 1) {
+        // 多尺度哈希混合（噪声#1）
+        vec2 p2 = p * 0.5; vec2 p3 = p * 2.7;
+        float m1 = hash1(ivec2(floor(p2)), fr * 2u + 1u);
+        float m2 = hash1(ivec2(floor(p3)), fr * 2u + 2u);
+        c = vec3(mix(h1, m1, 0.5), mix(h2, m2, 0.5), mix(h3, h1, 0.5));
+    } else if (variation == 2) {
+        // 频谱混合（中频条纹，三通道不同朝向/频率）
+        float sr = 0.5 + 0.5 * sin(6.28318 * (uv.x * 38.0 + uv.y * 5.0) + tf * 2.0);
+        float sg = 0.5 + 0.5 * sin(6.28318 * (uv.x * 7.0  + uv.y * 33.0) - tf * 1.7);
+        float sb = 0.5 + 0.5 * sin(6.28318 * (uv.x * 0.0  + uv.y * 41.0) + tf * 2.6);
+        c = vec3(sr, sg, sb);
+    } else if (variation == 3) {
+        // 蓝噪声滚动（整数哈希，大坐标下无需取模）；颜色采用单帧渐变映射
+        vec2 pp = p * 0.5 + vec2(tf * 12.0, tf * 9.4);
+        ivec2 cell = ivec2(floor(pp));
+        float n1 = hash1(cell, 0x3A1Fu);
+        float n2 = hash1(cell, 0x7C2Bu);
+        float v = clamp((n1 * 0.7 + n2 * 0.3), 0.0, 1.0);
+        // 使用 v->hue 的渐变映射，避免颜色切换，帧间运动靠 pp 滚动实现
+        float hue = v;
+        c = hsv2rgb(vec3(hue, 0.9, 0.95));
+    } else if (variation == 4) {
+        // 径向扰动 + 旋涡条纹（与区域板区分：更强调角向旋涡）
+        vec2 d = (uv - 0.5) * 2.0;
+        float r = length(d);
+        float a = atan(d.y, d.x);
+        float a2 = a + r * 3.0 + tf * 0.4;
+        float v1 = 0.5 + 0.5 * sin(180.0 * a2);
+        float v2 = 0.5 + 0.5 * sin(120.0 * (r + 0.3 * a2) + tf * 1.7);
+        float v3 = 0.5 + 0.5 * sin(90.0  * (r - 0.2 * a2) - tf * 1.1);
+        c = vec3(v1, v2, v3);
+    } else if (variation == 5) {
+        // 区域板动态（Zoneplate Dynamic）：更丰富的渐变色，强调径向频率+角向相位
+        vec2 d = (uv - 0.5) * 2.0;
+        float r = length(d);
+        float a = atan(d.y, d.x);
+        float aN = (a / 6.2831853) + 1.0;
+        // 动态环频，随时间与帧序轻微变化，保证逐帧不同
+        float w = mix(80.0, 240.0, 0.5 + 0.5 * sin(tf * 0.27 + pf * 0.013));
+        float ring = 0.5 + 0.5 * sin(w * r * r + tf * 1.3 + pf * 0.11);
+        // 色相由角度、半径与环形相位共同决定，保证单帧内色彩丰富但连续
+        float hue = fract(0.28 * aN + 0.35 * r + 0.15 * ring + tf * 0.07 + pf * 0.017);
+        float sat = 0.75 + 0.25 * (0.5 + 0.5 * sin(6.0 * a + 3.0 * r + tf * 0.9 + pf * 0.05));
+        float val = 0.55 + 0.45 * ring;
+        c = hsv2rgb(vec3(hue, sat, val));
+    } else if (variation == 6) {
+        // 混合场（通道朝向/频段显著不同，拉大差异）
+        float rr = 0.5 + 0.5 * sin(6.28318 * (dot(uv, vec2( 1.0,  0.15)) * 45.0) + tf * 2.1);
+        float gg = 0.5 + 0.5 * sin(6.28318 * (dot(uv, vec2(-0.2,  1.00)) * 37.0) - tf * 1.8);
+        float bb = 0.5 + 0.5 * sin(6.28318 * (dot(uv, vec2( 0.9, -0.30)) * 53.0) + tf * 2.9);
+        c = vec3(rr, gg, bb);
+    } else if (variation == 7) {
+        // HSV 全色域覆盖（平滑，无抖动）
+        float h = fract(uv.x + uv.y + tf*0.35 + pf*0.123);
+        float s = 0.9;
+        float v = 0.9;
+        c = hsv2rgb(vec3(h,s,v));
+    } else if (variation == 8) {
+        // 谱梯度混合（平滑，无抖动）
+        float w = fract(uv.x*0.37 + uv.y*0.41 + tf*0.50 + pf*0.217);
+        vec3 a = vec3(1.0, 0.0, 0.5);
+        vec3 b2 = vec3(0.0, 1.0, 1.0);
+        c = mix(a, b2, w);
+    } else if (variation == 9) {
+        // Lissajous 色域轨迹（叠加噪声防止重复块）
+        float r = sin(uv.x*157.0 + tf*2.31 + pf*1.1) * sin(uv.y*133.0 - tf*1.77 + pf*0.7) * 0.5 + 0.5;
+        float g = sin(uv.x*141.0 - tf*2.07 + pf*0.9) * sin(uv.y*149.0 + tf*1.61 + pf*1.3) * 0.5 + 0.5;
+        float b = sin(uv.x*163.0 + tf*2.83 + pf*0.5) * sin(uv.y*127.0 - tf*1.29 + pf*1.7) * 0.5 + 0.5;
+        c = vec3(r,g,b);
+    } else if (variation == 10) {
+        // 位平面闪烁（Bit-Plane Flicker）：三通道不同位平面逐帧翻转
+        c = bitPlaneFlicker(uv, t);
+    } else if (variation == 11) {
+        // 时域色相扫动（平滑）：hue 随时间线性变化
+        float h = fract(uv.x + tf*0.55 + pf*0.21);
+        c = hsv2rgb(vec3(h, 0.85, 0.95));
+    } else if (variation == 12) {
+        // 三正弦全色域（平滑）：相位错开 120 度
+        float ph = tf*0.85 + pf*0.23;
+        float r = 0.5 + 0.5*sin(6.28318*(uv.x*0.23 + uv.y*0.31) + ph);
+        float g = 0.5 + 0.5*sin(6.28318*(uv.x*0.29 + uv.y*0.17) + ph + 2.094);
+        float b = 0.5 + 0.5*sin(6.28318*(uv.x*0.19 + uv.y*0.27) + ph + 4.188);
+        c = vec3(r,g,b);
+    } else if (variation == 13) {
+        // 伪 YUV->RGB 扫动（平滑）：Y 固定、UV 扫动
+        float Y = 0.7;
+        float U = sin(uv.x*3.0 + tf*1.2 + pf*0.7)*0.5;
+        float V = sin(uv.y*3.0 - tf*1.5 + pf*0.9)*0.5;
+        float R = clamp(Y + 1.13983*V, 0.0, 1.0);
+        float G = clamp(Y - 0.39465*U - 0.58060*V, 0.0, 1.0);
+        float B = clamp(Y + 2.03211*U, 0.0, 1.0);
+        c = vec3(R,G,B);
+    } else if (variation == 14) {
+        // Philox 计数器 RNG：每通道 10 bit 真随机、不可压缩，CPU 可逐位复现（用于回读校验）
+        return philoxCodes(ivec2(gl_FragCoord.xy), fr);
+    } else {
+        // 混合场（通道交错不同相位/尺度）
+        c = hash3(ip, fr ^ 0x5BD1E995u);
+    }
+
+    // 按输出位深量化（10 / 12 bit），降低压缩可预测性同时确保位深覆盖
+    c = quantize(c);
+    return c;
+}
+
+// 简化SMPTE彩条（横向8等分）
+vec3 colorBars(vec2 uv) {
+    float x = uv.x;
+    int idx = int(floor(x * 8.0));
+    if (idx == 0) return vec3(1.0, 1.0, 1.0);       // 白
+    if (idx == 1) return vec3(1.0, 1.0, 0.0);       // 黄
+    if (idx == 2) return vec3(0.0, 1.0, 1.0);       // 青
+    if (idx == 3) return vec3(0.0, 1.0, 0.0);       // 绿
+    if (idx == 4) return vec3(1.0, 0.0, 1.0);       // 品红
+    if (idx == 5) return vec3(1.0, 0.0, 0.0);       // 红
+    if (idx == 6) return vec3(0.0, 0.0, 1.0);       // 蓝
+    return vec3(0.0, 0.0, 0.0);                     // 黑
+}
+
+// 渐变与轻微噪声（观察色带/抖动）
+vec3 smoothGradient(vec2 uv, float time) {
+    float g = uv.x;
+    // 轻微蓝噪声，减少条带感
+    vec2 pixelPos = uv * uResolution;
+    float noise = hash1(ivec2(floor(pixelPos)), uint(uFrameIndex));
+    g = clamp(g + (noise - 0.5) * 0.01, 0.0, 1.0);
+    return vec3(g);
+}
+
+// 网格（32px间距，1px线宽）
+vec3 gridPattern(vec2 uv, float time) {
+    vec2 p = uv * uResolution;
+    float spacing = 32.0;
+    float lw = 1.0;
+    float fx = fract(p.x / spacing);
+    float fy = fract(p.y / spacing);
+    float mask = (fx < lw / spacing || fy < lw / spacing) ? 1.0 : 0.0;
+    // 背景微动态，避免静态压缩
+    float bg = 0.10 + 0.05 * sin(time * 0.6);
+    return mix(vec3(bg), vec3(1.0), mask);
+}
+
+// 移动竖向亮条（测试拖影/过冲）
+vec3 movingBar(vec2 uv, float time) {
+    float speed = 0.25; // 周期约4秒
+    float pos = fract(time * speed);
+    float dx = abs(uv.x - pos);
+    dx = min(dx, 1.0 - dx); // 环绕距离
+    float halfWidth = 0.05;
+    float bar = step(dx, halfWidth);
+    // 前缘加高亮边
+    float edge = smoothstep(halfWidth, halfWidth - 0.01, dx);
+    vec3 bg = vec3(0.0);
+    vec3 barColor = vec3(1.0);
+    vec3 edgeColor = vec3(1.0, 1.0, 0.3);
+    vec3 col = mix(bg, barColor, bar);
+    col = mix(col, edgeColor, edge * 0.6);
+    return col;
+}
+
+// UFO风格移动目标（多行不同速度，测试运动清晰度）
+vec3 ufoPattern(vec2 uv, float time) {
+    vec3 bg = vec3(0.02);
+    vec3 col = bg;
+    int rowCount = 3;
+    float sizeScale = 1.0;
+    for (int i = 0; i < rowCount; ++i) {
+        float y = mix(0.2, 0.8, (float(i) + 0.5) / float(rowCount));
+        float baseSpeed = mix(0.6, 2.5, float(i) / max(1.0, float(rowCount) - 1.0));
+        float pos = fract(time * baseSpeed);
+        vec2 c = vec2(pos, y);
+        // 椭圆飞船主体
+        vec2 d = (uv - c);
+        d.x *= 2.0; // 拉伸
+        float baseR = 0.08 * sizeScale;
+        float body = smoothstep(baseR, baseR - 0.005, length(d));
+        // 圆顶
+        vec2 domeD = uv - (c + vec2(0.0, 0.035 * sizeScale));
+        float dome = smoothstep(0.05 * sizeScale, 0.045 * sizeScale, length(domeD));
+        // 尾焰
+        float trail = exp(-abs(uv.x - c.x) * 30.0) * smoothstep(0.02 * sizeScale, 0.0, abs(uv.y - y));
+        vec3 ship = mix(vec3(0.1, 0.8, 1.0), vec3(1.0), dome) * 0.9;
+        vec3 shipBody = mix(vec3(0.1), vec3(0.9), body);
+        vec3 flame = vec3(1.0, 0.8, 0.2) * trail;
+        col = max(col, shipBody);
+        col = max(col, ship);
+        col = max(col, flame);
+    }
+    return col;
+}
+
+// 1px棋盘反相闪烁（时域极限，打满过渡）
+vec3 temporalFlip(vec2 uv, float time) {
+    vec2 p = uv * uResolution;
+    float cb = mod(floor(p.x) + floor(p.y), 2.0);
+    float flip = mod(floor(time * 120.0), 2.0); // 120Hz 反相
+    float v = abs(cb - flip);
+    return vec3(v);
+}
+
+// Zone plate（同心高频，覆盖各向频率）
+vec3 zonePlate(vec2 uv, float time) {
+    vec2 c = uv - vec2(0.5);
+    c *= 2.0;
+    float r2 = dot(c, c);
+    float w = 90.0; // 频率权重
+    float v = 0.5 + 0.5 * sin(w * r2 + time * 1.2);
+    // 三通道相移，避免等灰
+    float r = v;
+    float g = 0.5 + 0.5 * sin(w * r2 + time * 1.2 + 2.1);
+    float b = 0.5 + 0.5 * sin(w * r2 + time * 1.2 + 4.2);
+    return vec3(r, g, b);
+}
+
+// 位平面闪烁：在10bit量化上按位翻转（时域抖动）
+vec3 bitPlaneFlicker(vec2 uv, float time) {
+    float v = clamp(uv.x, 0.0, 1.0);
+    int q = int(floor(v * 1023.0 + 0.5));
+    int bitIdx = int(mod(floor(time * 2.0), 5.0)); // LSB..bit4 轮换
+    int phase = int(mod(floor(time * 120.0), 2.0));
+    if (phase == 1) {
+        q ^= (1 << bitIdx);
+    }
+    float outv = clamp(float(q) / 1023.0, 0.0, 1.0);
+    // 通道交错不同位平面
+    int bitIdxG = (bitIdx + 1) % 5;
+    int bitIdxB = (bitIdx + 2) % 5;
+    int qg = int(floor(uv.y * 1023.0 + 0.5));
+    int qb = int(floor(fract(uv.x + uv.y) * 1023.0 + 0.5));
+    if (phase == 1) { qg ^= (1 << bitIdxG); qb ^= (1 << bitIdxB); }
+    return vec3(outv, float(qg) / 1023.0, float(qb) / 1023.0);
+}
+
+// 彩色棋盘轮换：R/G/B 在棋盘上轮换，时域相位不同
+vec3 colorCheckerCycle(vec2 uv, float time) {
+    float s = 24.0;
+    vec2 cell = floor(uv * s);
+    float cb = mod(cell.x + cell.y, 2.0);
+    float phase = mod(floor(time * 2.0), 3.0);
+    vec3 c;
+    if (phase < 0.5) c = vec3(1.0, 0.0, 0.0);
+    else if (phase < 1.5) c = vec3(0.0, 1.0, 0.0);
+    else c = vec3(0.0, 0.0, 1.0);
+    return mix(vec3(0.0), c, cb);
+}
+
+// 蓝噪声滚动：高频伪蓝噪声，沿对角方向滚动
+vec3 blueNoiseScroll(vec2 uv, float time) {
+    vec2 p = uv * uResolution / 2.0 + vec2(time * 60.0, time * 47.0);
+    ivec2 cell = ivec2(floor(p));
+    float n = hash1(cell, 0x3A1Fu);
+    float n2 = hash1(cell, 0x7C2Bu);
+    float v = clamp((n * 0.7 + n2 * 0.3), 0.0, 1.0);
+    // 三通道相移 + 轻度时域抖动
+    float r = fract(v + 0.33);
+    float g = fract(v + 0.66);
+    float b = v;
+    return vec3(r, g, b);
+}
+
+// 径向相位扫频：动态改变径向频率，覆盖不同空间频率
+vec3 radialPhaseSweep(vec2 uv, float time) {
+    vec2 c = uv - vec2(0.5);
+    float r = length(c);
+    float k = mix(10.0, 250.0, 0.5 + 0.5 * sin(time * 0.7));
+    float v = 0.5 + 0.5 * sin(k * r + time * 2.0);
+    return vec3(v);
+}
+
+// 旋转楔形线：角向高频条纹，随时间旋转
+vec3 wedgeSpin(vec2 uv, float time) {
+    vec2 c = uv - vec2(0.5);
+    float a = atan(c.y, c.x) + time * 0.8;
+    float stripes = sin(a * 120.0);
+    float v = stripes > 0.0 ? 1.0 : 0.0;
+    return vec3(v);
+}
+// 棋盘格（高对比）
+vec3 checker(vec2 uv, float time) {
+    float s = 16.0; // 固定密度
+    vec2 gcell = floor(uv * s);
+    float cb = mod(gcell.x + gcell.y, 2.0);
+    return mix(vec3(0.0), vec3(1.0), cb);
+}
+
+// RGBW 全屏轮播
+vec3 rgbwCycle(float time) {
+    float t = floor(mod(time * 0.5, 4.0));
+    if (t < 0.5) return vec3(1.0, 0.0, 0.0);
+    else if (t < 1.5) return vec3(0.0, 1.0, 0.0);
+    else if (t < 2.5) return vec3(0.0, 0.0, 1.0);
+    else return vec3(1.0);
+}
+
+// Siemens Star（放射状楔形）
+vec3 siemensStar(vec2 uv) {
+    vec2 c = uv - vec2(0.5);
+    float a = atan(c.y, c.x);
+    float stripes = cos(a * 100.0);
+    float v = stripes > 0.0 ? 1.0 : 0.0;
+    return vec3(v);
+}
+
+// 水平分辨率楔形（沿X方向增加竖向条纹密度）
+vec3 horizWedge(vec2 uv) {
+    float k = 400.0;
+    float v = sin(k * uv.x * uv.x);
+    return vec3(v > 0.0 ? 1.0 : 0.0);
+}
+
+// 垂直分辨率楔形（沿Y方向增加横向条纹密度）
+vec3 vertWedge(vec2 uv) {
+    float k = 400.0;
+    float v = sin(k * uv.y * uv.y);
+    return vec3(v > 0.0 ? 1.0 : 0.0);
+}
+
+// 同心圆环（静态）
+vec3 concentricRings(vec2 uv) {
+    vec2 c = uv - vec2(0.5);
+    float r2 = dot(c, c);
+    float v = sin(120.0 * r2);
+    return vec3(v > 0.0 ? 1.0 : 0.0);
+}
+
+// 点栅格（网格点)
+vec3 dotGrid(vec2 uv) {
+    vec2 p = uv * uResolution;
+    vec2 g = fract(p / 16.0);
+    // 距离格点最近点
+    vec2 d = min(g, 1.0 - g);
+    float r = length((d - 0.5/16.0) * 16.0);
+    float dotv = smoothstep(0.15, 0.05, r);
+    return vec3(dotv);
+}
+
+// Gamma Checker（步进灰+嵌入棋盘）
+vec3 gammaChecker(vec2 uv) {
+    int steps = 8;
+    int idx = int(floor(uv.x * float(steps)));
+    float g = (float(idx) + 0.5) / float(steps);
+    // 内嵌棋盘
+    float n = 16.0;
+    vec2 p = uv * n;
+    float cb = mod(floor(p.x) + floor(p.y), 2.0);
+    float amp = 0.15; // 对比振幅
+    float v = clamp(g + (cb > 0.5 ? amp : -amp) * (1.0 - g) * g, 0.0, 1.0);
+    return vec3(v);
+}
+
+void main()
+{
+    vec2 uv = TexCoord;
+
+    // 半透明面板直接返回（避免受内容模式影响）
+    if (uColorVariation == -1) {
+        FragColor = vec4(0.0, 0.0, 0.0, 0.7);
+        return;
+    }
+
+    vec3 color;
+    if (uCategory == 0) {
+        // STATIC_GROUP: 常用静态测试图样
+        // 索引定义：
+        // 0: 彩条, 1: 灰阶渐变, 2: 16阶灰条, 3: 1px细棋盘, 4: 粗棋盘,
+        // 5: 32px网格, 6: 8px网格, 7: RGB竖条, 8: 十字/三分线,
+        // 9: 黑, 10: 白, 11: 红, 12: 绿, 13: 蓝, 14: 50%灰,
+        // 15: Siemens Star, 16: 水平楔形, 17: 垂直楔形, 18: 同心圆环, 19: 点栅格, 20: Gamma Checker
+        int idx = uContentMode;
+        if (idx == 0) {
+            color = colorBars(uv);
+        } else if (idx == 1) {
+            // 纯渐变（无抖动）
+            float g = clamp(uv.x, 0.0, 1.0);
+            color = vec3(g);
+        } else if (idx == 2) {
+            int steps = 16;
+            int bar = int(floor(uv.x * float(steps)));
+            float v = (float(bar) + 0.5) / float(steps);
+            color = vec3(v);
+        } else if (idx == 3) {
+            // 1px细棋盘
+            vec2 p = uv * uResolution;
+            float cb = mod(floor(p.x) + floor(p.y), 2.0);
+            color = vec3(cb);
+        } else if (idx == 4) {
+            color = checker(uv, uTime);
+        } else if (idx == 5) {
+            color = gridPattern(uv, 0.0);
+        } else if (idx == 6) {
+            // 8px网格
+            vec2 p = uv * uResolution; float spacing = 8.0; float lw = 1.0;
+            float fx = fract(p.x / spacing); float fy = fract(p.y / spacing);
+            float mask = (fx < lw / spacing || fy < lw / spacing) ? 1.0 : 0.0;
+            color = mix(vec3(0.15), vec3(1.0), mask);
+        } else if (idx == 7) {
+            // RGB 竖条（每3条循环）
+            int b = int(floor(uv.x * 90.0));
+            int m = b % 3;
+            if (m == 0) color = vec3(1.0, 0.0, 0.0);
+            else if (m == 1) color = vec3(0.0, 1.0, 0.0);
+            else color = vec3(0.0, 0.0, 1.0);
+        } else if (idx == 8) {
+            // 十字 + 三分线
+            vec2 p = uv * uResolution; float lw = 1.0;
+            float cx = abs(uv.x - 0.5) * uResolution.x; // 中心竖线
+            float cy = abs(uv.y - 0.5) * uResolution.y; // 中心横线
+            float t1x = abs(uv.x - 1.0/3.0) * uResolution.x;
+            float t2x = abs(uv.x - 2.0/3.0) * uResolution.x;
+            float t1y = abs(uv.y - 1.0/3.0) * uResolution.y;
+            float t2y = abs(uv.y - 2.0/3.0) * uResolution.y;
+            float line = 0.0;
+            line += step(cx, lw) + step(cy, lw);
+            line += step(t1x, lw) + step(t2x, lw) + step(t1y, lw) + step(t2y, lw);
+            color = mix(vec3(0.0), vec3(1.0), clamp(line, 0.0, 1.0));
+        } else if (idx == 9) {
+            color = vec3(0.0);
+        } else if (idx == 10) {
+            color = vec3(1.0);
+        } else if (idx == 11) {
+            color = vec3(1.0, 0.0, 0.0);
+        } else if (idx == 12) {
+            color = vec3(0.0, 1.0, 0.0);
+        } else if (idx == 13) {
+            color = vec3(0.0, 0.0, 1.0);
+        } else if (idx == 14) {
+            color = vec3(0.5);
+        } else if (idx == 15) {
+            color = siemensStar(uv);
+        } else if (idx == 16) {
+            color = horizWedge(uv);
+        } else if (idx == 17) {
+            color = vertWedge(uv);
+        } else if (idx == 18) {
+            color = concentricRings(uv);
+        } else if (idx == 19) {
+            color = dotGrid(uv);
+        } else if (idx == 20) {
+            color = gammaChecker(uv);
+        } else {
+            color = vec3(0.0);
+        }
+    } else if (uCategory == 1) {
+        // DYNAMIC_GROUP: 高熵带宽压力（避免重复色块，低可压缩性，10-bit 覆盖）
+        int idx = clamp(uContentMode, 0, 14);
+        color = generateComplexColor(uv, uTime, idx);
+    } else {
+        // AUX_GROUP: test‑ufo 对标；其余索引为 C++ 端绘制场景（绘制压力/上传带宽）的暗背景
+        if (uContentMode != 0) color = vec3(0.04 + 0.04 * uv.y);
+        else color = ufoPattern(uv, uTime);
+    }
+
+    FragColor = vec4(color, 1.0);
+}
+)";
+
+std::string patternFragmentSource() {
+    return Shader::insertAfterVersion(kPatternFragmentShader, kNoiseHashGlsl + kPhiloxGlsl);
+}
+
+namespace {
+struct PatternName { const char* zh; const char* en; };
+
+constexpr PatternName kStaticNames[kStaticPatternCount] = {
+    {"彩条", "Color Bars"},
+    {"灰阶渐变", "Gray Gradient"},
+    {"16阶灰条", "16-step Gray"},
+    {"细棋盘(1px)", "Fine Checker (1px)"},
+    {"粗棋盘", "Coarse Checker"},
+    {"网格32px", "Grid 32px"},
+    {"网格8px", "Grid 8px"},
+    {"RGB竖条", "RGB Stripes"},
+    {"十字+三分线", "Cross + Thirds"},
+    {"纯黑", "Black"},
+    {"纯白", "White"},
+    {"纯红", "Red"},
+    {"纯绿", "Green"},
+    {"纯蓝", "Blue"},
+    {"50%灰", "50% Gray"},
+    {"Siemens Star", "Siemens Star"},
+    {"水平楔形", "Horizontal Wedge"},
+    {"垂直楔形", "Vertical Wedge"},
+    {"同心圆环", "Concentric Rings"},
+    {"点栅格", "Dot Grid"},
+    {"Gamma Checker", "Gamma Checker"},
+};
+
+constexpr PatternName kDynamicNames[kDynamicPatternCount] = {
+    {"高熵: HSV 色轮", "HE: HSV Wheel"},
+    {"高熵: 多尺度哈希", "HE: Multi-Scale Hash"},
+    {"高熵: 频谱混合", "HE: Spectral Mix"},
+    {"高熵: 蓝噪声滚动", "HE: Blue-Noise Scroll"},
+    {"高熵: 径向扰动", "HE: Radial Turbulence"},
+    {"高熵: 区域板动态", "HE: Zoneplate Dynamic"},
+    {"高熵: 混合场", "HE: Mixed Field"},
+    {"高熵: HSV 全色域", "HE: HSV Full-Gamut"},
+    {"高熵: 谱梯度混合", "HE: Spectral Gradient"},
+    {"高熵: Lissajous 色域", "HE: Lissajous Field"},
+    {"高熵: 位平面闪烁", "HE: Bit-Plane Flicker"},
+    {"高熵: 色相扫动", "HE: Hue Sweep"},
+    {"高熵: 三正弦色域", "HE: Tri-Sine Gamut"},
+    {"高熵: YUV 扫动", "HE: YUV Sweep"},
+    {"高熵: Philox 计数器随机", "HE: Philox Counter RNG"},
+};
+
+constexpr PatternName kAuxNames[kAuxPatternCount] = {
+    {"辅助: UFO 运动", "Aux: UFO Motion"},
+    {"辅助: 绘制调用压力", "Aux: Draw-Call Stress"},
+    {"辅助: 上传带宽", "Aux: Upload Bandwidth"},
+};
+} // namespace
+
+int patternCount(int category) {
+    switch (category) {
+        case 0: return kStaticPatternCount;
+        case 1: return kDynamicPatternCount;
+        case 2: return kAuxPatternCount;
+    }
+    return 0;
+}
+
+const char* patternName(int category, int index, bool zh) {
+    const PatternName* table = nullptr;
+    int count = 0;
+    const char* fallbackZh = "图样";
+    const char* fallbackEn = "Pattern";
+    switch (category) {
+        case 0: table = kStaticNames; count = kStaticPatternCount; fallbackZh = "静态图样"; fallbackEn = "Static"; break;
+        case 1: table = kDynamicNames; count = kDynamicPatternCount; fallbackZh = "高熵"; fallbackEn = "High-Entropy"; break;
+        case 2: table = kAuxNames; count = kAuxPatternCount; fallbackZh = "辅助"; fallbackEn = "Aux"; break;
+    }
+    if (table && index >= 0 && index < count) return zh ? table[index].zh : table[index].en;
+    return zh ? fallbackZh : fallbackEn;
+}
@@ -0,0 +1,169 @@
+#include "philox.h"
+#include "readback_ring.h"
+#include "thread_pool.h"
+#include "trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DHT_HAS_AVX2_PATH 1
+#endif
+
+const std::string kPhiloxGlsl = R"(
+// ---- Philox4x32-10 计数器 RNG（GLSL 3.30 无 umulExtended，手工拆分 16 位求高位）----
+uvec2 mulHiLo32(uint a, uint b) {
+    uint a0 = a & 0xFFFFu, a1 = a >> 16u, b0 = b & 0xFFFFu, b1 = b >> 16u;
+    uint p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint mid = (p00 >> 16u) + (p01 & 0xFFFFu) + (p10 & 0xFFFFu);
+    uint hi = p11 + (p01 >> 16u) + (p10 >> 16u) + (mid >> 16u);
+    return uvec2(hi, a * b);
+}
+
+uvec4 philox4x32_10(uvec4 c) {
+    uvec2 k = uvec2(0x44485431u, 0x9E3779B9u);
+    for (int r = 0; r < 10; ++r) {
+        uvec2 p0 = mulHiLo32(0xD2511F53u, c.x);
+        uvec2 p1 = mulHiLo32(0xCD9E8D57u, c.z);
+        c = uvec4(p1.x ^ c.y ^ k.x, p1.y, p0.x ^ c.w ^ k.y, p0.y);
+        k += uvec2(0x9E3779B9u, 0xBB67AE85u);
+    }
+    return c;
+}
+
+// 计数器 (x, y, frame, 0)：每通道取高 10 位，CPU 可逐位复现
+vec3 philoxCodes(ivec2 pixel, uint frame) {
+    uvec4 r = philox4x32_10(uvec4(uvec2(pixel), frame, 0u));
+    return vec3(r.xyz >> 22u) / 1023.0;
+}
+)";
+
+namespace philox {
+
+#ifdef DHT_HAS_AVX2_PATH
+namespace {
+// 8 路 32x32->64 乘法：返回高 32 位，lo 输出低 32 位
+__attribute__((target("avx2"))) inline __m256i mulHiLo(__m256i a, __m256i m, __m256i& lo) {
+    lo = _mm256_mullo_epi32(a, m);
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(a, m), 32);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(m, 32));
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+__attribute__((target("avx2"))) void rowCodesAvx2(uint32_t frame, uint32_t y, uint32_t x0, uint32_t n, uint32_t* out) {
+    const __m256i M0 = _mm256_set1_epi32(static_cast<int>(0xD2511F53u));
+    const __m256i M1 = _mm256_set1_epi32(static_cast<int>(0xCD9E8D57u));
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i mask10 = _mm256_set1_epi32(0x3FF);
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i c0 = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(x0 + i)), lane);
+        __m256i c1 = _mm256_set1_epi32(static_cast<int>(y));
+        __m256i c2 = _mm256_set1_epi32(static_cast<int>(frame));
+        __m256i c3 = _mm256_setzero_si256();
+        uint32_t k0 = kKey0, k1 = kKey1;
+        for (int r = 0; r < 10; ++r) {
+            __m256i lo0, lo1;
+            __m256i hi0 = mulHiLo(c0, M0, lo0);
+            __m256i hi1 = mulHiLo(c2, M1, lo1);
+            __m256i n0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(static_cast<int>(k0)));
+            __m256i n2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(static_cast<int>(k1)));
+            c0 = n0; c1 = lo1; c2 = n2; c3 = lo0;
+            k0 += 0x9E3779B9u; k1 += 0xBB67AE85u;
+        }
+        __m256i r = _mm256_srli_epi32(c0, 22);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi32(c1, 12), _mm256_slli_epi32(mask10, 10));
+        __m256i b = _mm256_and_si256(_mm256_srli_epi32(c2, 2), _mm256_slli_epi32(mask10, 20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_or_si256(r, _mm256_or_si256(g, b)));
+    }
+    for (; i < n; ++i) out[i] = packedCodes(x0 + i, y, frame);
+}
+} // namespace
+#endif
+
+void rowCodes(uint32_t frame, uint32_t y, uint32_t x0, uint32_t n, uint32_t* out) {
+#ifdef DHT_HAS_AVX2_PATH
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    if (hasAvx2) {
+        rowCodesAvx2(frame, y, x0, n, out);
+        return;
+    }
+#endif
+    for (uint32_t i = 0; i < n; ++i) out[i] = packedCodes(x0 + i, y, frame);
+}
+
+} // namespace philox
+
+PhiloxVerifier::PhiloxVerifier() {
+    ring_ = std::make_unique<ReadbackRing>(kSlots, "philox verifier", [this](const ReadbackRing::Frame& f) {
+        if (f.data) verify(static_cast<uint32_t>(f.frame & 0x7fffffff), f.width, f.height,
+               f.type == GL_UNSIGNED_INT_2_10_10_10_REV ? 10 : 8, f.data);
+    });
+}
+
+PhiloxVerifier::~PhiloxVerifier() {
+    ring_.reset();
+}
+
+void PhiloxVerifier::capture(unsigned long long frame, GLuint fbo, GLenum readBuffer, int width, int height, int channelBits) {
+    ring_->capture(frame, "", fbo, readBuffer, width, height,
+                   channelBits >= 10 ? GL_UNSIGNED_INT_2_10_10_10_REV : GL_UNSIGNED_BYTE);
+}
+
+PhiloxVerifier::Stats PhiloxVerifier::stats() const {
+    Stats st;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        st = stats_;
+    }
+    st.skipped = ring_->skipped();
+    return st;
+}
+
+void PhiloxVerifier::reset() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    stats_ = Stats();
+}
+
+void PhiloxVerifier::verify(uint32_t frame, int width, int height, int channelBits, const uint32_t* pixels) {
+    DHT_TRACE_ZONE("philox verify");
+    auto t0 = std::chrono::high_resolution_clock::now();
+    const int w = width, h = height;
+    const bool tenBit = channelBits >= 10;
+    std::atomic<unsigned long long> mismatched{0};
+    ThreadPool::shared().parallelFor(static_cast<size_t>(h), 8, [&](size_t y0, size_t y1) {
+        DHT_TRACE_ZONE("philox rows");
+        // 各线程复用期望行缓冲，稳定后不再分配
+        thread_local std::vector<uint32_t> expect;
+        expect.resize(static_cast<size_t>(w));
+        unsigned long long bad = 0;
+        for (size_t y = y0; y < y1; ++y) {
+            philox::rowCodes(frame, static_cast<uint32_t>(y), 0u, static_cast<uint32_t>(w), expect.data());
+            const uint32_t* row = pixels + y * static_cast<size_t>(w);
+            if (tenBit) {
+                for (int x = 0; x < w; ++x) bad += ((row[x] & 0x3FFFFFFFu) != expect[x]);
+            } else {
+                // 8-bit 帧缓冲：码值 c 经 round(c*255/1023) 转换（不存在 .5 的平局）
+                for (int x = 0; x < w; ++x) {
+                    uint32_t e = expect[x];
+                    uint32_t r8 = ((e & 0x3FFu) * 255u + 511u) / 1023u;
+                    uint32_t g8 = (((e >> 10) & 0x3FFu) * 255u + 511u) / 1023u;
+                    uint32_t b8 = (((e >> 20) & 0x3FFu) * 255u + 511u) / 1023u;
+                    bad += ((row[x] & 0x00FFFFFFu) != (r8 | (g8 << 8) | (b8 << 16)));
+                }
+            }
+        }
+        mismatched.fetch_add(bad);
+    });
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+    std::lock_guard<std::mutex> lk(mutex_);
+    stats_.framesVerified++;
+    stats_.channelBits = channelBits;
+    stats_.lastVerifyMs = ms;
+    if (mismatched.load() > 0) {
+        stats_.framesMismatched++;
+        stats_.pixelsMismatched += mismatched.load();
+        stats_.lastMismatchFrame = frame;
+    }
+}
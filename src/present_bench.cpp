@@ -0,0 +1,82 @@
+#include "present_bench.h"
+#include "display_backend.h"
+#include "gl_state.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+constexpr int kWarmupFrames = 30;   // 模式/间隔切换后丢弃的帧（合成器重新配置、驱动队列稳定）
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    const size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p * (sorted.size() - 1) + 0.5));
+    return sorted[idx];
+}
+
+void presentFrame(DisplayBackend& backend, bool finish, double* swapMs) {
+    GLState& gs = GLState::get();
+    gs.bindFramebuffer(GL_FRAMEBUFFER, backend.defaultFramebuffer());
+    gs.viewport(0, 0, backend.width(), backend.height());
+    gs.clear(GL_COLOR_BUFFER_BIT);
+    if (finish) glFinish();
+    const auto t0 = std::chrono::steady_clock::now();
+    backend.swapBuffers();
+    const auto t1 = std::chrono::steady_clock::now();
+    backend.pollEvents();
+    if (swapMs) *swapMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+} // namespace
+
+std::vector<PresentBench::Result> PresentBench::Run(DisplayBackend& backend, int framesPerConfig, int restoreSwapInterval) {
+    std::vector<Result> results;
+    const bool startFullscreen = backend.fullscreen();
+    std::vector<bool> modes = {false};
+    if (!backend.headless()) modes.push_back(true);
+    std::vector<int> intervals = {0, 1};
+    if (backend.supportsAdaptiveVsync()) intervals.push_back(-1);
+
+    glClearColor(0.5f, 0.5f, 0.5f, 1.0f);
+    std::vector<double> swaps(static_cast<size_t>(framesPerConfig));
+    for (bool fullscreen : modes) {
+        if (!backend.setFullscreen(fullscreen) && fullscreen != backend.fullscreen()) continue;
+        for (int interval : intervals) {
+            backend.setSwapInterval(interval);
+            for (bool finish : {false, true}) {
+                for (int i = 0; i < kWarmupFrames && !backend.shouldClose(); ++i) presentFrame(backend, finish, nullptr);
+
+                const auto start = std::chrono::steady_clock::now();
+                int frames = 0;
+                for (; frames < framesPerConfig && !backend.shouldClose(); ++frames) {
+                    presentFrame(backend, finish, &swaps[frames]);
+                }
+                const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (frames == 0) continue;
+
+                Result r;
+                r.fullscreen = fullscreen;
+                r.swapInterval = interval;
+                r.finish = finish;
+                r.width = backend.width();
+                r.height = backend.height();
+                r.frames = frames;
+                r.loopFps = secs > 0.0 ? frames / secs : 0.0;
+                std::vector<double> sorted(swaps.begin(), swaps.begin() + frames);
+                std::sort(sorted.begin(), sorted.end());
+                double sum = 0.0, sumSq = 0.0;
+                for (double v : sorted) { sum += v; sumSq += v * v; }
+                r.swapMeanMs = sum / frames;
+                r.swapStdMs = std::sqrt(std::max(0.0, sumSq / frames - r.swapMeanMs * r.swapMeanMs));
+                r.swapP50Ms = percentile(sorted, 0.50);
+                r.swapP99Ms = percentile(sorted, 0.99);
+                r.swapMaxMs = sorted.back();
+                results.push_back(r);
+            }
+        }
+    }
+
+    backend.setFullscreen(startFullscreen);
+    backend.setSwapInterval(restoreSwapInterval);
+    return results;
+}
@@ -0,0 +1,16 @@
+#include "probes.h"
+
+#if defined(HAS_SDT)
+// USDT 信号量：bpftrace/perf 附加探针时递增，探针宏据此跳过参数求值
+#define DHT_DEFINE_PROBE_SEMAPHORE(name) \
+    __attribute__((section(".probes"))) volatile unsigned short DHT_PROBE_SEMAPHORE(name) = 0
+
+DHT_DEFINE_PROBE_SEMAPHORE(frame_start);
+DHT_DEFINE_PROBE_SEMAPHORE(render_submit);
+DHT_DEFINE_PROBE_SEMAPHORE(sleep_begin);
+DHT_DEFINE_PROBE_SEMAPHORE(sleep_end);
+DHT_DEFINE_PROBE_SEMAPHORE(swap_begin);
+DHT_DEFINE_PROBE_SEMAPHORE(swap_end);
+DHT_DEFINE_PROBE_SEMAPHORE(pattern_change);
+DHT_DEFINE_PROBE_SEMAPHORE(config_change);
+#endif
@@ -0,0 +1,176 @@
+#include "readback_ring.h"
+#include "gl_state.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <cstdio>
+
+ReadbackRing::ReadbackRing(int slots, const char* threadName, Handler handler)
+    : slots_(static_cast<size_t>(std::max(1, slots))), handler_(std::move(handler)) {
+    for (Slot& s : slots_) glGenBuffers(1, &s.pbo);
+    worker_ = std::thread([this, threadName] { workerLoop(threadName); });
+}
+
+ReadbackRing::~ReadbackRing() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        stop_ = true;
+        queue_.clear();
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+    GLState& gs = GLState::get();
+    for (Slot& s : slots_) {
+        if (s.state == SlotState::Mapped) {
+            gs.bindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        if (s.fence) glDeleteSync(s.fence);
+        gs.forgetBuffer(s.pbo);
+        glDeleteBuffers(1, &s.pbo);
+    }
+    gs.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+unsigned long long ReadbackRing::skipped() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return skipped_;
+}
+
+bool ReadbackRing::capture(unsigned long long frame, const char* pattern, GLuint fbo, GLenum readBuffer, int width, int height,
+                           GLenum type, Tiles tiles) {
+    poll(frame);
+    if (width <= 0 || height <= 0) return false;
+
+    auto it = std::find_if(slots_.begin(), slots_.end(), [](const Slot& s) { return s.state == SlotState::Free; });
+    if (it == slots_.end()) {
+        // 后台跟不上或驱动迟迟不完成围栏：宁可丢样本也不阻塞
+        std::lock_guard<std::mutex> lk(mutex_);
+        skipped_++;
+        return false;
+    }
+    Slot& slot = *it;
+    const int tile = tiles.grid > 0 ? std::min({tiles.size, width, height}) : 0;
+    slot.frame.frame = frame;
+    slot.frame.width = tile ? tile * tiles.grid : width;
+    slot.frame.height = tile ? tile * tiles.grid : height;
+    slot.frame.tileGrid = tile ? tiles.grid : 0;
+    slot.frame.type = type;
+    slot.frame.bytes = static_cast<size_t>(slot.frame.width) * slot.frame.height * 4;
+    std::snprintf(slot.frame.pattern, sizeof(slot.frame.pattern), "%s", pattern);
+
+    GLState& gs = GLState::get();
+    gs.bindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glReadBuffer(readBuffer);
+    gs.bindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    if (slot.capacity < slot.frame.bytes) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(slot.frame.bytes), nullptr, GL_STREAM_READ);
+        slot.capacity = slot.frame.bytes;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    if (tile) {
+        size_t offset = 0;
+        const size_t tileBytes = static_cast<size_t>(tile) * tile * 4;
+        for (int ty = 0; ty < tiles.grid; ++ty) {
+            for (int tx = 0; tx < tiles.grid; ++tx) {
+                const int x = tiles.grid > 1 ? (width - tile) * tx / (tiles.grid - 1) : 0;
+                const int y = tiles.grid > 1 ? (height - tile) * ty / (tiles.grid - 1) : 0;
+                glReadPixels(x, y, tile, tile, GL_RGBA, type, reinterpret_cast<void*>(offset));
+                offset += tileBytes;
+            }
+        }
+    } else {
+        glReadPixels(0, 0, width, height, GL_RGBA, type, nullptr);
+    }
+    // 其余代码按客户端内存回读，需恢复打包缓冲绑定
+    gs.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.state = SlotState::Pending;
+    pendingOrder_.push_back(static_cast<int>(it - slots_.begin()));
+    return true;
+}
+
+void ReadbackRing::poll(unsigned long long frame) {
+    lastFrame_ = frame;
+    retire();
+    mapReady(frame);
+}
+
+void ReadbackRing::flush() {
+    if (!pendingOrder_.empty()) {
+        glFinish();
+        mapReady(lastFrame_);
+    }
+    std::unique_lock<std::mutex> lk(mutex_);
+    doneCv_.wait(lk, [this] {
+        for (const Slot& s : slots_) {
+            if (s.state == SlotState::Mapped && !s.done) return false;
+        }
+        return true;
+    });
+}
+
+void ReadbackRing::mapReady(unsigned long long frame) {
+    GLState& gs = GLState::get();
+    // 只做零超时查询：未完成的围栏留到后续帧，按发起顺序映射以保证处理顺序
+    while (!pendingOrder_.empty()) {
+        Slot& slot = slots_[pendingOrder_.front()];
+        const GLenum r = glClientWaitSync(slot.fence, 0, 0);
+        if (r != GL_ALREADY_SIGNALED && r != GL_CONDITION_SATISFIED) break;
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        gs.bindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        slot.frame.data = static_cast<const uint32_t*>(
+            glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(slot.frame.bytes), GL_MAP_READ_BIT));
+        gs.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        slot.frame.lag = static_cast<unsigned>(frame - slot.frame.frame);
+        slot.done = false;
+        slot.state = SlotState::Mapped;
+        const int index = pendingOrder_.front();
+        pendingOrder_.pop_front();
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            queue_.push_back(index);
+        }
+        cv_.notify_one();
+    }
+}
+
+void ReadbackRing::retire() {
+    GLState& gs = GLState::get();
+    for (Slot& slot : slots_) {
+        if (slot.state != SlotState::Mapped) continue;
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            if (!slot.done) continue;
+        }
+        // 映射失败的槽无需解除映射
+        if (slot.frame.data) {
+            gs.bindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        slot.frame.data = nullptr;
+        slot.state = SlotState::Free;
+    }
+    gs.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void ReadbackRing::workerLoop(const char* threadName) {
+    trace::setThreadName(threadName);
+    for (;;) {
+        int index;
+        {
+            std::unique_lock<std::mutex> lk(mutex_);
+            cv_.wait(lk, [this] { return stop_ || !queue_.empty(); });
+            if (stop_) return;
+            index = queue_.front();
+            queue_.pop_front();
+        }
+        handler_(slots_[index].frame);
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            slots_[index].done = true;
+        }
+        doneCv_.notify_all();
+    }
+}
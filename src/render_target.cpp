@@ -0,0 +1,174 @@
+#include "render_target.h"
+#include "gl_state.h"
+
+#include <algorithm>
+
+namespace {
+const char* kResolveVertexShader = R"(#version 330 core
+void main() {
+    // 全屏三角形（无需顶点缓冲）
+    vec2 p = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+// 盒式滤波：目标像素覆盖的源像素区域取平均（线性 blit 在缩小超过 2 倍时只采 2x2，会混叠）
+const char* kResolveFragmentShader = R"(#version 330 core
+uniform sampler2D uSrc;
+uniform vec2 uScale;     // 源尺寸 / 目标尺寸
+out vec4 FragColor;
+
+void main() {
+    ivec2 srcSize = textureSize(uSrc, 0);
+    vec2 lo = (gl_FragCoord.xy - 0.5) * uScale;
+    vec2 hi = (gl_FragCoord.xy + 0.5) * uScale;
+    ivec2 p0 = clamp(ivec2(floor(lo)), ivec2(0), srcSize - 1);
+    ivec2 p1 = clamp(ivec2(ceil(hi)), p0 + 1, srcSize);
+    // 每轴最多 16 个采样（16K -> 720p 仍覆盖完整）
+    p1 = min(p1, p0 + 16);
+    vec4 acc = vec4(0.0);
+    for (int y = p0.y; y < p1.y; ++y)
+        for (int x = p0.x; x < p1.x; ++x)
+            acc += texelFetch(uSrc, ivec2(x, y), 0);
+    ivec2 n = p1 - p0;
+    FragColor = acc / float(n.x * n.y);
+}
+)";
+
+struct TexFormat { GLenum internal, format, type; };
+
+TexFormat texFormat(RenderTarget::Format f) {
+    switch (f) {
+        case RenderTarget::Format::RGB10_A2: return {GL_RGB10_A2, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV};
+        case RenderTarget::Format::RGBA16F:  return {GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT};
+        case RenderTarget::Format::RGBA8:    break;
+    }
+    return {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE};
+}
+} // namespace
+
+RenderTarget::~RenderTarget() {
+    release();
+    if (vao_) {
+        GLState::get().forgetVertexArray(vao_);
+        glDeleteVertexArrays(1, &vao_);
+    }
+}
+
+const char* RenderTarget::formatName(Format format) {
+    switch (format) {
+        case Format::RGBA8:    return "RGBA8";
+        case Format::RGB10_A2: return "RGB10_A2";
+        case Format::RGBA16F:  return "RGBA16F";
+    }
+    return "?";
+}
+
+size_t RenderTarget::bytesPerPixel(Format format) {
+    return format == Format::RGBA16F ? 8 : 4;
+}
+
+size_t RenderTarget::bytes() const {
+    return static_cast<size_t>(width_) * height_ * bytesPerPixel(format_);
+}
+
+int RenderTarget::channelBits() const {
+    return attachmentBits_ >= 10 ? 10 : 8;
+}
+
+int RenderTarget::maxDimension() {
+    // 上限在上下文生命周期内不变：首次调用时查询一次，帧循环中不再发出 glGet（部分驱动上为同步点）
+    static const int maxDim = [] {
+        GLint maxTex = 0;
+        GLint maxVp[2] = {0, 0};
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTex);
+        glGetIntegerv(GL_MAX_VIEWPORT_DIMS, maxVp);
+        return std::max(1, std::min({maxTex, maxVp[0], maxVp[1]}));
+    }();
+    return maxDim;
+}
+
+bool RenderTarget::ensure(int width, int height, Format format) {
+    if (width <= 0 || height <= 0) return false;
+    if (fbo_ && width == width_ && height == height_ && format == format_) return true;
+    release();
+
+    GLState& gs = GLState::get();
+    // 清空之前的错误，以便检测分配失败（GL_OUT_OF_MEMORY）
+    while (glGetError() != GL_NO_ERROR) {}
+
+    const TexFormat tf = texFormat(format);
+    glGenTextures(1, &color_);
+    gs.activeTexture(GL_TEXTURE0);
+    gs.bindTexture(GL_TEXTURE_2D, color_);
+    glTexImage2D(GL_TEXTURE_2D, 0, tf.internal, width, height, 0, tf.format, tf.type, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glGenFramebuffers(1, &fbo_);
+    gs.bindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color_, 0);
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    const bool allocated = glGetError() == GL_NO_ERROR;
+    // 驱动可能以更低精度的内部格式实现请求的格式，位数以附件查询为准
+    GLint bits[3] = {0, 0, 0};
+    if (complete) {
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE, &bits[0]);
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_GREEN_SIZE, &bits[1]);
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_BLUE_SIZE, &bits[2]);
+    }
+    gs.bindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (!complete || !allocated) {
+        release();
+        return false;
+    }
+    width_ = width;
+    height_ = height;
+    format_ = format;
+    attachmentBits_ = std::min({bits[0], bits[1], bits[2]});
+
+    if (!resolveShader_) {
+        resolveShader_ = std::make_unique<Shader>(kResolveVertexShader, kResolveFragmentShader);
+        uSrc_ = resolveShader_->uniformInt("uSrc");
+        uScale_ = resolveShader_->uniformVec2("uScale");
+        glGenVertexArrays(1, &vao_);
+    }
+    return true;
+}
+
+void RenderTarget::release() {
+    GLState& gs = GLState::get();
+    if (fbo_) {
+        gs.forgetFramebuffer(fbo_);
+        glDeleteFramebuffers(1, &fbo_);
+        fbo_ = 0;
+    }
+    if (color_) {
+        gs.forgetTexture(color_);
+        glDeleteTextures(1, &color_);
+        color_ = 0;
+    }
+    width_ = height_ = 0;
+    attachmentBits_ = 0;
+}
+
+void RenderTarget::bind() const {
+    GLState& gs = GLState::get();
+    gs.bindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    gs.viewport(0, 0, width_, height_);
+}
+
+void RenderTarget::resolveTo(GLuint dstFramebuffer, int dstWidth, int dstHeight) {
+    if (!fbo_ || dstWidth <= 0 || dstHeight <= 0) return;
+    GLState& gs = GLState::get();
+    gs.bindFramebuffer(GL_FRAMEBUFFER, dstFramebuffer);
+    gs.viewport(0, 0, dstWidth, dstHeight);
+    gs.disable(GL_BLEND);
+    resolveShader_->use();
+    resolveShader_->set(uSrc_, 0);
+    resolveShader_->set(uScale_, static_cast<float>(width_) / dstWidth, static_cast<float>(height_) / dstHeight);
+    gs.activeTexture(GL_TEXTURE0);
+    gs.bindTexture(GL_TEXTURE_2D, color_);
+    gs.bindVertexArray(vao_);
+    gs.drawArrays(GL_TRIANGLES, 0, 3);
+}
@@ -1,4 +1,7 @@
 #include "shader.h"
+#include "gl_state.h"
+#include "gl_debug.h"
+#include <algorithm>
 #include <sstream>
 
 Shader::Shader(const std::string& vertexSource, const std::string& fragmentSource) {
@@ -11,32 +14,72 @@ Shader::Shader(const std::string& vertexSource, const std::string& fragmentSourc
     checkCompileErrors(programID, "PROGRAM");
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
+    collectUniforms();
 }
 
 Shader::~Shader() {
-    if (programID != 0) glDeleteProgram(programID);
+    if (programID != 0) {
+        GLState::get().forgetProgram(programID);
+        glDeleteProgram(programID);
+    }
 }
 
-void Shader::use() const { glUseProgram(programID); }
+void Shader::use() const { GLState::get().useProgram(programID); }
 
 void Shader::setFloat(const std::string& name, float value) const {
-    GLint location = glGetUniformLocation(programID, name.c_str());
-    if (location != -1) glUniform1f(location, value);
+    set(uniformFloat(name), value);
 }
 
 void Shader::setVec2(const std::string& name, float x, float y) const {
-    GLint location = glGetUniformLocation(programID, name.c_str());
-    if (location != -1) glUniform2f(location, x, y);
+    set(uniformVec2(name), x, y);
 }
 
 void Shader::setVec3(const std::string& name, float x, float y, float z) const {
-    GLint location = glGetUniformLocation(programID, name.c_str());
-    if (location != -1) glUniform3f(location, x, y, z);
+    set(uniformVec3(name), x, y, z);
 }
 
 void Shader::setInt(const std::string& name, int value) const {
-    GLint location = glGetUniformLocation(programID, name.c_str());
-    if (location != -1) glUniform1i(location, value);
+    set(uniformInt(name), value);
+}
+
+GLint Shader::location(const std::string& name) const {
+    auto it = uniformLocations.find(name);
+    return it != uniformLocations.end() ? it->second : -1;
+}
+
+void Shader::collectUniforms() {
+    uniformLocations.clear();
+    GLint linked = 0;
+    glGetProgramiv(programID, GL_LINK_STATUS, &linked);
+    if (!linked) return;
+    GLint count = 0, maxLen = 0;
+    glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLen);
+    std::string name(static_cast<size_t>(std::max(maxLen, 1)), '\0');
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei len = 0; GLint size = 0; GLenum type = 0;
+        glGetActiveUniform(programID, static_cast<GLuint>(i), maxLen, &len, &size, &type, name.data());
+        std::string n(name.data(), static_cast<size_t>(len));
+        // 数组 uniform 以 "name[0]" 形式返回，同时登记基名
+        if (n.size() > 3 && n.compare(n.size() - 3, 3, "[0]") == 0) n.resize(n.size() - 3);
+        GLint loc = glGetUniformLocation(programID, n.c_str());
+        if (loc != -1) uniformLocations[n] = loc; // uniform block 成员无 location
+    }
+}
+
+bool Shader::bindUniformBlock(const std::string& blockName, GLuint bindingPoint) const {
+    GLuint index = glGetUniformBlockIndex(programID, blockName.c_str());
+    if (index == GL_INVALID_INDEX) return false;
+    glUniformBlockBinding(programID, index, bindingPoint);
+    return true;
+}
+
+std::string Shader::insertAfterVersion(const std::string& source, const std::string& lib) {
+    size_t ver = source.find("#version");
+    if (ver == std::string::npos) return lib + source;
+    size_t eol = source.find('\n', ver);
+    if (eol == std::string::npos) return source + "\n" + lib;
+    return source.substr(0, eol + 1) + lib + source.substr(eol + 1);
 }
 
 GLuint Shader::compileShader(const std::string& source, GLenum shaderType) {
@@ -57,12 +100,15 @@ void Shader::checkCompileErrors(GLuint shader, const std::string& type) {
         if (!success) {
             glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
             std::cerr << "Shader compile error (" << type << "): " << infoLog << std::endl;
+            // 同时计入 KHR_debug 消息统计
+            gldebug::insert(GL_DEBUG_TYPE_ERROR, GL_DEBUG_SEVERITY_HIGH, infoLog);
         }
     } else {
         glGetProgramiv(shader, GL_LINK_STATUS, &success);
         if (!success) {
             glGetProgramInfoLog(shader, 1024, nullptr, infoLog);
             std::cerr << "Program link error: " << infoLog << std::endl;
+            gldebug::insert(GL_DEBUG_TYPE_ERROR, GL_DEBUG_SEVERITY_HIGH, infoLog);
         }
     }
 }
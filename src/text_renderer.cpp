@@ -1,4 +1,6 @@
 #include "text_renderer.h"
+#include "gl_state.h"
+#include "trace.h"
 #include <vector>
 #include <stdexcept>
 #include <cstring>
@@ -35,37 +37,33 @@ void main() {
 )";
 }
 
-static std::u32string Utf8ToUtf32Impl(const std::string& s) {
-    std::u32string out;
-    size_t i = 0, n = s.size();
-    while (i < n) {
-        unsigned char c = static_cast<unsigned char>(s[i]);
-        if (c < 0x80) {
-            out.push_back(c);
-            ++i;
-        } else if ((c >> 5) == 0x6 && i + 1 < n) {
-            char32_t cp = ((c & 0x1F) << 6) | (static_cast<unsigned char>(s[i+1]) & 0x3F);
-            out.push_back(cp);
-            i += 2;
-        } else if ((c >> 4) == 0xE && i + 2 < n) {
-            char32_t cp = ((c & 0x0F) << 12)
-                        | ((static_cast<unsigned char>(s[i+1]) & 0x3F) << 6)
-                        | (static_cast<unsigned char>(s[i+2]) & 0x3F);
-            out.push_back(cp);
-            i += 3;
-        } else if ((c >> 3) == 0x1E && i + 3 < n) {
-            char32_t cp = ((c & 0x07) << 18)
-                        | ((static_cast<unsigned char>(s[i+1]) & 0x3F) << 12)
-                        | ((static_cast<unsigned char>(s[i+2]) & 0x3F) << 6)
-                        | (static_cast<unsigned char>(s[i+3]) & 0x3F);
-            out.push_back(cp);
-            i += 4;
-        } else {
-            out.push_back(0xFFFD);
-            ++i;
-        }
+// 解码 s[i] 起的一个码点并前移 i；非法序列返回 U+FFFD 并前移 1 字节
+static char32_t DecodeUtf8(std::string_view s, size_t& i) {
+    const size_t n = s.size();
+    unsigned char c = static_cast<unsigned char>(s[i]);
+    if (c < 0x80) {
+        ++i;
+        return c;
+    } else if ((c >> 5) == 0x6 && i + 1 < n) {
+        char32_t cp = ((c & 0x1F) << 6) | (static_cast<unsigned char>(s[i+1]) & 0x3F);
+        i += 2;
+        return cp;
+    } else if ((c >> 4) == 0xE && i + 2 < n) {
+        char32_t cp = ((c & 0x0F) << 12)
+                    | ((static_cast<unsigned char>(s[i+1]) & 0x3F) << 6)
+                    | (static_cast<unsigned char>(s[i+2]) & 0x3F);
+        i += 3;
+        return cp;
+    } else if ((c >> 3) == 0x1E && i + 3 < n) {
+        char32_t cp = ((c & 0x07) << 18)
+                    | ((static_cast<unsigned char>(s[i+1]) & 0x3F) << 12)
+                    | ((static_cast<unsigned char>(s[i+2]) & 0x3F) << 6)
+                    | (static_cast<unsigned char>(s[i+3]) & 0x3F);
+        i += 4;
+        return cp;
     }
-    return out;
+    ++i;
+    return 0xFFFD;
 }
 
 TextRenderer::TextRenderer() = default;
@@ -73,11 +71,12 @@ TextRenderer::TextRenderer() = default;
 TextRenderer::~TextRenderer() {
     for (auto& kv : glyphCache_) {
         if (kv.second.textureId) {
+            GLState::get().forgetTexture(kv.second.textureId);
             glDeleteTextures(1, &kv.second.textureId);
         }
     }
-    if (vbo_) glDeleteBuffers(1, &vbo_);
-    if (vao_) glDeleteVertexArrays(1, &vao_);
+    if (vbo_) { GLState::get().forgetBuffer(vbo_); glDeleteBuffers(1, &vbo_); }
+    if (vao_) { GLState::get().forgetVertexArray(vao_); glDeleteVertexArrays(1, &vao_); }
     if (face_) { FT_Done_Face(face_); face_ = nullptr; }
     if (ft_)   { FT_Done_FreeType(ft_); ft_ = nullptr; }
 }
@@ -92,22 +91,28 @@ bool TextRenderer::Init(int screenWidth, int screenHeight) {
     }
     ftReady_ = true;
 
+    GLState& gs = GLState::get();
     glGenVertexArrays(1, &vao_);
     glGenBuffers(1, &vbo_);
-    glBindVertexArray(vao_);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
+    gs.bindVertexArray(vao_);
+    gs.bindBuffer(GL_ARRAY_BUFFER, vbo_);
+    gs.bufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
 
     shader_ = std::make_unique<Shader>(kTextVertexShader, kTextFragmentShader);
+    uScreenSize_ = shader_->uniformVec2("uScreenSize");
+    uTextColor_ = shader_->uniformVec3("uTextColor");
+    // 采样器固定使用纹理单元 0，只需设置一次
+    shader_->use();
+    shader_->set(shader_->uniformInt("uText"), 0);
+    screenSizeDirty_ = true;
     return true;
 }
 
 bool TextRenderer::LoadFont(const std::string& fontPath, int pixelHeight) {
     if (!ftReady_) return false;
+    DHT_TRACE_ZONE("LoadFont");
 
     if (face_) {
         FT_Done_Face(face_);
@@ -125,30 +130,34 @@ bool TextRenderer::LoadFont(const std::string& fontPath, int pixelHeight) {
     return true;
 }
 
-void TextRenderer::RenderText(const std::string& utf8Text, float x, float y, float scale,
+void TextRenderer::RenderText(std::string_view utf8Text, float x, float y, float scale,
                               float r, float g, float b) {
     if (!face_) return;
+    DHT_TRACE_ZONE("RenderText");
 
     shader_->use();
-    shader_->setVec2("uScreenSize", static_cast<float>(screenW_), static_cast<float>(screenH_));
-    shader_->setVec3("uTextColor", r, g, b);
-
-    glActiveTexture(GL_TEXTURE0);
-    GLint loc = glGetUniformLocation(shader_->getProgram(), "uText");
-    if (loc != -1) glUniform1i(loc, 0);
-
-    glBindVertexArray(vao_);
+    if (screenSizeDirty_) {
+        shader_->set(uScreenSize_, static_cast<float>(screenW_), static_cast<float>(screenH_));
+        screenSizeDirty_ = false;
+    }
+    shader_->set(uTextColor_, r, g, b);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // 状态经缓存下发：连续多段文本时只有首段真正切换
+    GLState& gs = GLState::get();
+    gs.activeTexture(GL_TEXTURE0);
+    gs.bindVertexArray(vao_);
+    gs.bindBuffer(GL_ARRAY_BUFFER, vbo_);
+    gs.enable(GL_BLEND);
+    gs.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    const std::u32string text32 = Utf8ToUtf32(utf8Text);
     float penX = x;
     float baseY = y;
 
-    for (char32_t cp : text32) {
-        if (!EnsureGlyphCached(cp)) continue;
-        const Character& ch = glyphCache_[cp];
+    // 逐码点就地解码，不构造临时 u32string（稳态下每帧零堆分配）
+    for (size_t i = 0; i < utf8Text.size();) {
+        const Character* glyph = EnsureGlyphCached(DecodeUtf8(utf8Text, i));
+        if (!glyph) continue;
+        const Character& ch = *glyph;
 
         float xpos = penX + static_cast<float>(ch.bearingX) * scale;
         float ypos = baseY - static_cast<float>(ch.bearingY) * scale;
@@ -166,29 +175,26 @@ void TextRenderer::RenderText(const std::string& utf8Text, float x, float y, flo
             { xpos + w, ypos + h, 1.0f, 0.0f }
         };
 
-        glBindTexture(GL_TEXTURE_2D, ch.textureId);
-
-        glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        gs.bindTexture(GL_TEXTURE_2D, ch.textureId);
+        // VBO 已在循环外绑定一次（原先每个字形都绑定/解绑）
+        gs.bufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+        gs.drawArrays(GL_TRIANGLES, 0, 6);
 
         penX += static_cast<float>(ch.advance >> 6) * scale;
     }
-
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glDisable(GL_BLEND);
+    // 不再逐次解绑/关闭混合：下一个使用者通过状态缓存设置自己需要的状态
 }
 
 void TextRenderer::SetScreenSize(int screenWidth, int screenHeight) {
     screenW_ = screenWidth;
     screenH_ = screenHeight;
+    screenSizeDirty_ = true;
 }
 
-std::u32string TextRenderer::Utf8ToUtf32(const std::string& utf8) {
-    return Utf8ToUtf32Impl(utf8);
+std::u32string TextRenderer::Utf8ToUtf32(std::string_view utf8) {
+    std::u32string out;
+    for (size_t i = 0; i < utf8.size();) out.push_back(DecodeUtf8(utf8, i));
+    return out;
 }
 
 float TextRenderer::GetLineHeightPx(float scale) const {
@@ -202,21 +208,22 @@ float TextRenderer::GetLineHeightPx(float scale) const {
     return static_cast<float>(fontPixelHeight_ > 0 ? fontPixelHeight_ * 1.2 : 24.0 * 1.2) * scale;
 }
 
-float TextRenderer::MeasureTextWidth(const std::string& utf8Text, float scale) {
-    const std::u32string text32 = Utf8ToUtf32(utf8Text);
+float TextRenderer::MeasureTextWidth(std::string_view utf8Text, float scale) {
     float widthPx = 0.0f;
     if (!face_) {
         // Rough estimate without font: 0.6em per character
-        widthPx = static_cast<float>(text32.size()) * (fontPixelHeight_ > 0 ? fontPixelHeight_ * 0.6f : 12.0f);
+        size_t count = 0;
+        for (size_t i = 0; i < utf8Text.size(); ++count) DecodeUtf8(utf8Text, i);
+        widthPx = static_cast<float>(count) * (fontPixelHeight_ > 0 ? fontPixelHeight_ * 0.6f : 12.0f);
         return widthPx * scale;
     }
-    for (char32_t cp : text32) {
-        if (!EnsureGlyphCached(cp)) {
+    for (size_t i = 0; i < utf8Text.size();) {
+        const Character* glyph = EnsureGlyphCached(DecodeUtf8(utf8Text, i));
+        if (!glyph) {
             widthPx += (fontPixelHeight_ > 0 ? fontPixelHeight_ * 0.5f : 10.0f);
             continue;
         }
-        const Character& ch = glyphCache_[cp];
-        widthPx += static_cast<float>(ch.advance >> 6);
+        widthPx += static_cast<float>(glyph->advance >> 6);
     }
     return widthPx * scale;
 }
@@ -238,27 +245,32 @@ float TextRenderer::GetDescenderPx(float scale) const {
     return static_cast<float>(fontPixelHeight_ > 0 ? fontPixelHeight_ * 0.2 : 5.0) * scale;
 }
 
-bool TextRenderer::EnsureGlyphCached(char32_t codepoint) {
-    if (glyphCache_.find(codepoint) != glyphCache_.end()) return true;
-    if (!face_) return false;
+const TextRenderer::Character* TextRenderer::EnsureGlyphCached(char32_t codepoint) {
+    auto it = glyphCache_.find(codepoint);
+    if (it != glyphCache_.end()) return &it->second;
+    if (!face_) return nullptr;
+    DHT_TRACE_ZONE("glyph raster");
 
     FT_UInt glyph_index = FT_Get_Char_Index(face_, codepoint);
     if (FT_Load_Char(face_, codepoint, FT_LOAD_RENDER)) {
-        if (codepoint != U'\u25A1' && EnsureGlyphCached(U'\u25A1')) {
-            glyphCache_[codepoint] = glyphCache_[U'\u25A1'];
-            return true;
+        if (codepoint != U'\u25A1') {
+            if (const Character* fallback = EnsureGlyphCached(U'\u25A1')) {
+                const Character copy = *fallback;
+                return &(glyphCache_[codepoint] = copy);
+            }
         }
-        return false;
+        return nullptr;
     }
 
     FT_GlyphSlot g = face_->glyph;
 
     GLuint tex = 0;
     glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
+    GLState::get().bindTexture(GL_TEXTURE_2D, tex);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RED,
                  g->bitmap.width, g->bitmap.rows,
                  0, GL_RED, GL_UNSIGNED_BYTE, g->bitmap.buffer);
+    GLState::get().countUpload(static_cast<size_t>(g->bitmap.width) * g->bitmap.rows);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -273,8 +285,5 @@ bool TextRenderer::EnsureGlyphCached(char32_t codepoint) {
     ch.bearingY = g->bitmap_top;
     ch.advance = g->advance.x;
 
-    glyphCache_[codepoint] = ch;
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-    return true;
+    return &(glyphCache_[codepoint] = ch);
 }
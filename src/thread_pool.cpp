@@ -0,0 +1,155 @@
+#include "thread_pool.h"
+#include "trace.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 1; i < threads; ++i) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& t : workers_) t.join();
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+uint64_t ThreadPool::popFront(std::atomic<uint64_t>& range) {
+    uint64_t v = range.load();
+    for (;;) {
+        const uint64_t begin = v & 0xFFFFFFFFu, end = v >> 32;
+        if (begin >= end) return kNoChunk;
+        if (range.compare_exchange_weak(v, (end << 32) | (begin + 1))) return begin;
+    }
+}
+
+uint64_t ThreadPool::steal(Job& job, unsigned self) {
+    for (;;) {
+        // 选剩余块最多的参与者，取其尾部一半（自己的区间此时已空，只有自己会写入）
+        unsigned victim = job.slots;
+        uint64_t most = 0, seen = 0;
+        for (unsigned i = 0; i < job.slots; ++i) {
+            if (i == self) continue;
+            const uint64_t v = job.ranges[i].load();
+            const uint64_t n = (v >> 32) > (v & 0xFFFFFFFFu) ? (v >> 32) - (v & 0xFFFFFFFFu) : 0;
+            if (n > most) { most = n; victim = i; seen = v; }
+        }
+        if (victim == job.slots) return kNoChunk;
+        const uint64_t begin = seen & 0xFFFFFFFFu, end = seen >> 32;
+        const uint64_t take = self < job.slots ? (most + 1) / 2 : 1;
+        if (!job.ranges[victim].compare_exchange_weak(seen, ((end - take) << 32) | begin)) continue;
+        if (take > 1) job.ranges[self].store((end << 32) | (end - take + 1));
+        return end - take;
+    }
+}
+
+void ThreadPool::runChunk(Job& job, uint64_t chunk) {
+    const size_t begin = static_cast<size_t>(chunk) * job.grain;
+    const size_t end = std::min(job.count, begin + job.grain);
+    (*job.fn)(begin, end);
+    if (job.done.fetch_add(end - begin) + (end - begin) == job.count) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        doneCv_.notify_all();
+    }
+}
+
+void ThreadPool::runJob(Job& job, unsigned generation) {
+    // 迟到的参与者（槽位已分完）没有自己的区间，只窃取。
+    // 工作线程在有新任务提交后让出（剩余块留给其他参与者窃取），回到队列优先帮最新的任务
+    const bool worker = generation != kCaller;
+    const auto preempted = [&] { return worker && submitted_.load(std::memory_order_relaxed) != generation; };
+    const unsigned self = job.nextSlot.fetch_add(1);
+    if (self < job.slots) {
+        for (uint64_t c; (c = popFront(job.ranges[self])) != kNoChunk;) {
+            runChunk(job, c);
+            if (preempted()) return;
+        }
+    }
+    for (;;) {
+        const uint64_t c = steal(job, self);
+        if (c == kNoChunk) return;
+        runChunk(job, c);
+        if (preempted()) return;
+        if (self < job.slots) {
+            for (uint64_t n; (n = popFront(job.ranges[self])) != kNoChunk;) {
+                runChunk(job, n);
+                if (preempted()) return;
+            }
+        }
+    }
+}
+
+bool ThreadPool::hasWork(const Job& job) {
+    for (unsigned i = 0; i < job.slots; ++i) {
+        const uint64_t v = job.ranges[i].load(std::memory_order_relaxed);
+        if ((v >> 32) > (v & 0xFFFFFFFFu)) return true;
+    }
+    return false;
+}
+
+std::shared_ptr<ThreadPool::Job> ThreadPool::nextJob() {
+    // 从最新提交的任务找起：渲染线程的 parallelFor 不会排在长时间运行的分析任务之后；
+    // 块已分完的任务顺手移出队列（提交者仍持有它，等待在途块完成）
+    for (auto it = jobs_.rbegin(); it != jobs_.rend();) {
+        if (hasWork(**it)) return *it;
+        it = std::make_reverse_iterator(jobs_.erase(std::next(it).base()));
+    }
+    return nullptr;
+}
+
+void ThreadPool::workerLoop() {
+    trace::setThreadName("pool worker");
+    for (;;) {
+        std::shared_ptr<Job> job;
+        unsigned generation;
+        {
+            std::unique_lock<std::mutex> lk(mutex_);
+            cv_.wait(lk, [&] { return stop_ || (job = nextJob()) != nullptr; });
+            if (stop_) return;
+            generation = submitted_.load(std::memory_order_relaxed);
+        }
+        runJob(*job, generation);
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    grain = std::max<size_t>(1, grain);
+    if (workers_.empty() || count <= grain) {
+        fn(0, count);
+        return;
+    }
+    // 块序号需放进 32 位
+    grain = std::max<size_t>(grain, count / 0xFFFFFFFFull + 1);
+    const uint64_t chunks = (count + grain - 1) / grain;
+    auto job = std::make_shared<Job>();
+    job->count = count;
+    job->grain = grain;
+    job->fn = &fn;
+    job->slots = size();
+    job->ranges = std::make_unique<std::atomic<uint64_t>[]>(job->slots);
+    for (unsigned i = 0; i < job->slots; ++i) {
+        const uint64_t begin = chunks * i / job->slots, end = chunks * (i + 1) / job->slots;
+        job->ranges[i].store((end << 32) | begin);
+    }
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        jobs_.push_back(job);
+        submitted_.fetch_add(1, std::memory_order_relaxed);
+    }
+    cv_.notify_all();
+    runJob(*job, kCaller);
+    std::unique_lock<std::mutex> lk(mutex_);
+    doneCv_.wait(lk, [&] { return job->done.load() == job->count; });
+    auto it = std::find(jobs_.begin(), jobs_.end(), job);
+    if (it != jobs_.end()) jobs_.erase(it);
+}
@@ -0,0 +1,167 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace trace {
+// 环形缓冲槽位（序列锁）：第 i 个事件写入期间 seq = 2i+1，写完为 2i+2。字段为 relaxed 原子量，
+// 导出线程据 seq 跳过正在写入或已被覆盖的槽位，属主线程的记录路径不加锁
+struct Event {
+    std::atomic<uint64_t> seq{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> beginNs{0};
+    std::atomic<uint64_t> endNs{0};
+};
+
+// 每个线程（或 GPU 等非线程轨道）一个环形缓冲
+struct Track {
+    Track(uint32_t id, std::string threadName, size_t cap)
+        : events(new Event[cap]), capacity(cap), tid(id), name(std::move(threadName)) {}
+    std::unique_ptr<Event[]> events;
+    size_t capacity;                    // 2 的幂
+    std::atomic<uint64_t> written{0};   // 单调递增；导出时读取
+    uint32_t tid;
+    std::string name;
+};
+} // namespace trace
+
+namespace {
+using trace::Event;
+using trace::Track;
+
+std::atomic<bool> gEnabled{true};
+const uint64_t gEpochNs = trace::nowNs();
+// 注册表锁只在线程首次记录、改名与导出时使用，不在记录路径上
+std::mutex gRegistryMutex;
+std::vector<std::unique_ptr<Track>> gThreads; // 线程退出后保留，导出时仍可见
+thread_local Track* tBuffer = nullptr;
+thread_local const char* tPendingName = nullptr;
+thread_local size_t tPendingCapacity = 1u << 14;
+
+size_t roundUpPow2(size_t v) {
+    size_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+Track* registerBuffer(const char* name, size_t capacity) {
+    std::lock_guard<std::mutex> lk(gRegistryMutex);
+    const uint32_t tid = static_cast<uint32_t>(gThreads.size() + 1);
+    std::string n = name ? name : "thread " + std::to_string(tid);
+    gThreads.push_back(std::make_unique<Track>(tid, std::move(n), roundUpPow2(std::max<size_t>(capacity, 64))));
+    return gThreads.back().get();
+}
+
+void append(Track* tb, const char* name, uint64_t beginNs, uint64_t endNs) {
+    const uint64_t i = tb->written.load(std::memory_order_relaxed);
+    Event& e = tb->events[i & (tb->capacity - 1)];
+    e.seq.store(2 * i + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    e.name.store(name, std::memory_order_relaxed);
+    e.beginNs.store(beginNs, std::memory_order_relaxed);
+    e.endNs.store(endNs, std::memory_order_relaxed);
+    e.seq.store(2 * i + 2, std::memory_order_release);
+    tb->written.store(i + 1, std::memory_order_release);
+}
+
+// 读取第 i 个事件；槽位正被写入或已被更新的事件覆盖时返回 false
+bool readEvent(const Track* tb, uint64_t i, const char*& name, uint64_t& beginNs, uint64_t& endNs) {
+    const Event& e = tb->events[i & (tb->capacity - 1)];
+    const uint64_t seq = e.seq.load(std::memory_order_acquire);
+    if (seq != 2 * i + 2) return false;
+    name = e.name.load(std::memory_order_relaxed);
+    beginNs = e.beginNs.load(std::memory_order_relaxed);
+    endNs = e.endNs.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return e.seq.load(std::memory_order_relaxed) == seq;
+}
+
+// 写入带引号的 JSON 字符串：转义引号、反斜杠与控制字符（名称可能含字体路径等任意文本）
+void putJsonString(std::FILE* f, const char* s) {
+    std::fputc('"', f);
+    for (; *s; ++s) {
+        const unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') {
+            std::fputc('\\', f);
+            std::fputc(c, f);
+        } else if (c < 0x20) {
+            std::fprintf(f, "\\u%04x", c);
+        } else {
+            std::fputc(c, f);
+        }
+    }
+    std::fputc('"', f);
+}
+
+} // namespace
+
+namespace trace {
+
+void setEnabled(bool enabled) { gEnabled.store(enabled, std::memory_order_relaxed); }
+bool enabled() { return gEnabled.load(std::memory_order_relaxed); }
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void setThreadName(const char* name, size_t capacity) {
+    if (tBuffer) {
+        std::lock_guard<std::mutex> lk(gRegistryMutex);
+        tBuffer->name = name;
+        return;
+    }
+    tPendingName = name;
+    tPendingCapacity = capacity;
+}
+
+void record(const char* name, uint64_t beginNs, uint64_t endNs) {
+    if (!tBuffer) tBuffer = registerBuffer(tPendingName, tPendingCapacity);
+    append(tBuffer, name, beginNs, endNs);
+}
+
+Track* createTrack(const char* name, size_t capacity) { return registerBuffer(name, capacity); }
+
+void recordTo(Track* track, const char* name, uint64_t beginNs, uint64_t endNs) { append(track, name, beginNs, endNs); }
+
+long writeChromeJson(const std::string& path, double seconds) {
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return -1;
+    const uint64_t now = nowNs();
+    const uint64_t cutoff = seconds > 0.0 ? now - std::min<uint64_t>(now, static_cast<uint64_t>(seconds * 1e9)) : 0;
+    long count = 0;
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+    std::lock_guard<std::mutex> lk(gRegistryMutex);
+    bool first = true;
+    for (const auto& tb : gThreads) {
+        std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                     first ? "" : ",\n", tb->tid);
+        putJsonString(f, tb->name.c_str());
+        std::fputs("}}", f);
+        first = false;
+        const uint64_t written = tb->written.load(std::memory_order_acquire);
+        const uint64_t n = std::min<uint64_t>(written, tb->capacity);
+        for (uint64_t i = written - n; i < written; ++i) {
+            const char* name;
+            uint64_t beginNs, endNs;
+            if (!readEvent(tb.get(), i, name, beginNs, endNs)) continue;
+            if (!name || endNs < cutoff || endNs < beginNs || beginNs < gEpochNs) continue;
+            // ts/dur 以微秒为单位
+            std::fputs(",\n{\"name\":", f);
+            putJsonString(f, name);
+            std::fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                         tb->tid, (beginNs - gEpochNs) / 1000.0, (endNs - beginNs) / 1000.0);
+            ++count;
+        }
+    }
+    std::fputs("\n]}\n", f);
+    const bool ok = std::fclose(f) == 0;
+    return ok ? count : -1;
+}
+
+} // namespace trace
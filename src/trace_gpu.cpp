@@ -0,0 +1,78 @@
+#include "trace.h"
+
+#include <GL/glew.h>
+
+namespace {
+// GPU 查询池：每个槽位一对时间戳查询，约可容纳 kGpuSlots/每帧区间数 帧的延迟
+constexpr int kGpuSlots = 64;
+struct GpuSlot {
+    GLuint queries[2] = {0, 0};
+    const char* name = nullptr;
+    bool pending = false;
+};
+GpuSlot gGpuSlots[kGpuSlots];
+bool gGpuReady = false;
+int gGpuNext = 0;
+int64_t gGpuOffsetNs = 0;   // CPU 时间 - GPU 时间
+int gGpuCalibrateCountdown = 0;
+trace::Track* gGpuBuffer = nullptr;
+} // namespace
+
+namespace trace {
+
+GpuScope::GpuScope(const char* name) {
+    if (!enabled()) return;
+    if (!gGpuReady) {
+        for (GpuSlot& s : gGpuSlots) glGenQueries(2, s.queries);
+        gGpuReady = true;
+    }
+    GpuSlot& s = gGpuSlots[gGpuNext];
+    if (s.pending) return; // 结果尚未取回，丢弃本区间而不是等待 GPU
+    slot_ = gGpuNext;
+    gGpuNext = (gGpuNext + 1) % kGpuSlots;
+    s.name = name;
+    glQueryCounter(s.queries[0], GL_TIMESTAMP);
+}
+
+GpuScope::~GpuScope() {
+    if (slot_ < 0) return;
+    GpuSlot& s = gGpuSlots[slot_];
+    glQueryCounter(s.queries[1], GL_TIMESTAMP);
+    s.pending = true;
+}
+
+void collectGpu() {
+    if (!gGpuReady) return;
+    if (gGpuCalibrateCountdown-- <= 0) {
+        // 周期性重新对齐 GPU 与 CPU 时钟（查询当前 GPU 时间不等待命令队列）
+        GLint64 gpuNow = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+        gGpuOffsetNs = static_cast<int64_t>(nowNs()) - gpuNow;
+        gGpuCalibrateCountdown = 120;
+    }
+    if (!gGpuBuffer) gGpuBuffer = createTrack("GPU", 1u << 16);
+    for (GpuSlot& s : gGpuSlots) {
+        if (!s.pending) continue;
+        GLint available = 0;
+        glGetQueryObjectiv(s.queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+        GLuint64 t0 = 0, t1 = 0;
+        glGetQueryObjectui64v(s.queries[0], GL_QUERY_RESULT, &t0);
+        glGetQueryObjectui64v(s.queries[1], GL_QUERY_RESULT, &t1);
+        s.pending = false;
+        recordTo(gGpuBuffer, s.name, static_cast<uint64_t>(static_cast<int64_t>(t0) + gGpuOffsetNs),
+                 static_cast<uint64_t>(static_cast<int64_t>(t1) + gGpuOffsetNs));
+    }
+}
+
+void shutdownGpu() {
+    if (!gGpuReady) return;
+    for (GpuSlot& s : gGpuSlots) {
+        glDeleteQueries(2, s.queries);
+        s = GpuSlot();
+    }
+    gGpuReady = false;
+    gGpuNext = 0;
+}
+
+} // namespace trace
@@ -0,0 +1,374 @@
+#include "upload_stream.h"
+#include "gl_state.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+const char* kUploadVertexShader = R"(#version 330 core
+void main() {
+    // 全屏三角形（无需顶点缓冲）
+    vec2 p = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+// 纹理与目标同尺寸，逐像素取值（不滤波，显示的即为上传的码值）
+const char* kUploadFragmentShader = R"(#version 330 core
+uniform sampler2D uSrc;
+out vec4 FragColor;
+void main() {
+    FragColor = texelFetch(uSrc, ivec2(gl_FragCoord.xy), 0);
+}
+)";
+
+constexpr GLuint64 kFenceTimeoutNs = 1000000000ull;
+
+double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void waitAndDelete(GLsync& fence) {
+    if (!fence) return;
+    glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceTimeoutNs);
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+} // namespace
+
+UploadStream::UploadStream() {
+    shader_ = std::make_unique<Shader>(kUploadVertexShader, kUploadFragmentShader);
+    uSrc_ = shader_->uniformInt("uSrc");
+    glGenVertexArrays(1, &vao_);
+    glGenQueries(kRingSize, queries_);
+    genRows_ = [this](size_t begin, size_t end) {
+        // 整数哈希噪声：逐帧变化、不可压缩；RGB10_A2 时每通道取满 10 位
+        const uint32_t f = static_cast<uint32_t>(genFrame_) * 0xC2B2AE3Du;
+        const uint32_t alpha = format_ == Format::RGB10_A2 ? 0xC0000000u : 0xFF000000u;
+        const uint32_t colorMask = ~alpha;
+        for (size_t y = begin; y < end; ++y) {
+            uint32_t* row = genDst_ + y * static_cast<size_t>(width_);
+            const uint32_t ry = static_cast<uint32_t>(y) * 0x85EBCA77u + f;
+            for (int x = 0; x < width_; ++x) {
+                uint32_t v = static_cast<uint32_t>(x) * 0x9E3779B1u ^ ry;
+                v ^= v >> 15;
+                v *= 0x2C1B3C6Du;
+                v ^= v >> 12;
+                v *= 0x297A2D39u;
+                v ^= v >> 15;
+                row[x] = (v & colorMask) | alpha;
+            }
+        }
+    };
+    resetWindow();
+}
+
+UploadStream::~UploadStream() {
+    release();
+    glDeleteQueries(kRingSize, queries_);
+    if (vao_) {
+        GLState::get().forgetVertexArray(vao_);
+        glDeleteVertexArrays(1, &vao_);
+    }
+}
+
+bool UploadStream::methodSupported(Method method) {
+    if (method == Method::Persistent) return GLEW_ARB_buffer_storage || GLEW_VERSION_4_4;
+    return true;
+}
+
+const char* UploadStream::methodName(Method method, bool zh) {
+    switch (method) {
+        case Method::TexSubImage: return zh ? "glTexSubImage2D（客户端内存）" : "glTexSubImage2D (client memory)";
+        case Method::PboOrphan:   return zh ? "PBO 孤立化" : "orphaned PBO";
+        case Method::PboRing:     return zh ? "PBO 三缓冲环" : "triple-buffered PBO ring";
+        case Method::Persistent:  return zh ? "持久映射（buffer_storage）" : "persistent mapping (buffer_storage)";
+    }
+    return "?";
+}
+
+const char* UploadStream::formatName(Format format) {
+    return format == Format::RGB10_A2 ? "RGB10_A2" : "RGBA8";
+}
+
+void UploadStream::cycleMethod() {
+    do {
+        method_ = static_cast<Method>((static_cast<int>(method_) + 1) % kMethodCount);
+    } while (!methodSupported(method_));
+    storageDirty_ = true;
+    resetWindow();
+}
+
+void UploadStream::cycleFormat() {
+    format_ = format_ == Format::RGBA8 ? Format::RGB10_A2 : Format::RGBA8;
+    storageDirty_ = true;
+    resetWindow();
+}
+
+void UploadStream::resetWindow() {
+    haveLastFrame_ = false;
+    windowFrames_ = 0;
+    windowBytes_ = 0;
+    windowMapFailures_ = 0;
+    windowGenMs_ = windowUploadMs_ = windowUploadMaxMs_ = windowGpuMs_ = 0.0;
+    windowGpuSamples_ = 0;
+    windowFrameSum_ = windowFrameSqSum_ = windowFrameMax_ = 0.0;
+    windowIntervals_ = 0;
+    stats_ = Stats{};
+}
+
+void UploadStream::release() {
+    GLState& gs = GLState::get();
+    for (GLsync& fence : fences_) waitAndDelete(fence);
+    // 映射失败时缓冲未处于映射状态，解除映射会产生 GL_INVALID_OPERATION
+    if (persistentPbo_ && persistentPtr_) {
+        gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, persistentPbo_);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        persistentPtr_ = nullptr;
+    }
+    GLuint buffers[] = {orphanPbo_, ringPbo_[0], ringPbo_[1], ringPbo_[2], persistentPbo_};
+    for (GLuint& b : buffers) {
+        if (!b) continue;
+        gs.forgetBuffer(b);
+        glDeleteBuffers(1, &b);
+    }
+    orphanPbo_ = persistentPbo_ = 0;
+    std::fill(std::begin(ringPbo_), std::end(ringPbo_), 0u);
+    if (texture_) {
+        gs.forgetTexture(texture_);
+        glDeleteTextures(1, &texture_);
+        texture_ = 0;
+    }
+    std::fill(std::begin(queryPending_), std::end(queryPending_), false);
+    staging_.clear();
+    staging_.shrink_to_fit();
+    width_ = height_ = 0;
+    frameBytes_ = 0;
+}
+
+void UploadStream::ensure(int width, int height) {
+    if (width <= 0 || height <= 0) return;
+    if (!storageDirty_ && texture_ && width == width_ && height == height_) return;
+    release();
+    storageDirty_ = false;
+    width_ = width;
+    height_ = height;
+    frameBytes_ = static_cast<size_t>(width) * height * 4; // 两种格式均为 4 字节/像素
+    const auto size = static_cast<GLsizeiptr>(frameBytes_);
+
+    GLState& gs = GLState::get();
+    textureInternal_ = format_ == Format::RGB10_A2 ? GL_RGB10_A2 : GL_RGBA8;
+    glGenTextures(1, &texture_);
+    gs.activeTexture(GL_TEXTURE0);
+    gs.bindTexture(GL_TEXTURE_2D, texture_);
+    gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, textureInternal_, width, height, 0, GL_RGBA,
+                 format_ == Format::RGB10_A2 ? GL_UNSIGNED_INT_2_10_10_10_REV : GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+    switch (method_) {
+        case Method::TexSubImage:
+            staging_.resize(static_cast<size_t>(width) * height);
+            break;
+        case Method::PboOrphan:
+            glGenBuffers(1, &orphanPbo_);
+            gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, orphanPbo_);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+            break;
+        case Method::PboRing:
+            glGenBuffers(kRingSize, ringPbo_);
+            for (GLuint pbo : ringPbo_) {
+                gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+                glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+            }
+            break;
+        case Method::Persistent: {
+            // 一个缓冲分三段，映射一次长期持有；一致性映射无需显式刷新
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glGenBuffers(1, &persistentPbo_);
+            gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, persistentPbo_);
+            glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size * kRingSize, nullptr, flags);
+            persistentPtr_ = static_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size * kRingSize, flags));
+            break;
+        }
+    }
+    // 文字渲染等从客户端内存上传，解包缓冲必须复位
+    gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void UploadStream::generate(uint32_t* dst, unsigned long long frame) {
+    genDst_ = dst;
+    genFrame_ = frame;
+    ThreadPool::shared().parallelFor(static_cast<size_t>(height_), 16, genRows_);
+}
+
+void UploadStream::collectGpu() {
+    for (int i = 0; i < kRingSize; ++i) {
+        if (!queryPending_[i]) continue;
+        GLint available = 0;
+        glGetQueryObjectiv(queries_[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(queries_[i], GL_QUERY_RESULT, &ns);
+        queryPending_[i] = false;
+        windowGpuMs_ += ns / 1e6;
+        windowGpuSamples_++;
+    }
+}
+
+void UploadStream::upload(unsigned long long frame) {
+    GLState& gs = GLState::get();
+    const GLenum type = format_ == Format::RGB10_A2 ? GL_UNSIGNED_INT_2_10_10_10_REV : GL_UNSIGNED_BYTE;
+    const int slot = ringIndex_;
+    ringIndex_ = (ringIndex_ + 1) % kRingSize;
+    collectGpu();
+
+    double genMs = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    const void* texSrc = nullptr;     // 绑定 PBO 时为缓冲内偏移
+    bool mapped = true;
+    switch (method_) {
+        case Method::TexSubImage: {
+            const auto g0 = std::chrono::steady_clock::now();
+            generate(staging_.data(), frame);
+            genMs = msSince(g0);
+            gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            texSrc = staging_.data();
+            break;
+        }
+        case Method::PboOrphan: {
+            gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, orphanPbo_);
+            // 重新指定存储：驱动分配新块，旧块待 GPU 用完后回收，映射无需等待
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(frameBytes_), nullptr, GL_STREAM_DRAW);
+            void* p = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(frameBytes_),
+                                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (!p) {
+                mapped = false;
+                break;
+            }
+            const auto g0 = std::chrono::steady_clock::now();
+            generate(static_cast<uint32_t*>(p), frame);
+            genMs = msSince(g0);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            break;
+        }
+        case Method::PboRing: {
+            // 等待该槽三帧前的拷贝完成，再以非同步方式映射
+            waitAndDelete(fences_[slot]);
+            gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, ringPbo_[slot]);
+            void* p = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(frameBytes_),
+                                       GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (!p) {
+                mapped = false;
+                break;
+            }
+            const auto g0 = std::chrono::steady_clock::now();
+            generate(static_cast<uint32_t*>(p), frame);
+            genMs = msSince(g0);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            break;
+        }
+        case Method::Persistent: {
+            if (!persistentPtr_) {
+                mapped = false;
+                break;
+            }
+            waitAndDelete(fences_[slot]);
+            gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, persistentPbo_);
+            const size_t offset = frameBytes_ * static_cast<size_t>(slot);
+            const auto g0 = std::chrono::steady_clock::now();
+            generate(reinterpret_cast<uint32_t*>(persistentPtr_ + offset), frame);
+            genMs = msSince(g0);
+            texSrc = reinterpret_cast<const void*>(offset);
+            break;
+        }
+    }
+
+    // 映射失败：缓冲内容不是本帧数据，不上传也不计入带宽（纹理保留上一帧）
+    if (!mapped) {
+        gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        windowMapFailures_++;
+        return;
+    }
+
+    // 上一轮同槽查询未取回时本帧不计时（避免阻塞）
+    const bool timed = !queryPending_[slot];
+    if (timed) glBeginQuery(GL_TIME_ELAPSED, queries_[slot]);
+    gs.activeTexture(GL_TEXTURE0);
+    gs.bindTexture(GL_TEXTURE_2D, texture_);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width_, height_, GL_RGBA, type, texSrc);
+    if (timed) {
+        glEndQuery(GL_TIME_ELAPSED);
+        queryPending_[slot] = true;
+    }
+    gs.countUpload(frameBytes_);
+    if (method_ == Method::PboRing || method_ == Method::Persistent) {
+        fences_[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    gs.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    const double uploadMs = std::max(0.0, msSince(t0) - genMs);
+    windowBytes_ += frameBytes_;
+    windowGenMs_ += genMs;
+    windowUploadMs_ += uploadMs;
+    windowUploadMaxMs_ = std::max(windowUploadMaxMs_, uploadMs);
+}
+
+void UploadStream::render(unsigned long long frame, int width, int height) {
+    const auto now = std::chrono::steady_clock::now();
+    if (haveLastFrame_) {
+        const double dt = std::chrono::duration<double, std::milli>(now - lastFrame_).count();
+        windowFrameSum_ += dt;
+        windowFrameSqSum_ += dt * dt;
+        windowFrameMax_ = std::max(windowFrameMax_, dt);
+        windowIntervals_++;
+    } else {
+        windowStart_ = now;
+        haveLastFrame_ = true;
+    }
+    lastFrame_ = now;
+
+    ensure(width, height);
+    if (!texture_) return;
+    upload(frame);
+    windowFrames_++;
+
+    GLState& gs = GLState::get();
+    gs.disable(GL_BLEND);
+    shader_->use();
+    shader_->set(uSrc_, 0);
+    gs.activeTexture(GL_TEXTURE0);
+    gs.bindTexture(GL_TEXTURE_2D, texture_);
+    gs.bindVertexArray(vao_);
+    gs.drawArrays(GL_TRIANGLES, 0, 3);
+
+    // 约每秒发布一次窗口统计
+    const double windowMs = std::chrono::duration<double, std::milli>(now - windowStart_).count();
+    if (windowMs >= 1000.0 && windowFrames_ > 0) {
+        Stats s;
+        s.gbps = windowBytes_ / (windowMs * 1e6);
+        s.genMs = windowGenMs_ / windowFrames_;
+        s.uploadMs = windowUploadMs_ / windowFrames_;
+        s.uploadMaxMs = windowUploadMaxMs_;
+        s.callGbps = windowUploadMs_ > 0.0 ? windowBytes_ / (windowUploadMs_ * 1e6) : 0.0;
+        s.gpuMs = windowGpuSamples_ ? windowGpuMs_ / windowGpuSamples_ : 0.0;
+        s.mapFailures = windowMapFailures_;
+        if (windowIntervals_ > 0) {
+            s.frameMs = windowFrameSum_ / windowIntervals_;
+            s.frameSdMs = std::sqrt(std::max(0.0, windowFrameSqSum_ / windowIntervals_ - s.frameMs * s.frameMs));
+            s.frameMaxMs = windowFrameMax_;
+        }
+        s.valid = true;
+        resetWindow();
+        stats_ = s;
+        // 新窗口从本帧开始计
+        windowStart_ = now;
+        lastFrame_ = now;
+        haveLastFrame_ = true;
+    }
+}
@@ -0,0 +1,361 @@
+#include "vram_test.h"
+#include "gl_state.h"
+#include "noise_hash.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+constexpr uint32_t kRandomSeed = 0x4D454D54u;   // "MEMT"
+constexpr int kCellGrid = 64;                   // 每块校验为 64x64 个单元，每单元 512 个纹素
+constexpr int kCellTexels = VramTest::kBlockWidth * VramTest::kBlockHeight / (kCellGrid * kCellGrid);
+constexpr uint32_t kBlockWords = static_cast<uint32_t>(VramTest::kBlockWidth) * VramTest::kBlockHeight * 4;
+constexpr GLsizeiptr kBlockBytes = static_cast<GLsizeiptr>(kBlockWords) * 4;
+static_assert(kCellTexels == 512, "kVerifyFragmentShader 中的 kCellTexels 需同步修改");
+
+const char* kVertexShader = R"(#version 330 core
+void main() {
+    // 全屏三角形（无需顶点缓冲）
+    vec2 p = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+// 期望值：行走 1（奇数轮取反为行走 0）、地址即数据（奇数轮取反）、计数器随机（xxhash32(地址, 轮次)）
+const std::string kPatternGlsl = R"(
+uniform int uPattern;
+uniform int uPass;
+uniform int uBase;       // 块首字的全局地址
+const int kBlockWidth = 2048;
+
+uint expectedWord(uint word) {
+    uint pass = uint(uPass);
+    uint flip = (pass & 1u) != 0u ? 0xFFFFFFFFu : 0u;
+    if (uPattern == 0) return (1u << ((word + pass) & 31u)) ^ flip;
+    if (uPattern == 1) return word ^ flip;
+    return xxhash32(uvec3(word, pass, 0x4D454D54u));
+}
+
+uvec4 expectedTexel(int texel) {
+    uint w = uint(uBase) + uint(texel) * 4u;
+    return uvec4(expectedWord(w), expectedWord(w + 1u), expectedWord(w + 2u), expectedWord(w + 3u));
+}
+)";
+
+const char* kFillFragmentShader = R"(#version 330 core
+out uvec4 FragColor;
+void main() {
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    FragColor = expectedTexel(p.y * kBlockWidth + p.x);
+}
+)";
+
+// 每个片元校验一个单元：上半 64 行读纹理，下半 64 行经纹理缓冲读缓冲。
+// 输出（不匹配字数, 单元内首个出错字的块内序号, 出错位并集, 是否出错）
+const char* kVerifyFragmentShader = R"(#version 330 core
+uniform usampler2D uTex;
+uniform usamplerBuffer uBuf;
+const int kGrid = 64;
+const int kCellTexels = 512;
+out uvec4 FragColor;
+void main() {
+    ivec2 c = ivec2(gl_FragCoord.xy);
+    bool fromBuffer = c.y >= kGrid;
+    int first = ((c.y % kGrid) * kGrid + c.x) * kCellTexels;
+    uint bad = 0u, firstBad = 0xFFFFFFFFu, bits = 0u;
+    for (int i = 0; i < kCellTexels; ++i) {
+        int t = first + i;
+        uvec4 v = fromBuffer ? texelFetch(uBuf, t) : texelFetch(uTex, ivec2(t % kBlockWidth, t / kBlockWidth), 0);
+        uvec4 d = v ^ expectedTexel(t);
+        if (any(notEqual(d, uvec4(0u)))) {
+            for (int k = 0; k < 4; ++k) {
+                if (d[k] != 0u) {
+                    bad++;
+                    firstBad = min(firstBad, uint(t) * 4u + uint(k));
+                    bits |= d[k];
+                }
+            }
+        }
+    }
+    FragColor = uvec4(bad, firstBad, bits, bad != 0u ? 1u : 0u);
+}
+)";
+
+// 归约：每个片元汇总一个来源（x=0 纹理, x=1 缓冲）的 64x64 个单元
+const char* kReduceFragmentShader = R"(#version 330 core
+uniform usampler2D uSrc;
+out uvec4 FragColor;
+void main() {
+    int source = int(gl_FragCoord.x);
+    uvec4 r = uvec4(0u, 0xFFFFFFFFu, 0u, 0u);
+    for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            uvec4 v = texelFetch(uSrc, ivec2(x, source * 64 + y), 0);
+            r = uvec4(r.x + v.x, min(r.y, v.y), r.z | v.z, r.w + v.w);
+        }
+    }
+    FragColor = r;
+}
+)";
+
+// 整数纹理 + 帧缓冲；分配失败或不完整时返回 false（已创建的对象由调用方删除）
+bool createTarget(GLenum internal, int width, int height, GLuint& texture, GLuint& fbo) {
+    GLState& gs = GLState::get();
+    glGenTextures(1, &texture);
+    gs.activeTexture(GL_TEXTURE0);
+    gs.bindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, internal, width, height, 0, GL_RGBA_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glGenFramebuffers(1, &fbo);
+    gs.bindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    gs.bindFramebuffer(GL_FRAMEBUFFER, 0);
+    return complete;
+}
+
+void deleteTarget(GLuint& texture, GLuint& fbo) {
+    GLState& gs = GLState::get();
+    if (fbo) {
+        gs.forgetFramebuffer(fbo);
+        glDeleteFramebuffers(1, &fbo);
+        fbo = 0;
+    }
+    if (texture) {
+        gs.forgetTexture(texture);
+        glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+}
+} // namespace
+
+const char* VramTest::patternName(int pattern) {
+    switch (pattern) {
+        case kWalkingOnes: return "walking-ones";
+        case kAddress: return "address";
+        default: return "random";
+    }
+}
+
+uint32_t VramTest::expected(int pattern, uint32_t pass, uint32_t word) {
+    const uint32_t flip = (pass & 1u) ? 0xFFFFFFFFu : 0u;
+    if (pattern == kWalkingOnes) return (1u << ((word + pass) & 31u)) ^ flip;
+    if (pattern == kAddress) return word ^ flip;
+    return noise::xxhash32(word, pass, kRandomSeed);
+}
+
+VramTest::VramTest(int mib, std::string logPath) : logPath_(std::move(logPath)) {
+    log_.open(logPath_, std::ios::out | std::ios::app);
+    if (log_.is_open() && log_.tellp() == 0) {
+        log_ << "frame,time_s,block,source,pattern,pass,words,mismatches,first_bad_word,diff_bits,bad_cells\n";
+    }
+
+    const std::string lib = kNoiseHashGlsl + kPatternGlsl;
+    fillShader_ = std::make_unique<Shader>(kVertexShader, Shader::insertAfterVersion(kFillFragmentShader, lib));
+    uFillPattern_ = fillShader_->uniformInt("uPattern");
+    uFillPass_ = fillShader_->uniformInt("uPass");
+    uFillBase_ = fillShader_->uniformInt("uBase");
+    verifyShader_ = std::make_unique<Shader>(kVertexShader, Shader::insertAfterVersion(kVerifyFragmentShader, lib));
+    uVerifyPattern_ = verifyShader_->uniformInt("uPattern");
+    uVerifyPass_ = verifyShader_->uniformInt("uPass");
+    uVerifyBase_ = verifyShader_->uniformInt("uBase");
+    uVerifyTex_ = verifyShader_->uniformInt("uTex");
+    uVerifyBuf_ = verifyShader_->uniformInt("uBuf");
+    reduceShader_ = std::make_unique<Shader>(kVertexShader, kReduceFragmentShader);
+    uReduceSrc_ = reduceShader_->uniformInt("uSrc");
+    glGenVertexArrays(1, &vao_);
+    // 校验与归约目标是整个测试的前提：任一创建失败则不分配块（ok() 为 false，由调用方关闭测试）
+    if (!createTarget(GL_RGBA32UI, kCellGrid, kCellGrid * 2, cellTexture_, cellFbo_) ||
+        !createTarget(GL_RGBA32UI, 2, 1, sumTexture_, sumFbo_)) {
+        release();
+        return;
+    }
+
+    slots_.resize(kSlots);
+    GLState& gs = GLState::get();
+    for (Slot& s : slots_) {
+        glGenBuffers(1, &s.pbo);
+        gs.bindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, 32, nullptr, GL_STREAM_READ);
+    }
+
+    // 纹理缓冲上限不足一块时只校验纹理（缓冲仍作为复制目标写入）
+    GLint maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+    stats_.bufferVerify = maxTexels >= kBlockWidth * kBlockHeight;
+
+    // 逐块分配，首次失败（GL_OUT_OF_MEMORY / 不完整）即停止
+    const int count = std::max(1, mib / kBlockMiB);
+    for (int i = 0; i < count; ++i) {
+        while (glGetError() != GL_NO_ERROR) {}
+        Block b;
+        bool ok = createTarget(GL_RGBA32UI, kBlockWidth, kBlockHeight, b.texture, b.fbo);
+        glGenBuffers(1, &b.buffer);
+        gs.bindBuffer(GL_PIXEL_PACK_BUFFER, b.buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, kBlockBytes, nullptr, GL_DYNAMIC_COPY);
+        if (stats_.bufferVerify) {
+            glGenTextures(1, &b.bufferTexture);
+            glBindTexture(GL_TEXTURE_BUFFER, b.bufferTexture);
+            glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32UI, b.buffer);
+            glBindTexture(GL_TEXTURE_BUFFER, 0);
+        }
+        ok = ok && glGetError() == GL_NO_ERROR;
+        blocks_.push_back(b);
+        if (!ok) {
+            blocks_.pop_back();
+            if (b.bufferTexture) glDeleteTextures(1, &b.bufferTexture);
+            gs.forgetBuffer(b.buffer);
+            glDeleteBuffers(1, &b.buffer);
+            deleteTarget(b.texture, b.fbo);
+            break;
+        }
+    }
+    gs.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    stats_.blocks = static_cast<int>(blocks_.size());
+}
+
+VramTest::~VramTest() { release(); }
+
+void VramTest::release() {
+    GLState& gs = GLState::get();
+    for (Slot& s : slots_) {
+        if (s.fence) glDeleteSync(s.fence);
+        gs.forgetBuffer(s.pbo);
+        glDeleteBuffers(1, &s.pbo);
+    }
+    slots_.clear();
+    pending_.clear();
+    for (Block& b : blocks_) {
+        if (b.bufferTexture) glDeleteTextures(1, &b.bufferTexture);
+        gs.forgetBuffer(b.buffer);
+        glDeleteBuffers(1, &b.buffer);
+        deleteTarget(b.texture, b.fbo);
+    }
+    blocks_.clear();
+    deleteTarget(cellTexture_, cellFbo_);
+    deleteTarget(sumTexture_, sumFbo_);
+    if (vao_) {
+        gs.forgetVertexArray(vao_);
+        glDeleteVertexArrays(1, &vao_);
+        vao_ = 0;
+    }
+}
+
+void VramTest::poll() {
+    GLState& gs = GLState::get();
+    while (!pending_.empty()) {
+        Slot& slot = slots_[pending_.front()];
+        const GLenum r = glClientWaitSync(slot.fence, 0, 0);
+        if (r != GL_ALREADY_SIGNALED && r != GL_CONDITION_SATISFIED) break;
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        gs.bindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        const auto* counts = static_cast<const uint32_t*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, 32, GL_MAP_READ_BIT));
+        if (counts) {
+            record(slot, counts);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        pending_.erase(pending_.begin());
+    }
+    gs.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void VramTest::record(const Slot& slot, const uint32_t* counts) {
+    const int sources = stats_.bufferVerify ? 2 : 1;
+    for (int s = 0; s < sources; ++s) {
+        const uint32_t* c = counts + s * 4;
+        stats_.verifications++;
+        stats_.verifiedBytes += static_cast<unsigned long long>(kBlockBytes);
+        stats_.mismatchWords += c[0];
+        if (c[0]) {
+            stats_.errorEvents++;
+            stats_.lastErrorFrame = slot.frame;
+            stats_.lastErrorBlock = slot.block;
+            stats_.lastErrorInBuffer = s == 1;
+            stats_.lastErrorPattern = slot.pattern;
+            stats_.lastErrorWord = c[1];
+            stats_.lastErrorBits = c[2];
+            stats_.lastErrorExpected = expected(slot.pattern, slot.pass, static_cast<uint32_t>(slot.block) * kBlockWords + c[1]);
+        }
+        if (log_.is_open()) {
+            log_ << slot.frame << ',' << std::fixed << std::setprecision(4) << slot.time << ',' << slot.block << ','
+                 << (s ? "buffer" : "texture") << ',' << patternName(slot.pattern) << ',' << slot.pass << ',' << kBlockWords
+                 << ',' << c[0] << ',';
+            if (c[0]) log_ << c[1] << ",0x" << std::hex << std::setw(8) << std::setfill('0') << c[2] << std::dec << std::setfill(' ');
+            else log_ << ',';
+            log_ << ',' << c[3] << '\n';
+        }
+    }
+    if (log_.is_open()) log_.flush();
+}
+
+void VramTest::step(unsigned long long frame, double time) {
+    if (blocks_.empty()) return;
+    poll();
+    auto it = std::find_if(slots_.begin(), slots_.end(), [](const Slot& s) { return s.fence == nullptr; });
+    if (it == slots_.end()) {
+        stats_.skipped++;
+        return;
+    }
+
+    GLState& gs = GLState::get();
+    Block& b = blocks_[next_];
+    // 全局字地址按 32 位回绕（16 GiB 以上的块与低地址块共用地址空间）
+    const int base = static_cast<int>(static_cast<uint32_t>(next_) * kBlockWords);
+    gs.bindVertexArray(vao_);
+
+    // 校验上一轮写入的内容（距写入已过一整轮，即块数帧）
+    if (b.fills > 0) {
+        Slot& slot = *it;
+        slot.frame = frame;
+        slot.time = time;
+        slot.block = next_;
+        slot.pattern = static_cast<int>((b.fills - 1) % kPatternCount);
+        slot.pass = (b.fills - 1) / kPatternCount;
+
+        gs.bindFramebuffer(GL_FRAMEBUFFER, cellFbo_);
+        gs.viewport(0, 0, kCellGrid, stats_.bufferVerify ? kCellGrid * 2 : kCellGrid);
+        verifyShader_->use();
+        verifyShader_->set(uVerifyPattern_, slot.pattern);
+        verifyShader_->set(uVerifyPass_, static_cast<int>(slot.pass));
+        verifyShader_->set(uVerifyBase_, base);
+        verifyShader_->set(uVerifyTex_, 0);
+        verifyShader_->set(uVerifyBuf_, 1);
+        gs.activeTexture(GL_TEXTURE1);
+        gs.bindTexture(GL_TEXTURE_BUFFER, b.bufferTexture);
+        gs.activeTexture(GL_TEXTURE0);
+        gs.bindTexture(GL_TEXTURE_2D, b.texture);
+        gs.drawArrays(GL_TRIANGLES, 0, 3);
+
+        gs.bindFramebuffer(GL_FRAMEBUFFER, sumFbo_);
+        gs.viewport(0, 0, 2, 1);
+        reduceShader_->use();
+        reduceShader_->set(uReduceSrc_, 0);
+        gs.bindTexture(GL_TEXTURE_2D, cellTexture_);
+        gs.drawArrays(GL_TRIANGLES, 0, 3);
+
+        // 只回读两个来源的计数（32 字节），围栏完成后才映射
+        gs.bindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glReadPixels(0, 0, 2, 1, GL_RGBA_INTEGER, GL_UNSIGNED_INT, nullptr);
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        pending_.push_back(static_cast<int>(it - slots_.begin()));
+    }
+
+    // 写入下一图样，再在 GPU 上复制到缓冲
+    const uint32_t fill = b.fills++;
+    gs.bindFramebuffer(GL_FRAMEBUFFER, b.fbo);
+    gs.viewport(0, 0, kBlockWidth, kBlockHeight);
+    fillShader_->use();
+    fillShader_->set(uFillPattern_, static_cast<int>(fill % kPatternCount));
+    fillShader_->set(uFillPass_, static_cast<int>(fill / kPatternCount));
+    fillShader_->set(uFillBase_, base);
+    gs.drawArrays(GL_TRIANGLES, 0, 3);
+    gs.bindBuffer(GL_PIXEL_PACK_BUFFER, b.buffer);
+    glReadPixels(0, 0, kBlockWidth, kBlockHeight, GL_RGBA_INTEGER, GL_UNSIGNED_INT, nullptr);
+    gs.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    next_ = (next_ + 1) % static_cast<int>(blocks_.size());
+    if (next_ == 0) stats_.rotations++;
+}
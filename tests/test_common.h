@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdio>
+
+// 最小测试工具：CHECK 失败时打印位置并计数（不中断），main 以 dhttest::result() 返回。
+// 需要 GL 的测试在无法创建无头上下文时返回 kSkip（ctest 记为跳过）
+namespace dhttest {
+
+constexpr int kSkip = 77;
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline int result() {
+    if (failures()) std::fprintf(stderr, "%d check(s) failed\n", failures());
+    return failures() ? 1 : 0;
+}
+
+} // namespace dhttest
+
+#define CHECK(cond)                                                                      \
+    do {                                                                                 \
+        if (!(cond)) {                                                                   \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            ::dhttest::failures()++;                                                     \
+        }                                                                                \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                                             \
+    do {                                                                                           \
+        const auto checkA_ = (a);                                                                  \
+        const auto checkB_ = (b);                                                                  \
+        if (!(checkA_ == checkB_)) {                                                               \
+            std::fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: 0x%llx != 0x%llx\n", __FILE__, __LINE__, #a, #b, \
+                         static_cast<unsigned long long>(checkA_), static_cast<unsigned long long>(checkB_));   \
+            ::dhttest::failures()++;                                                               \
+        }                                                                                          \
+    } while (0)
@@ -0,0 +1,51 @@
+// DSC 模型：YCoCg-R 变换对全部 10-bit 边界值与随机像素可逆，分量不超出位深 + 1 位；
+// 平坦画面以高码率编码时重建无误差
+#include "dsc_model.h"
+#include "test_common.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+uint32_t pack(uint32_t r, uint32_t g, uint32_t b) { return r | g << 10 | b << 20; }
+
+// 逆变换不还原或分量越界时返回 false
+bool roundTrip(uint32_t px) {
+    int c[3];
+    dsc::toYCoCgR(px, c);
+    const bool inRange = c[0] >= 0 && c[0] <= 1023 && c[1] >= -1023 && c[1] <= 1023 && c[2] >= -1023 && c[2] <= 1023;
+    if (dsc::fromYCoCgR(c) == (px & 0x3FFFFFFFu) && inRange) return true;
+    std::fprintf(stderr, "px 0x%08x -> Y %d Co %d Cg %d -> 0x%08x\n", px, c[0], c[1], c[2], dsc::fromYCoCgR(c));
+    return false;
+}
+
+} // namespace
+
+int main() {
+    int bad = 0;
+    // 每个分量取 0..1023 的稀疏网格加两端附近的值
+    std::vector<uint32_t> levels;
+    for (uint32_t v = 0; v < 1024; v += 31) levels.push_back(v);
+    for (uint32_t v : {1u, 2u, 511u, 512u, 513u, 1021u, 1022u, 1023u}) levels.push_back(v);
+    for (uint32_t r : levels)
+        for (uint32_t g : levels)
+            for (uint32_t b : levels) bad += !roundTrip(pack(r, g, b));
+
+    // 随机像素（含 alpha 位，变换应忽略）
+    std::mt19937 rng(2024);
+    for (int i = 0; i < 1000000 && bad < 10; ++i) bad += !roundTrip(static_cast<uint32_t>(rng()));
+    CHECK_EQ(bad, 0);
+
+    // 平坦灰画面：预测残差为 0，以 12 bpp 编码时重建误差为 0、无溢出
+    const int w = 256, h = 64;
+    std::vector<uint32_t> flat(static_cast<size_t>(w) * h, pack(512, 512, 512) | 3u << 30);
+    dsc::Config config;
+    config.bitsPerPixel = 12.0;
+    config.sliceHeight = 16;
+    const dsc::FrameScore score = dsc::encode(flat.data(), w, h, config);
+    CHECK_EQ(score.slices.size(), 16u);
+    CHECK_EQ(score.maxError, 0);
+    CHECK_EQ(score.overflow, 0);
+    return dhttest::result();
+}
@@ -0,0 +1,117 @@
+// 帧标记编解码：按 cell()/white() 合成的画面（亮度平面、YUYV 限幅）可解码出原帧号与签名，
+// 任一单元格翻转都被 CRC 拒绝；块均值签名与合成电平一致，内容改变时 contentMismatches 报告
+#include "frame_marker.h"
+#include "test_common.h"
+
+#include <vector>
+
+namespace {
+
+constexpr int kWidth = 640, kHeight = 360;
+
+// 自上而下的合成采集帧；value 为 0..255 的亮度，yuyv 时写入 16..235 限幅亮度与中性色度
+struct Image {
+    bool yuyv = false;
+    std::vector<uint8_t> bytes;
+
+    explicit Image(bool yuyvLayout) : yuyv(yuyvLayout), bytes(static_cast<size_t>(kWidth) * kHeight * bpp()) {}
+    int bpp() const { return yuyv ? 2 : 1; }
+    size_t stride() const { return static_cast<size_t>(kWidth) * bpp(); }
+    marker::Layout layout() const { return yuyv ? marker::Layout{2, 0x00FF00FFu, {-1, -1, -1}} : marker::Layout{1, 0xFFFFFFFFu, {-1, -1, -1}}; }
+
+    void fill(const marker::Rect& r, int value) {
+        const uint8_t y = static_cast<uint8_t>(yuyv ? 16 + (value * 219 + 127) / 255 : value);
+        for (int row = r.y0; row < r.y1; ++row) {
+            uint8_t* p = bytes.data() + row * stride();
+            for (int x = r.x0; x < r.x1; ++x) {
+                p[x * bpp()] = y;
+                if (yuyv) p[x * 2 + 1] = 128;
+            }
+        }
+    }
+};
+
+void paintContent(Image& image, uint32_t content) {
+    for (int i = 0; i < marker::kBlocks; ++i)
+        image.fill(marker::block(i, kWidth, kHeight), marker::blockLevel(content, i) * 17);
+}
+
+void paintStrip(Image& image, const marker::Payload& p) {
+    for (int row = 0; row < marker::kRows; ++row)
+        for (int col = 0; col < marker::kCells; ++col)
+            image.fill(marker::cell(row, col, kWidth, kHeight), marker::white(p, row, col) ? 255 : 0);
+}
+
+bool decodes(const Image& image, marker::Payload& out, float level[marker::kRows][marker::kCells]) {
+    marker::measure(image.bytes.data(), kWidth, kHeight, image.stride(), image.layout(), level);
+    return marker::decode(level, out) && marker::valid(out);
+}
+
+void checkLayout(bool yuyv) {
+    const uint32_t content = 0x0F3C5A96u;
+    for (uint32_t frame : {0u, 1u, 12345u, 0x80000001u, 0xFFFFFFFFu}) {
+        Image image(yuyv);
+        paintContent(image, content);
+        const marker::Payload sent = marker::make(frame, content);
+        paintStrip(image, sent);
+
+        float level[marker::kRows][marker::kCells];
+        marker::Payload got;
+        CHECK(decodes(image, got, level));
+        CHECK_EQ(got.frame, frame);
+        CHECK_EQ(got.content, content);
+        CHECK_EQ(got.crc, sent.crc);
+
+        float mean[marker::kBlocks];
+        marker::measureBlocks(image.bytes.data(), kWidth, kHeight, image.stride(), image.layout(), mean);
+        CHECK_EQ(marker::contentMismatches(content, level, mean, 0.0f), 0);
+        if (!yuyv) {
+            for (float& m : mean) m /= 255.0f;
+            CHECK_EQ(marker::signature(mean), content);
+        }
+
+        // 画面在标记生成后改变（过期内容）：被改的两块报告不符
+        Image stale = image;
+        stale.fill(marker::block(1, kWidth, kHeight), 0);      // 15 -> 0
+        stale.fill(marker::block(6, kWidth, kHeight), 255);    // 9 -> 15
+        marker::measureBlocks(stale.bytes.data(), kWidth, kHeight, stale.stride(), stale.layout(), mean);
+        CHECK_EQ(marker::contentMismatches(content, level, mean, 1.0f), 2);
+
+        // 任一数据单元格翻转：解码出的 CRC 不再匹配
+        int accepted = 0;
+        for (int row = 0; row < marker::kRows; ++row) {
+            for (int col = 2; col < marker::kCells - 2; ++col) {
+                Image flipped = image;
+                flipped.fill(marker::cell(row, col, kWidth, kHeight), marker::white(sent, row, col) ? 0 : 255);
+                accepted += decodes(flipped, got, level);
+            }
+        }
+        CHECK_EQ(accepted, 0);
+    }
+
+    // 无标记（全灰）时拒绝解码
+    Image blank(yuyv);
+    blank.fill(marker::Rect{0, 0, kWidth, kHeight}, 128);
+    float level[marker::kRows][marker::kCells];
+    marker::Payload got;
+    CHECK(!decodes(blank, got, level));
+}
+
+} // namespace
+
+int main() {
+    for (bool scalar : {false, true}) {
+        marker::setForceScalar(scalar);
+        std::printf("marker: %s\n", marker::simdPath());
+        checkLayout(false);
+        checkLayout(true);
+    }
+    marker::setForceScalar(false);
+
+    // 签名各块的量化与取回
+    float mean[marker::kBlocks];
+    for (int i = 0; i < marker::kBlocks; ++i) mean[i] = static_cast<float>(i * 2) / marker::kBlockLevels;
+    const uint32_t content = marker::signature(mean);
+    for (int i = 0; i < marker::kBlocks; ++i) CHECK_EQ(marker::blockLevel(content, i), i * 2);
+    return dhttest::result();
+}
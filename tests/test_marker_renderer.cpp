@@ -0,0 +1,94 @@
+// 帧标记 GPU 绘制（无头后端）：回读画面可解码出帧号，GPU 计算的签名与 CPU 对同一画面的块均值一致，
+// 绘制不改变清屏色。无法创建无头上下文时跳过
+#include "display_backend.h"
+#include "frame_marker.h"
+#include "gl_state.h"
+#include "marker_renderer.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+constexpr int kWidth = 640, kHeight = 360;
+
+// 灰度取 k/15，块均值恰在量化级上（避开半级边界处 GPU/CPU 求和顺序造成的差异）
+void paint(GLState& gs, GLuint fbo, int variant) {
+    gs.bindFramebuffer(GL_FRAMEBUFFER, fbo);
+    gs.viewport(0, 0, kWidth, kHeight);
+    const float base = static_cast<float>(3 + variant) / marker::kBlockLevels;
+    glClearColor(base, base, base, 1.0f);
+    gs.clear(GL_COLOR_BUFFER_BIT);
+    // 左上块（自下而上坐标的上半部左四分之一）置白、右下块置黑
+    gs.enable(GL_SCISSOR_TEST);
+    const marker::Rect white = marker::block(0, kWidth, kHeight), black = marker::block(7, kWidth, kHeight);
+    glScissor(white.x0, kHeight - white.y1, white.x1 - white.x0, white.y1 - white.y0);
+    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+    gs.clear(GL_COLOR_BUFFER_BIT);
+    glScissor(black.x0, kHeight - black.y1, black.x1 - black.x0, black.y1 - black.y0);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    gs.clear(GL_COLOR_BUFFER_BIT);
+    gs.disable(GL_SCISSOR_TEST);
+}
+
+// RGBA8 回读并翻转为自上而下
+std::vector<uint8_t> grab(GLState& gs, const DisplayBackend& backend) {
+    std::vector<uint8_t> bottomUp(static_cast<size_t>(kWidth) * kHeight * 4), image(bottomUp.size());
+    gs.bindFramebuffer(GL_READ_FRAMEBUFFER, backend.defaultFramebuffer());
+    glReadBuffer(backend.readBuffer());
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, kWidth, kHeight, GL_RGBA, GL_UNSIGNED_BYTE, bottomUp.data());
+    const size_t stride = static_cast<size_t>(kWidth) * 4;
+    for (int y = 0; y < kHeight; ++y)
+        std::copy_n(bottomUp.data() + (kHeight - 1 - y) * stride, stride, image.data() + y * stride);
+    return image;
+}
+
+} // namespace
+
+int main() {
+    auto backend = createHeadlessBackend();
+    DisplayBackend::Options options;
+    options.width = kWidth;
+    options.height = kHeight;
+    if (!backend || !backend->create(options) || !backend->loadGL()) {
+        std::printf("skip: no headless GL context\n");
+        return dhttest::kSkip;
+    }
+    GLState& gs = GLState::get();
+    gs.invalidate();
+    MarkerRenderer renderer;
+    CHECK(renderer.ok());
+    if (!renderer.ok()) return dhttest::result();
+
+    const marker::Layout rgba{4, 0x00FFFFFFu, {0, 1, 2}};
+    const uint32_t frames[] = {0u, 1u, 12345u, 0x80000001u, 0xFFFFFFFFu};
+    for (int i = 0; i < 5; ++i) {
+        paint(gs, backend->defaultFramebuffer(), i);
+        glClearColor(0.25f, 0.5f, 0.75f, 1.0f);
+        renderer.draw(frames[i], backend->defaultFramebuffer(), backend->readBuffer(), kWidth, kHeight);
+        GLfloat clear[4];
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, clear);
+        CHECK(clear[0] == 0.25f && clear[1] == 0.5f && clear[2] == 0.75f);
+
+        const std::vector<uint8_t> image = grab(gs, *backend);
+        float level[marker::kRows][marker::kCells];
+        marker::measure(image.data(), kWidth, kHeight, static_cast<size_t>(kWidth) * 4, rgba, level);
+        marker::Payload got;
+        CHECK(marker::decode(level, got));
+        CHECK(marker::valid(got));
+        CHECK_EQ(got.frame, frames[i]);
+
+        float mean[marker::kBlocks];
+        marker::measureBlocks(image.data(), kWidth, kHeight, static_cast<size_t>(kWidth) * 4, rgba, mean);
+        CHECK_EQ(marker::contentMismatches(got.content, level, mean, 0.0f), 0);
+        for (float& m : mean) m /= 255.0f;
+        CHECK_EQ(got.content, marker::signature(mean));
+        CHECK_EQ(marker::blockLevel(got.content, 0), marker::kBlockLevels);
+        CHECK_EQ(marker::blockLevel(got.content, 7), 0);
+        CHECK_EQ(marker::blockLevel(got.content, 3), 3 + i);
+    }
+    CHECK_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+    return dhttest::result();
+}
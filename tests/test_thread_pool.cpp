@@ -0,0 +1,72 @@
+// ThreadPool：parallelFor 每个下标恰好执行一次（随机区间与粒度、多种线程数），
+// fn 内嵌套 parallelFor、多个线程同时提交时均能完成且不重不漏
+#include "thread_pool.h"
+#include "test_common.h"
+
+#include <random>
+
+namespace {
+
+// 每个下标的执行次数；返回不为 1 的下标数
+size_t coverage(ThreadPool& pool, size_t count, size_t grain) {
+    std::vector<std::atomic<int>> hits(count);
+    pool.parallelFor(count, grain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) hits[i].fetch_add(1, std::memory_order_relaxed);
+    });
+    size_t bad = 0;
+    for (auto& h : hits) bad += h.load() != 1;
+    return bad;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(7);
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        ThreadPool pool(threads);
+        CHECK_EQ(pool.size(), threads);
+        CHECK_EQ(coverage(pool, 0, 1), 0u);
+        for (int trial = 0; trial < 200; ++trial) {
+            const size_t count = rng() % 5000;
+            const size_t grain = 1 + rng() % 64;
+            const size_t bad = coverage(pool, count, grain);
+            if (bad) std::fprintf(stderr, "threads %u count %zu grain %zu: %zu bad\n", threads, count, grain, bad);
+            CHECK(bad == 0);
+        }
+    }
+
+    ThreadPool pool(4);
+
+    // 嵌套：外层每块再对内层区间 parallelFor（提交者始终做完自己的任务，不会互相等待而死锁）
+    {
+        constexpr size_t kOuter = 64, kInner = 300;
+        std::vector<std::atomic<int>> hits(kOuter * kInner);
+        pool.parallelFor(kOuter, 1, [&](size_t o0, size_t o1) {
+            for (size_t o = o0; o < o1; ++o) {
+                pool.parallelFor(kInner, 7, [&](size_t i0, size_t i1) {
+                    for (size_t i = i0; i < i1; ++i) hits[o * kInner + i].fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+        });
+        size_t bad = 0;
+        for (auto& h : hits) bad += h.load() != 1;
+        CHECK_EQ(bad, 0u);
+    }
+
+    // 并发提交：多个外部线程同时对同一池提交任务
+    {
+        constexpr int kSubmitters = 4;
+        std::atomic<size_t> bad{0};
+        std::vector<std::thread> submitters;
+        for (int s = 0; s < kSubmitters; ++s) {
+            submitters.emplace_back([&, s] {
+                std::mt19937 local(100 + s);
+                for (int trial = 0; trial < 100; ++trial)
+                    bad += coverage(pool, 1 + local() % 3000, 1 + local() % 32);
+            });
+        }
+        for (auto& t : submitters) t.join();
+        CHECK_EQ(bad.load(), 0u);
+    }
+    return dhttest::result();
+}
@@ -0,0 +1,285 @@
+// dht_bench：逐图样填充率基准。
+// 无头 EGL 上下文中把每个图样离屏渲染到 1080p~8K 目标，统计 GPU 耗时（timer query）、
+// CPU 提交耗时与 Mpixel/s，输出 JSON 便于跨提交对比（llvmpipe 上同样可运行）。
+#include "display_backend.h"
+#include "gl_state.h"
+#include "patterns.h"
+#include "render_target.h"
+#include "shader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+struct Resolution { const char* name; int width; int height; };
+constexpr Resolution kResolutions[] = {
+    {"1080p", 1920, 1080},
+    {"1440p", 2560, 1440},
+    {"4K", 3840, 2160},
+    {"5K", 5120, 2880},
+    {"8K", 7680, 4320},
+};
+
+struct Options {
+    int frames = 30;
+    int warmup = 3;
+    std::vector<Resolution> resolutions;
+    std::string groups = "SDA";
+    RenderTarget::Format format = RenderTarget::Format::RGB10_A2;
+    std::string outPath;    // 空 = 标准输出
+};
+
+struct Result {
+    Resolution res;
+    char group;
+    int index;
+    double gpuMs;           // 每帧 GPU 耗时（timer query）
+    double cpuSubmitMs;     // 每帧 CPU 提交耗时（UBO 更新 + 绘制调用，不含等待）
+    double wallMs;          // 每帧墙钟耗时（含 glFinish）
+    double mpixPerSec;      // 按 GPU 耗时折算
+    double wallMpixPerSec;  // 按墙钟折算（llvmpipe 等软件光栅器的 timer query 只覆盖命令入队，以此为准）
+};
+
+void printUsage(const char* argv0) {
+    std::cout << "Usage: " << argv0 << " [--frames N] [--res 1080p,1440p,4K,5K,8K] [--groups SDA]\n"
+              << "                 [--format rgba8|rgb10a2|rgba16f] [--out file.json]\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) {
+            opt.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--res" && hasValue) {
+            std::stringstream ss(argv[++i]);
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                bool found = false;
+                for (const auto& r : kResolutions) {
+                    if (item == r.name) { opt.resolutions.push_back(r); found = true; }
+                }
+                if (!found) { std::cerr << "Unknown resolution: " << item << std::endl; return false; }
+            }
+        } else if (arg == "--groups" && hasValue) {
+            opt.groups = argv[++i];
+        } else if (arg == "--format" && hasValue) {
+            const std::string f = argv[++i];
+            if (f == "rgba8") opt.format = RenderTarget::Format::RGBA8;
+            else if (f == "rgb10a2") opt.format = RenderTarget::Format::RGB10_A2;
+            else if (f == "rgba16f") opt.format = RenderTarget::Format::RGBA16F;
+            else { std::cerr << "Unknown format: " << f << std::endl; return false; }
+        } else if (arg == "--out" && hasValue) {
+            opt.outPath = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    if (opt.resolutions.empty()) opt.resolutions.assign(std::begin(kResolutions), std::end(kResolutions));
+    return true;
+}
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') { out += '\\'; out += c; }
+        else if (static_cast<unsigned char>(c) < 0x20) out += ' ';
+        else out += c;
+    }
+    return out;
+}
+
+std::string glString(GLenum name) {
+    const GLubyte* s = glGetString(name);
+    return s ? reinterpret_cast<const char*>(s) : "Unknown";
+}
+
+int groupCategory(char g) {
+    return g == 'S' ? 0 : (g == 'D' ? 1 : 2);
+}
+
+// 全屏四边形（与主程序 setupQuad 相同的顶点布局）
+GLuint createQuad(GLuint buffers[2]) {
+    const float vertices[] = {
+        -1.0f, -1.0f, 0.0f, 0.0f,
+         1.0f, -1.0f, 1.0f, 0.0f,
+         1.0f,  1.0f, 1.0f, 1.0f,
+        -1.0f,  1.0f, 0.0f, 1.0f,
+    };
+    const unsigned int indices[] = {0, 1, 2, 2, 3, 0};
+    GLState& gs = GLState::get();
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(2, buffers);
+    gs.bindVertexArray(vao);
+    gs.bindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+    gs.bufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    gs.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+    gs.bufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    return vao;
+}
+
+void writeJson(std::ostream& os, const Options& opt, const std::vector<Result>& results) {
+    os << "{\n"
+       << "  \"tool\": \"dht_bench\",\n"
+       << "  \"gl_vendor\": \"" << jsonEscape(glString(GL_VENDOR)) << "\",\n"
+       << "  \"gl_renderer\": \"" << jsonEscape(glString(GL_RENDERER)) << "\",\n"
+       << "  \"gl_version\": \"" << jsonEscape(glString(GL_VERSION)) << "\",\n"
+       << "  \"format\": \"" << RenderTarget::formatName(opt.format) << "\",\n"
+       << "  \"frames\": " << opt.frames << ",\n"
+       << "  \"results\": [\n";
+    char buf[512];
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::snprintf(buf, sizeof(buf),
+                      "    {\"resolution\": \"%s\", \"width\": %d, \"height\": %d, \"pattern\": \"%c:%d\", "
+                      "\"name\": \"%s\", \"gpu_ms\": %.4f, \"cpu_submit_ms\": %.4f, \"wall_ms\": %.4f, "
+                      "\"mpix_per_s\": %.2f, \"wall_mpix_per_s\": %.2f}%s\n",
+                      r.res.name, r.res.width, r.res.height, r.group, r.index,
+                      jsonEscape(patternName(groupCategory(r.group), r.index, false)).c_str(),
+                      r.gpuMs, r.cpuSubmitMs, r.wallMs, r.mpixPerSec, r.wallMpixPerSec, i + 1 < results.size() ? "," : "");
+        os << buf;
+    }
+    os << "  ]\n}\n";
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    auto backend = createHeadlessBackend();
+    if (!backend) {
+        std::cerr << "dht_bench requires EGL (headless backend not built)" << std::endl;
+        return 1;
+    }
+    DisplayBackend::Options bo;
+    bo.width = 64;
+    bo.height = 64;
+    if (!backend->create(bo) || !backend->loadGL()) {
+        std::cerr << "Failed to create headless GL context" << std::endl;
+        return 1;
+    }
+
+    GLState& gs = GLState::get();
+    gs.invalidate();
+    gs.disable(GL_DEPTH_TEST);
+    gs.disable(GL_BLEND);
+    gs.disable(GL_DITHER);
+
+    Shader shader(kPatternVertexShader, patternFragmentSource());
+    shader.bindUniformBlock("FrameBlock", kFrameBlockBinding);
+    const UniformInt uColorVariation = shader.uniformInt("uColorVariation");
+    GLuint quadBuffers[2] = {0, 0};
+    const GLuint vao = createQuad(quadBuffers);
+    GLuint ubo = 0;
+    glGenBuffers(1, &ubo);
+    gs.bindBuffer(GL_UNIFORM_BUFFER, ubo);
+    gs.bufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_DYNAMIC_DRAW);
+    gs.bindBufferBase(GL_UNIFORM_BUFFER, kFrameBlockBinding, ubo);
+    std::vector<GLuint> queries(static_cast<size_t>(opt.frames));
+    glGenQueries(opt.frames, queries.data());
+
+    std::cerr << "dht_bench on " << glString(GL_RENDERER) << " (" << RenderTarget::formatName(opt.format)
+              << ", " << opt.frames << " frames)" << std::endl;
+
+    using clock = std::chrono::high_resolution_clock;
+    std::vector<Result> results;
+    RenderTarget target;
+    for (const Resolution& res : opt.resolutions) {
+        if (!target.ensure(res.width, res.height, opt.format)) {
+            std::cerr << "  " << res.name << ": offscreen target allocation failed, skipped" << std::endl;
+            continue;
+        }
+        target.bind();
+        shader.use();
+        gs.bindVertexArray(vao);
+        gs.bindBuffer(GL_UNIFORM_BUFFER, ubo);
+
+        for (char group : opt.groups) {
+            const int cat = groupCategory(group);
+            for (int idx = 0; idx < patternCount(cat); ++idx) {
+                if (!isFillRatePattern(cat, idx)) continue; // 提交压力/上传场景由 C++ 端绘制，非填充率图样
+                // 时间按 60 Hz 递进，保证每次运行内容一致
+                auto drawFrame = [&](int f) {
+                    FrameUniforms fu{};
+                    fu.time = static_cast<float>(f) / 60.0f;
+                    fu.frameIndex = f;
+                    fu.category = cat;
+                    fu.contentMode = idx;
+                    fu.resolution[0] = static_cast<float>(res.width);
+                    fu.resolution[1] = static_cast<float>(res.height);
+                    gs.bufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(fu), &fu);
+                    shader.set(uColorVariation, cat == 1 ? idx : 0);
+                    gs.drawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+                };
+                for (int f = 0; f < opt.warmup; ++f) drawFrame(f);
+                glFinish();
+
+                double cpuMs = 0.0;
+                const auto wall0 = clock::now();
+                for (int f = 0; f < opt.frames; ++f) {
+                    const auto t0 = clock::now();
+                    glBeginQuery(GL_TIME_ELAPSED, queries[f]);
+                    drawFrame(opt.warmup + f);
+                    glEndQuery(GL_TIME_ELAPSED);
+                    cpuMs += std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+                }
+                glFinish();
+                const double wallMs = std::chrono::duration<double, std::milli>(clock::now() - wall0).count();
+
+                GLuint64 gpuNs = 0;
+                for (GLuint q : queries) {
+                    GLuint64 ns = 0;
+                    glGetQueryObjectui64v(q, GL_QUERY_RESULT, &ns);
+                    gpuNs += ns;
+                }
+                Result r{res, group, idx, 0, 0, 0, 0, 0};
+                r.gpuMs = gpuNs / 1e6 / opt.frames;
+                r.cpuSubmitMs = cpuMs / opt.frames;
+                r.wallMs = wallMs / opt.frames;
+                const double pixels = static_cast<double>(res.width) * res.height * opt.frames;
+                r.mpixPerSec = gpuNs > 0 ? pixels / (gpuNs / 1e9) / 1e6 : 0.0;
+                r.wallMpixPerSec = wallMs > 0.0 ? pixels / (wallMs / 1e3) / 1e6 : 0.0;
+                results.push_back(r);
+                std::fprintf(stderr, "  %-6s %c:%-2d %-28s %9.3f ms gpu %9.3f ms wall %8.1f Mpix/s\n", res.name, group,
+                             idx, patternName(cat, idx, false), r.gpuMs, r.wallMs, r.wallMpixPerSec);
+            }
+        }
+    }
+
+    if (opt.outPath.empty()) {
+        writeJson(std::cout, opt, results);
+    } else {
+        std::ofstream out(opt.outPath);
+        if (!out) {
+            std::cerr << "Cannot write " << opt.outPath << std::endl;
+            return 1;
+        }
+        writeJson(out, opt, results);
+        std::cerr << "Wrote " << results.size() << " results to " << opt.outPath << std::endl;
+    }
+
+    glDeleteQueries(opt.frames, queries.data());
+    glDeleteBuffers(1, &ubo);
+    glDeleteBuffers(2, quadBuffers);
+    glDeleteVertexArrays(1, &vao);
+    target.release();
+    return 0;
+}
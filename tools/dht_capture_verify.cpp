@@ -0,0 +1,376 @@
+// dht_capture_verify：帧标记采集端校验工具（仅 Linux）。
+// 从 V4L2 采集设备（HDMI 采集卡；测试时可用 v4l2loopback）逐帧读取画面，解码 display_hardware_test
+// 以 --marker（或按 B）绘制的帧标记条，实时报告丢帧、重复、乱序、CRC 与内容签名不符（带采集时间戳），
+// 事件可写入 CSV。需要未压缩格式（YUYV/UYVY/NV12/灰度/RGB），MJPEG 输出的采集卡须切换到原始格式。
+#include "frame_marker.h"
+
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+struct Options {
+    std::string device = "/dev/video0";
+    int width = 0;              // 0 = 保持设备当前尺寸
+    int height = 0;
+    unsigned long long frames = 0;  // 0 = 不限
+    double seconds = 0.0;           // 0 = 不限
+    std::string logPath;            // 空 = 不写事件日志
+    bool scalar = false;
+    float contentTolerance = 1.0f;  // 内容签名容差（4-bit 级，另加半级量化误差）；负数 = 不复核
+};
+
+// 支持的采集格式：平面 YUV 只取首个（亮度）平面；RGB 格式给出 R/G/B 字节偏移，内容签名按 BT.709 亮度复核
+struct Format {
+    uint32_t fourcc;
+    marker::Layout layout;
+    const char* name;
+};
+constexpr Format kFormats[] = {
+    {V4L2_PIX_FMT_YUYV, {2, 0x00FF00FFu}, "YUYV"},
+    {V4L2_PIX_FMT_UYVY, {2, 0xFF00FF00u}, "UYVY"},
+    {V4L2_PIX_FMT_NV12, {1, 0xFFFFFFFFu}, "NV12"},
+    {V4L2_PIX_FMT_NV21, {1, 0xFFFFFFFFu}, "NV21"},
+    {V4L2_PIX_FMT_YUV420, {1, 0xFFFFFFFFu}, "YU12"},
+    {V4L2_PIX_FMT_YVU420, {1, 0xFFFFFFFFu}, "YV12"},
+    {V4L2_PIX_FMT_GREY, {1, 0xFFFFFFFFu}, "GREY"},
+    {V4L2_PIX_FMT_RGB24, {3, 0xFFFFFFFFu, {0, 1, 2}}, "RGB3"},
+    {V4L2_PIX_FMT_BGR24, {3, 0xFFFFFFFFu, {2, 1, 0}}, "BGR3"},
+    {V4L2_PIX_FMT_XBGR32, {4, 0x00FFFFFFu, {2, 1, 0}}, "XR24"},
+    {V4L2_PIX_FMT_ABGR32, {4, 0x00FFFFFFu, {2, 1, 0}}, "AR24"},
+    {V4L2_PIX_FMT_XRGB32, {4, 0xFFFFFF00u, {1, 2, 3}}, "BX24"},
+    {V4L2_PIX_FMT_ARGB32, {4, 0xFFFFFF00u, {1, 2, 3}}, "BA24"},
+};
+
+const Format* findFormat(uint32_t fourcc) {
+    for (const Format& f : kFormats) {
+        if (f.fourcc == fourcc) return &f;
+    }
+    return nullptr;
+}
+
+volatile std::sig_atomic_t stopRequested = 0;
+void onSignal(int) { stopRequested = 1; }
+
+int xioctl(int fd, unsigned long request, void* arg) {
+    int r;
+    do {
+        r = ioctl(fd, request, arg);
+    } while (r == -1 && errno == EINTR);
+    return r;
+}
+
+void printUsage(const char* argv0) {
+    std::cout << "Usage: " << argv0 << " [--device /dev/videoN] [--size WxH] [--frames N] [--seconds S]\n"
+              << "                  [--log PATH] [--scalar] [--content-tolerance LEVELS]\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--device" && hasValue) {
+            opt.device = argv[++i];
+        } else if (arg == "--size" && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &opt.width, &opt.height) != 2 || opt.width <= 0 || opt.height <= 0) {
+                std::cerr << "Invalid size: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--frames" && hasValue) {
+            opt.frames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--seconds" && hasValue) {
+            opt.seconds = std::atof(argv[++i]);
+        } else if (arg == "--log" && hasValue) {
+            opt.logPath = argv[++i];
+        } else if (arg == "--scalar") {
+            opt.scalar = true;
+        } else if (arg == "--content-tolerance" && hasValue) {
+            opt.contentTolerance = static_cast<float>(std::atof(argv[++i]));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 映射的采集缓冲
+struct Buffer {
+    void* start = MAP_FAILED;
+    size_t length = 0;
+};
+
+class Capture {
+public:
+    ~Capture() {
+        if (streaming_) {
+            v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            xioctl(fd_, VIDIOC_STREAMOFF, &type);
+        }
+        for (Buffer& b : buffers_) {
+            if (b.start != MAP_FAILED) munmap(b.start, b.length);
+        }
+        if (fd_ >= 0) close(fd_);
+    }
+
+    bool open(const Options& opt) {
+        fd_ = ::open(opt.device.c_str(), O_RDWR | O_NONBLOCK);
+        if (fd_ < 0) return fail("open " + opt.device);
+        v4l2_capability cap{};
+        if (xioctl(fd_, VIDIOC_QUERYCAP, &cap) < 0) return fail("VIDIOC_QUERYCAP");
+        const uint32_t caps = (cap.capabilities & V4L2_CAP_DEVICE_CAPS) ? cap.device_caps : cap.capabilities;
+        if (!(caps & V4L2_CAP_VIDEO_CAPTURE) || !(caps & V4L2_CAP_STREAMING)) {
+            std::cerr << opt.device << ": not a single-planar streaming capture device" << std::endl;
+            return false;
+        }
+        card_ = reinterpret_cast<const char*>(cap.card);
+
+        fmt_.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if (xioctl(fd_, VIDIOC_G_FMT, &fmt_) < 0) return fail("VIDIOC_G_FMT");
+        format_ = findFormat(fmt_.fmt.pix.pixelformat);
+        // 当前格式不支持或指定了尺寸时，按表中顺序协商
+        if (!format_ || opt.width > 0) {
+            for (const Format& f : kFormats) {
+                v4l2_format want = fmt_;
+                want.fmt.pix.pixelformat = f.fourcc;
+                if (opt.width > 0) {
+                    want.fmt.pix.width = static_cast<uint32_t>(opt.width);
+                    want.fmt.pix.height = static_cast<uint32_t>(opt.height);
+                }
+                want.fmt.pix.bytesperline = 0;
+                if (xioctl(fd_, VIDIOC_S_FMT, &want) == 0 && want.fmt.pix.pixelformat == f.fourcc) {
+                    fmt_ = want;
+                    format_ = &f;
+                    break;
+                }
+            }
+        }
+        if (!format_) {
+            std::cerr << opt.device << ": no uncompressed format supported (YUYV/UYVY/NV12/GREY/RGB)" << std::endl;
+            return false;
+        }
+        if (fmt_.fmt.pix.bytesperline == 0) {
+            fmt_.fmt.pix.bytesperline = fmt_.fmt.pix.width * static_cast<uint32_t>(format_->layout.bytesPerPixel);
+        }
+
+        v4l2_requestbuffers req{};
+        req.count = 4;
+        req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        req.memory = V4L2_MEMORY_MMAP;
+        if (xioctl(fd_, VIDIOC_REQBUFS, &req) < 0 || req.count < 2) return fail("VIDIOC_REQBUFS");
+        buffers_.resize(req.count);
+        for (uint32_t i = 0; i < req.count; ++i) {
+            v4l2_buffer buf{};
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            buf.index = i;
+            if (xioctl(fd_, VIDIOC_QUERYBUF, &buf) < 0) return fail("VIDIOC_QUERYBUF");
+            buffers_[i].length = buf.length;
+            buffers_[i].start = mmap(nullptr, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, buf.m.offset);
+            if (buffers_[i].start == MAP_FAILED) return fail("mmap");
+            if (xioctl(fd_, VIDIOC_QBUF, &buf) < 0) return fail("VIDIOC_QBUF");
+        }
+        v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if (xioctl(fd_, VIDIOC_STREAMON, &type) < 0) return fail("VIDIOC_STREAMON");
+        streaming_ = true;
+        return true;
+    }
+
+    // 等待下一帧（超时返回 0，出错返回 -1）；成功时 buf 为已出队缓冲，处理后须 release
+    int next(v4l2_buffer& buf, int timeoutMs) {
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(fd_, &fds);
+        timeval tv{timeoutMs / 1000, (timeoutMs % 1000) * 1000};
+        const int r = select(fd_ + 1, &fds, nullptr, nullptr, &tv);
+        if (r <= 0) return r < 0 && errno != EINTR ? -1 : 0;
+        buf = v4l2_buffer{};
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        if (xioctl(fd_, VIDIOC_DQBUF, &buf) < 0) return errno == EAGAIN ? 0 : -1;
+        return 1;
+    }
+
+    void release(v4l2_buffer& buf) { xioctl(fd_, VIDIOC_QBUF, &buf); }
+
+    const uint8_t* data(const v4l2_buffer& buf) const { return static_cast<const uint8_t*>(buffers_[buf.index].start); }
+    int width() const { return static_cast<int>(fmt_.fmt.pix.width); }
+    int height() const { return static_cast<int>(fmt_.fmt.pix.height); }
+    size_t stride() const { return fmt_.fmt.pix.bytesperline; }
+    const Format& format() const { return *format_; }
+    const std::string& card() const { return card_; }
+
+private:
+    bool fail(const std::string& what) {
+        std::cerr << what << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    int fd_ = -1;
+    bool streaming_ = false;
+    v4l2_format fmt_{};
+    const Format* format_ = nullptr;
+    std::vector<Buffer> buffers_;
+    std::string card_;
+};
+
+// 帧序判定：以已见最大帧号为基准（乱序帧不回退基准），差值按 32 位回绕计算
+struct Tracker {
+    unsigned long long frames = 0, decoded = 0, noMarker = 0, crcErrors = 0, contentErrors = 0;
+    unsigned long long dropped = 0, dropEvents = 0, duplicates = 0, reordered = 0;
+    bool haveLast = false;
+    uint32_t last = 0;
+    bool markerLost = false;    // 连续无标记只报告一次
+};
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    marker::setForceScalar(opt.scalar);
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    Capture cap;
+    if (!cap.open(opt)) return 1;
+    std::cerr << "dht_capture_verify " << opt.device << " (" << cap.card() << ") " << cap.width() << "x" << cap.height()
+              << " " << cap.format().name << ", " << marker::simdPath() << " kernels" << std::endl;
+
+    std::ofstream log;
+    if (!opt.logPath.empty()) {
+        log.open(opt.logPath, std::ios::out | std::ios::app);
+        if (!log.is_open()) {
+            std::cerr << "Cannot write " << opt.logPath << std::endl;
+            return 1;
+        }
+        if (log.tellp() == 0) log << "time_s,sequence,event,frame,expected,count\n";
+    }
+
+    Tracker t;
+    double firstTs = -1.0;
+    unsigned long long lastSequence = 0;
+    // 事件：控制台与 CSV 各一行；time 为驱动给出的采集时间戳（相对首帧，秒）
+    auto event = [&](double ts, unsigned long long seq, const char* what, uint32_t frame, uint32_t expected,
+                     unsigned long long count) {
+        std::printf("[%10.4f s] #%-8llu %-10s frame %u (expected %u) x%llu\n", ts, seq, what, frame, expected, count);
+        if (log.is_open()) {
+            log << ts << ',' << seq << ',' << what << ',' << frame << ',' << expected << ',' << count << '\n';
+        }
+    };
+
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    auto lastReport = start;
+    unsigned long long reportFrames = 0;
+    double decodeMs = 0.0;
+    float level[marker::kRows][marker::kCells];
+    float blockMean[marker::kBlocks];
+    while (!stopRequested) {
+        if (opt.frames && t.frames >= opt.frames) break;
+        if (opt.seconds > 0.0 && std::chrono::duration<double>(clock::now() - start).count() >= opt.seconds) break;
+
+        v4l2_buffer buf;
+        const int r = cap.next(buf, 2000);
+        if (r < 0) {
+            std::cerr << "capture error: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (r == 0) {
+            if (!stopRequested) std::cerr << "no frames for 2 s" << std::endl;
+            continue;
+        }
+        const double captureTs = buf.timestamp.tv_sec + buf.timestamp.tv_usec * 1e-6;
+        if (firstTs < 0.0) firstTs = captureTs;
+        const double ts = captureTs - firstTs;
+        // 驱动序号跳变说明采集端自身丢帧（与被测链路无关），单独报告
+        if (t.frames && buf.sequence > lastSequence + 1) {
+            event(ts, buf.sequence, "cap-drop", 0, 0, buf.sequence - lastSequence - 1);
+        }
+        lastSequence = buf.sequence;
+
+        const auto d0 = clock::now();
+        marker::measure(cap.data(buf), cap.width(), cap.height(), cap.stride(), cap.format().layout, level);
+        marker::Payload p;
+        const bool found = marker::decode(level, p);
+        // 内容签名复核：标记条以上区域的块均值与标记携带的签名不符，说明画面与帧号不对应（如旧内容配新标记）
+        int badBlocks = 0;
+        if (found && opt.contentTolerance >= 0.0f && marker::valid(p)) {
+            marker::measureBlocks(cap.data(buf), cap.width(), cap.height(), cap.stride(), cap.format().layout, blockMean);
+            badBlocks = marker::contentMismatches(p.content, level, blockMean, opt.contentTolerance);
+        }
+        decodeMs += std::chrono::duration<double, std::milli>(clock::now() - d0).count();
+        cap.release(buf);
+        t.frames++;
+        reportFrames++;
+
+        if (!found) {
+            t.noMarker++;
+            if (!t.markerLost) event(ts, buf.sequence, "no-marker", 0, t.last + 1, 1);
+            t.markerLost = true;
+        } else if (!marker::valid(p)) {
+            t.crcErrors++;
+            event(ts, buf.sequence, "crc", p.frame, t.last + 1, 1);
+        } else {
+            t.markerLost = false;
+            t.decoded++;
+            if (badBlocks) {
+                t.contentErrors++;
+                event(ts, buf.sequence, "content", p.frame, p.frame, static_cast<unsigned long long>(badBlocks));
+            }
+            if (t.haveLast) {
+                const int32_t delta = static_cast<int32_t>(p.frame - t.last);
+                if (delta == 0) {
+                    t.duplicates++;
+                    event(ts, buf.sequence, "duplicate", p.frame, t.last + 1, 1);
+                } else if (delta < 0) {
+                    t.reordered++;
+                    event(ts, buf.sequence, "reorder", p.frame, t.last + 1, 1);
+                } else if (delta > 1) {
+                    t.dropped += static_cast<unsigned long long>(delta - 1);
+                    t.dropEvents++;
+                    event(ts, buf.sequence, "drop", p.frame, t.last + 1, static_cast<unsigned long long>(delta - 1));
+                }
+                if (delta > 0) t.last = p.frame;
+            } else {
+                t.last = p.frame;
+                t.haveLast = true;
+            }
+        }
+
+        const auto now = clock::now();
+        const double since = std::chrono::duration<double>(now - lastReport).count();
+        if (since >= 1.0) {
+            std::fprintf(stderr, "%.1f fps | frames %llu decoded %llu | drop %llu (%llu events) dup %llu reorder %llu crc %llu"
+                                 " content %llu no-marker %llu | decode %.3f ms\n",
+                         reportFrames / since, t.frames, t.decoded, t.dropped, t.dropEvents, t.duplicates, t.reordered,
+                         t.crcErrors, t.contentErrors, t.noMarker, decodeMs / reportFrames);
+            if (log.is_open()) log.flush();
+            lastReport = now;
+            reportFrames = 0;
+            decodeMs = 0.0;
+        }
+    }
+
+    std::printf("\nSummary: %llu frames, %llu decoded, %llu dropped in %llu events, %llu duplicated, %llu reordered, "
+                "%llu CRC mismatches, %llu content mismatches, %llu without marker\n",
+                t.frames, t.decoded, t.dropped, t.dropEvents, t.duplicates, t.reordered, t.crcErrors, t.contentErrors,
+                t.noMarker);
+    // 渲染帧率低于刷新率时重复是预期的；丢帧、乱序、CRC 与内容签名不符才判为失败
+    return (t.dropped || t.reordered || t.crcErrors || t.contentErrors) ? 2 : 0;
+}
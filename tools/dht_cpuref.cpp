@@ -0,0 +1,388 @@
+// dht_cpuref：CPU 参考光栅器工具。
+// 用多线程（工作窃取线程池）+ SIMD 内核在 CPU 上渲染全部图样，统计每帧耗时与 Mpixel/s；
+// 可导出 10-bit PPM 黄金图（无需 GL），或在无头 EGL 上下文中与 GPU 的 RGB10_A2 回读逐像素比对；
+// --entropy 对每帧做熵/可压缩性估计，并按估计码长给图样排名；--dsc 以 DSC 1.2a 编码器模型给图样打分。
+#include "cpu_raster.h"
+#include "display_backend.h"
+#include "dsc_model.h"
+#include "frame_entropy.h"
+#include "gl_state.h"
+#include "patterns.h"
+#include "render_target.h"
+#include "shader.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+struct Options {
+    int width = 1920;
+    int height = 1080;
+    int frames = 10;
+    std::string groups = "SDA";
+    bool scalar = false;
+    bool compare = false;
+    bool entropy = false;
+    double dscBpp = 0.0;    // 0 = 不运行 DSC 模型
+    std::string dumpDir;    // 空 = 不导出
+};
+
+// 逐像素比对统计（按通道码值差）
+struct Diff {
+    unsigned long long pixels = 0;
+    unsigned long long exact = 0;
+    unsigned long long overOne = 0;     // 任一通道差值 > 1 LSB
+    int maxDiff = 0;
+};
+
+void printUsage(const char* argv0) {
+    std::cout << "Usage: " << argv0 << " [--size WxH] [--frames N] [--groups SDA] [--scalar]\n"
+              << "                  [--dump DIR] [--compare] [--entropy] [--dsc BPP]\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &opt.width, &opt.height) != 2 || opt.width <= 0 || opt.height <= 0) {
+                std::cerr << "Invalid size: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--frames" && hasValue) {
+            opt.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--groups" && hasValue) {
+            opt.groups = argv[++i];
+        } else if (arg == "--scalar") {
+            opt.scalar = true;
+        } else if (arg == "--dump" && hasValue) {
+            opt.dumpDir = argv[++i];
+        } else if (arg == "--compare") {
+            opt.compare = true;
+        } else if (arg == "--entropy") {
+            opt.entropy = true;
+        } else if (arg == "--dsc" && hasValue) {
+            opt.dscBpp = std::atof(argv[++i]);
+            if (opt.dscBpp < 6.0 || opt.dscBpp > 30.0) {
+                std::cerr << "Invalid DSC bpp: " << argv[i] << std::endl;
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+int groupCategory(char g) {
+    return g == 'S' ? 0 : (g == 'D' ? 1 : 2);
+}
+
+// 16-bit PPM（maxval 1023），自上而下存储
+bool writePpm(const std::string& path, const std::vector<uint32_t>& px, int w, int h) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    std::fprintf(f, "P6\n%d %d\n1023\n", w, h);
+    std::vector<unsigned char> line(static_cast<size_t>(w) * 6);
+    for (int y = h - 1; y >= 0; --y) {
+        const uint32_t* row = px.data() + static_cast<size_t>(y) * w;
+        for (int x = 0; x < w; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                const uint32_t v = (row[x] >> (10 * c)) & 0x3FF;
+                line[x * 6 + c * 2] = static_cast<unsigned char>(v >> 8);
+                line[x * 6 + c * 2 + 1] = static_cast<unsigned char>(v & 0xFF);
+            }
+        }
+        std::fwrite(line.data(), 1, line.size(), f);
+    }
+    return std::fclose(f) == 0;
+}
+
+void accumulate(Diff& d, const uint32_t* cpu, const uint32_t* gpu, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t a = cpu[i], b = gpu[i];
+        int worst = 0;
+        for (int c = 0; c < 3; ++c) {
+            const int diff = std::abs(static_cast<int>((a >> (10 * c)) & 0x3FF) - static_cast<int>((b >> (10 * c)) & 0x3FF));
+            worst = std::max(worst, diff);
+        }
+        d.exact += worst == 0;
+        d.overOne += worst > 1;
+        d.maxDiff = std::max(d.maxDiff, worst);
+    }
+    d.pixels += count;
+}
+
+// GPU 侧：与主程序相同的着色器、四边形与 FrameBlock，渲染到 RGB10_A2 离屏目标后同步回读
+class GpuReference {
+public:
+    bool init(int width, int height) {
+        backend_ = createHeadlessBackend();
+        if (!backend_) {
+            std::cerr << "--compare requires EGL (headless backend not built)" << std::endl;
+            return false;
+        }
+        DisplayBackend::Options bo;
+        bo.width = 64;
+        bo.height = 64;
+        if (!backend_->create(bo) || !backend_->loadGL()) {
+            std::cerr << "Failed to create headless GL context" << std::endl;
+            return false;
+        }
+        GLState& gs = GLState::get();
+        gs.invalidate();
+        gs.disable(GL_DEPTH_TEST);
+        gs.disable(GL_BLEND);
+        gs.disable(GL_DITHER);
+        if (!target_.ensure(width, height, RenderTarget::Format::RGB10_A2)) {
+            std::cerr << "Offscreen RGB10_A2 target allocation failed" << std::endl;
+            return false;
+        }
+        shader_ = std::make_unique<Shader>(kPatternVertexShader, patternFragmentSource());
+        shader_->bindUniformBlock("FrameBlock", kFrameBlockBinding);
+        uColorVariation_ = shader_->uniformInt("uColorVariation");
+
+        const float vertices[] = {
+            -1.0f, -1.0f, 0.0f, 0.0f,
+             1.0f, -1.0f, 1.0f, 0.0f,
+             1.0f,  1.0f, 1.0f, 1.0f,
+            -1.0f,  1.0f, 0.0f, 1.0f,
+        };
+        const unsigned int indices[] = {0, 1, 2, 2, 3, 0};
+        glGenVertexArrays(1, &vao_);
+        glGenBuffers(2, buffers_);
+        gs.bindVertexArray(vao_);
+        gs.bindBuffer(GL_ARRAY_BUFFER, buffers_[0]);
+        gs.bufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+        gs.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers_[1]);
+        gs.bufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+        glGenBuffers(1, &ubo_);
+        gs.bindBuffer(GL_UNIFORM_BUFFER, ubo_);
+        gs.bufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_DYNAMIC_DRAW);
+        gs.bindBufferBase(GL_UNIFORM_BUFFER, kFrameBlockBinding, ubo_);
+        const GLubyte* renderer = glGetString(GL_RENDERER);
+        std::cerr << "GPU reference: " << (renderer ? reinterpret_cast<const char*>(renderer) : "Unknown") << std::endl;
+        return true;
+    }
+
+    void render(int cat, int idx, const cpuraster::Frame& frame, std::vector<uint32_t>& out) {
+        GLState& gs = GLState::get();
+        target_.bind();
+        shader_->use();
+        gs.bindVertexArray(vao_);
+        gs.bindBuffer(GL_UNIFORM_BUFFER, ubo_);
+        FrameUniforms fu{};
+        fu.time = frame.time;
+        fu.frameIndex = static_cast<int>(frame.frameIndex);
+        fu.category = cat;
+        fu.contentMode = idx;
+        fu.resolution[0] = static_cast<float>(frame.width);
+        fu.resolution[1] = static_cast<float>(frame.height);
+        gs.bufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(fu), &fu);
+        shader_->set(uColorVariation_, cat == 1 ? idx : 0);
+        gs.drawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        out.resize(static_cast<size_t>(frame.width) * frame.height);
+        gs.bindFramebuffer(GL_READ_FRAMEBUFFER, target_.framebuffer());
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0, 0, frame.width, frame.height, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV, out.data());
+    }
+
+    ~GpuReference() {
+        if (!backend_) return;
+        if (ubo_) glDeleteBuffers(1, &ubo_);
+        if (vao_) {
+            glDeleteBuffers(2, buffers_);
+            glDeleteVertexArrays(1, &vao_);
+        }
+        shader_.reset();
+        target_.release();
+    }
+
+private:
+    std::unique_ptr<DisplayBackend> backend_;
+    RenderTarget target_;
+    std::unique_ptr<Shader> shader_;
+    UniformInt uColorVariation_;
+    GLuint vao_ = 0, ubo_ = 0;
+    GLuint buffers_[2] = {0, 0};
+};
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    cpuraster::setForceScalar(opt.scalar);
+    entropy::setForceScalar(opt.scalar);
+
+    GpuReference gpu;
+    if (opt.compare && !gpu.init(opt.width, opt.height)) return 1;
+
+    std::cerr << "dht_cpuref " << opt.width << "x" << opt.height << ", " << opt.frames << " frames, "
+              << ThreadPool::shared().size() << " threads, " << cpuraster::simdPath() << " kernels" << std::endl;
+
+    // --entropy：逐帧平均（三通道平均），结束后按 Rice 估计码长从高到低排名
+    struct EntropyRow {
+        char label[16];
+        int cat, idx;
+        entropy::FrameStats mean;
+        double ms;
+    };
+    std::vector<EntropyRow> entropyRows;
+    entropy::Analyzer analyzer;
+
+    // --dsc：逐帧取最差值（缓冲峰值、码率需求）与累计强制量化，结束后按缓冲峰值排名
+    struct DscRow {
+        char label[16];
+        int cat, idx;
+        double demandBpp, codedBpp, avgQp, peakFullness, ms;
+        long long forcedQuant, overflow;
+        int maxError;
+    };
+    std::vector<DscRow> dscRows;
+    dsc::Config dscConfig;
+    dscConfig.bitsPerPixel = opt.dscBpp;
+
+    using clock = std::chrono::high_resolution_clock;
+    const size_t pixelCount = static_cast<size_t>(opt.width) * opt.height;
+    std::vector<uint32_t> cpuPixels(pixelCount), gpuPixels, prevPixels;
+    int failures = 0;
+    for (char group : opt.groups) {
+        const int cat = groupCategory(group);
+        for (int idx = 0; idx < patternCount(cat); ++idx) {
+            Diff diff;
+            double cpuMs = 0.0;
+            EntropyRow er{};
+            std::snprintf(er.label, sizeof(er.label), "%c:%d", group, idx);
+            er.cat = cat;
+            er.idx = idx;
+            DscRow dr{};
+            std::memcpy(dr.label, er.label, sizeof(dr.label));
+            dr.cat = cat;
+            dr.idx = idx;
+            for (int f = 0; f < opt.frames; ++f) {
+                // 与 dht_bench 相同：时间按 60 Hz 递进，帧序即帧号
+                cpuraster::Frame frame;
+                frame.width = opt.width;
+                frame.height = opt.height;
+                frame.time = static_cast<float>(f) / 60.0f;
+                frame.frameIndex = static_cast<uint32_t>(f);
+                const auto t0 = clock::now();
+                cpuraster::render(cat, idx, frame, cpuPixels.data());
+                cpuMs += std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+                if (opt.compare) {
+                    gpu.render(cat, idx, frame, gpuPixels);
+                    accumulate(diff, cpuPixels.data(), gpuPixels.data(), pixelCount);
+                }
+                if (opt.entropy) {
+                    const auto e0 = clock::now();
+                    const entropy::FrameStats fs =
+                        analyzer.analyze(cpuPixels.data(), opt.width, opt.height, f ? prevPixels.data() : nullptr);
+                    er.ms += std::chrono::duration<double, std::milli>(clock::now() - e0).count();
+                    for (int c = 0; c < 3; ++c) {
+                        for (int p = 0; p < entropy::kPredictorCount; ++p) er.mean.bits[p][c] += fs.bits[p][c] / opt.frames;
+                        er.mean.riceBits[c] += fs.riceBits[c] / opt.frames;
+                        if (f) er.mean.temporalMse[c] += fs.temporalMse[c] / (opt.frames - 1);
+                    }
+                    if (f) er.mean.changed += fs.changed / (opt.frames - 1);
+                    prevPixels = cpuPixels;
+                }
+                if (opt.dscBpp > 0.0) {
+                    const dsc::FrameScore ds = dsc::encode(cpuPixels.data(), opt.width, opt.height, dscConfig);
+                    dr.demandBpp = std::max(dr.demandBpp, ds.demandBpp);
+                    dr.codedBpp += ds.codedBpp / opt.frames;
+                    dr.avgQp += ds.avgQp / opt.frames;
+                    dr.peakFullness = std::max(dr.peakFullness, ds.peakFullness);
+                    dr.forcedQuant += ds.forcedQuant;
+                    dr.overflow += ds.overflow;
+                    dr.maxError = std::max(dr.maxError, ds.maxError);
+                    dr.ms += ds.ms / opt.frames;
+                }
+            }
+            if (opt.dscBpp > 0.0) dscRows.push_back(dr);
+            if (opt.entropy) {
+                er.ms /= opt.frames;
+                entropyRows.push_back(er);
+            }
+            if (!opt.dumpDir.empty()) {
+                char name[64];
+                std::snprintf(name, sizeof(name), "/%c%02d.ppm", group, idx);
+                if (!writePpm(opt.dumpDir + name, cpuPixels, opt.width, opt.height))
+                    std::cerr << "Cannot write " << opt.dumpDir << name << std::endl;
+            }
+            const double msPerFrame = cpuMs / opt.frames;
+            const double mpix = msPerFrame > 0.0 ? pixelCount / (msPerFrame / 1e3) / 1e6 : 0.0;
+            std::printf("%c:%-2d %-28s %9.3f ms %8.1f Mpix/s", group, idx, patternName(cat, idx, false), msPerFrame, mpix);
+            if (opt.compare) {
+                const bool exact = cpuraster::bitExact(cat, idx);
+                const bool fail = exact && diff.exact != diff.pixels;
+                failures += fail;
+                std::printf("  exact %7.3f%%  >1LSB %7.3f%%  max %4d  %s", 100.0 * diff.exact / diff.pixels,
+                            100.0 * diff.overOne / diff.pixels, diff.maxDiff,
+                            exact ? (fail ? "FAIL" : "bit-exact") : "tolerance");
+            }
+            if (opt.entropy) {
+                auto avg = [](const double* v) { return (v[0] + v[1] + v[2]) / 3.0; };
+                std::printf("  H raw/left/top/MED %5.2f/%5.2f/%5.2f/%5.2f  Rice %5.2f bps  dMSE %9.1f  %6.2f ms",
+                            avg(er.mean.bits[entropy::kRaw]), avg(er.mean.bits[entropy::kLeft]),
+                            avg(er.mean.bits[entropy::kTop]), avg(er.mean.bits[entropy::kMed]), avg(er.mean.riceBits),
+                            avg(er.mean.temporalMse), er.ms);
+            }
+            if (opt.dscBpp > 0.0) {
+                std::printf("  DSC demand %5.2f coded %5.2f bpp  QP %4.1f  peak %5.1f%%  forced %6lld  ovf %6lld  err %4d  %7.2f ms",
+                            dr.demandBpp, dr.codedBpp, dr.avgQp, dr.peakFullness * 100.0, dr.forcedQuant, dr.overflow,
+                            dr.maxError, dr.ms);
+            }
+            std::printf("\n");
+        }
+    }
+    if (opt.entropy && !entropyRows.empty()) {
+        std::stable_sort(entropyRows.begin(), entropyRows.end(), [](const EntropyRow& a, const EntropyRow& b) {
+            return a.mean.riceBits[0] + a.mean.riceBits[1] + a.mean.riceBits[2] >
+                   b.mean.riceBits[0] + b.mean.riceBits[1] + b.mean.riceBits[2];
+        });
+        std::printf("\nLink stress ranking (%s kernels; MED residual, block-adaptive Rice, bits/sample of 10):\n",
+                    entropy::simdPath());
+        int rank = 0;
+        for (const EntropyRow& r : entropyRows) {
+            const double rice = (r.mean.riceBits[0] + r.mean.riceBits[1] + r.mean.riceBits[2]) / 3.0;
+            std::printf("%3d. %-5s %-28s %5.2f bps  %5.2f:1  changed %6.2f%%\n", ++rank, r.label,
+                        patternName(r.cat, r.idx, false), rice, rice > 0.0 ? 10.0 / rice : 0.0, 100.0 * r.mean.changed);
+        }
+    }
+    if (!dscRows.empty()) {
+        // 缓冲峰值相同（均触顶）时按强制量化次数、再按码率需求区分
+        std::stable_sort(dscRows.begin(), dscRows.end(), [](const DscRow& a, const DscRow& b) {
+            if (a.peakFullness != b.peakFullness) return a.peakFullness > b.peakFullness;
+            if (a.forcedQuant != b.forcedQuant) return a.forcedQuant > b.forcedQuant;
+            return a.demandBpp > b.demandBpp;
+        });
+        std::printf("\nDSC stress ranking (%.2f bpp target, 10 bpc; rate-buffer peak, forced quantization, bpp demand):\n",
+                    opt.dscBpp);
+        int rank = 0;
+        for (const DscRow& r : dscRows) {
+            std::printf("%3d. %-5s %-28s peak %5.1f%%  forced %6lld  demand %5.2f bpp  QP %4.1f\n", ++rank, r.label,
+                        patternName(r.cat, r.idx, false), r.peakFullness * 100.0, r.forcedQuant, r.demandBpp, r.avgQp);
+        }
+    }
+    if (opt.compare && failures) {
+        std::cerr << failures << " bit-exact pattern(s) mismatched" << std::endl;
+        return 2;
+    }
+    return 0;
+}
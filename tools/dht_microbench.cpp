@@ -0,0 +1,157 @@
+// dht_microbench：CPU 热路径微基准。
+// 在 1000 Hz 循环下每帧预算仅 1 ms，覆盖层构建、帧率计算与输入处理的开销需可单独回归。
+// 默认使用无头上下文（需 EGL），--windowed 时使用 GLFW 窗口。
+#include "display_hardware_test.h"
+#include "text_renderer.h"
+#include "alloc_tracker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// MonitorTest 的友元：直接调用私有热路径
+struct MicrobenchAccess {
+    static size_t overlayLines(MonitorTest& t) {
+        t.frameArena.reset(); // 与主循环一致：每帧开始时复位
+        return t.buildOverlayLines().size();
+    }
+    static size_t controlItems(MonitorTest& t) { return t.buildControlItems().size(); }
+    static double targetFps(MonitorTest& t) { return t.calculateTargetFps(); }
+    static void handleInput(MonitorTest& t) { t.handleInput(); }
+    static TextRenderer* text(MonitorTest& t) { return t.textRenderer.get(); }
+    static void setMode(MonitorTest& t, TestMode mode) { t.config.mode = mode; }
+    static void setLanguage(MonitorTest& t, Language lang) { t.language = lang; }
+    static void setMinimal(MonitorTest& t, bool minimal) { t.minimalOverlay = minimal; }
+};
+
+namespace {
+constexpr int kBatches = 10;        // 每项分批计时，报告最快批与中位批（排除调度抖动）
+
+struct Result {
+    std::string name;
+    double bestNs;
+    double medianNs;
+    double allocsPerCall;   // 仅 DHT_ALLOC_TRACKING 构建时有效
+};
+
+volatile size_t gSink = 0;          // 防止结果被优化掉
+
+Result measure(const std::string& name, int iterations, const std::function<size_t()>& fn) {
+    const int perBatch = std::max(1, iterations / kBatches);
+    for (int i = 0; i < std::min(perBatch, 1000); ++i) gSink = gSink + fn(); // 预热（字形缓存、分配器）
+    std::vector<double> batchNs;
+    const alloc::Counters allocStart = alloc::threadCounters();
+    for (int b = 0; b < kBatches; ++b) {
+        const auto t0 = std::chrono::steady_clock::now();
+        size_t acc = 0;
+        for (int i = 0; i < perBatch; ++i) acc += fn();
+        const auto t1 = std::chrono::steady_clock::now();
+        gSink = gSink + acc;
+        batchNs.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / perBatch);
+    }
+    // batchNs 自身的分配（至多数次扩容）相对总调用次数可忽略
+    const double allocs = static_cast<double>(alloc::threadCounters().allocs - allocStart.allocs);
+    std::sort(batchNs.begin(), batchNs.end());
+    return {name, batchNs.front(), batchNs[batchNs.size() / 2], allocs / (static_cast<double>(perBatch) * kBatches)};
+}
+
+void printUsage(const char* argv0) {
+    std::cout << "Usage: " << argv0 << " [--iters N] [--windowed] [--out file.json]\n";
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 20000;
+    bool windowed = false;
+    std::string outPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iters") == 0 && i + 1 < argc) {
+            iterations = std::max(kBatches, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--windowed") == 0) {
+            windowed = true;
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    MonitorTest test;
+    LaunchOptions options;
+    options.headless = !windowed;
+    options.width = 1920;
+    options.height = 1080;
+    if (!test.initialize(options)) {
+        std::cerr << "Initialization failed" << (windowed ? "" : " (headless needs EGL; try --windowed)") << std::endl;
+        return 1;
+    }
+
+    const std::string asciiLine = "Frame time: 8.33 ms  (Target: 8.33 ms) | Pattern: [D:14] HE: Philox Counter RNG";
+    const std::string cjkLine = "帧时间: 8.33 ms  (目标: 8.33 ms) | 图样: [D:14] 高熵: Philox 计数器随机数";
+    TextRenderer* text = MicrobenchAccess::text(test);
+
+    std::vector<Result> results;
+    results.push_back(measure("utf8_to_utf32_ascii", iterations, [&] { return TextRenderer::Utf8ToUtf32(asciiLine).size(); }));
+    results.push_back(measure("utf8_to_utf32_cjk", iterations, [&] { return TextRenderer::Utf8ToUtf32(cjkLine).size(); }));
+    if (text) {
+        results.push_back(measure("measure_text_ascii", iterations, [&] { return static_cast<size_t>(text->MeasureTextWidth(asciiLine)); }));
+        results.push_back(measure("measure_text_cjk", iterations, [&] { return static_cast<size_t>(text->MeasureTextWidth(cjkLine)); }));
+    }
+    MicrobenchAccess::setMinimal(test, false);
+    MicrobenchAccess::setLanguage(test, Language::ZH);
+    results.push_back(measure("overlay_lines_zh", iterations, [&] { return MicrobenchAccess::overlayLines(test); }));
+    results.push_back(measure("control_items_zh", iterations, [&] { return MicrobenchAccess::controlItems(test); }));
+    MicrobenchAccess::setLanguage(test, Language::EN);
+    results.push_back(measure("overlay_lines_en", iterations, [&] { return MicrobenchAccess::overlayLines(test); }));
+    results.push_back(measure("control_items_en", iterations, [&] { return MicrobenchAccess::controlItems(test); }));
+    MicrobenchAccess::setMinimal(test, true);
+    results.push_back(measure("overlay_lines_minimal", iterations, [&] { return MicrobenchAccess::overlayLines(test); }));
+    MicrobenchAccess::setMinimal(test, false);
+
+    const std::pair<const char*, TestMode> modes[] = {
+        {"target_fps_fixed", TestMode::FIXED_FPS},
+        {"target_fps_jitter", TestMode::JITTER_FPS},
+        {"target_fps_oscillation", TestMode::OSCILLATION_FPS},
+    };
+    for (const auto& [name, mode] : modes) {
+        MicrobenchAccess::setMode(test, mode);
+        results.push_back(measure(name, iterations, [&] { return static_cast<size_t>(MicrobenchAccess::targetFps(test)); }));
+    }
+    MicrobenchAccess::setMode(test, TestMode::FIXED_FPS);
+    results.push_back(measure("handle_input_idle", iterations, [&] { MicrobenchAccess::handleInput(test); return size_t{1}; }));
+
+    // 1000 Hz 下每帧 1 ms 预算的占比
+    std::cout << "\n" << iterations << " iterations x " << kBatches << " batches\n";
+    for (const auto& r : results) {
+        std::printf("%-24s best %10.1f ns  median %10.1f ns  (%.3f%% of 1 ms)",
+                    r.name.c_str(), r.bestNs, r.medianNs, r.medianNs / 1e4);
+        if (alloc::enabled()) std::printf("  %.2f allocs/call", r.allocsPerCall);
+        std::printf("\n");
+    }
+
+    if (!outPath.empty()) {
+        std::ofstream out(outPath);
+        if (!out) {
+            std::cerr << "Cannot write " << outPath << std::endl;
+            return 1;
+        }
+        out << "{\n  \"tool\": \"dht_microbench\",\n  \"iterations\": " << iterations << ",\n  \"results\": [\n";
+        char buf[256];
+        for (size_t i = 0; i < results.size(); ++i) {
+            std::snprintf(buf, sizeof(buf), "    {\"name\": \"%s\", \"best_ns\": %.1f, \"median_ns\": %.1f, \"allocs_per_call\": %.3f}%s\n",
+                          results[i].name.c_str(), results[i].bestNs, results[i].medianNs, results[i].allocsPerCall,
+                          i + 1 < results.size() ? "," : "");
+            out << buf;
+        }
+        out << "  ]\n}\n";
+    }
+    return 0;
+}
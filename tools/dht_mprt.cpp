@@ -0,0 +1,552 @@
+// dht_mprt：运动模糊（MPRT）离线分析工具。
+// 读入高速相机拍摄的 UFO / 移动亮条画面（Y4M 或原始 YUV/灰度，内存映射），按图样的解析运动公式
+// 预测目标位置，逐帧测量亮度剖面：前/后缘 10%–90% 模糊边宽（像素与毫秒）、过冲、下冲、拖影（重影）
+// 与跟踪抖动。帧按块分配到共享线程池并行分析，每帧只读目标所在的水平条带。
+#include "thread_pool.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+// 目标的解析运动（与 patterns.cpp 中 ufoPattern / movingBar 一致；uv 原点在左下）
+struct Target {
+    const char* name;
+    double speed;       // 每秒移动的画面宽度比例，位置 = fract(t * speed)
+    double halfWidth;   // 剖面所在行上目标的半宽（uv）
+    double y;           // 剖面所在行（uv，自下而上）
+    double bandHalf;    // 取平均的条带半高（uv）
+};
+// ufoPattern：3 行，速度 mix(0.6, 2.5, i/2)，椭圆主体 x 半径 0.08/2；movingBar：半宽 0.05，0.25 画面/秒
+constexpr Target kTargets[] = {
+    {"ufo0", 0.60, 0.04, 0.30, 0.01},
+    {"ufo1", 1.55, 0.04, 0.50, 0.01},
+    {"ufo2", 2.50, 0.04, 0.70, 0.01},
+    {"bar", 0.25, 0.05, 0.50, 0.20},
+};
+
+enum class RawFormat { Gray8, Gray16, Yuv420p, Nv12, Yuyv };
+
+struct Options {
+    std::string input;
+    std::string target = "ufo1";
+    double fps = 0.0;           // 0 = 取 Y4M 头
+    bool raw = false;
+    int rawWidth = 0, rawHeight = 0;
+    RawFormat rawFormat = RawFormat::Gray8;
+    int screen[4] = {0, 0, 0, 0};   // 相机画面中显示器区域 x0,y0,x1,y1（自上而下），全 0 = 整帧
+    bool haveT0 = false;
+    double t0 = 0.0;            // 首帧对应的图样时间（秒），缺省时由前若干帧估计
+    double speed = 0.0;         // 覆盖目标速度（画面宽度/秒）
+    double pursuitMs = 0.0;     // >0：模拟眼动追踪，沿预测轨迹平移后平均该时长内的帧（MPRT）
+    std::string csvPath;
+};
+
+// 内存映射的输入：逐帧记录亮度平面的起点，亮度样本为 1 或 2 字节（小端）
+struct Video {
+    const uint8_t* map = nullptr;
+    size_t size = 0;
+    int width = 0, height = 0;
+    double fps = 0.0;
+    int bytesPerSample = 1;
+    int maxCode = 255;          // 样本满量程（Y4M 按标签位深，如 p10 为 1023）
+    int pixelStep = 1;          // 相邻亮度样本的间隔（样本数；YUYV 为 2）
+    size_t rowStride = 0;       // 字节
+    std::vector<size_t> frames; // 每帧亮度平面偏移
+
+    ~Video() {
+        if (map) munmap(const_cast<uint8_t*>(map), size);
+    }
+
+    int sample(size_t frame, int x, int y) const {
+        const uint8_t* p = map + frames[frame] + y * rowStride + static_cast<size_t>(x) * pixelStep * bytesPerSample;
+        return bytesPerSample == 1 ? p[0] : p[0] | (p[1] << 8);
+    }
+};
+
+struct FrameResult {
+    bool valid = false;
+    const char* status = "";
+    double time = 0.0;
+    double center = 0.0;        // 实测中心（相机像素）
+    double lag = 0.0;           // 实测 - 预测（沿运动方向，像素）
+    double leadWidth = 0.0, trailWidth = 0.0;   // 10%–90% 边宽（像素）
+    double overshoot = 0.0, undershoot = 0.0;   // 相对目标亮度（%）
+    double ghost = 0.0;         // 后方相对前方同距离处的最大多余亮度（%）
+    double ghostOffset = 0.0;   // 拖影距中心（像素）
+};
+
+void printUsage(const char* argv0) {
+    std::cout << "Usage: " << argv0 << " INPUT.y4m | --raw WxH --format gray8|gray16|yuv420p|nv12|yuyv --fps N INPUT\n"
+              << "                  [--target ufo0|ufo1|ufo2|bar] [--screen X0,Y0,X1,Y1] [--t0 S] [--speed V]\n"
+              << "                  [--pursuit MS] [--fps N] [--csv PATH]\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--raw" && hasValue) {
+            opt.raw = true;
+            if (std::sscanf(argv[++i], "%dx%d", &opt.rawWidth, &opt.rawHeight) != 2 || opt.rawWidth <= 0 || opt.rawHeight <= 0) {
+                std::cerr << "Invalid size: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--format" && hasValue) {
+            const std::string f = argv[++i];
+            if (f == "gray8") opt.rawFormat = RawFormat::Gray8;
+            else if (f == "gray16") opt.rawFormat = RawFormat::Gray16;
+            else if (f == "yuv420p") opt.rawFormat = RawFormat::Yuv420p;
+            else if (f == "nv12") opt.rawFormat = RawFormat::Nv12;
+            else if (f == "yuyv") opt.rawFormat = RawFormat::Yuyv;
+            else {
+                std::cerr << "Invalid format: " << f << std::endl;
+                return false;
+            }
+        } else if (arg == "--fps" && hasValue) {
+            opt.fps = std::atof(argv[++i]);
+        } else if (arg == "--target" && hasValue) {
+            opt.target = argv[++i];
+        } else if (arg == "--screen" && hasValue) {
+            int* s = opt.screen;
+            if (std::sscanf(argv[++i], "%d,%d,%d,%d", &s[0], &s[1], &s[2], &s[3]) != 4 || s[2] <= s[0] || s[3] <= s[1]) {
+                std::cerr << "Invalid screen rectangle: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--t0" && hasValue) {
+            opt.t0 = std::atof(argv[++i]);
+            opt.haveT0 = true;
+        } else if (arg == "--speed" && hasValue) {
+            opt.speed = std::atof(argv[++i]);
+        } else if (arg == "--pursuit" && hasValue) {
+            opt.pursuitMs = std::atof(argv[++i]);
+        } else if (arg == "--csv" && hasValue) {
+            opt.csvPath = argv[++i];
+        } else if (!arg.empty() && arg[0] != '-' && opt.input.empty()) {
+            opt.input = arg;
+        } else {
+            return false;
+        }
+    }
+    return !opt.input.empty();
+}
+
+bool mapFile(const std::string& path, Video& v) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Cannot open " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat st{};
+    fstat(fd, &st);
+    v.size = static_cast<size_t>(st.st_size);
+    void* p = v.size ? mmap(nullptr, v.size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (p == MAP_FAILED) {
+        std::cerr << "Cannot map " << path << std::endl;
+        return false;
+    }
+    v.map = static_cast<const uint8_t*>(p);
+    return true;
+}
+
+// YUV4MPEG2：文件头一行（W/H/F/C 参数），每帧 "FRAME[ 参数]\n" 后接平面数据；只用亮度平面
+bool indexY4m(Video& v) {
+    const uint8_t* end = v.map + v.size;
+    const uint8_t* nl = static_cast<const uint8_t*>(std::memchr(v.map, '\n', v.size));
+    if (v.size < 10 || std::memcmp(v.map, "YUV4MPEG2 ", 10) != 0 || !nl) {
+        std::cerr << "Not a YUV4MPEG2 file" << std::endl;
+        return false;
+    }
+    const std::string header(reinterpret_cast<const char*>(v.map), nl - v.map);
+    std::string chroma = "420";
+    size_t pos = 0;
+    while ((pos = header.find(' ', pos)) != std::string::npos) {
+        ++pos;
+        const char tag = header[pos];
+        const std::string val = header.substr(pos + 1, header.find(' ', pos) - pos - 1);
+        if (tag == 'W') v.width = std::atoi(val.c_str());
+        else if (tag == 'H') v.height = std::atoi(val.c_str());
+        else if (tag == 'C') chroma = val;
+        else if (tag == 'F') {
+            int num = 0, den = 1;
+            if (std::sscanf(val.c_str(), "%d:%d", &num, &den) == 2 && den > 0) v.fps = static_cast<double>(num) / den;
+        }
+    }
+    if (v.width <= 0 || v.height <= 0) {
+        std::cerr << "Y4M header lacks W/H" << std::endl;
+        return false;
+    }
+    // 色度标签：420/422/444/mono，其后可带位深（"420p10"、"444p16"、"mono16"）；420 另有取样位置变体
+    // （jpeg/paldv/mpeg2，均为 8 位）。位深 > 8 时每样本 2 字节；其他标签（如 444alpha、411）不支持
+    const bool mono = chroma.rfind("mono", 0) == 0;
+    const std::string base = chroma.substr(0, mono ? 4 : 3);
+    std::string suffix = chroma.substr(base.size());
+    if (!mono && !suffix.empty() && suffix[0] == 'p' && suffix.size() > 1 && std::isdigit(static_cast<unsigned char>(suffix[1])))
+        suffix.erase(0, 1);
+    int bits = 8;
+    if (!suffix.empty() && suffix.find_first_not_of("0123456789") == std::string::npos) bits = std::atoi(suffix.c_str());
+    else if (!(suffix.empty() || (base == "420" && (suffix == "jpeg" || suffix == "paldv" || suffix == "mpeg2")))) bits = 0;
+    if ((base != "420" && base != "422" && base != "444" && !mono) || bits < 8 || bits > 16) {
+        std::cerr << "Unsupported Y4M colour space: C" << chroma << std::endl;
+        return false;
+    }
+    v.bytesPerSample = bits > 8 ? 2 : 1;
+    v.maxCode = (1 << bits) - 1;
+    const size_t cw = (v.width + 1) / 2, ch = (v.height + 1) / 2;
+    size_t chromaSamples = 2 * cw * ch;
+    if (base == "422") chromaSamples = 2 * cw * v.height;
+    else if (base == "444") chromaSamples = 2 * static_cast<size_t>(v.width) * v.height;
+    else if (mono) chromaSamples = 0;
+    const size_t frameBytes = (static_cast<size_t>(v.width) * v.height + chromaSamples) * v.bytesPerSample;
+    v.rowStride = static_cast<size_t>(v.width) * v.bytesPerSample;
+    const uint8_t* p = nl + 1;
+    while (p + 5 < end && std::memcmp(p, "FRAME", 5) == 0) {
+        const uint8_t* fl = static_cast<const uint8_t*>(std::memchr(p, '\n', end - p));
+        if (!fl || static_cast<size_t>(end - (fl + 1)) < frameBytes) break;
+        v.frames.push_back(static_cast<size_t>(fl + 1 - v.map));
+        p = fl + 1 + frameBytes;
+    }
+    return true;
+}
+
+bool indexRaw(const Options& opt, Video& v) {
+    v.width = opt.rawWidth;
+    v.height = opt.rawHeight;
+    const size_t pixels = static_cast<size_t>(v.width) * v.height;
+    size_t frameBytes = pixels;
+    v.rowStride = v.width;
+    switch (opt.rawFormat) {
+        case RawFormat::Gray8: break;
+        case RawFormat::Gray16:
+            v.bytesPerSample = 2;
+            v.maxCode = 65535;
+            frameBytes = pixels * 2;
+            v.rowStride = static_cast<size_t>(v.width) * 2;
+            break;
+        case RawFormat::Yuv420p:
+        case RawFormat::Nv12: frameBytes = pixels + 2 * ((v.width + 1) / 2) * static_cast<size_t>((v.height + 1) / 2); break;
+        case RawFormat::Yuyv:
+            v.pixelStep = 2;
+            frameBytes = pixels * 2;
+            v.rowStride = static_cast<size_t>(v.width) * 2;
+            break;
+    }
+    for (size_t off = 0; off + frameBytes <= v.size; off += frameBytes) v.frames.push_back(off);
+    return true;
+}
+
+// 几何与运动：uv → 相机像素
+struct Geometry {
+    double x0, y0, x1, y1;      // 显示器区域（相机像素，自上而下）
+    double px(double u) const { return x0 + u * (x1 - x0); }
+    double py(double v) const { return y1 - v * (y1 - y0); }
+    double pxPerU() const { return x1 - x0; }
+};
+
+struct Analyzer {
+    const Video& video;
+    const Target& target;
+    Geometry geo;
+    double speed;               // 画面宽度/秒
+    double phase = 0.0;         // 首帧的位置相位：位置 = fract(phase + speed * t)
+    int bandY0 = 0, bandY1 = 0; // 条带行范围
+    int pursuitFrames = 0;      // 追踪平均的半窗口（帧）
+
+    Analyzer(const Video& v, const Target& t, const Geometry& g, double s) : video(v), target(t), geo(g), speed(s) {
+        bandY0 = std::clamp(static_cast<int>(std::floor(g.py(t.y + t.bandHalf))), 0, v.height - 1);
+        bandY1 = std::clamp(static_cast<int>(std::ceil(g.py(t.y - t.bandHalf))), bandY0 + 1, v.height);
+    }
+
+    // 条带内逐列平均亮度（归一化到 0..1）
+    void profile(size_t frame, int xa, int xb, std::vector<double>& out) const {
+        out.assign(static_cast<size_t>(xb - xa), 0.0);
+        for (int y = bandY0; y < bandY1; ++y) {
+            for (int x = xa; x < xb; ++x) out[x - xa] += video.sample(frame, x, y);
+        }
+        const double scale = 1.0 / ((bandY1 - bandY0) * video.maxCode);
+        for (double& p : out) p *= scale;
+    }
+
+    // 以 frame 为参考的追踪剖面：相邻 ±pursuitFrames 帧按解析速度平移（线性插值）后平均，
+    // 相当于追焦相机/眼动追踪看到的图像；任一帧取样越出显示区域时返回 false
+    bool trackedProfile(size_t frame, double xa, int n, std::vector<double>& out) const {
+        if (pursuitFrames == 0) {
+            profile(frame, static_cast<int>(xa), static_cast<int>(xa) + n, out);
+            return true;
+        }
+        const long first = static_cast<long>(frame) - pursuitFrames, last = static_cast<long>(frame) + pursuitFrames;
+        if (first < 0 || last >= static_cast<long>(video.frames.size())) return false;
+        out.assign(static_cast<size_t>(n), 0.0);
+        std::vector<double> p;
+        for (long f = first; f <= last; ++f) {
+            const double shifted = xa + speed * (f - static_cast<long>(frame)) / video.fps * geo.pxPerU();
+            const int base = static_cast<int>(std::floor(shifted));
+            const double frac = shifted - base;
+            if (base < geo.x0 || base + n + 1 > geo.x1) return false;
+            profile(static_cast<size_t>(f), base, base + n + 1, p);
+            for (int i = 0; i < n; ++i) out[i] += p[i] + (p[i + 1] - p[i]) * frac;
+        }
+        for (double& v : out) v /= static_cast<double>(last - first + 1);
+        return true;
+    }
+
+    // 粗定位：整行剖面中高于 (最小 + 最大)/2 的区域质心；目标跨越画面边缘时返回 false
+    bool coarse(size_t frame, double& u) const {
+        const int xa = static_cast<int>(std::ceil(geo.x0)), xb = static_cast<int>(std::floor(geo.x1));
+        std::vector<double> p;
+        profile(frame, xa, xb, p);
+        const auto [mn, mx] = std::minmax_element(p.begin(), p.end());
+        const double thr = (*mn + *mx) * 0.5;
+        if (p.front() > thr || p.back() > thr) return false;
+        double sum = 0.0, weight = 0.0;
+        for (size_t i = 0; i < p.size(); ++i) {
+            if (p[i] > thr) {
+                sum += (p[i] - thr) * (xa + i + 0.5);
+                weight += p[i] - thr;
+            }
+        }
+        if (weight <= 0.0) return false;
+        u = (sum / weight - geo.x0) / geo.pxPerU();
+        return true;
+    }
+
+    // 由前若干帧的粗定位估计相位（圆周平均，避免 0/1 回绕）
+    void estimatePhase(size_t frames) {
+        double s = 0.0, c = 0.0;
+        for (size_t f = 0; f < frames; ++f) {
+            double u;
+            if (!coarse(f, u)) continue;
+            const double ph = 2.0 * M_PI * (u - speed * f / video.fps);
+            s += std::sin(ph);
+            c += std::cos(ph);
+        }
+        phase = std::atan2(s, c) / (2.0 * M_PI);
+        phase -= std::floor(phase);
+    }
+
+    FrameResult analyze(size_t frame) const {
+        FrameResult r;
+        r.time = frame / video.fps;
+        double u = phase + speed * r.time;
+        u -= std::floor(u);
+        const double halfPx = target.halfWidth * geo.pxPerU();
+        const double window = target.halfWidth * 4.0;
+        if (u - window < 0.0 || u + window > 1.0) {
+            r.status = "wrap";
+            return r;
+        }
+        const double predicted = geo.px(u);
+        const int xa = static_cast<int>(std::floor(geo.px(u - window))), xb = static_cast<int>(std::ceil(geo.px(u + window)));
+        const int n = xb - xa;
+        std::vector<double> p;
+        if (!trackedProfile(frame, xa, n, p)) {
+            r.status = "wrap";
+            return r;
+        }
+        const int outer = std::max(2, n / 10);
+
+        // 背景：窗口两端 10% 的中位数
+        std::vector<double> tmp(p.begin(), p.begin() + outer);
+        tmp.insert(tmp.end(), p.end() - outer, p.end());
+        std::nth_element(tmp.begin(), tmp.begin() + tmp.size() / 2, tmp.end());
+        const double lo = tmp[tmp.size() / 2];
+        // 50% 跨越点定中心：从最亮处向两侧找首个低于阈值的位置
+        const int peak = static_cast<int>(std::max_element(p.begin() + outer, p.end() - outer) - p.begin());
+        const double half = (lo + p[peak]) * 0.5;
+        int l = peak, rr = peak;
+        while (l > 0 && p[l - 1] > half) --l;
+        while (rr < n - 1 && p[rr + 1] > half) ++rr;
+        if (l <= outer || rr >= n - 1 - outer) {
+            r.status = "no-target";
+            return r;
+        }
+        r.center = xa + (l + rr + 1) * 0.5;
+        // 目标亮度：中心 ±半宽/2 的中位数
+        const int ca = std::max(0, static_cast<int>(r.center - xa - halfPx * 0.5));
+        const int cb = std::min(n, static_cast<int>(r.center - xa + halfPx * 0.5) + 1);
+        tmp.assign(p.begin() + ca, p.begin() + cb);
+        std::nth_element(tmp.begin(), tmp.begin() + tmp.size() / 2, tmp.end());
+        const double hi = tmp[tmp.size() / 2];
+        if (hi - lo < 0.02) {
+            r.status = "low-contrast";
+            return r;
+        }
+        std::vector<double> nrm(n);
+        for (int i = 0; i < n; ++i) nrm[i] = (p[i] - lo) / (hi - lo);
+
+        // 从中心向外找归一化亮度首次低于 level 的位置（线性插值，返回距中心的像素数）
+        const int ci = static_cast<int>(r.center - xa);
+        auto crossing = [&](double level, int dir) {
+            for (int i = ci; i + dir >= 0 && i + dir < n; i += dir) {
+                if (nrm[i] >= level && nrm[i + dir] < level) {
+                    return std::abs(i + dir * (nrm[i] - level) / (nrm[i] - nrm[i + dir]) - (r.center - xa));
+                }
+            }
+            return -1.0;
+        };
+        // 目标向 +x 运动：右侧为前缘，左侧为后缘
+        const double lead90 = crossing(0.9, 1), lead10 = crossing(0.1, 1);
+        const double trail90 = crossing(0.9, -1), trail10 = crossing(0.1, -1);
+        if (lead90 < 0.0 || lead10 < 0.0 || trail90 < 0.0 || trail10 < 0.0) {
+            r.status = "no-edge";
+            return r;
+        }
+        r.leadWidth = lead10 - lead90;
+        r.trailWidth = trail10 - trail90;
+        r.lag = r.center - predicted;
+
+        double over = 0.0, under = 0.0;
+        for (int i = 0; i < n; ++i) {
+            const double d = std::abs(i + 0.5 - (r.center - xa));
+            if (d <= std::max(lead10, trail10)) over = std::max(over, nrm[i] - 1.0);
+            under = std::max(under, -nrm[i]);
+        }
+        r.overshoot = over * 100.0;
+        r.undershoot = under * 100.0;
+        // 拖影：后缘外侧相对前缘外侧同距离处的多余亮度（对称的尾焰等静态内容相互抵消）
+        const int dStart = static_cast<int>(std::ceil(std::max(lead10, trail10))) + 1;
+        const int dEnd = std::min(ci, n - 1 - ci) - outer;
+        for (int d = dStart; d < dEnd; ++d) {
+            const double g = nrm[ci - d] - nrm[ci + d];
+            if (g * 100.0 > r.ghost) {
+                r.ghost = g * 100.0;
+                r.ghostOffset = d;
+            }
+        }
+        r.valid = true;
+        r.status = "ok";
+        return r;
+    }
+};
+
+double percentile(std::vector<double> v, double q) {
+    if (v.empty()) return 0.0;
+    const size_t k = std::min(v.size() - 1, static_cast<size_t>(q * (v.size() - 1) + 0.5));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    const Target* target = nullptr;
+    for (const Target& t : kTargets) {
+        if (opt.target == t.name) target = &t;
+    }
+    if (!target) {
+        std::cerr << "Unknown target: " << opt.target << std::endl;
+        return 1;
+    }
+
+    Video video;
+    if (!mapFile(opt.input, video)) return 1;
+    if (!(opt.raw ? indexRaw(opt, video) : indexY4m(video))) return 1;
+    if (opt.fps > 0.0) video.fps = opt.fps;
+    if (video.fps <= 0.0) {
+        std::cerr << "Frame rate unknown: pass --fps" << std::endl;
+        return 1;
+    }
+    if (video.frames.empty()) {
+        std::cerr << "No frames in " << opt.input << std::endl;
+        return 1;
+    }
+    // 顺序读取提示：条带行在文件中按帧递增
+    madvise(const_cast<uint8_t*>(video.map), video.size, MADV_SEQUENTIAL);
+
+    Geometry geo{0.0, 0.0, static_cast<double>(video.width), static_cast<double>(video.height)};
+    if (opt.screen[2] > opt.screen[0]) {
+        geo = Geometry{static_cast<double>(opt.screen[0]), static_cast<double>(opt.screen[1]),
+                       static_cast<double>(std::min(opt.screen[2], video.width)),
+                       static_cast<double>(std::min(opt.screen[3], video.height))};
+    }
+    Analyzer analyzer(video, *target, geo, opt.speed > 0.0 ? opt.speed : target->speed);
+    if (opt.haveT0) {
+        analyzer.phase = analyzer.speed * opt.t0;
+        analyzer.phase -= std::floor(analyzer.phase);
+    } else {
+        analyzer.estimatePhase(std::min<size_t>(video.frames.size(), 64));
+    }
+    analyzer.pursuitFrames = static_cast<int>(std::lround(opt.pursuitMs * 0.5e-3 * video.fps));
+    const double pxPerMs = analyzer.speed * geo.pxPerU() / 1000.0;
+    std::cerr << "dht_mprt " << opt.input << ": " << video.width << "x" << video.height << " @ " << video.fps << " fps, "
+              << video.frames.size() << " frames, target " << target->name << " (" << pxPerMs * 1000.0 << " px/s), "
+              << ThreadPool::shared().size() << " threads";
+    if (analyzer.pursuitFrames > 0) std::cerr << ", pursuit " << 2 * analyzer.pursuitFrames + 1 << " frames";
+    std::cerr << std::endl;
+
+    using clock = std::chrono::high_resolution_clock;
+    const auto t0 = clock::now();
+    std::vector<FrameResult> results(video.frames.size());
+    ThreadPool::shared().parallelFor(results.size(), 64, [&](size_t b, size_t e) {
+        for (size_t f = b; f < e; ++f) results[f] = analyzer.analyze(f);
+    });
+    const double seconds = std::chrono::duration<double>(clock::now() - t0).count();
+
+    if (!opt.csvPath.empty()) {
+        FILE* csv = std::fopen(opt.csvPath.c_str(), "w");
+        if (!csv) {
+            std::cerr << "Cannot write " << opt.csvPath << std::endl;
+            return 1;
+        }
+        std::fprintf(csv, "frame,time_s,status,center_px,lag_px,lead_bew_px,trail_bew_px,lead_bet_ms,trail_bet_ms,"
+                          "overshoot_pct,undershoot_pct,ghost_pct,ghost_offset_px\n");
+        for (size_t f = 0; f < results.size(); ++f) {
+            const FrameResult& r = results[f];
+            std::fprintf(csv, "%zu,%.6f,%s,%.2f,%.2f,%.2f,%.2f,%.3f,%.3f,%.2f,%.2f,%.2f,%.1f\n", f, r.time, r.status, r.center,
+                         r.lag, r.leadWidth, r.trailWidth, r.leadWidth / pxPerMs, r.trailWidth / pxPerMs, r.overshoot,
+                         r.undershoot, r.ghost, r.ghostOffset);
+        }
+        std::fclose(csv);
+    }
+
+    std::vector<double> lead, trail, over, under, ghost, lag;
+    for (const FrameResult& r : results) {
+        if (!r.valid) continue;
+        lead.push_back(r.leadWidth);
+        trail.push_back(r.trailWidth);
+        over.push_back(r.overshoot);
+        under.push_back(r.undershoot);
+        ghost.push_back(r.ghost);
+        lag.push_back(r.lag);
+    }
+    double lagMean = 0.0, lagVar = 0.0;
+    for (double v : lag) lagMean += v / lag.size();
+    for (double v : lag) lagVar += (v - lagMean) * (v - lagMean) / lag.size();
+
+    const double mb = static_cast<double>(video.size) / (1024.0 * 1024.0);
+    std::printf("%zu frames analyzed, %zu skipped (wrap / no target), %.3f s (%.0f frames/s, %.0f MB/s)\n", lead.size(),
+                results.size() - lead.size(), seconds, results.size() / seconds, mb / seconds);
+    if (lead.empty()) return 2;
+    std::printf("                 median      p90\n");
+    auto row = [&](const char* name, const std::vector<double>& v, double scale, const char* unit) {
+        std::printf("%-14s %8.3f %8.3f %s\n", name, percentile(v, 0.5) * scale, percentile(v, 0.9) * scale, unit);
+    };
+    row("lead BEW", lead, 1.0, "px");
+    row("trail BEW", trail, 1.0, "px");
+    row("lead BET", lead, 1.0 / pxPerMs, "ms");
+    row("trail BET", trail, 1.0 / pxPerMs, "ms");
+    row("overshoot", over, 1.0, "%");
+    row("undershoot", under, 1.0, "%");
+    row("ghost", ghost, 1.0, "%");
+    std::printf("tracking jitter %.3f px rms (%.3f ms), mean offset %.2f px\n", std::sqrt(lagVar), std::sqrt(lagVar) / pxPerMs,
+                lagMean);
+    return 0;
+}